@@ -22,6 +22,9 @@
 <#if has_field_with_constraint(fieldList)>
 #include <zserio/ConstraintException.h>
 </#if>
+<#if withWriterCode && has_offset_patching(fieldList)>
+#include <zserio/OffsetPatcher.h>
+</#if>
 <#if (withReflectionCode && has_non_simple_parameter(compoundParametersData))>
 #include <functional>
 </#if>
@@ -365,6 +368,7 @@ void ${name}::${field.setterName}(<@field_raw_cpp_type_name field/>&& <@field_ar
 }
 
     </#if>
+<@compound_copy_raw_field_definition name, field/>
 </#list>
 <@compound_functions_definition name, compoundFunctionsData/>
 <#macro choice_tag_no_match name indent>
@@ -479,6 +483,38 @@ size_t ${name}::initializeOffsets(${name}::ZserioPackingContext&<#if uses_packin
 }
     </#if>
 </#if>
+<#if isSkippable>
+
+<#macro choice_skip_member member packed indent>
+    <#local I>${""?left_pad(indent * 4)}</#local>
+    <#if member.compoundField??>
+        <#if canUseNativeSwitch>
+${I}{
+        <@compound_skip_field member.compoundField, indent+1/>
+${I}}
+        <#else>
+    <@compound_skip_field member.compoundField, indent/>
+        </#if>
+    <#else>
+${I}// empty
+    </#if>
+    <#if canUseNativeSwitch>
+${I}break;
+    </#if>
+</#macro>
+<#macro choice_skip_no_match name indent>
+    <#local I>${""?left_pad(indent * 4)}</#local>
+${I}return ::zserio::Result<void>::error(::zserio::ErrorCode::InvalidChoice);
+</#macro>
+::zserio::Result<void> ${name}::skip(::zserio::BitStreamReader&<#if fieldList?has_content> in</#if><#rt>
+        <#lt><@compound_skip_parameter_list compoundParametersData/>)
+{
+    <@compound_skip_owner compoundParametersData, fieldList/>
+    <@choice_switch "choice_skip_member", "choice_skip_no_match", ownerIndirectSelectorExpression, 1/>
+
+    return ::zserio::Result<void>::success();
+}
+</#if>
 
 <#macro choice_compare_member member packed indent>
     <#local I>${""?left_pad(indent * 4)}</#local>
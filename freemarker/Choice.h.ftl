@@ -275,6 +275,9 @@ public:
     size_t initializeOffsets(ZserioPackingContext& context, size_t bitPosition);
     </#if>
 </#if>
+<#if isSkippable>
+    <@compound_skip_declaration compoundParametersData/>
+</#if>
 
 <#if withCodeComments>
     /**
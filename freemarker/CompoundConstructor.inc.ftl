@@ -37,6 +37,9 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if withParsingInfoCode>
         m_parsingInfo()
     </#if>
+    <#if isProjectable>
+        m_loadedFields(::zserio::FieldMask::all())
+    </#if>
     <#if memberInitializationMacroName != "">
         <#if (numExtendedFields > 0)>
         m_numExtendedFields(${numExtendedFields})
@@ -48,17 +51,30 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
 }
 </#macro>
 
-<#macro compound_read_constructor_declaration compoundConstructorsData packed=false>
+<#macro compound_read_constructor_declaration compoundConstructorsData packed=false projection=false>
     <#if withCodeComments>
     /**
+        <#if projection>
+     * Projection read constructor.
+     *
+     * Reads only the fields selected by the field mask. Other fields are skipped in the bit stream without
+     * decoding and stay default constructed, their getters throw and their loaded indicators return false.
+     * Fields which determine the layout of the following fields are always read. The object is meant only
+     * for reading of the loaded fields.
+     *
+        <#else>
      * Read constructor.
      *
+        </#if>
         <#if packed>
      * Called only internally if packed arrays are used.
      *
      * \param context Context for packed arrays.
         </#if>
      * \param in Bit stream reader to use.
+        <#if projection>
+     * \param fieldMask Fields to read, combination of FIELD_ constants.
+        </#if>
         <#list compoundConstructorsData.compoundParametersData.list as compoundParameter>
      * \param <@parameter_argument_name compoundParameter.name/> Value of the parameter \ref ${compoundParameter.getterName} "${compoundParameter.name}".
         </#list>
@@ -71,7 +87,7 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
             <#lt>ZserioPackingContext& context,
             <#nt><#rt><#-- trim only newline -->
     </#if>
-            ::zserio::BitStreamReader& in<#t>
+            ::zserio::BitStreamReader& in<#if projection>, ::zserio::FieldMask fieldMask</#if><#t>
     <#if constructorArgumentTypeList?has_content>
             <#lt>,
             ${constructorArgumentTypeList}<#t>
@@ -79,13 +95,17 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
             <#lt>, const allocator_type& allocator = allocator_type());
 </#macro>
 
-<#macro compound_read_constructor_definition compoundConstructorsData memberInitializationMacroName packed=false>
+<#macro compound_read_constructor_definition compoundConstructorsData memberInitializationMacroName packed=false
+        projection=false>
     <#local constructorArgumentTypeList><@compound_constructor_argument_type_list compoundConstructorsData, 2/></#local>
 ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundName}(<#rt>
     <#if packed>
         ${compoundConstructorsData.compoundName}::ZserioPackingContext& context, <#t>
     </#if>
         ::zserio::BitStreamReader&<#if withParsingInfoCode || compoundConstructorsData.fieldList?has_content> in</#if><#t>
+    <#if projection>
+        , ::zserio::FieldMask fieldMask<#t>
+    </#if>
     <#if constructorArgumentTypeList?has_content>
         <#lt>,
         ${constructorArgumentTypeList}<#t>
@@ -103,6 +123,16 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if withParsingInfoCode>
         m_parsingInfo(in.getBitPosition())
     </#if>
+    <#if projection>
+        <#-- fields which determine the layout are always read -->
+        m_loadedFields(fieldMask<#rt>
+        <#list compoundConstructorsData.fieldList as field>
+            <#if field.skip.isOwnerField> | <@field_mask_name field/></#if><#t>
+        </#list>
+        <#lt>)
+    <#elseif isProjectable>
+        m_loadedFields(::zserio::FieldMask::all())
+    </#if>
     <#if memberInitializationMacroName != "">
         <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
         m_numExtendedFields(0)
@@ -175,6 +205,9 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
         m_numExtendedFields(other.m_numExtendedFields)
     </#if>
+    <#if isProjectable>
+        m_loadedFields(other.m_loadedFields)
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_copy_constructor_initializer_field field, 2/>
         <#if field.usesAnyHolder>
@@ -198,6 +231,9 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
         m_numExtendedFields(other.m_numExtendedFields)
     </#if>
+    <#if isProjectable>
+        m_loadedFields(other.m_loadedFields)
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_copy_constructor_initializer_field field, 2/>
         <#if field.usesAnyHolder>
@@ -244,6 +280,9 @@ ${compoundConstructorsData.compoundName}& ${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
     m_numExtendedFields = other.m_numExtendedFields;
     </#if>
+    <#if isProjectable>
+    m_loadedFields = other.m_loadedFields;
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_assignment_field field, 1/>
         <#if field.usesAnyHolder>
@@ -267,6 +306,9 @@ ${compoundConstructorsData.compoundName}& ${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
     m_numExtendedFields = other.m_numExtendedFields;
     </#if>
+    <#if isProjectable>
+    m_loadedFields = other.m_loadedFields;
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_assignment_field field, 1/>
         <#if field.usesAnyHolder>
@@ -313,6 +355,9 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
         m_numExtendedFields(other.m_numExtendedFields)
     </#if>
+    <#if isProjectable>
+        m_loadedFields(other.m_loadedFields)
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_move_constructor_initializer_field field, 2/>
         <#if field.usesAnyHolder>
@@ -336,6 +381,9 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
         m_numExtendedFields(other.m_numExtendedFields)
     </#if>
+    <#if isProjectable>
+        m_loadedFields(other.m_loadedFields)
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_move_constructor_initializer_field field, 2/>
         <#if field.usesAnyHolder>
@@ -383,6 +431,9 @@ ${compoundConstructorsData.compoundName}& ${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
     m_numExtendedFields = other.m_numExtendedFields;
     </#if>
+    <#if isProjectable>
+    m_loadedFields = other.m_loadedFields;
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_move_assignment_field field, 1/>
         <#if field.usesAnyHolder>
@@ -406,6 +457,9 @@ ${compoundConstructorsData.compoundName}& ${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
     m_numExtendedFields = other.m_numExtendedFields;
     </#if>
+    <#if isProjectable>
+    m_loadedFields = other.m_loadedFields;
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_move_assignment_field field, 1/>
         <#if field.usesAnyHolder>
@@ -457,6 +511,9 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
         m_numExtendedFields(other.m_numExtendedFields)
     </#if>
+    <#if isProjectable>
+        m_loadedFields(other.m_loadedFields)
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_allocator_propagating_copy_constructor_initializer_field field, 2/>
         <#if field.usesAnyHolder>
@@ -485,6 +542,9 @@ ${compoundConstructorsData.compoundName}::${compoundConstructorsData.compoundNam
     <#if (num_extended_fields(compoundConstructorsData.fieldList) > 0)>
         m_numExtendedFields(other.m_numExtendedFields)
     </#if>
+    <#if isProjectable>
+        m_loadedFields(other.m_loadedFields)
+    </#if>
     <#list compoundConstructorsData.fieldList as field>
         <@compound_allocator_propagating_copy_constructor_initializer_field field, 2/>
         <#if field.usesAnyHolder>
@@ -98,7 +98,8 @@ ${I}return <@field_member_type_name field/>(::zserio::NullOpt<#if field.holderNe
         <#local readCommandArgs>
             ${field.runtimeFunction.arg!}<#if field.needsAllocator><#if field.runtimeFunction.arg??>, </#if>allocator</#if><#t>
         </#local>
-        <#local readCommand><#lt>static_cast<<@field_cpp_type_name field/>>(in.read${field.runtimeFunction.suffix}(${readCommandArgs}))</#local>
+        <#local readSuffix>${field.runtimeFunction.suffix}<#if field.isBufferView>View</#if></#local>
+        <#local readCommand><#lt>static_cast<<@field_cpp_type_name field/>>(in.read${readSuffix}(${readCommandArgs}))</#local>
     <#elseif field.typeInfo.isEnum>
         <#local readCommand>::zserio::read<<@field_cpp_type_name field/>>(in)</#local>
     <#elseif field.compound??>
@@ -173,8 +174,20 @@ ${I}in.alignTo(${field.alignmentValue});
 <#macro compound_check_offset_field field compoundName actionName streamObjectName indent>
     <#local I>${""?left_pad(indent * 4)}</#local>
 ${I}${streamObjectName}.alignTo(UINT32_C(8));
+    <#if actionName == "Write" && field.offset.fieldName??>
+${I}if (${streamObjectName}.getOffsetPatcher() != nullptr)
+${I}{
+${I}    // single pass serialization, offset is filled in after the whole object is written, an offset field
+${I}    // which is not written before this field is kept as error by the patcher
+${I}    static_cast<void>(${streamObjectName}.getOffsetPatcher()->resolve(&(${field.offset.ownerGetter}),
+${I}            "${field.offset.fieldName}", 0, ${streamObjectName}.getBitPosition() / 8));
+${I}}
+${I}// check offset
+${I}else if (${streamObjectName}.getBitPosition() / 8 != (${field.offset.getter}))
+    <#else>
 ${I}// check offset
 ${I}if (${streamObjectName}.getBitPosition() / 8 != (${field.offset.getter}))
+    </#if>
 ${I}{
 ${I}    throw ::zserio::CppRuntimeException("${actionName}: Wrong offset for field ${compoundName}.${field.name}: ") <<
 ${I}            (${streamObjectName}.getBitPosition() / 8) << " != " << (${field.offset.getter}) << "!";
@@ -222,6 +235,14 @@ ${I}}
 <#macro compound_write_field_inner field compoundName indent packed>
     <#local I>${""?left_pad(indent * 4)}</#local>
     <@compound_write_field_prolog field, compoundName, indent/>
+    <#if is_offset_patch_slot(field, packed)>
+${I}if (out.getOffsetPatcher() != nullptr)
+${I}{
+${I}    // single pass serialization, offset is filled in when its labeled field is written
+${I}    static_cast<void>(out.getOffsetPatcher()->addSlot(this, "${field.name}", out.getBitPosition(),
+${I}            static_cast<uint8_t>(<#if field.array??>${field.array.elementBitSize.value}<#else>${field.bitSize.value}</#if>)));
+${I}}
+    </#if>
     <#if packed && uses_field_packing_context(field)>
         <#if field.compound?? || field.typeInfo.isBitmask>
 ${I}<@compound_get_field field/>.write(context.${field.getterName}(), out);
@@ -243,6 +264,25 @@ ${I}<@compound_get_field field/>.write(out);
     </#if>
 </#macro>
 
+<#function is_offset_patch_slot field packed>
+    <#if !field.isUsedAsOffset || packed>
+        <#return false>
+    </#if>
+    <#if field.array??>
+        <#return field.array.length?? && !field.array.isPacked && field.array.elementBitSize??>
+    </#if>
+    <#return field.bitSize??>
+</#function>
+
+<#function has_offset_patching fieldList>
+    <#list fieldList as field>
+        <#if field.isUsedAsOffset || (field.offset?? && field.offset.fieldName??)>
+            <#return true>
+        </#if>
+    </#list>
+    <#return false>
+</#function>
+
 <#macro compound_write_field_prolog field compoundName indent>
     <#local I>${""?left_pad(indent * 4)}</#local>
     <#if field.alignmentValue??>
@@ -444,8 +484,15 @@ ${I}}
 
     <#if needs_field_offset_checker(field)>
         static void checkOffset(const ${compoundName}& owner, size_t index, size_t byteOffset);
+        <#if field.offset.indexedFieldGetterName??>
+        static size_t getOffset(const ${compoundName}& owner, size_t index);
+        </#if>
         <#if withWriterCode>
         static void initializeOffset(${compoundName}& owner, size_t index, size_t byteOffset);
+            <#if field.offset.fieldName??>
+        static ::zserio::Result<void> resolveOffset(const ${compoundName}& owner, size_t index,
+                size_t byteOffset, ::zserio::IOffsetPatcher& offsetPatcher);
+            </#if>
         </#if>
     </#if>
     <#if field.array.elementCompound?? &&
@@ -470,6 +517,14 @@ void ${compoundName}::<@array_expressions_name field.name/>::checkOffset(const $
     }
 }
 
+        <#if field.offset.indexedFieldGetterName??>
+size_t ${compoundName}::<@array_expressions_name field.name/>::getOffset(const ${compoundName}& owner,
+        size_t index)
+{
+    return static_cast<size_t>(${field.offset.indirectGetter});
+}
+
+        </#if>
         <#if withWriterCode>
 void ${compoundName}::<@array_expressions_name field.name/>::initializeOffset(${compoundName}& owner,
         size_t index, size_t byteOffset)
@@ -478,6 +533,15 @@ void ${compoundName}::<@array_expressions_name field.name/>::initializeOffset(${
     ${field.offset.indirectSetter};
 }
 
+            <#if field.offset.fieldName??>
+::zserio::Result<void> ${compoundName}::<@array_expressions_name field.name/>::resolveOffset(
+        const ${compoundName}& owner, size_t index, size_t byteOffset, ::zserio::IOffsetPatcher& offsetPatcher)
+{
+    return offsetPatcher.resolve(&(${field.offset.ownerIndirectGetter}), "${field.offset.fieldName}", index,
+            byteOffset);
+}
+
+            </#if>
         </#if>
     </#if>
     <#if field.array.elementCompound?? &&
@@ -863,6 +927,254 @@ ${I}endBitPosition = <@compound_get_field field/>.initializeOffsets(endBitPositi
         </#if>
     void ${field.setterName}(<@field_raw_cpp_type_name field/>&& <@field_argument_name field/>);
     </#if>
+    <#if needs_field_copy_raw(field)>
+        <#if withCodeComments>
+
+    /**
+     * Copies the encoded field ${field.name} from the stream this object has been read from.
+     *
+     * The bits are copied as they are without encoding the field again. This allows to pass unchanged
+     * subtrees through when the object is written field by field, e.g. by transcoding or filtering proxies.
+     *
+     * \param in Bit stream reader which has been used to read this object.
+     * \param out Bit stream writer where to copy the encoded field.
+     *
+     * \throw CppRuntimeException When the field has not been read or when its bits cannot be copied.
+     */
+        </#if>
+    void ${field.copyRawName}(::zserio::BitStreamReader& in, ::zserio::BitStreamWriter& out) const;
+    </#if>
+</#macro>
+
+<#macro compound_copy_raw_field_definition compoundName field>
+    <#if needs_field_copy_raw(field)>
+void ${compoundName}::${field.copyRawName}(::zserio::BitStreamReader& in, ::zserio::BitStreamWriter& out) const
+{
+    const ::zserio::ParsingInfo& parsingInfo = <@compound_get_field field/>.parsingInfo();
+    if (in.setBitPosition(parsingInfo.getBitPosition()).isError() ||
+            out.writeBitsFrom(in, parsingInfo.getBitSize()).isError())
+    {
+        throw ::zserio::CppRuntimeException("Copy: Failed to copy encoded field ${compoundName}.${field.name}!");
+    }
+}
+
+    </#if>
+</#macro>
+
+<#macro compound_skip_declaration compoundParametersData>
+
+    <#if withCodeComments>
+    /**
+     * Skips the serialized object in the bit stream without reading it.
+     *
+     * Fields are not decoded and no memory is allocated. Only fields which determine the layout of the following
+     * fields are read, fields with constant bit size are skipped at once.
+     *
+     * \param in Bit stream reader to skip in.
+        <#list compoundParametersData.list as compoundParameter>
+     * \param <@parameter_argument_name compoundParameter.name/> Value of the parameter ${compoundParameter.name}.
+        </#list>
+     *
+     * \return Success or error code.
+     */
+    </#if>
+    static ::zserio::Result<void> skip(::zserio::BitStreamReader& in<#rt>
+            <#lt><@compound_skip_parameter_list compoundParametersData/>);
+</#macro>
+
+<#macro compound_skip_parameter_list compoundParametersData>
+    <#list compoundParametersData.list as compoundParameter>
+        <#if compoundParameter.typeInfo.isSimple>
+        , ${compoundParameter.typeInfo.typeFullName} <#t>
+        <#else>
+        , const ${compoundParameter.typeInfo.typeFullName}& <#t>
+        </#if>
+        <@parameter_argument_name compoundParameter.name/><#t>
+    </#list>
+</#macro>
+
+<#function needs_skip_owner compoundParametersData fieldList>
+    <#if compoundParametersData.list?has_content>
+        <#return true>
+    </#if>
+    <#list fieldList as field>
+        <#if field.skip.isOwnerField>
+            <#return true>
+        </#if>
+    </#list>
+    <#return false>
+</#function>
+
+<#-- expressions are formatted as accessors of the owner, thus the owner mimics the getters of the object -->
+<#macro compound_skip_owner compoundParametersData fieldList>
+    <#if needs_skip_owner(compoundParametersData, fieldList)>
+    <@compound_skip_owner_struct "ZserioSkipOwner", compoundParametersData, fieldList/>
+
+    ZserioSkipOwner owner = {};
+        <#list compoundParametersData.list as compoundParameter>
+    owner.<@parameter_member_name compoundParameter.name/> = <#if !compoundParameter.typeInfo.isSimple>&</#if><#rt>
+            <#lt><@parameter_argument_name compoundParameter.name/>;
+        </#list>
+    // parameters need not be used by any expression
+    static_cast<void>(owner);
+
+    </#if>
+</#macro>
+
+<#macro compound_skip_owner_struct structName compoundParametersData fieldList>
+    struct ${structName}
+    {
+        <#list compoundParametersData.list as compoundParameter>
+            <#if compoundParameter.typeInfo.isSimple>
+        ${compoundParameter.typeInfo.typeFullName} ${compoundParameter.getterName}() const
+        {
+            return <@parameter_member_name compoundParameter.name/>;
+        }
+            <#else>
+        const ${compoundParameter.typeInfo.typeFullName}& ${compoundParameter.getterName}() const
+        {
+            return *<@parameter_member_name compoundParameter.name/>;
+        }
+            </#if>
+
+        </#list>
+        <#list fieldList as field>
+            <#if field.skip.isOwnerField>
+        <@field_cpp_type_name field/> ${field.getterName}() const
+        {
+            return <@field_member_name field/>;
+        }
+
+            </#if>
+        </#list>
+        <#list compoundParametersData.list as compoundParameter>
+            <#if compoundParameter.typeInfo.isSimple>
+        ${compoundParameter.typeInfo.typeFullName} <@parameter_member_name compoundParameter.name/>;
+            <#else>
+        const ${compoundParameter.typeInfo.typeFullName}* <@parameter_member_name compoundParameter.name/>;
+            </#if>
+        </#list>
+        <#list fieldList as field>
+            <#if field.skip.isOwnerField>
+        <@field_cpp_type_name field/> <@field_member_name field/>;
+            </#if>
+        </#list>
+    };
+</#macro>
+
+<#macro compound_skip_check_result resultName indent>
+    <#local I>${""?left_pad(indent * 4)}</#local>
+${I}if (${resultName}.isError())
+${I}{
+${I}    return ::zserio::Result<void>::error(${resultName}.getError());
+${I}}
+</#macro>
+
+<#macro compound_skip_field field indent>
+    <#local I>${""?left_pad(indent * 4)}</#local>
+    <#if field.optional??>
+        <#if field.optional.clause??>
+${I}if (${field.skip.optionalClause})
+        <#else>
+${I}auto ${field.name}IsUsedResult = in.readBool();
+        <@compound_skip_check_result "${field.name}IsUsedResult", indent/>
+${I}if (${field.name}IsUsedResult.getValue())
+        </#if>
+${I}{
+        <@compound_skip_field_inner field, indent+1/>
+${I}}
+    <#else>
+    <@compound_skip_field_inner field, indent/>
+    </#if>
+</#macro>
+
+<#macro compound_skip_field_inner field indent>
+    <#local I>${""?left_pad(indent * 4)}</#local>
+    <#if field.alignmentValue??>
+${I}auto ${field.name}AlignResult = in.alignTo(${field.alignmentValue});
+        <@compound_skip_check_result "${field.name}AlignResult", indent/>
+    </#if>
+    <#if field.offset??>
+        <#-- offsets are not checked, skipped fields are not needed -->
+${I}auto ${field.name}OffsetAlignResult = in.alignTo(UINT32_C(8));
+        <@compound_skip_check_result "${field.name}OffsetAlignResult", indent/>
+    </#if>
+    <#if field.skip.isOwnerField>
+        <#if field.runtimeFunction??>
+${I}auto ${field.name}Result = in.read${field.runtimeFunction.suffix}(<@compound_skip_read_arguments field/>);
+        <@compound_skip_check_result "${field.name}Result", indent/>
+${I}owner.<@field_member_name field/> = static_cast<<@field_cpp_type_name field/>>(${field.name}Result.getValue());
+        <#elseif field.typeInfo.isEnum>
+${I}owner.<@field_member_name field/> = ::zserio::read<<@field_cpp_type_name field/>>(in);
+        <#else>
+${I}owner.<@field_member_name field/> = <@field_cpp_type_name field/>(in);
+        </#if>
+    <#else>
+        <#local skipCommand>
+            <#if field.array??>
+                <@array_typedef_name field/>::skip(in<#t>
+                <#if field.skip.arrayLength??>, static_cast<size_t>(${field.skip.arrayLength})</#if>)<#t>
+            <#elseif field.compound??>
+                <@field_cpp_type_name field/>::skip(in<#t>
+                <#list field.compound.instantiatedParameters as parameter>
+                    , ${parameter.indirectExpression}<#t>
+                </#list>
+                )<#t>
+            <#elseif field.bitSize?? && field.bitSize.isDynamicBitField>
+                in.skipBits(static_cast<size_t>(${field.bitSize.ownerIndirectValue}))<#t>
+            <#elseif field.bitSize??>
+                in.skipBits(${field.bitSize.value})<#t>
+            <#elseif field.runtimeFunction?? && (field.runtimeFunction.suffix == "String" ||
+                    field.runtimeFunction.suffix == "Bytes" || field.runtimeFunction.suffix == "BitBuffer")>
+                in.skip${field.runtimeFunction.suffix}()<#t>
+            <#elseif field.runtimeFunction??>
+                in.read${field.runtimeFunction.suffix}(${field.runtimeFunction.arg!})<#t>
+            </#if>
+        </#local>
+        <#if skipCommand?has_content>
+${I}auto ${field.name}Result = ${skipCommand};
+        <@compound_skip_check_result "${field.name}Result", indent/>
+        <#elseif field.typeInfo.isEnum>
+${I}static_cast<void>(::zserio::read<<@field_cpp_type_name field/>>(in));
+        <#else>
+${I}static_cast<void>(<@field_cpp_type_name field/>(in));
+        </#if>
+    </#if>
+</#macro>
+
+<#-- length of dynamic bit fields must be evaluated on the owner as well -->
+<#macro compound_skip_read_arguments field>
+    <#if field.bitSize?? && field.bitSize.isDynamicBitField>
+        static_cast<uint8_t>(${field.bitSize.ownerIndirectValue})<#t>
+    <#else>
+        ${field.runtimeFunction.arg!}<#t>
+    </#if>
+</#macro>
+
+<#macro compound_view_field_type_name field>
+    <#if field.array??>
+        ::zserio::ArrayView<<@compound_view_element_traits_name field/>, <@array_type_enum field/>><#t>
+    <#elseif field.compound??>
+        ${field.typeInfo.typeFullName}View<#t>
+    <#elseif field.typeInfo.isString>
+        ::zserio::StringView<#t>
+    <#elseif field.typeInfo.isBytes>
+        ::zserio::BytesView<#t>
+    <#else>
+        <@field_cpp_type_name field/><#t>
+    </#if>
+</#macro>
+
+<#macro compound_view_element_traits_name field>
+    <#if field.array.elementCompound??>
+        ${field.array.elementTypeInfo.typeFullName}View<#t>
+    <#elseif field.array.elementTypeInfo.isString>
+        ::zserio::StringViewTraits<#t>
+    <#elseif field.array.elementTypeInfo.isBytes>
+        ::zserio::BytesViewTraits<#t>
+    <#else>
+        ::zserio::ValueViewTraits<<@array_traits_type_name field/>><#t>
+    </#if>
 </#macro>
 
 <#macro compound_get_field field>
@@ -1002,6 +1314,10 @@ ${I};
     </#if>
 </#macro>
 
+<#macro field_mask_name field>
+    FIELD_${field.name}<#t>
+</#macro>
+
 <#macro choice_tag_name field>
     CHOICE_${field.name}<#t>
 </#macro>
@@ -1264,6 +1580,14 @@ ${I}context.${field.getterName}().init<<@array_traits_type_name field/>>(<#rt>
     <#return false>
 </#function>
 
+<#function needs_field_copy_raw field>
+    <#-- only compounds know where they have been read from -->
+    <#if withWriterCode && withParsingInfoCode && field.compound?? && !field.array??>
+        <#return true>
+    </#if>
+    <#return false>
+</#function>
+
 <#function needs_field_read_local_variable field>
     <#if field.array?? || field.constraint??>
         <#return true>
@@ -23,6 +23,9 @@
 <#if has_field_with_constraint(fieldList)>
 #include <zserio/ConstraintException.h>
 </#if>
+<#if withWriterCode && has_offset_patching(fieldList)>
+#include <zserio/OffsetPatcher.h>
+</#if>
 <#if (withReflectionCode && has_non_simple_parameter(compoundParametersData))>
 #include <functional>
 </#if>
@@ -32,6 +35,12 @@
 <@user_includes cppUserIncludes, false/>
 <@namespace_begin package.path/>
 
+<#if isProjectable>
+    <#list fieldList as field>
+constexpr ::zserio::FieldMask ${name}::<@field_mask_name field/>;
+    </#list>
+
+</#if>
 <#assign numExtendedFields=num_extended_fields(fieldList)>
 <#function extended_field_index numFields numExtendedFields fieldIndex>
     <#return fieldIndex - (numFields - numExtendedFields)>
@@ -42,7 +51,7 @@
         <#if field.optional??>
             <#if field.holderNeedsAllocator>allocator<#else>::zserio::InPlace</#if>, <#t>
         </#if>
-        <#if field.typeInfo.isString>
+        <#if field.typeInfo.isString && !field.isBufferView>
         ::zserio::stringViewToString(${field.initializer}, allocator)<#t>
         <#else>
         static_cast<${field.typeInfo.typeFullName}>(${field.initializer})<#t>
@@ -85,6 +94,20 @@
 
 <@compound_read_constructor_definition compoundConstructorsData, readConstructorInitMacroName, true/>
 </#if>
+<#if isProjectable>
+<#macro projection_read_constructor_field_initialization packed>
+    <#list fieldList as field>
+        <@field_member_name field/>(${field.readerName}(in<#if !field.skip.isOwnerField>, fieldMask</#if><#rt>
+        <#if field.needsAllocator || field.holderNeedsAllocator>
+                , allocator<#t>
+        </#if>
+                <#lt>))
+    </#list>
+</#macro>
+
+<@compound_read_constructor_definition compoundConstructorsData, "projection_read_constructor_field_initialization",
+        false, true/>
+</#if>
 
 <#if needs_compound_initialization(compoundConstructorsData) || has_field_with_initialization(fieldList)>
 <@compound_copy_constructor_definition compoundConstructorsData/>
@@ -273,17 +296,28 @@ void ${name}::initializeChildren()
 }
 
 </#if>
+<#macro structure_check_loaded_field field>
+    <#if isProjectable>
+    if (!${field.isLoadedIndicatorName}())
+    {
+        throw ::zserio::CppRuntimeException("Field ${name}.${field.name} is not loaded!");
+    }
+
+    </#if>
+</#macro>
 <@compound_parameter_accessors_definition name, compoundParametersData/>
 <#list fieldList as field>
     <#if needs_field_getter(field)>
 <@field_raw_cpp_type_name field/>& ${name}::${field.getterName}()
 {
+    <@structure_check_loaded_field field/>
     return <@compound_get_field field/><#if field.array??>.getRawArray()</#if>;
 }
 
     </#if>
 <@field_raw_cpp_argument_type_name field/> ${name}::${field.getterName}() const
 {
+    <@structure_check_loaded_field field/>
     return <@compound_get_field field/><#if field.array??>.getRawArray()</#if>;
 }
 
@@ -297,6 +331,9 @@ void ${name}::${field.setterName}(<@field_raw_cpp_argument_type_name field/> <@f
     }
         </#if>
     <@field_member_name field/> = <@compound_setter_field_value field/>;
+        <#if isProjectable>
+    m_loadedFields |= <@field_mask_name field/>;
+        </#if>
 }
 
     </#if>
@@ -310,15 +347,26 @@ void ${name}::${field.setterName}(<@field_raw_cpp_type_name field/>&& <@field_ar
     }
         </#if>
     <@field_member_name field/> = <@compound_setter_field_rvalue field/>;
+        <#if isProjectable>
+    m_loadedFields |= <@field_mask_name field/>;
+        </#if>
 }
 
     </#if>
+<@compound_copy_raw_field_definition name, field/>
     <#if field.isExtended>
 bool ${name}::${field.isPresentIndicatorName}() const
 {
     return m_numExtendedFields > ${extended_field_index(fieldList?size, numExtendedFields, field?index)};
 }
 
+    </#if>
+    <#if isProjectable>
+bool ${name}::${field.isLoadedIndicatorName}() const
+{
+    return m_loadedFields.contains(<@field_mask_name field/>);
+}
+
     </#if>
     <#if field.optional??>
 bool ${name}::${field.optional.isUsedIndicatorName}() const
@@ -341,6 +389,9 @@ void ${name}::${field.optional.resetterName}()
     }
             </#if>
     <@field_member_name field/>.reset();
+            <#if isProjectable>
+    m_loadedFields |= <@field_mask_name field/>;
+            </#if>
 }
 
         </#if>
@@ -415,6 +466,21 @@ size_t ${name}::initializeOffsets(${name}::ZserioPackingContext&<#if uses_packin
 }
     </#if>
 </#if>
+<#if isSkippable>
+
+::zserio::Result<void> ${name}::skip(::zserio::BitStreamReader&<#if fieldList?has_content> in</#if><#rt>
+        <#lt><@compound_skip_parameter_list compoundParametersData/>)
+{
+    <@compound_skip_owner compoundParametersData, fieldList/>
+    <#list fieldList as field>
+    <@compound_skip_field field, 1/>
+    </#list>
+    <#if fieldList?has_content>
+
+    </#if>
+    return ::zserio::Result<void>::success();
+}
+</#if>
 
 <#macro structure_compare_field field indent>
     <#local I>${""?left_pad(indent * 4)}</#local>
@@ -626,8 +692,206 @@ const ::zserio::ParsingInfo& ${name}::parsingInfo() const
 
         </#if>
     <@compound_read_field field, name, 1, true/>
+}
+    </#if>
+    <#if isProjectable && !field.skip.isOwnerField>
+
+<@field_member_type_name field, name/> ${name}::${field.readerName}(<#rt>
+        <#lt>::zserio::BitStreamReader& in, ::zserio::FieldMask fieldMask<#rt>
+        <#if field.needsAllocator || field.holderNeedsAllocator>
+        <#lt>,
+        const allocator_type& allocator<#rt>
+        </#if>
+        <#lt>)
+{
+    if (fieldMask.contains(<@field_mask_name field/>))
+    {
+        return ${field.readerName}(in<#if field.needsAllocator || field.holderNeedsAllocator>, allocator</#if>);
+    }
+
+    const ::zserio::Result<void> skipResult = ${field.skipperName}(in);
+    if (skipResult.isError())
+    {
+        throw ::zserio::CppRuntimeException("Read: Failed to skip field ${name}.${field.name}: ") <<
+                ::zserio::getErrorMessage(skipResult.getError()) << "!";
+    }
+
+        <#if field.optional?? || (!field.typeInfo.isSimple && !(field.typeInfo.isString && field.initializer??))>
+    return <@field_member_type_name field/>(<@field_default_constructor_arguments field/>);
+        <#else>
+    return <@field_default_constructor_arguments field/>;
+        </#if>
+}
+
+::zserio::Result<void> ${name}::${field.skipperName}(::zserio::BitStreamReader& in) const
+{
+    // expressions are formatted as accessors of the owner, the fields they use are already read
+    const ${name}& owner = *this;
+    static_cast<void>(owner);
+    <@compound_skip_field field, 1/>
+
+    return ::zserio::Result<void>::success();
 }
     </#if>
 
 </#list>
+<#macro structure_view_check_result resultName valueTypeName indent>
+    <#local I>${""?left_pad(indent * 4)}</#local>
+${I}if (${resultName}.isError())
+${I}{
+${I}    return ::zserio::Result<${valueTypeName}>::error(${resultName}.getError());
+${I}}
+</#macro>
+<#macro structure_view_seek fieldIndex valueTypeName>
+    ::zserio::BitStreamReader in(m_buffer);
+    ZserioViewOwner owner = {};
+    const ::zserio::Result<void> seekResult = seek(in, owner, ${fieldIndex});
+    <@structure_view_check_result "seekResult", valueTypeName, 1/>
+
+</#macro>
+<#macro structure_view_read_field field viewTypeName>
+    <#if field.array?? && field.offset?? && field.offset.indexedFieldGetterName??>
+    const auto offsetsResult = ${field.offset.indexedFieldGetterName}();
+    <@structure_view_check_result "offsetsResult", viewTypeName, 1/>
+
+    return ${viewTypeName}::create(m_buffer, in, <#rt>
+            <#lt><#if field.skip.arrayLength??>static_cast<size_t>(${field.skip.arrayLength})<#else>0</#if>,
+            ::zserio::ArrayViewOffsets(offsetsResult.getValue()));
+    <#elseif field.array??>
+    return ${viewTypeName}::create(m_buffer, in<#rt>
+            <#lt><#if field.skip.arrayLength??>, static_cast<size_t>(${field.skip.arrayLength})</#if>);
+    <#elseif field.compound??>
+    return ::zserio::Result<${viewTypeName}>::success(${viewTypeName}(m_buffer, in.getBitPosition()<#rt>
+        <#list field.compound.instantiatedParameters as parameter>
+            <#lt>, ${parameter.indirectExpression}<#rt>
+        </#list>
+            <#lt>));
+    <#elseif field.typeInfo.isString>
+    return in.readStringView();
+    <#elseif field.typeInfo.isBytes>
+    return in.readBytesView();
+    <#elseif field.runtimeFunction??>
+    const auto readResult = in.read${field.runtimeFunction.suffix}(<@compound_skip_read_arguments field/>);
+    <@structure_view_check_result "readResult", viewTypeName, 1/>
+
+    return ::zserio::Result<${viewTypeName}>::success(static_cast<${viewTypeName}>(readResult.getValue()));
+    <#elseif field.typeInfo.isEnum>
+    return ::zserio::Result<${viewTypeName}>::success(::zserio::read<${viewTypeName}>(in));
+    <#else>
+    return ::zserio::Result<${viewTypeName}>::success(${viewTypeName}(in));
+    </#if>
+</#macro>
+<#if isViewable>
+constexpr bool ${name}View::IS_BITSIZEOF_CONSTANT;
+
+${name}View::${name}View(::zserio::Span<const uint8_t> buffer, size_t bitPosition<#rt>
+    <#list compoundParametersData.list as compoundParameter>
+        <#lt>,
+        ${compoundParameter.typeInfo.typeFullName} <@parameter_argument_name compoundParameter.name/><#rt>
+    </#list>
+        <#lt>) :
+        m_buffer(buffer),
+        m_bitPosition(bitPosition)<#if compoundParametersData.list?has_content>,</#if>
+    <#list compoundParametersData.list as compoundParameter>
+        <@parameter_member_name compoundParameter.name/>(<@parameter_argument_name compoundParameter.name/>)<#sep>,</#sep>
+    </#list>
+{}
+    <#if !compoundParametersData.list?has_content>
+
+::zserio::Result<${name}View> ${name}View::read(
+        ::zserio::Span<const uint8_t> buffer, ::zserio::BitStreamReader& in)
+{
+    const size_t bitPosition = in.getBitPosition();
+    const ::zserio::Result<void> skipResult = ${name}::skip(in);
+    <@structure_view_check_result "skipResult", "${name}View", 1/>
+
+    return ::zserio::Result<${name}View>::success(${name}View(buffer, bitPosition));
+}
+
+::zserio::Result<void> ${name}View::skip(::zserio::BitStreamReader& in)
+{
+    return ${name}::skip(in);
+}
+    </#if>
+
+size_t ${name}View::getBitPosition() const
+{
+    return m_bitPosition;
+}
+    <#list compoundParametersData.list as compoundParameter>
+
+${compoundParameter.typeInfo.typeFullName} ${name}View::${compoundParameter.getterName}() const
+{
+    return <@parameter_member_name compoundParameter.name/>;
+}
+    </#list>
+    <#list fieldList as field>
+        <#if field.optional??>
+
+::zserio::Result<bool> ${name}View::${field.optional.isUsedIndicatorName}() const
+{
+    <@structure_view_seek field?index, "bool"/>
+            <#if field.optional.clause??>
+    return ::zserio::Result<bool>::success(${field.skip.optionalClause});
+            <#else>
+    return in.readBool();
+            </#if>
+}
+        </#if>
+        <#assign viewTypeName><@compound_view_field_type_name field/></#assign>
+
+::zserio::Result<${viewTypeName}> ${name}View::${field.getterName}() const
+{
+    <@structure_view_seek field?index, viewTypeName/>
+        <#if field.optional??>
+            <#if field.optional.clause??>
+    if (!(${field.skip.optionalClause}))
+            <#else>
+    const ::zserio::Result<bool> isUsedResult = in.readBool();
+    <@structure_view_check_result "isUsedResult", viewTypeName, 1/>
+    if (!isUsedResult.getValue())
+            </#if>
+    {
+        return ::zserio::Result<${viewTypeName}>::error(::zserio::ErrorCode::EmptyOptional);
+    }
+        </#if>
+        <#if field.alignmentValue??>
+    const ::zserio::Result<void> alignResult = in.alignTo(${field.alignmentValue});
+    <@structure_view_check_result "alignResult", viewTypeName, 1/>
+        </#if>
+        <#if field.offset??>
+    const ::zserio::Result<void> offsetAlignResult = in.alignTo(UINT32_C(8));
+    <@structure_view_check_result "offsetAlignResult", viewTypeName, 1/>
+        </#if>
+    <@structure_view_read_field field, viewTypeName/>
+}
+    </#list>
+
+::zserio::Result<size_t> ${name}View::bitSizeOf() const
+{
+    <@structure_view_seek fieldList?size, "size_t"/>
+    return ::zserio::Result<size_t>::success(in.getBitPosition() - m_bitPosition);
+}
+
+::zserio::Result<void> ${name}View::seek(::zserio::BitStreamReader& in,
+        ZserioViewOwner&<#if needs_skip_owner(compoundParametersData, fieldList)> owner</#if>, <#rt>
+        <#lt>size_t<#if fieldList?has_content> fieldIndex</#if>) const
+{
+    const ::zserio::Result<void> positionResult = in.setBitPosition(m_bitPosition);
+    <@compound_skip_check_result "positionResult", 1/>
+    <#list compoundParametersData.list as compoundParameter>
+    owner.<@parameter_member_name compoundParameter.name/> = <@parameter_member_name compoundParameter.name/>;
+    </#list>
+    <#list fieldList as field>
+
+    if (fieldIndex == ${field?index})
+    {
+        return ::zserio::Result<void>::success();
+    }
+    <@compound_skip_field field, 1/>
+    </#list>
+
+    return ::zserio::Result<void>::success();
+}
+</#if>
 <@namespace_end package.path/>
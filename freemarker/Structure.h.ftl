@@ -25,6 +25,14 @@
 <#if withParsingInfoCode>
 #include <zserio/ParsingInfo.h>
 </#if>
+<#if isProjectable>
+#include <zserio/FieldMask.h>
+</#if>
+<#if isViewable>
+#include <zserio/ArrayView.h>
+#include <zserio/Span.h>
+#include <zserio/StringView.h>
+</#if>
 <#if withTypeInfoCode>
 <@type_includes types.typeInfo/>
     <#if withReflectionCode>
@@ -59,6 +67,15 @@ public:
     /** Definition for allocator type. */
 </#if>
     using allocator_type = ${types.allocator.default};
+<#if isProjectable>
+
+    <#if withCodeComments>
+    /** Masks of the fields for the projection read constructor. */
+    </#if>
+    <#list fieldList as field>
+    static constexpr ::zserio::FieldMask <@field_mask_name field/> = ::zserio::FieldMask::field(${field?index});
+    </#list>
+</#if>
 <#if withSettersCode>
 
     <@compound_default_constructor compoundConstructorsData/>
@@ -102,6 +119,12 @@ public:
     </#if>
     <@compound_read_constructor_declaration compoundConstructorsData, true/>
 </#if>
+<#if isProjectable>
+    <#if withCodeComments>
+
+    </#if>
+    <@compound_read_constructor_declaration compoundConstructorsData, false, true/>
+</#if>
 
 <#if withCodeComments>
     /** Default destructor. */
@@ -223,6 +246,17 @@ public:
         </#if>
     bool ${field.isPresentIndicatorName}() const;
     </#if>
+    <#if isProjectable>
+
+        <#if withCodeComments>
+    /**
+     * Checks if the field ${field.name} has been loaded by the projection read constructor.
+     *
+     * \return True if the field ${field.name} is loaded, otherwise false.
+     */
+        </#if>
+    bool ${field.isLoadedIndicatorName}() const;
+    </#if>
     <#if field.optional??>
         <#if withCodeComments>
 
@@ -326,6 +360,9 @@ public:
     size_t initializeOffsets(ZserioPackingContext& context, size_t bitPosition);
     </#if>
 </#if>
+<#if isSkippable>
+    <@compound_skip_declaration compoundParametersData/>
+</#if>
 
 <#if withCodeComments>
     /**
@@ -416,6 +453,16 @@ private:
         </#if>
             <#lt>);
     </#if>
+    <#if isProjectable && !field.skip.isOwnerField>
+    <@field_member_type_name field/> ${field.readerName}(<#rt>
+            <#lt>::zserio::BitStreamReader& in, ::zserio::FieldMask fieldMask<#rt>
+        <#if field.needsAllocator || field.holderNeedsAllocator>
+            <#lt>,
+            const allocator_type& allocator<#rt>
+        </#if>
+    <#lt>);
+    ::zserio::Result<void> ${field.skipperName}(::zserio::BitStreamReader& in) const;
+    </#if>
     <#if !field?has_next>
 
     </#if>
@@ -429,10 +476,151 @@ private:
 <#if (numExtendedFields > 0)>
     uint32_t m_numExtendedFields;
 </#if>
+<#if isProjectable>
+    <#-- Loaded fields must be before field members because getters used by the read check them. -->
+    ::zserio::FieldMask m_loadedFields;
+</#if>
 <#list fieldList as field>
     <@field_member_type_name field/> <@field_member_name field/>;
 </#list>
 };
+<#if isViewable>
+
+    <#if withCodeComments>
+/**
+ * Zero-copy view of the serialized ${name}.
+ *
+ * The view holds only the buffer and the bit position of the object. Fields are decoded lazily by the getters
+ * directly from the buffer by skipping all preceding fields, nothing is allocated. Strings and bytes are returned
+ * as views into the buffer, compound fields as their views and arrays as lazy ::zserio::ArrayView ranges.
+ *
+ * The buffer must outlive the view and all values returned by its getters.
+ */
+    </#if>
+class ${name}View
+{
+public:
+    <#if withCodeComments>
+    /** Type of the viewed element, allows to use the view as view traits of ::zserio::ArrayView. */
+    </#if>
+    using ValueType = ${name}View;
+
+    <#if withCodeComments>
+    /** Bit size of the viewed object is not constant. */
+    </#if>
+    static constexpr bool IS_BITSIZEOF_CONSTANT = false;
+
+    <#if withCodeComments>
+    /**
+     * Constructor.
+     *
+     * \param buffer Buffer which contains the serialized object.
+     * \param bitPosition Bit position of the object in the buffer.
+        <#list compoundParametersData.list as compoundParameter>
+     * \param <@parameter_argument_name compoundParameter.name/> Value of the parameter ${compoundParameter.name}.
+        </#list>
+     */
+    </#if>
+    ${name}View(::zserio::Span<const uint8_t> buffer, size_t bitPosition<#rt>
+    <#list compoundParametersData.list as compoundParameter>
+            <#lt>,
+            ${compoundParameter.typeInfo.typeFullName} <@parameter_argument_name compoundParameter.name/><#rt>
+    </#list>
+            <#lt>);
+    <#if !compoundParametersData.list?has_content>
+
+        <#if withCodeComments>
+    /**
+     * Creates the view of the object at the current position of the reader and skips the object.
+     *
+     * \param buffer Buffer read by the reader.
+     * \param in Bit stream reader positioned at the object.
+     *
+     * \return View of the object or error code.
+     */
+        </#if>
+    static ::zserio::Result<${name}View> read(
+            ::zserio::Span<const uint8_t> buffer, ::zserio::BitStreamReader& in);
+
+        <#if withCodeComments>
+    /**
+     * Skips the viewed object in the bit stream.
+     *
+     * \param in Bit stream reader positioned at the object.
+     *
+     * \return Success or error code.
+     */
+        </#if>
+    static ::zserio::Result<void> skip(::zserio::BitStreamReader& in);
+    </#if>
+
+    <#if withCodeComments>
+    /**
+     * Gets bit position of the viewed object in the buffer.
+     *
+     * \return Bit position of the object.
+     */
+    </#if>
+    size_t getBitPosition() const;
+    <#list compoundParametersData.list as compoundParameter>
+
+        <#if withCodeComments>
+    /**
+     * Gets the value of the parameter ${compoundParameter.name}.
+     *
+     * \return Value of the parameter.
+     */
+        </#if>
+    ${compoundParameter.typeInfo.typeFullName} ${compoundParameter.getterName}() const;
+    </#list>
+    <#list fieldList as field>
+        <#if field.optional??>
+
+            <#if withCodeComments>
+    /**
+     * Checks if the optional field ${field.name} is used.
+     *
+     * \return True if the optional field is used, false if not, or error code.
+     */
+            </#if>
+    ::zserio::Result<bool> ${field.optional.isUsedIndicatorName}() const;
+        </#if>
+
+        <#if withCodeComments>
+    /**
+     * Decodes the field ${field.name}.
+     *
+            <#if field.optional??>
+     * \return Value of the field or error code (EmptyOptional when the field is not used).
+            <#else>
+     * \return Value of the field or error code.
+            </#if>
+     */
+        </#if>
+    ::zserio::Result<<@compound_view_field_type_name field/>> ${field.getterName}() const;
+    </#list>
+
+    <#if withCodeComments>
+    /**
+     * Calculates size of the viewed object in bits by skipping all its fields.
+     *
+     * \return Bit size of the object or error code.
+     */
+    </#if>
+    ::zserio::Result<size_t> bitSizeOf() const;
+
+private:
+    <@compound_skip_owner_struct "ZserioViewOwner", compoundParametersData, fieldList/>
+
+    ::zserio::Result<void> seek(::zserio::BitStreamReader& in, ZserioViewOwner& owner, size_t fieldIndex) const;
+
+    ::zserio::Span<const uint8_t> m_buffer;
+    size_t m_bitPosition;
+    <#list compoundParametersData.list as compoundParameter>
+    ${compoundParameter.typeInfo.typeFullName} <@parameter_member_name compoundParameter.name/>;
+    </#list>
+};
+</#if>
 <@namespace_end package.path/>
 
 <@include_guard_end package.path, name/>
@@ -23,6 +23,9 @@
 <#if has_field_with_constraint(fieldList)>
 #include <zserio/ConstraintException.h>
 </#if>
+<#if withWriterCode && has_offset_patching(fieldList)>
+#include <zserio/OffsetPatcher.h>
+</#if>
 <#if (withReflectionCode && has_non_simple_parameter(compoundParametersData))>
 #include <functional>
 </#if>
@@ -456,6 +459,7 @@ void ${name}::${field.setterName}(<@field_raw_cpp_type_name field/>&& <@field_ar
 }
 
     </#if>
+<@compound_copy_raw_field_definition name, field/>
 </#list>
 <@compound_functions_definition name, compoundFunctionsData/>
 ${name}::ChoiceTag ${name}::choiceTag() const
@@ -574,6 +578,28 @@ size_t ${name}::initializeOffsets(${name}::ZserioPackingContext& context, size_t
 }
     </#if>
 </#if>
+<#if isSkippable>
+
+::zserio::Result<void> ${name}::skip(::zserio::BitStreamReader& in<#rt>
+        <#lt><@compound_skip_parameter_list compoundParametersData/>)
+{
+    <@compound_skip_owner compoundParametersData, fieldList/>
+    auto choiceTagResult = in.readVarSize();
+    <@compound_skip_check_result "choiceTagResult", 1/>
+    switch (static_cast<${name}::ChoiceTag>(static_cast<int32_t>(choiceTagResult.getValue())))
+    {
+    <#list fieldList as field>
+    case <@choice_tag_name field/>:
+    {
+        <@compound_skip_field field, 2/>
+        return ::zserio::Result<void>::success();
+    }
+    </#list>
+    default:
+        return ::zserio::Result<void>::error(::zserio::ErrorCode::InvalidUnion);
+    }
+}
+</#if>
 
 bool ${name}::operator==(const ${name}& other) const
 {
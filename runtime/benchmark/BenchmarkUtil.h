@@ -0,0 +1,108 @@
+#ifndef ZSERIO_BENCHMARK_UTIL_H_INC
+#define ZSERIO_BENCHMARK_UTIL_H_INC
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace zserio
+{
+namespace benchmark
+{
+
+/**
+ * Prevents the compiler from optimizing out the computed value.
+ *
+ * \param value Value to keep.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+    static volatile T sink;
+    sink = value;
+    (void)sink;
+}
+
+/**
+ * Runs the given function several times and measures the best run.
+ *
+ * \param func Function to measure, returns false on failure.
+ * \param bestSeconds Duration of the best run in seconds.
+ *
+ * \return True when all runs succeeded, false otherwise.
+ */
+template <typename FUNC>
+inline bool measureBest(FUNC func, double& bestSeconds)
+{
+    static const int NUM_RUNS = 5;
+
+    bestSeconds = 0.0;
+    for (int i = 0; i < NUM_RUNS; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (!func())
+        {
+            return false;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < bestSeconds)
+        {
+            bestSeconds = elapsed.count();
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Runs the given function several times and prints the best run.
+ *
+ * \param name Name of the benchmark to print.
+ * \param numOperations Number of operations done by a single run of the function.
+ * \param func Function to measure, returns false on failure.
+ *
+ * \return True when all runs succeeded, false otherwise.
+ */
+template <typename FUNC>
+inline bool run(const char* name, size_t numOperations, FUNC func)
+{
+    double bestSeconds = 0.0;
+    if (!measureBest(func, bestSeconds))
+    {
+        std::printf("%-40s FAILED\n", name);
+        return false;
+    }
+
+    std::printf("%-40s %10.3f ms %10.3f ns/op\n", name, bestSeconds * 1e3,
+            bestSeconds * 1e9 / static_cast<double>(numOperations));
+    return true;
+}
+
+/**
+ * Runs the given function several times and prints throughput of the best run.
+ *
+ * \param name Name of the benchmark to print.
+ * \param numBits Number of bits processed by a single run of the function.
+ * \param func Function to measure, returns false on failure.
+ *
+ * \return True when all runs succeeded, false otherwise.
+ */
+template <typename FUNC>
+inline bool runThroughput(const char* name, size_t numBits, FUNC func)
+{
+    double bestSeconds = 0.0;
+    if (!measureBest(func, bestSeconds))
+    {
+        std::printf("%-40s FAILED\n", name);
+        return false;
+    }
+
+    std::printf("%-40s %10.3f ms %10.3f Gbit/s\n", name, bestSeconds * 1e3,
+            static_cast<double>(numBits) / bestSeconds * 1e-9);
+    return true;
+}
+
+} // namespace benchmark
+} // namespace zserio
+
+#endif // ifndef ZSERIO_BENCHMARK_UTIL_H_INC
@@ -0,0 +1,118 @@
+#include <string>
+#include <vector>
+
+#include "zserio/BitPackingUtil.h"
+#include "zserio/BitStreamReader.h"
+#include "zserio/BitStreamWriter.h"
+
+#include "BenchmarkUtil.h"
+
+using namespace zserio;
+
+namespace
+{
+
+const size_t NUM_VALUES = 4 * 1024 * 1024;
+const uint8_t PACKED_NUM_BITS = 12;
+
+const char* getSimdLevelName(detail::SimdLevel level)
+{
+    switch (level)
+    {
+    case detail::SimdLevel::AVX2:
+        return "avx2";
+    case detail::SimdLevel::SSE41:
+        return "sse4.1";
+    default:
+        return "scalar";
+    }
+}
+
+bool readPackedPerValue(Span<const uint8_t> buffer, std::vector<uint16_t>& values)
+{
+    BitStreamReader reader(buffer);
+    for (uint16_t& value : values)
+    {
+        auto result = reader.readBits(PACKED_NUM_BITS);
+        if (result.isError())
+        {
+            return false;
+        }
+        value = static_cast<uint16_t>(result.getValue());
+    }
+    benchmark::doNotOptimize(values.back());
+    return true;
+}
+
+bool readPackedArray(Span<const uint8_t> buffer, std::vector<uint16_t>& values)
+{
+    BitStreamReader reader(buffer);
+    const bool success = reader.readBitsArray(Span<uint16_t>(values), PACKED_NUM_BITS).isSuccess();
+    benchmark::doNotOptimize(values.back());
+    return success;
+}
+
+bool readAlignedArray(Span<const uint8_t> buffer, std::vector<uint32_t>& values)
+{
+    BitStreamReader reader(buffer);
+    const bool success = reader.readBitsArray(Span<uint32_t>(values), 32).isSuccess();
+    benchmark::doNotOptimize(values.back());
+    return success;
+}
+
+bool writePackedPerValue(Span<uint8_t> buffer, const std::vector<uint16_t>& values)
+{
+    BitStreamWriter writer(buffer);
+    for (uint16_t value : values)
+    {
+        if (writer.writeBits(value, PACKED_NUM_BITS).isError())
+        {
+            return false;
+        }
+    }
+    benchmark::doNotOptimize(buffer[0]);
+    return true;
+}
+
+bool writePackedArray(Span<uint8_t> buffer, const std::vector<uint16_t>& values)
+{
+    BitStreamWriter writer(buffer);
+    const bool success = writer.writeBitsArray(Span<const uint16_t>(values), PACKED_NUM_BITS).isSuccess();
+    benchmark::doNotOptimize(buffer[0]);
+    return success;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> data(NUM_VALUES * sizeof(uint32_t));
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 31U);
+    }
+    std::vector<uint16_t> packedValues(NUM_VALUES);
+    std::vector<uint32_t> alignedValues(NUM_VALUES);
+
+    bool success = benchmark::run("readBits(12) per value", NUM_VALUES,
+            [&]() { return readPackedPerValue(Span<const uint8_t>(data), packedValues); });
+    success &= benchmark::run("writeBits(12) per value", NUM_VALUES,
+            [&]() { return writePackedPerValue(Span<uint8_t>(data), packedValues); });
+
+    const detail::SimdLevel supportedLevel = detail::getSimdLevel();
+    for (uint8_t level = 0; level <= static_cast<uint8_t>(supportedLevel); ++level)
+    {
+        detail::setSimdLevel(static_cast<detail::SimdLevel>(level));
+        const std::string suffix = std::string(" [") + getSimdLevelName(detail::getSimdLevel()) + "]";
+
+        success &= benchmark::run(("readBitsArray(12)" + suffix).c_str(), NUM_VALUES,
+                [&]() { return readPackedArray(Span<const uint8_t>(data), packedValues); });
+        success &= benchmark::run(("readBitsArray(32) aligned" + suffix).c_str(), NUM_VALUES,
+                [&]() { return readAlignedArray(Span<const uint8_t>(data), alignedValues); });
+        success &= benchmark::run(("writeBitsArray(12)" + suffix).c_str(), NUM_VALUES,
+                [&]() { return writePackedArray(Span<uint8_t>(data), packedValues); });
+    }
+    detail::setSimdLevel(supportedLevel);
+
+    return success ? 0 : 1;
+}
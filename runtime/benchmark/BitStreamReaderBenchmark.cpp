@@ -0,0 +1,134 @@
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "zserio/BitStreamReader.h"
+#include "zserio/BitStreamWriter.h"
+
+#include "BenchmarkUtil.h"
+
+using namespace zserio;
+
+namespace
+{
+
+const size_t BUFFER_BYTE_SIZE = 16 * 1024 * 1024;
+const size_t MAX_BUFFER_SIZE = std::numeric_limits<size_t>::max() / 8 - 4;
+const size_t BLOB_BYTE_SIZE = 64 * 1024;
+const size_t NUM_BLOBS = BUFFER_BYTE_SIZE / BLOB_BYTE_SIZE - 1;
+
+// mimics the buffer validation which used to be done by every read call
+bool isBufferValid(Span<const uint8_t> buffer, size_t bufferBitSize)
+{
+    return buffer.size() <= MAX_BUFFER_SIZE && buffer.size() >= (bufferBitSize + 7) / 8;
+}
+
+bool readBytesRevalidated(Span<const uint8_t> buffer)
+{
+    BitStreamReader reader(buffer);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < BUFFER_BYTE_SIZE; ++i)
+    {
+        if (!isBufferValid(buffer, reader.getBufferBitSize()))
+        {
+            return false;
+        }
+        auto result = reader.readBits(8);
+        if (result.isError())
+        {
+            return false;
+        }
+        sum += result.getValue();
+    }
+    benchmark::doNotOptimize(sum);
+    return true;
+}
+
+bool readBytesValidatedOnce(Span<const uint8_t> buffer)
+{
+    auto readerResult = BitStreamReader::create(buffer);
+    if (readerResult.isError())
+    {
+        return false;
+    }
+    BitStreamReader& reader = readerResult.getValue();
+    uint32_t sum = 0;
+    for (size_t i = 0; i < BUFFER_BYTE_SIZE; ++i)
+    {
+        auto result = reader.readBits(8);
+        if (result.isError())
+        {
+            return false;
+        }
+        sum += result.getValue();
+    }
+    benchmark::doNotOptimize(sum);
+    return true;
+}
+
+// blobs follow a flag of numFlagBits bits, i.e. they are not byte aligned unless numFlagBits is 0
+bool writeBlobs(Span<uint8_t> buffer, Span<const uint8_t> blob, uint8_t numFlagBits)
+{
+    BitStreamWriter writer(buffer);
+    for (size_t i = 0; i < NUM_BLOBS; ++i)
+    {
+        if ((numFlagBits > 0 && writer.writeBits(0, numFlagBits).isError()) || writer.writeBytes(blob).isError())
+        {
+            return false;
+        }
+    }
+    benchmark::doNotOptimize(buffer[0]);
+    return true;
+}
+
+bool readBlobs(Span<const uint8_t> buffer, uint8_t numFlagBits)
+{
+    BitStreamReader reader(buffer);
+    size_t size = 0;
+    for (size_t i = 0; i < NUM_BLOBS; ++i)
+    {
+        if (numFlagBits > 0 && reader.readBits(numFlagBits).isError())
+        {
+            return false;
+        }
+        auto result = reader.readBytes();
+        if (result.isError())
+        {
+            return false;
+        }
+        size += result.getValue().size();
+    }
+    benchmark::doNotOptimize(size);
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> data(BUFFER_BYTE_SIZE);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 31U);
+    }
+    const Span<const uint8_t> buffer(data.data(), data.size());
+
+    bool success = benchmark::run("readBits(8) revalidated per call", BUFFER_BYTE_SIZE,
+            [&]() { return readBytesRevalidated(buffer); });
+    success &= benchmark::run("readBits(8) validated once", BUFFER_BYTE_SIZE,
+            [&]() { return readBytesValidatedOnce(buffer); });
+
+    const Span<const uint8_t> blob(data.data(), BLOB_BYTE_SIZE);
+    std::vector<uint8_t> blobData(BUFFER_BYTE_SIZE);
+    const uint8_t flagBitSizes[] = {0, 3};
+    for (uint8_t numFlagBits : flagBitSizes)
+    {
+        const std::string suffix = numFlagBits == 0 ? " aligned" : " after bit:3";
+        success &= benchmark::run(("writeBytes" + suffix).c_str(), NUM_BLOBS * BLOB_BYTE_SIZE,
+                [&]() { return writeBlobs(Span<uint8_t>(blobData), blob, numFlagBits); });
+        success &= benchmark::run(("readBytes" + suffix).c_str(), NUM_BLOBS * BLOB_BYTE_SIZE,
+                [&]() { return readBlobs(Span<const uint8_t>(blobData), numFlagBits); });
+    }
+
+    return success ? 0 : 1;
+}
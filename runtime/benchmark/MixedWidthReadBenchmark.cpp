@@ -0,0 +1,84 @@
+#include <array>
+#include <vector>
+
+#include "zserio/BitStreamReader.h"
+
+#include "BenchmarkUtil.h"
+
+using namespace zserio;
+
+namespace
+{
+
+const size_t BUFFER_BYTE_SIZE = 16 * 1024 * 1024;
+
+// widths typical for bit fields, flags and fixed integers of real schemas
+const std::array<uint8_t, 16> WIDTHS = {1, 3, 8, 12, 5, 16, 2, 32, 7, 1, 24, 4, 9, 13, 6, 21};
+
+size_t calcNumReads(size_t bufferBitSize)
+{
+    size_t widthsBitSize = 0;
+    for (uint8_t width : WIDTHS)
+    {
+        widthsBitSize += width;
+    }
+    return bufferBitSize / widthsBitSize * WIDTHS.size();
+}
+
+bool readMixedWidths(Span<const uint8_t> buffer, size_t numReads)
+{
+    BitStreamReader reader(buffer);
+    uint32_t sum = 0;
+    for (size_t i = 0; i < numReads; ++i)
+    {
+        auto result = reader.readBits(WIDTHS[i % WIDTHS.size()]);
+        if (result.isError())
+        {
+            return false;
+        }
+        sum += result.getValue();
+    }
+    benchmark::doNotOptimize(sum);
+    return true;
+}
+
+bool readMixedWidths64(Span<const uint8_t> buffer, size_t numReads)
+{
+    BitStreamReader reader(buffer);
+    uint64_t sum = 0;
+    for (size_t i = 0; i < numReads; ++i)
+    {
+        // doubled widths exercise reads crossing the cache word
+        auto result = reader.readBits64(static_cast<uint8_t>(WIDTHS[i % WIDTHS.size()] * 2));
+        if (result.isError())
+        {
+            return false;
+        }
+        sum += result.getValue();
+    }
+    benchmark::doNotOptimize(sum);
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> data(BUFFER_BYTE_SIZE);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 31U);
+    }
+    const Span<const uint8_t> buffer(data.data(), data.size());
+    const size_t bufferBitSize = BUFFER_BYTE_SIZE * 8;
+
+    const size_t numReads = calcNumReads(bufferBitSize);
+    bool success = benchmark::runThroughput("readBits mixed 1-32 bits", bufferBitSize,
+            [&]() { return readMixedWidths(buffer, numReads); });
+
+    const size_t numReads64 = calcNumReads(bufferBitSize / 2);
+    success &= benchmark::runThroughput("readBits64 mixed 2-64 bits", bufferBitSize,
+            [&]() { return readMixedWidths64(buffer, numReads64); });
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include <array>
+#include <string>
+#include <vector>
+
+#include "zserio/BitStreamWriter.h"
+
+#include "BenchmarkUtil.h"
+
+using namespace zserio;
+
+namespace
+{
+
+const size_t BUFFER_BYTE_SIZE = 16 * 1024 * 1024;
+
+// widths typical for bit fields, flags and fixed integers of real schemas
+const std::array<uint8_t, 16> WIDTHS = {1, 3, 8, 12, 5, 16, 2, 32, 7, 1, 24, 4, 9, 13, 6, 21};
+
+size_t calcNumWrites(size_t bufferBitSize)
+{
+    size_t widthsBitSize = 0;
+    for (uint8_t width : WIDTHS)
+    {
+        widthsBitSize += width;
+    }
+    return bufferBitSize / widthsBitSize * WIDTHS.size();
+}
+
+bool writeMixedWidths(Span<uint8_t> buffer, size_t numWrites, bool hasWriteCache)
+{
+    BitStreamWriter writer(buffer);
+    if (hasWriteCache)
+    {
+        writer.enableWriteCache();
+    }
+    for (size_t i = 0; i < numWrites; ++i)
+    {
+        const uint8_t numBits = WIDTHS[i % WIDTHS.size()];
+        const uint32_t value = static_cast<uint32_t>(i * 2654435761U) >> (32U - numBits);
+        if (writer.writeBits(value, numBits).isError())
+        {
+            return false;
+        }
+    }
+    writer.flush();
+    benchmark::doNotOptimize(buffer[0]);
+    return true;
+}
+
+bool writeMixedWidths64(Span<uint8_t> buffer, size_t numWrites, bool hasWriteCache)
+{
+    BitStreamWriter writer(buffer);
+    if (hasWriteCache)
+    {
+        writer.enableWriteCache();
+    }
+    for (size_t i = 0; i < numWrites; ++i)
+    {
+        // doubled widths exercise writes crossing the cache word
+        const uint8_t numBits = static_cast<uint8_t>(WIDTHS[i % WIDTHS.size()] * 2);
+        const uint64_t value = static_cast<uint64_t>(i * 0x9E3779B97F4A7C15ULL) >> (64U - numBits);
+        if (writer.writeBits64(value, numBits).isError())
+        {
+            return false;
+        }
+    }
+    writer.flush();
+    benchmark::doNotOptimize(buffer[0]);
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> data(BUFFER_BYTE_SIZE);
+    const Span<uint8_t> buffer(data.data(), data.size());
+    const size_t bufferBitSize = BUFFER_BYTE_SIZE * 8;
+
+    const size_t numWrites = calcNumWrites(bufferBitSize);
+    const size_t numWrites64 = calcNumWrites(bufferBitSize / 2);
+    bool success = true;
+    for (bool hasWriteCache : {false, true})
+    {
+        const char* suffix = hasWriteCache ? " [write cache]" : "";
+        success &= benchmark::runThroughput((std::string("writeBits mixed 1-32 bits") + suffix).c_str(),
+                bufferBitSize, [&]() { return writeMixedWidths(buffer, numWrites, hasWriteCache); });
+        success &= benchmark::runThroughput((std::string("writeBits64 mixed 2-64 bits") + suffix).c_str(),
+                bufferBitSize, [&]() { return writeMixedWidths64(buffer, numWrites64, hasWriteCache); });
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include <vector>
+
+#include "zserio/Array.h"
+#include "zserio/ArrayTraits.h"
+#include "zserio/BitStreamReader.h"
+#include "zserio/BitStreamWriter.h"
+#include "zserio/ParallelReadScope.h"
+#include "zserio/ThreadPoolExecutor.h"
+
+#include "BenchmarkUtil.h"
+
+using namespace zserio;
+
+namespace
+{
+
+const size_t NUM_ELEMENTS = 20000;
+const size_t MAX_NUM_VALUES = 64;
+const size_t BUFFER_BYTE_SIZE = NUM_ELEMENTS * (MAX_NUM_VALUES * 4 + 8);
+
+// element similar to a generated compound, holds a variable number of values
+struct Element
+{
+    using allocator_type = std::allocator<uint8_t>;
+
+    explicit Element(const allocator_type& allocator = allocator_type()) :
+            values(allocator)
+    {}
+
+    std::vector<uint32_t> values;
+};
+
+struct Owner;
+
+struct ElementFactory
+{
+    using OwnerType = Owner;
+
+    static Result<void> create(Owner&, std::vector<Element>& rawArray, BitStreamReader& in, size_t) noexcept
+    {
+        auto sizeResult = in.readVarSize();
+        if (sizeResult.isError())
+        {
+            return Result<void>::error(sizeResult.getError());
+        }
+
+        Element element;
+        element.values.reserve(sizeResult.getValue());
+        for (uint32_t i = 0; i < sizeResult.getValue(); ++i)
+        {
+            auto valueResult = in.readBits(32);
+            if (valueResult.isError())
+            {
+                return Result<void>::error(valueResult.getError());
+            }
+            element.values.push_back(valueResult.getValue());
+        }
+        rawArray.push_back(std::move(element));
+
+        return Result<void>::success();
+    }
+};
+
+// owner similar to a generated compound which holds the indexed offsets of its array
+struct Owner
+{
+    std::vector<uint32_t> offsets;
+
+    struct ArrayExpressions
+    {
+        using OwnerType = Owner;
+
+        static void checkOffset(const Owner&, size_t, size_t)
+        {}
+
+        static size_t getOffset(const Owner& owner, size_t index)
+        {
+            return owner.offsets[index];
+        }
+    };
+};
+
+using ElementArray = Array<std::vector<Element>, ObjectArrayTraits<Element, ElementFactory>, ArrayType::ALIGNED,
+        Owner::ArrayExpressions>;
+
+bool writeElements(std::vector<uint8_t>& data, Owner& owner, size_t& bitSize)
+{
+    BitStreamWriter writer(data.data(), data.size());
+    for (size_t index = 0; index < NUM_ELEMENTS; ++index)
+    {
+        if (writer.alignTo(8).isError())
+        {
+            return false;
+        }
+        owner.offsets.push_back(static_cast<uint32_t>(writer.getBitPosition() / 8));
+
+        const uint32_t numValues = static_cast<uint32_t>((index * 7U) % MAX_NUM_VALUES);
+        if (writer.writeVarSize(numValues).isError())
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < numValues; ++i)
+        {
+            if (writer.writeBits(static_cast<uint32_t>(index) * 31U + i, 32).isError())
+            {
+                return false;
+            }
+        }
+    }
+    bitSize = writer.getBitPosition();
+
+    return true;
+}
+
+bool readElements(Span<const uint8_t> buffer, size_t bitSize, Owner& owner, IExecutor* executor)
+{
+    BitStreamReader reader(buffer.data(), bitSize, BitsTag());
+    ElementArray array;
+    auto result = (executor != nullptr) ? array.read(owner, reader, NUM_ELEMENTS, *executor)
+                                        : array.read(owner, reader, NUM_ELEMENTS);
+    if (result.isError() || array.getRawArray().size() != NUM_ELEMENTS || reader.getBitPosition() != bitSize)
+    {
+        return false;
+    }
+    benchmark::doNotOptimize(array.getRawArray().back().values.size());
+
+    return true;
+}
+
+bool readElementsScoped(Span<const uint8_t> buffer, size_t bitSize, Owner& owner, IExecutor& executor)
+{
+    ParallelReadScope parallelReadScope(executor);
+    return readElements(buffer, bitSize, owner, nullptr);
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> data(BUFFER_BYTE_SIZE);
+    Owner owner;
+    size_t bitSize = 0;
+    if (!writeElements(data, owner, bitSize))
+    {
+        return 1;
+    }
+    const Span<const uint8_t> buffer(data.data(), data.size());
+
+    bool success = benchmark::run(
+            "Array::read sequential", NUM_ELEMENTS, [&]() { return readElements(buffer, bitSize, owner, nullptr); });
+
+    ThreadPoolExecutor executor;
+    success &= benchmark::run("Array::read parallel", NUM_ELEMENTS,
+            [&]() { return readElements(buffer, bitSize, owner, &executor); });
+    success &= benchmark::run("Array::read parallel scope", NUM_ELEMENTS,
+            [&]() { return readElementsScoped(buffer, bitSize, owner, executor); });
+
+    return success ? 0 : 1;
+}
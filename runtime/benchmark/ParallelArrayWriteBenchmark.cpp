@@ -0,0 +1,157 @@
+#include <vector>
+
+#include "zserio/Array.h"
+#include "zserio/ArrayTraits.h"
+#include "zserio/BitSizeOfCalculator.h"
+#include "zserio/BitStreamWriter.h"
+#include "zserio/ParallelWriteScope.h"
+#include "zserio/ThreadPoolExecutor.h"
+
+#include "BenchmarkUtil.h"
+
+using namespace zserio;
+
+namespace
+{
+
+const size_t NUM_ELEMENTS = 20000;
+const size_t MAX_NUM_VALUES = 64;
+const size_t BUFFER_BYTE_SIZE = NUM_ELEMENTS * (MAX_NUM_VALUES * 4 + 8);
+
+// element similar to a generated compound, holds a variable number of values
+struct Element
+{
+    using allocator_type = std::allocator<uint8_t>;
+
+    explicit Element(const allocator_type& allocator = allocator_type()) :
+            values(allocator)
+    {}
+
+    Result<size_t> bitSizeOf(size_t) const
+    {
+        auto sizeResult = bitSizeOfVarSize(static_cast<uint32_t>(values.size()));
+        if (sizeResult.isError())
+        {
+            return sizeResult;
+        }
+        return Result<size_t>::success(sizeResult.getValue() + values.size() * 32);
+    }
+
+    Result<size_t> initializeOffsets(size_t bitPosition)
+    {
+        auto sizeResult = bitSizeOf(bitPosition);
+        if (sizeResult.isError())
+        {
+            return sizeResult;
+        }
+        return Result<size_t>::success(bitPosition + sizeResult.getValue());
+    }
+
+    Result<void> write(BitStreamWriter& out) const
+    {
+        auto result = out.writeVarSize(static_cast<uint32_t>(values.size()));
+        for (size_t i = 0; i < values.size() && !result.isError(); ++i)
+        {
+            result = out.writeBits(values[i], 32);
+        }
+        return result;
+    }
+
+    std::vector<uint32_t> values;
+};
+
+struct Owner;
+
+struct ElementFactory
+{
+    using OwnerType = Owner;
+};
+
+// owner similar to a generated compound which holds the indexed offsets of its array
+struct Owner
+{
+    std::vector<uint32_t> offsets;
+
+    struct ArrayExpressions
+    {
+        using OwnerType = Owner;
+
+        static void checkOffset(const Owner&, size_t, size_t)
+        {}
+
+        static void initializeOffset(Owner& owner, size_t index, size_t byteOffset)
+        {
+            owner.offsets[index] = static_cast<uint32_t>(byteOffset);
+        }
+    };
+};
+
+using ElementArray = Array<std::vector<Element>, ObjectArrayTraits<Element, ElementFactory>, ArrayType::ALIGNED,
+        Owner::ArrayExpressions>;
+
+ElementArray createElements()
+{
+    ElementArray array;
+    for (size_t index = 0; index < NUM_ELEMENTS; ++index)
+    {
+        Element element;
+        const size_t numValues = (index * 7U) % MAX_NUM_VALUES;
+        for (size_t i = 0; i < numValues; ++i)
+        {
+            element.values.push_back(static_cast<uint32_t>(index * 31U + i));
+        }
+        array.getRawArray().push_back(element);
+    }
+    return array;
+}
+
+bool writeElements(std::vector<uint8_t>& data, Owner& owner, const ElementArray& array, IExecutor* executor)
+{
+    BitStreamWriter writer(data.data(), data.size());
+    writer.enableWriteCache();
+    auto result = (executor != nullptr) ? array.write(owner, writer, *executor) : array.write(owner, writer);
+    if (result.isError())
+    {
+        return false;
+    }
+    benchmark::doNotOptimize(writer.getBitPosition());
+
+    return true;
+}
+
+bool serializeElements(std::vector<uint8_t>& data, Owner& owner, ElementArray& array, IExecutor& executor)
+{
+    ParallelWriteScope parallelWriteScope(executor);
+    auto offsetsResult = array.initializeOffsets(owner, 0);
+    if (offsetsResult.isError())
+    {
+        return false;
+    }
+    return writeElements(data, owner, array, nullptr);
+}
+
+} // namespace
+
+int main()
+{
+    ElementArray array = createElements();
+    Owner owner;
+    owner.offsets.resize(NUM_ELEMENTS);
+    std::vector<uint8_t> data(BUFFER_BYTE_SIZE);
+
+    bool success = benchmark::run("Array::write sequential", NUM_ELEMENTS,
+            [&]() { return writeElements(data, owner, array, nullptr); });
+
+    ThreadPoolExecutor executor;
+    success &= benchmark::run("Array::write parallel", NUM_ELEMENTS,
+            [&]() { return writeElements(data, owner, array, &executor); });
+    success &= benchmark::run("Array::bitSizeOf parallel", NUM_ELEMENTS, [&]() {
+        auto result = array.bitSizeOf(owner, 0, executor);
+        benchmark::doNotOptimize(result.isSuccess() ? result.getValue() : 0);
+        return result.isSuccess();
+    });
+    success &= benchmark::run("initializeOffsets + write parallel scope", NUM_ELEMENTS,
+            [&]() { return serializeElements(data, owner, array, executor); });
+
+    return success ? 0 : 1;
+}
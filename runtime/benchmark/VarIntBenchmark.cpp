@@ -0,0 +1,64 @@
+#include <vector>
+
+#include "zserio/BitStreamReader.h"
+#include "zserio/BitStreamWriter.h"
+
+#include "BenchmarkUtil.h"
+
+using namespace zserio;
+
+namespace
+{
+
+const size_t NUM_VALUES = 4 * 1024 * 1024;
+
+bool readPerValue(Span<const uint8_t> buffer, std::vector<uint32_t>& values)
+{
+    BitStreamReader reader(buffer);
+    for (uint32_t& value : values)
+    {
+        auto result = reader.readVarUInt32();
+        if (result.isError())
+        {
+            return false;
+        }
+        value = result.getValue();
+    }
+    benchmark::doNotOptimize(values.back());
+    return true;
+}
+
+bool readArray(Span<const uint8_t> buffer, std::vector<uint32_t>& values)
+{
+    BitStreamReader reader(buffer);
+    const bool success = reader.readVarUInt32Array(Span<uint32_t>(values)).isSuccess();
+    benchmark::doNotOptimize(values.back());
+    return success;
+}
+
+} // namespace
+
+int main()
+{
+    // mix of 1 - 4 bytes long identifiers
+    std::vector<uint8_t> data(NUM_VALUES * 4);
+    BitStreamWriter writer(data.data(), data.size());
+    uint32_t seed = 1;
+    for (size_t i = 0; i < NUM_VALUES; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        const uint32_t value = (seed >> 8U) >> ((seed & 0x03U) * 7U);
+        if (writer.writeVarUInt32(value).isError())
+        {
+            return 1;
+        }
+    }
+    const Span<const uint8_t> buffer(data.data(), (writer.getBitPosition() + 7) / 8);
+    std::vector<uint32_t> values(NUM_VALUES);
+
+    bool success = benchmark::run("readVarUInt32 per value", NUM_VALUES,
+            [&]() { return readPerValue(buffer, values); });
+    success &= benchmark::run("readVarUInt32Array", NUM_VALUES, [&]() { return readArray(buffer, values); });
+
+    return success ? 0 : 1;
+}
@@ -1,8 +1,10 @@
 #ifndef ZSERIO_ARRAY_H_INC
 #define ZSERIO_ARRAY_H_INC
 
+#include <algorithm>
 #include <cstdlib>
 #include <type_traits>
+#include <vector>
 
 #include "zserio/AllocatorPropagatingCopy.h"
 #include "zserio/ArrayTraits.h"
@@ -11,6 +13,11 @@
 #include "zserio/BitStreamWriter.h"
 #include "zserio/DeltaContext.h"
 #include "zserio/ErrorCode.h"
+#include "zserio/IExecutor.h"
+#include "zserio/OffsetPatcher.h"
+#include "zserio/ParallelReadScope.h"
+#include "zserio/ParallelWriteScope.h"
+#include "zserio/RebindAlloc.h"
 #include "zserio/Result.h"
 #include "zserio/SizeConvertUtil.h"
 #include "zserio/Traits.h"
@@ -91,6 +98,29 @@ template <typename ARRAY_EXPRESSIONS, typename OWNER_TYPE,
 void checkOffset(const OWNER_TYPE&, size_t, size_t)
 {}
 
+// checks the offset of an array element at the current position of the stream
+template <typename ARRAY_EXPRESSIONS, typename IO, typename OWNER_TYPE>
+Result<void> checkStreamOffset(IO& io, const OWNER_TYPE& owner, size_t index)
+{
+    checkOffset<ARRAY_EXPRESSIONS>(owner, index, io.getBitPosition() / 8);
+    return Result<void>::success();
+}
+
+// single pass serialization resolves the offset instead of checking it
+template <typename ARRAY_EXPRESSIONS, typename OWNER_TYPE,
+        typename std::enable_if<has_resolve_offset<ARRAY_EXPRESSIONS>::value, int>::type = 0>
+Result<void> checkStreamOffset(BitStreamWriter& out, const OWNER_TYPE& owner, size_t index)
+{
+    IOffsetPatcher* offsetPatcher = out.getOffsetPatcher();
+    if (offsetPatcher != nullptr)
+    {
+        return ARRAY_EXPRESSIONS::resolveOffset(owner, index, out.getBitPosition() / 8, *offsetPatcher);
+    }
+
+    checkOffset<ARRAY_EXPRESSIONS>(owner, index, out.getBitPosition() / 8);
+    return Result<void>::success();
+}
+
 // call the initContext method properly on packed array traits
 template <typename PACKED_ARRAY_TRAITS, typename OWNER_TYPE, typename PACKING_CONTEXT,
         typename std::enable_if<has_owner_type<PACKED_ARRAY_TRAITS>::value &&
@@ -285,6 +315,27 @@ Result<void> arrayTraitsRead(const OWNER_TYPE&, RAW_ARRAY& rawArray, BitStreamRe
     return ARRAY_TRAITS::read(rawArray, in, index);
 }
 
+// skips the single element properly by array traits, elements without skip method are read and dropped
+template <typename ARRAY_TRAITS, typename std::enable_if<has_skip<ARRAY_TRAITS>::value, int>::type = 0>
+Result<void> arrayTraitsSkip(BitStreamReader& in, size_t) noexcept
+{
+    return ARRAY_TRAITS::skip(in);
+}
+
+template <typename ARRAY_TRAITS,
+        typename std::enable_if<!has_skip<ARRAY_TRAITS>::value && !has_owner_type<ARRAY_TRAITS>::value &&
+                        !has_allocator<ARRAY_TRAITS>::value,
+                int>::type = 0>
+Result<void> arrayTraitsSkip(BitStreamReader& in, size_t index) noexcept
+{
+    auto result = ARRAY_TRAITS::read(in, index);
+    if (result.isError())
+    {
+        return Result<void>::error(result.getError());
+    }
+    return Result<void>::success();
+}
+
 // calls the read method properly on packed array traits
 template <typename PACKED_ARRAY_TRAITS, typename OWNER_TYPE, typename RAW_ARRAY, typename PACKING_CONTEXT,
         typename std::enable_if<has_owner_type<PACKED_ARRAY_TRAITS>::value &&
@@ -379,6 +430,19 @@ enum ArrayType
     ALIGNED_AUTO /**< Aligned auto zserio array which is auto zserio array with indexed offsets. */
 };
 
+namespace detail
+{
+
+// aligned elements of variable bit size can be split into ranges which start at byte boundaries
+template <typename ARRAY_TRAITS, ArrayType ARRAY_TYPE>
+struct is_parallel_writable_array
+        : std::integral_constant<bool,
+                  !ARRAY_TRAITS::IS_BITSIZEOF_CONSTANT &&
+                          (ARRAY_TYPE == ArrayType::ALIGNED || ARRAY_TYPE == ArrayType::ALIGNED_AUTO)>
+{};
+
+} // namespace detail
+
 /**
  * Array wrapper for zserio arrays which are not explicitly packed but the element type is packable
  * and thus it can be packed if requested from a parent.
@@ -646,7 +710,28 @@ public:
             typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
     Result<size_t> bitSizeOf(const OwnerType& owner, size_t bitPosition) const
     {
-        return bitSizeOfImpl(owner, bitPosition);
+        return bitSizeOfScopedImpl(owner, bitPosition);
+    }
+
+    /**
+     * Calculates bit size of this array, bit sizes of elements are calculated concurrently by the executor.
+     *
+     * Available for arrays which need the owner. Aligned arrays of elements with variable bit size are split
+     * into ranges whose bit sizes are calculated concurrently twice, first from estimated start positions and
+     * then from the start positions given by their prefix sums to verify them. Other arrays and executors
+     * without concurrency fall back to the sequential calculation.
+     *
+     * \param owner Array owner.
+     * \param bitPosition Current bit position.
+     * \param executor Executor which calculates the ranges of elements.
+     *
+     * \return Bit size of the array.
+     */
+    template <typename OWNER_TYPE_ = OwnerType,
+            typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
+    Result<size_t> bitSizeOf(const OwnerType& owner, size_t bitPosition, IExecutor& executor) const
+    {
+        return bitSizeOfParallelImpl(owner, bitPosition, executor);
     }
 
     /**
@@ -680,7 +765,26 @@ public:
             typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
     Result<size_t> initializeOffsets(OwnerType& owner, size_t bitPosition)
     {
-        return initializeOffsetsImpl(owner, bitPosition);
+        return initializeOffsetsScopedImpl(owner, bitPosition);
+    }
+
+    /**
+     * Initializes indexed offsets, elements are initialized concurrently by the executor.
+     *
+     * Available for arrays which need the owner. Ranges of elements are processed as by the parallel
+     * bitSizeOf(), thus the initialization of the elements and of their offsets must be thread-safe.
+     *
+     * \param owner Array owner.
+     * \param bitPosition Current bit position.
+     * \param executor Executor which initializes the ranges of elements.
+     *
+     * \return Updated bit position which points to the first bit after the array.
+     */
+    template <typename OWNER_TYPE_ = OwnerType,
+            typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
+    Result<size_t> initializeOffsets(OwnerType& owner, size_t bitPosition, IExecutor& executor)
+    {
+        return initializeOffsetsParallelImpl(owner, bitPosition, executor);
     }
 
     /**
@@ -704,6 +808,9 @@ public:
      *
      * Available for arrays which need the owner.
      *
+     * Elements of aligned arrays with indexed offsets are read concurrently when a ParallelReadScope exists
+     * in the current thread and the allocator of the raw array is stateless.
+     *
      * \param owner Array owner.
      * \param in Bit stream reader to use for reading.
      * \param arrayLength Array length. Not needed for auto / implicit arrays.
@@ -712,7 +819,54 @@ public:
             typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
     Result<void> read(OwnerType& owner, BitStreamReader& in, size_t arrayLength = 0) noexcept
     {
-        return readImpl(owner, in, arrayLength);
+        return readScopedImpl(owner, in, arrayLength);
+    }
+
+    /**
+     * Reads the array from the bit stream, elements are decoded concurrently by the executor.
+     *
+     * Available for arrays which need the owner. Elements of aligned arrays with indexed offsets start at
+     * the offsets held by the owner, thus they are split into ranges which are read by independent readers
+     * of the same buffer and then moved into the raw array in order. Other arrays, windowed readers and
+     * executors without concurrency fall back to the sequential read.
+     *
+     * The allocator of the raw array and reading of the elements must be thread-safe.
+     *
+     * \param owner Array owner.
+     * \param in Bit stream reader to use for reading.
+     * \param arrayLength Array length. Not needed for auto arrays.
+     * \param executor Executor which reads the ranges of elements.
+     */
+    template <typename OWNER_TYPE_ = OwnerType,
+            typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
+    Result<void> read(OwnerType& owner, BitStreamReader& in, size_t arrayLength, IExecutor& executor) noexcept
+    {
+        return readParallelImpl(owner, in, arrayLength, executor);
+    }
+
+    /**
+     * Skips the array in the bit stream without reading it.
+     *
+     * Elements with constant bit size are skipped at once, other elements are skipped one by one without
+     * any allocation. Available for arrays whose elements can be skipped without the owner.
+     *
+     * \param in Bit stream reader to use for skipping.
+     * \param arrayLength Array length. Not needed for auto / implicit arrays.
+     *
+     * \return Success or error code.
+     */
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!has_owner_type<ARRAY_TRAITS_>::value || has_skip<ARRAY_TRAITS_>::value,
+                    int>::type = 0>
+    static Result<void> skip(BitStreamReader& in, size_t arrayLength = 0) noexcept
+    {
+        auto lengthResult = skipArrayLength(in, arrayLength);
+        if (lengthResult.isError())
+        {
+            return Result<void>::error(lengthResult.getError());
+        }
+
+        return skipElements(in, lengthResult.getValue());
     }
 
     /**
@@ -734,6 +888,9 @@ public:
      *
      * Available for arrays which need the owner.
      *
+     * Elements of aligned arrays with variable bit size are written concurrently when a ParallelWriteScope
+     * exists in the current thread.
+     *
      * \param owner Array owner.
      * \param out Bit stream write to use for writing.
      */
@@ -741,7 +898,28 @@ public:
             typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
     Result<void> write(const OwnerType& owner, BitStreamWriter& out) const noexcept
     {
-        return writeImpl(owner, out);
+        return writeScopedImpl(owner, out);
+    }
+
+    /**
+     * Writes the array to the bit stream, elements are written concurrently by the executor.
+     *
+     * Available for arrays which need the owner. Aligned arrays of elements with variable bit size are split
+     * into ranges whose start positions are given by prefix sums of their bit sizes. Ranges start at byte
+     * boundaries, thus they are written by independent writers of disjoint bytes of the same buffer. When any
+     * range does not end at the expected position, e.g. because the bit size of an element depends on more
+     * than the byte alignment of its position, the array is written again sequentially. Other arrays, growing
+     * writers, writers with an offset patcher and executors without concurrency write sequentially.
+     *
+     * \param owner Array owner.
+     * \param out Bit stream write to use for writing.
+     * \param executor Executor which writes the ranges of elements.
+     */
+    template <typename OWNER_TYPE_ = OwnerType,
+            typename std::enable_if<!std::is_same<OWNER_TYPE_, detail::DummyArrayOwner>::value, int>::type = 0>
+    Result<void> write(const OwnerType& owner, BitStreamWriter& out, IExecutor& executor) const noexcept
+    {
+        return writeParallelImpl(owner, out, executor);
     }
 
     /**
@@ -932,12 +1110,7 @@ private:
         {
             return alignResult;
         }
-        auto checkResult = detail::checkOffset<ArrayExpressions>(owner, index, io.getBitPosition() / 8);
-        if (checkResult.isError())
-        {
-            return checkResult;
-        }
-        return Result<void>::success();
+        return detail::checkStreamOffset<ArrayExpressions>(io, owner, index);
     }
 
     template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
@@ -1107,6 +1280,277 @@ private:
         return Result<size_t>::success(endBitPosition);
     }
 
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ != ArrayType::AUTO && ARRAY_TYPE_ != ArrayType::ALIGNED_AUTO &&
+                            ARRAY_TYPE_ != ArrayType::IMPLICIT,
+                    int>::type = 0>
+    static Result<size_t> skipArrayLength(BitStreamReader&, size_t arrayLength) noexcept
+    {
+        return Result<size_t>::success(arrayLength);
+    }
+
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ == ArrayType::AUTO || ARRAY_TYPE_ == ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    static Result<size_t> skipArrayLength(BitStreamReader& in, size_t) noexcept
+    {
+        auto result = in.readVarSize();
+        if (result.isError())
+        {
+            return Result<size_t>::error(result.getError());
+        }
+        return Result<size_t>::success(static_cast<size_t>(result.getValue()));
+    }
+
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ == ArrayType::IMPLICIT, int>::type = 0>
+    static Result<size_t> skipArrayLength(BitStreamReader& in, size_t) noexcept
+    {
+        static_assert(ARRAY_TYPE != ArrayType::IMPLICIT || ArrayTraits::IS_BITSIZEOF_CONSTANT,
+                "Implicit array elements must have constant bit size!");
+
+        auto sizeResult = ArrayTraits::bitSizeOf();
+        if (sizeResult.isError())
+        {
+            return Result<size_t>::error(sizeResult.getError());
+        }
+        const size_t elementBitSize = sizeResult.getValue();
+        if (elementBitSize == 0)
+        {
+            return Result<size_t>::error(ErrorCode::DivisionByZero);
+        }
+        return Result<size_t>::success((in.getBufferBitSize() - in.getBitPosition()) / elementBitSize);
+    }
+
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ != ArrayType::ALIGNED && ARRAY_TYPE_ != ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    static Result<void> alignElement(BitStreamReader&) noexcept
+    {
+        return Result<void>::success();
+    }
+
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ == ArrayType::ALIGNED || ARRAY_TYPE_ == ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    static Result<void> alignElement(BitStreamReader& in) noexcept
+    {
+        return in.alignTo(8);
+    }
+
+    // elements with constant bit size are skipped at once
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<ARRAY_TRAITS_::IS_BITSIZEOF_CONSTANT && !has_owner_type<ARRAY_TRAITS_>::value,
+                    int>::type = 0>
+    static Result<void> skipElements(BitStreamReader& in, size_t skipLength) noexcept
+    {
+        if (skipLength == 0)
+        {
+            return Result<void>::success();
+        }
+
+        auto sizeResult = ArrayTraits::bitSizeOf();
+        if (sizeResult.isError())
+        {
+            return Result<void>::error(sizeResult.getError());
+        }
+        const size_t elementBitSize = sizeResult.getValue();
+        const size_t bitPosition = in.getBitPosition();
+        if (elementBitSize != 0 && skipLength > (in.getBufferBitSize() - bitPosition) / elementBitSize)
+        {
+            return Result<void>::error(ErrorCode::EndOfStream);
+        }
+
+        return in.skipBits(constBitSizeOfElements(bitPosition, skipLength, elementBitSize));
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!ARRAY_TRAITS_::IS_BITSIZEOF_CONSTANT || has_owner_type<ARRAY_TRAITS_>::value,
+                    int>::type = 0>
+    static Result<void> skipElements(BitStreamReader& in, size_t skipLength) noexcept
+    {
+        for (size_t index = 0; index < skipLength; ++index)
+        {
+            auto alignResult = alignElement(in);
+            if (alignResult.isError())
+            {
+                return alignResult;
+            }
+            auto skipResult = detail::arrayTraitsSkip<ArrayTraits>(in, index);
+            if (skipResult.isError())
+            {
+                return skipResult;
+            }
+        }
+        return Result<void>::success();
+    }
+
+    template <typename ARRAY_EXPRESSIONS_ = ArrayExpressions, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<!has_get_offset<ARRAY_EXPRESSIONS_>::value ||
+                            (ARRAY_TYPE_ != ArrayType::ALIGNED && ARRAY_TYPE_ != ArrayType::ALIGNED_AUTO),
+                    int>::type = 0>
+    Result<void> readParallelImpl(OwnerType& owner, BitStreamReader& in, size_t arrayLength, IExecutor&) noexcept
+    {
+        return readImpl(owner, in, arrayLength);
+    }
+
+    template <typename ARRAY_EXPRESSIONS_ = ArrayExpressions, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<!has_get_offset<ARRAY_EXPRESSIONS_>::value ||
+                            (ARRAY_TYPE_ != ArrayType::ALIGNED && ARRAY_TYPE_ != ArrayType::ALIGNED_AUTO),
+                    int>::type = 0>
+    Result<void> readScopedImpl(OwnerType& owner, BitStreamReader& in, size_t arrayLength) noexcept
+    {
+        return readImpl(owner, in, arrayLength);
+    }
+
+    template <typename ARRAY_EXPRESSIONS_ = ArrayExpressions, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<has_get_offset<ARRAY_EXPRESSIONS_>::value &&
+                            (ARRAY_TYPE_ == ArrayType::ALIGNED || ARRAY_TYPE_ == ArrayType::ALIGNED_AUTO),
+                    int>::type = 0>
+    Result<void> readScopedImpl(OwnerType& owner, BitStreamReader& in, size_t arrayLength) noexcept
+    {
+        // stateful allocators, e.g. polymorphic allocators, can share a memory resource which is not thread-safe
+        IExecutor* executor = detail::parallelReadExecutor();
+        if (executor == nullptr || !std::is_empty<allocator_type>::value)
+        {
+            return readImpl(owner, in, arrayLength);
+        }
+
+        // nested arrays of the elements are read sequentially
+        detail::parallelReadExecutor() = nullptr;
+        auto result = readParallelImpl(owner, in, arrayLength, *executor);
+        detail::parallelReadExecutor() = executor;
+        return result;
+    }
+
+    template <typename ARRAY_EXPRESSIONS_ = ArrayExpressions, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<has_get_offset<ARRAY_EXPRESSIONS_>::value &&
+                            (ARRAY_TYPE_ == ArrayType::ALIGNED || ARRAY_TYPE_ == ArrayType::ALIGNED_AUTO),
+                    int>::type = 0>
+    Result<void> readParallelImpl(
+            OwnerType& owner, BitStreamReader& in, size_t arrayLength, IExecutor& executor) noexcept
+    {
+        auto lengthResult = readArrayLength(owner, in, arrayLength);
+        if (lengthResult.isError())
+        {
+            return Result<void>::error(lengthResult.getError());
+        }
+        const size_t readLength = lengthResult.getValue();
+
+        m_rawArray.clear();
+
+        // more ranges than tasks balance elements of different sizes
+        const size_t numRanges = std::min(readLength, executor.getConcurrency() * 4);
+        if (numRanges < 2 || in.fork(in.getBitPosition()).isError())
+        {
+            return readElements(owner, in, readLength);
+        }
+
+        // TODO: These allocations may abort if allocation fails with -fno-exceptions!
+        using RangeAllocator = RebindAlloc<allocator_type, ElementRange>;
+        std::vector<ElementRange, RangeAllocator> ranges{RangeAllocator(m_rawArray.get_allocator())};
+        ranges.reserve(numRanges);
+        for (size_t rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+        {
+            ranges.emplace_back(m_rawArray.get_allocator());
+            ElementRange& range = ranges.back();
+            range.beginIndex = readLength / numRanges * rangeIndex + std::min(rangeIndex, readLength % numRanges);
+            range.bitPosition = (rangeIndex == 0) ? in.getBitPosition()
+                                                  : ArrayExpressions::getOffset(owner, range.beginIndex) * 8;
+        }
+
+        auto readRange = [&](size_t rangeIndex) {
+            ElementRange& range = ranges[rangeIndex];
+            const size_t endIndex =
+                    (rangeIndex + 1 < numRanges) ? ranges[rangeIndex + 1].beginIndex : readLength;
+            range.error = readElementRange(owner, in, range, endIndex);
+        };
+        runTasks(executor, numRanges, readRange);
+
+        // elements are moved in order, the reader continues behind the last element
+        m_rawArray.reserve(readLength);
+        for (size_t rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+        {
+            ElementRange& range = ranges[rangeIndex];
+            if (range.error == ErrorCode::Success && rangeIndex + 1 < numRanges &&
+                    alignTo(8, range.bitPosition) !=
+                            ArrayExpressions::getOffset(owner, ranges[rangeIndex + 1].beginIndex) * 8)
+            {
+                // offsets must describe contiguous elements as in the sequential read
+                range.error = ErrorCode::InvalidOffset;
+            }
+            if (range.error != ErrorCode::Success)
+            {
+                m_rawArray.clear();
+                return Result<void>::error(range.error);
+            }
+            for (auto&& element : range.rawArray)
+            {
+                m_rawArray.push_back(std::move(element));
+            }
+        }
+        initializeMovedElements(owner);
+
+        return in.setBitPosition(ranges.back().bitPosition);
+    }
+
+    template <typename ARRAY_EXPRESSIONS_ = ArrayExpressions,
+            typename std::enable_if<has_initialize_element<ARRAY_EXPRESSIONS_>::value, int>::type = 0>
+    void initializeMovedElements(OwnerType& owner) noexcept
+    {
+        initializeElements(owner);
+    }
+
+    template <typename ARRAY_EXPRESSIONS_ = ArrayExpressions,
+            typename std::enable_if<!has_initialize_element<ARRAY_EXPRESSIONS_>::value, int>::type = 0>
+    void initializeMovedElements(OwnerType&) noexcept
+    {}
+
+    // elements read by a single task of the parallel read
+    struct ElementRange
+    {
+        explicit ElementRange(const allocator_type& allocator) :
+                rawArray(allocator),
+                beginIndex(0),
+                bitPosition(0),
+                error(ErrorCode::Success)
+        {}
+
+        RawArray rawArray;
+        size_t beginIndex;
+        size_t bitPosition; // start of the range, end of the range after the read
+        ErrorCode error;
+    };
+
+    static ErrorCode readElementRange(
+            OwnerType& owner, const BitStreamReader& in, ElementRange& range, size_t endIndex) noexcept
+    {
+        auto readerResult = in.fork(range.bitPosition);
+        if (readerResult.isError())
+        {
+            return readerResult.getError();
+        }
+        BitStreamReader& reader = readerResult.getValue();
+
+        range.rawArray.reserve(endIndex - range.beginIndex);
+        for (size_t index = range.beginIndex; index < endIndex; ++index)
+        {
+            auto alignResult = alignAndCheckOffset(reader, owner, index);
+            if (alignResult.isError())
+            {
+                return alignResult.getError();
+            }
+            auto readResult = detail::arrayTraitsRead<ArrayTraits>(owner, range.rawArray, reader, index);
+            if (readResult.isError())
+            {
+                return readResult.getError();
+            }
+        }
+        range.bitPosition = reader.getBitPosition();
+
+        return ErrorCode::Success;
+    }
+
     Result<void> readImpl(OwnerType& owner, BitStreamReader& in, size_t arrayLength) noexcept
     {
         auto lengthResult = readArrayLength(owner, in, arrayLength);
@@ -1117,6 +1561,53 @@ private:
         size_t readLength = lengthResult.getValue();
 
         m_rawArray.clear();
+        return readElements(owner, in, readLength);
+    }
+
+    // minimum bit size of an element read at once, the bit size of fixed width elements
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<ARRAY_TRAITS_::IS_BITSIZEOF_CONSTANT, int>::type = 0>
+    static size_t minReadArrayElementBitSize() noexcept
+    {
+        const auto bitSizeResult = ArrayTraits::bitSizeOf();
+        return bitSizeResult.isSuccess() ? bitSizeResult.getValue() : 0;
+    }
+
+    // variable integers take at least one byte
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!ARRAY_TRAITS_::IS_BITSIZEOF_CONSTANT, int>::type = 0>
+    static size_t minReadArrayElementBitSize() noexcept
+    {
+        return 8;
+    }
+
+    // elements which are not aligned are read at once straight into the raw array
+    template <typename ARRAY_TRAITS_ = ArrayTraits, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<has_read_array<ARRAY_TRAITS_>::value && ARRAY_TYPE_ != ArrayType::ALIGNED &&
+                            ARRAY_TYPE_ != ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    Result<void> readElements(OwnerType&, BitStreamReader& in, size_t readLength) noexcept
+    {
+        // the length comes from the stream, do not allocate for more elements than the rest of the stream holds
+        const size_t minElementBitSize = minReadArrayElementBitSize();
+        if (minElementBitSize != 0 &&
+                readLength > (in.getBufferBitSize() - in.getBitPosition()) / minElementBitSize)
+        {
+            return Result<void>::error(ErrorCode::EndOfStream);
+        }
+
+        // TODO: This resize() may abort if allocation fails with -fno-exceptions!
+        m_rawArray.resize(readLength);
+        return ArrayTraits::readArray(
+                in, Span<typename ArrayTraits::ElementType>(m_rawArray.data(), m_rawArray.size()));
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<!has_read_array<ARRAY_TRAITS_>::value || ARRAY_TYPE_ == ArrayType::ALIGNED ||
+                            ARRAY_TYPE_ == ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    Result<void> readElements(OwnerType& owner, BitStreamReader& in, size_t readLength) noexcept
+    {
         m_rawArray.reserve(readLength);
         for (size_t index = 0; index < readLength; ++index)
         {
@@ -1143,6 +1634,27 @@ private:
             return lengthResult;
         }
 
+        return writeElements(owner, out);
+    }
+
+    // elements which are not aligned are written at once straight from the raw array
+    template <typename ARRAY_TRAITS_ = ArrayTraits, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<has_write_array<ARRAY_TRAITS_>::value && ARRAY_TYPE_ != ArrayType::ALIGNED &&
+                            ARRAY_TYPE_ != ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    Result<void> writeElements(const OwnerType&, BitStreamWriter& out) const noexcept
+    {
+        return ArrayTraits::writeArray(
+                out, Span<const typename ArrayTraits::ElementType>(m_rawArray.data(), m_rawArray.size()));
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits, ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<!has_write_array<ARRAY_TRAITS_>::value || ARRAY_TYPE_ == ArrayType::ALIGNED ||
+                            ARRAY_TYPE_ == ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    Result<void> writeElements(const OwnerType& owner, BitStreamWriter& out) const noexcept
+    {
+        const size_t arrayLength = m_rawArray.size();
         for (size_t index = 0; index < arrayLength; ++index)
         {
             auto alignResult = alignAndCheckOffset(out, owner, index);
@@ -1159,6 +1671,362 @@ private:
         return Result<void>::success();
     }
 
+    // range of elements processed by a single task of the parallel bitSizeOf(), initializeOffsets() and write()
+    struct ElementBitRange
+    {
+        size_t beginIndex;
+        size_t endIndex;
+        size_t bitPosition;
+        size_t endBitPosition;
+        bool isValid;
+    };
+
+    using ElementBitRanges = std::vector<ElementBitRange, RebindAlloc<allocator_type, ElementBitRange>>;
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> bitSizeOfScopedImpl(const OwnerType& owner, size_t bitPosition) const
+    {
+        return bitSizeOfImpl(owner, bitPosition);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> bitSizeOfScopedImpl(const OwnerType& owner, size_t bitPosition) const
+    {
+        IExecutor* executor = detail::parallelWriteExecutor();
+        if (executor == nullptr)
+        {
+            return bitSizeOfImpl(owner, bitPosition);
+        }
+
+        // nested arrays of the elements are processed sequentially
+        detail::parallelWriteExecutor() = nullptr;
+        auto result = bitSizeOfParallelImpl(owner, bitPosition, *executor);
+        detail::parallelWriteExecutor() = executor;
+        return result;
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> bitSizeOfParallelImpl(const OwnerType& owner, size_t bitPosition, IExecutor&) const
+    {
+        return bitSizeOfImpl(owner, bitPosition);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> bitSizeOfParallelImpl(const OwnerType& owner, size_t bitPosition, IExecutor& executor) const
+    {
+        size_t endBitPosition = bitPosition;
+        auto addResult = addBitSizeOfArrayLength(endBitPosition, m_rawArray.size());
+        if (!addResult.isSuccess())
+        {
+            return Result<size_t>::error(addResult.getError());
+        }
+
+        auto calcRangeEnd = [&](const ElementBitRange& range, size_t) {
+            return bitSizeOfElementRange(owner, range);
+        };
+
+        // TODO: These allocations may abort if allocation fails with -fno-exceptions!
+        ElementBitRanges ranges{typename ElementBitRanges::allocator_type(m_rawArray.get_allocator())};
+        if (!calcElementBitRanges(endBitPosition, executor, ranges, calcRangeEnd) ||
+                !runElementBitRanges(executor, ranges, calcRangeEnd, true))
+        {
+            return bitSizeOfImpl(owner, bitPosition);
+        }
+
+        return Result<size_t>::success(ranges.back().endBitPosition - bitPosition);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> initializeOffsetsScopedImpl(OwnerType& owner, size_t bitPosition)
+    {
+        return initializeOffsetsImpl(owner, bitPosition);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> initializeOffsetsScopedImpl(OwnerType& owner, size_t bitPosition)
+    {
+        IExecutor* executor = detail::parallelWriteExecutor();
+        if (executor == nullptr)
+        {
+            return initializeOffsetsImpl(owner, bitPosition);
+        }
+
+        // nested arrays of the elements are processed sequentially
+        detail::parallelWriteExecutor() = nullptr;
+        auto result = initializeOffsetsParallelImpl(owner, bitPosition, *executor);
+        detail::parallelWriteExecutor() = executor;
+        return result;
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> initializeOffsetsParallelImpl(OwnerType& owner, size_t bitPosition, IExecutor&)
+    {
+        return initializeOffsetsImpl(owner, bitPosition);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<size_t> initializeOffsetsParallelImpl(OwnerType& owner, size_t bitPosition, IExecutor& executor)
+    {
+        size_t endBitPosition = bitPosition;
+        auto addResult = addBitSizeOfArrayLength(endBitPosition, m_rawArray.size());
+        if (!addResult.isSuccess())
+        {
+            return Result<size_t>::error(addResult.getError());
+        }
+
+        // offsets initialized from the estimated start positions are initialized again by the verification
+        auto calcRangeEnd = [&](const ElementBitRange& range, size_t) {
+            return initializeOffsetsElementRange(owner, range);
+        };
+
+        // TODO: These allocations may abort if allocation fails with -fno-exceptions!
+        ElementBitRanges ranges{typename ElementBitRanges::allocator_type(m_rawArray.get_allocator())};
+        if (!calcElementBitRanges(endBitPosition, executor, ranges, calcRangeEnd) ||
+                !runElementBitRanges(executor, ranges, calcRangeEnd, true))
+        {
+            return initializeOffsetsImpl(owner, bitPosition);
+        }
+
+        return Result<size_t>::success(ranges.back().endBitPosition);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<void> writeScopedImpl(const OwnerType& owner, BitStreamWriter& out) const noexcept
+    {
+        return writeImpl(owner, out);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<void> writeScopedImpl(const OwnerType& owner, BitStreamWriter& out) const noexcept
+    {
+        IExecutor* executor = detail::parallelWriteExecutor();
+        if (executor == nullptr)
+        {
+            return writeImpl(owner, out);
+        }
+
+        // nested arrays of the elements are processed sequentially
+        detail::parallelWriteExecutor() = nullptr;
+        auto result = writeParallelImpl(owner, out, *executor);
+        detail::parallelWriteExecutor() = executor;
+        return result;
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<!detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<void> writeParallelImpl(const OwnerType& owner, BitStreamWriter& out, IExecutor&) const noexcept
+    {
+        return writeImpl(owner, out);
+    }
+
+    template <typename ARRAY_TRAITS_ = ArrayTraits,
+            typename std::enable_if<detail::is_parallel_writable_array<ARRAY_TRAITS_, ARRAY_TYPE>::value,
+                    int>::type = 0>
+    Result<void> writeParallelImpl(const OwnerType& owner, BitStreamWriter& out, IExecutor& executor) const noexcept
+    {
+        auto lengthResult = writeArrayLength(out, m_rawArray.size());
+        if (lengthResult.isError())
+        {
+            return lengthResult;
+        }
+
+        const size_t elementsBitPosition = out.getBitPosition();
+        auto calcRangeEnd = [&](const ElementBitRange& range, size_t) {
+            return bitSizeOfElementRange(owner, range);
+        };
+
+        // TODO: These allocations may abort if allocation fails with -fno-exceptions!
+        ElementBitRanges ranges{typename ElementBitRanges::allocator_type(m_rawArray.get_allocator())};
+        if (out.getOffsetPatcher() != nullptr ||
+                !calcElementBitRanges(elementsBitPosition, executor, ranges, calcRangeEnd))
+        {
+            return writeElements(owner, out);
+        }
+
+        // ranges start at byte boundaries, the padding behind a range is written by the range itself
+        auto writeRange = [&](const ElementBitRange& range, size_t rangeIndex) -> Result<size_t> {
+            const bool isLastRange = (rangeIndex + 1 == ranges.size());
+            const size_t rangeEndBitPosition =
+                    isLastRange ? range.endBitPosition : ranges[rangeIndex + 1].bitPosition;
+            return writeElementRange(owner, out, range, rangeEndBitPosition, !isLastRange);
+        };
+        out.flush();
+        if (!runElementBitRanges(executor, ranges, writeRange, true))
+        {
+            // bit size of an element depends on more than the byte alignment or writing has failed
+            auto positionResult = out.setBitPosition(elementsBitPosition);
+            if (positionResult.isError())
+            {
+                return positionResult;
+            }
+            return writeElements(owner, out);
+        }
+
+        return out.setBitPosition(ranges.back().endBitPosition);
+    }
+
+    Result<size_t> bitSizeOfElementRange(const OwnerType& owner, const ElementBitRange& range) const
+    {
+        size_t endBitPosition = range.bitPosition;
+        for (size_t index = range.beginIndex; index < range.endIndex; ++index)
+        {
+            alignBitPosition(endBitPosition);
+            auto elementSizeResult =
+                    detail::arrayTraitsBitSizeOf<ArrayTraits>(owner, endBitPosition, m_rawArray[index]);
+            if (!elementSizeResult.isSuccess())
+            {
+                return elementSizeResult;
+            }
+            endBitPosition += elementSizeResult.getValue();
+        }
+        return Result<size_t>::success(endBitPosition);
+    }
+
+    Result<size_t> initializeOffsetsElementRange(OwnerType& owner, const ElementBitRange& range)
+    {
+        size_t endBitPosition = range.bitPosition;
+        for (size_t index = range.beginIndex; index < range.endIndex; ++index)
+        {
+            initializeOffset(owner, index, endBitPosition);
+            auto offsetResult =
+                    detail::arrayTraitsInitializeOffsets<ArrayTraits>(owner, endBitPosition, m_rawArray[index]);
+            if (!offsetResult.isSuccess())
+            {
+                return offsetResult;
+            }
+            endBitPosition = offsetResult.getValue();
+        }
+        return Result<size_t>::success(endBitPosition);
+    }
+
+    Result<size_t> writeElementRange(const OwnerType& owner, const BitStreamWriter& out,
+            const ElementBitRange& range, size_t rangeEndBitPosition, bool alignEnd) const noexcept
+    {
+        auto writerResult = out.fork(range.bitPosition, rangeEndBitPosition);
+        if (writerResult.isError())
+        {
+            return Result<size_t>::error(writerResult.getError());
+        }
+        BitStreamWriter& writer = writerResult.getValue();
+
+        for (size_t index = range.beginIndex; index < range.endIndex; ++index)
+        {
+            auto alignResult = alignAndCheckOffset(writer, owner, index);
+            if (alignResult.isError())
+            {
+                return Result<size_t>::error(alignResult.getError());
+            }
+            auto writeResult = detail::arrayTraitsWrite<ArrayTraits>(owner, writer, m_rawArray[index]);
+            if (writeResult.isError())
+            {
+                return Result<size_t>::error(writeResult.getError());
+            }
+        }
+
+        const size_t endBitPosition = writer.getBitPosition();
+        if (alignEnd)
+        {
+            auto alignResult = writer.alignTo(8);
+            if (alignResult.isError())
+            {
+                return Result<size_t>::error(alignResult.getError());
+            }
+        }
+
+        return Result<size_t>::success(endBitPosition);
+    }
+
+    // splits the elements into ranges and calculates their start and end bit positions
+    template <typename CALC_RANGE_END>
+    bool calcElementBitRanges(size_t elementsBitPosition, IExecutor& executor, ElementBitRanges& ranges,
+            CALC_RANGE_END& calcRangeEnd) const noexcept
+    {
+        // more ranges than tasks balance elements of different sizes
+        const size_t arrayLength = m_rawArray.size();
+        const size_t numRanges = std::min(arrayLength, executor.getConcurrency() * 4);
+        if (numRanges < 2)
+        {
+            return false;
+        }
+
+        ranges.resize(numRanges);
+        for (size_t rangeIndex = 0; rangeIndex < numRanges; ++rangeIndex)
+        {
+            ElementBitRange& range = ranges[rangeIndex];
+            range.beginIndex = (rangeIndex == 0) ? 0 : ranges[rangeIndex - 1].endIndex;
+            range.endIndex = range.beginIndex + arrayLength / numRanges;
+            if (rangeIndex < arrayLength % numRanges)
+            {
+                ++range.endIndex;
+            }
+            // true start positions are not known yet, all but the first range start at a byte boundary
+            range.bitPosition = (rangeIndex == 0) ? elementsBitPosition : alignTo(8, elementsBitPosition);
+        }
+        if (!runElementBitRanges(executor, ranges, calcRangeEnd, false))
+        {
+            return false;
+        }
+
+        // prefix sums of bit sizes of the ranges give their start positions
+        for (size_t rangeIndex = 1; rangeIndex < numRanges; ++rangeIndex)
+        {
+            ElementBitRange& range = ranges[rangeIndex];
+            const size_t rangeBitSize = range.endBitPosition - range.bitPosition;
+            range.bitPosition = alignTo(8, ranges[rangeIndex - 1].endBitPosition);
+            range.endBitPosition = range.bitPosition + rangeBitSize;
+        }
+
+        return true;
+    }
+
+    // runs the function for all ranges concurrently, when verifying the function must return the end position
+    // of the range calculated before
+    template <typename RANGE_FUNC>
+    static bool runElementBitRanges(
+            IExecutor& executor, ElementBitRanges& ranges, RANGE_FUNC& rangeFunc, bool verify) noexcept
+    {
+        auto runRange = [&](size_t rangeIndex) {
+            ElementBitRange& range = ranges[rangeIndex];
+            auto endResult = rangeFunc(range, rangeIndex);
+            range.isValid = endResult.isSuccess() && (!verify || endResult.getValue() == range.endBitPosition);
+            if (range.isValid)
+            {
+                range.endBitPosition = endResult.getValue();
+            }
+        };
+        runTasks(executor, ranges.size(), runRange);
+
+        for (const ElementBitRange& range : ranges)
+        {
+            if (!range.isValid)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     using PackingContext = typename detail::packing_context_type<typename RawArray::value_type>::type;
 
     size_t bitSizeOfPackedImpl(const OwnerType& owner, size_t bitPosition) const
@@ -93,6 +93,65 @@ inline Result<uint64_t> read_bits<uint64_t>(BitStreamReader& in, uint8_t numBits
     return in.readBits64(numBits);
 }
 
+template <typename T>
+Result<void> read_bits_array(BitStreamReader& in, Span<T> values, uint8_t numBits) noexcept;
+
+template <>
+inline Result<void> read_bits_array<int8_t>(
+        BitStreamReader& in, Span<int8_t> values, uint8_t numBits) noexcept
+{
+    return in.readSignedBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> read_bits_array<int16_t>(
+        BitStreamReader& in, Span<int16_t> values, uint8_t numBits) noexcept
+{
+    return in.readSignedBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> read_bits_array<int32_t>(
+        BitStreamReader& in, Span<int32_t> values, uint8_t numBits) noexcept
+{
+    return in.readSignedBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> read_bits_array<int64_t>(
+        BitStreamReader& in, Span<int64_t> values, uint8_t numBits) noexcept
+{
+    return in.readSignedBits64Array(values, numBits);
+}
+
+template <>
+inline Result<void> read_bits_array<uint8_t>(
+        BitStreamReader& in, Span<uint8_t> values, uint8_t numBits) noexcept
+{
+    return in.readBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> read_bits_array<uint16_t>(
+        BitStreamReader& in, Span<uint16_t> values, uint8_t numBits) noexcept
+{
+    return in.readBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> read_bits_array<uint32_t>(
+        BitStreamReader& in, Span<uint32_t> values, uint8_t numBits) noexcept
+{
+    return in.readBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> read_bits_array<uint64_t>(
+        BitStreamReader& in, Span<uint64_t> values, uint8_t numBits) noexcept
+{
+    return in.readBits64Array(values, numBits);
+}
+
 template <typename T>
 Result<void> write_bits(BitStreamWriter& out, T value, uint8_t numBits) noexcept;
 
@@ -144,6 +203,65 @@ inline Result<void> write_bits<uint64_t>(BitStreamWriter& out, uint64_t value, u
     return out.writeBits64(value, numBits);
 }
 
+template <typename T>
+Result<void> write_bits_array(BitStreamWriter& out, Span<const T> values, uint8_t numBits) noexcept;
+
+template <>
+inline Result<void> write_bits_array<int8_t>(
+        BitStreamWriter& out, Span<const int8_t> values, uint8_t numBits) noexcept
+{
+    return out.writeSignedBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> write_bits_array<int16_t>(
+        BitStreamWriter& out, Span<const int16_t> values, uint8_t numBits) noexcept
+{
+    return out.writeSignedBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> write_bits_array<int32_t>(
+        BitStreamWriter& out, Span<const int32_t> values, uint8_t numBits) noexcept
+{
+    return out.writeSignedBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> write_bits_array<int64_t>(
+        BitStreamWriter& out, Span<const int64_t> values, uint8_t numBits) noexcept
+{
+    return out.writeSignedBits64Array(values, numBits);
+}
+
+template <>
+inline Result<void> write_bits_array<uint8_t>(
+        BitStreamWriter& out, Span<const uint8_t> values, uint8_t numBits) noexcept
+{
+    return out.writeBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> write_bits_array<uint16_t>(
+        BitStreamWriter& out, Span<const uint16_t> values, uint8_t numBits) noexcept
+{
+    return out.writeBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> write_bits_array<uint32_t>(
+        BitStreamWriter& out, Span<const uint32_t> values, uint8_t numBits) noexcept
+{
+    return out.writeBitsArray(values, numBits);
+}
+
+template <>
+inline Result<void> write_bits_array<uint64_t>(
+        BitStreamWriter& out, Span<const uint64_t> values, uint8_t numBits) noexcept
+{
+    return out.writeBits64Array(values, numBits);
+}
+
 } // namespace detail
 
 /**
@@ -213,6 +331,19 @@ public:
         return detail::read_bits<T>(in, NUM_BITS);
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return detail::read_bits_array<T>(in, elements, NUM_BITS);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -224,6 +355,19 @@ public:
         return detail::write_bits(out, element, NUM_BITS);
     }
 
+    /**
+     * Writes all array elements at once.
+     *
+     * \param out Bit stream writer to use.
+     * \param elements Elements to write.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> writeArray(BitStreamWriter& out, Span<const ElementType> elements) noexcept
+    {
+        return detail::write_bits_array<T>(out, elements, NUM_BITS);
+    }
+
     /** Determines whether the bit size of the single element is constant. */
     static constexpr bool IS_BITSIZEOF_CONSTANT = true;
 };
@@ -478,6 +622,19 @@ struct StdIntArrayTraits
         return detail::read_bits<T>(in, NUM_BITS);
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return detail::read_bits_array<T>(in, elements, NUM_BITS);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -489,6 +646,19 @@ struct StdIntArrayTraits
         return detail::write_bits(out, element, NUM_BITS);
     }
 
+    /**
+     * Writes all array elements at once.
+     *
+     * \param out Bit stream writer to use.
+     * \param elements Elements to write.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> writeArray(BitStreamWriter& out, Span<const ElementType> elements) noexcept
+    {
+        return detail::write_bits_array<T>(out, elements, NUM_BITS);
+    }
+
     /** Determines whether the bit size of the single element is constant. */
     static constexpr bool IS_BITSIZEOF_CONSTANT = true;
 
@@ -565,6 +735,19 @@ struct VarIntNNArrayTraits<int16_t>
         return in.readVarInt16();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarInt16Array(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -645,6 +828,19 @@ struct VarIntNNArrayTraits<int32_t>
         return in.readVarInt32();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarInt32Array(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -723,6 +919,19 @@ struct VarIntNNArrayTraits<int64_t>
         return in.readVarInt64();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarInt64Array(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -801,6 +1010,19 @@ struct VarIntNNArrayTraits<uint16_t>
         return in.readVarUInt16();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarUInt16Array(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -879,6 +1101,19 @@ struct VarIntNNArrayTraits<uint32_t>
         return in.readVarUInt32();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarUInt32Array(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -957,6 +1192,19 @@ struct VarIntNNArrayTraits<uint64_t>
         return in.readVarUInt64();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarUInt64Array(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -1041,6 +1289,19 @@ struct VarIntArrayTraits<int64_t>
         return in.readVarInt();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarIntArray(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -1119,6 +1380,19 @@ struct VarIntArrayTraits<uint64_t>
         return in.readVarUInt();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarUIntArray(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -1196,6 +1470,19 @@ struct VarSizeArrayTraits
         return in.readVarSize();
     }
 
+    /**
+     * Reads all array elements at once.
+     *
+     * \param in Bit stream reader.
+     * \param elements Preallocated storage for the elements to read.
+     *
+     * \return Result indicating success or error code.
+     */
+    static Result<void> readArray(BitStreamReader& in, Span<ElementType> elements) noexcept
+    {
+        return in.readVarSizeArray(elements);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -1563,6 +1850,18 @@ struct BasicBytesArrayTraits
         return Result<void>::success();
     }
 
+    /**
+     * Skips the single array element without reading it.
+     *
+     * \param in Bit stream reader.
+     *
+     * \return Success or error code.
+     */
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        return in.skipBytes();
+    }
+
     /**
      * Writes the single array element.
      *
@@ -1640,6 +1939,18 @@ struct BasicStringArrayTraits
         return Result<void>::success();
     }
 
+    /**
+     * Skips the single array element without reading it.
+     *
+     * \param in Bit stream reader.
+     *
+     * \return Success or error code.
+     */
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        return in.skipString();
+    }
+
     /**
      * Writes the single array element.
      *
@@ -1717,6 +2028,18 @@ struct BasicBitBufferArrayTraits
         return Result<void>::success();
     }
 
+    /**
+     * Skips the single array element without reading it.
+     *
+     * \param in Bit stream reader.
+     *
+     * \return Success or error code.
+     */
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        return in.skipBitBuffer();
+    }
+
     /**
      * Writes the single array element.
      *
@@ -1916,6 +2239,20 @@ public:
         return ELEMENT_FACTORY::create(owner, rawArray, in, index);
     }
 
+    /**
+     * Skips the single array element without reading it.
+     *
+     * Available only for elements which do not need any parameters.
+     *
+     * \param in Bit stream reader.
+     *
+     * \return Success or error code.
+     */
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        return ElementType::skip(in);
+    }
+
     /**
      * Writes the single array element.
      *
@@ -0,0 +1,685 @@
+#ifndef ZSERIO_ARRAY_VIEW_H_INC
+#define ZSERIO_ARRAY_VIEW_H_INC
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "zserio/Array.h"
+#include "zserio/BitStreamReader.h"
+#include "zserio/ErrorCode.h"
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/StringView.h"
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+/**
+ * View traits for array elements which are decoded by value using the given array traits.
+ *
+ * Used for integers, floats, booleans, enums and bitmasks.
+ */
+template <typename ARRAY_TRAITS>
+struct ValueViewTraits
+{
+    /** Type of the decoded element. */
+    using ValueType = typename ARRAY_TRAITS::ElementType;
+
+    /** Determines whether the bit size of the single element is constant. */
+    static constexpr bool IS_BITSIZEOF_CONSTANT = ARRAY_TRAITS::IS_BITSIZEOF_CONSTANT;
+
+    /**
+     * Gets bit size of the single element. Available only for elements with constant bit size.
+     *
+     * \return Bit size of the single element.
+     */
+    static Result<size_t> bitSizeOf() noexcept
+    {
+        return ARRAY_TRAITS::bitSizeOf();
+    }
+
+    /**
+     * Decodes the single element.
+     *
+     * \param in Bit stream reader positioned at the element.
+     *
+     * \return Decoded element or error code.
+     */
+    static Result<ValueType> read(Span<const uint8_t>, BitStreamReader& in) noexcept
+    {
+        return ARRAY_TRAITS::read(in);
+    }
+
+    /**
+     * Skips the single element.
+     *
+     * \param in Bit stream reader positioned at the element.
+     *
+     * \return Success or error code.
+     */
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        return detail::arrayTraitsSkip<ARRAY_TRAITS>(in, 0);
+    }
+};
+
+/**
+ * View traits for array elements of string type which are returned as views into the buffer.
+ */
+struct StringViewTraits
+{
+    /** Type of the decoded element. */
+    using ValueType = StringView;
+
+    /** Determines whether the bit size of the single element is constant. */
+    static constexpr bool IS_BITSIZEOF_CONSTANT = false;
+
+    /**
+     * Gets view of the single element.
+     *
+     * \param in Bit stream reader positioned at the element.
+     *
+     * \return View into the buffer or error code (InvalidAlignment when the string is not byte aligned).
+     */
+    static Result<ValueType> read(Span<const uint8_t>, BitStreamReader& in) noexcept
+    {
+        return in.readStringView();
+    }
+
+    /**
+     * Skips the single element.
+     *
+     * \param in Bit stream reader positioned at the element.
+     *
+     * \return Success or error code.
+     */
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        return in.skipString();
+    }
+};
+
+/**
+ * View traits for array elements of bytes type which are returned as views into the buffer.
+ */
+struct BytesViewTraits
+{
+    /** Type of the decoded element. */
+    using ValueType = BytesView;
+
+    /** Determines whether the bit size of the single element is constant. */
+    static constexpr bool IS_BITSIZEOF_CONSTANT = false;
+
+    /**
+     * Gets view of the single element.
+     *
+     * \param in Bit stream reader positioned at the element.
+     *
+     * \return View into the buffer or error code (InvalidAlignment when the bytes are not byte aligned).
+     */
+    static Result<ValueType> read(Span<const uint8_t>, BitStreamReader& in) noexcept
+    {
+        return in.readBytesView();
+    }
+
+    /**
+     * Skips the single element.
+     *
+     * \param in Bit stream reader positioned at the element.
+     *
+     * \return Success or error code.
+     */
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        return in.skipBytes();
+    }
+};
+
+/**
+ * Byte offsets of the elements of an aligned array with indexed offsets.
+ *
+ * Offsets are decoded lazily from the view of the offset array, thus elements of the aligned array can be
+ * accessed at once even if their bit size is not constant. The type of the offset array view is erased,
+ * no memory is allocated.
+ */
+class ArrayViewOffsets
+{
+public:
+    /**
+     * Default constructor which creates empty offsets.
+     */
+    ArrayViewOffsets() noexcept :
+            m_bitPosition(0),
+            m_length(0),
+            m_readOffset(nullptr)
+    {}
+
+    /**
+     * Constructor.
+     *
+     * \param offsetsView View of the array which holds the byte offsets of the elements.
+     */
+    template <typename OFFSETS_VIEW>
+    explicit ArrayViewOffsets(const OFFSETS_VIEW& offsetsView) noexcept :
+            m_buffer(offsetsView.getBuffer()),
+            m_bitPosition(offsetsView.getBitPosition()),
+            m_length(offsetsView.size()),
+            m_readOffset(&readOffset<OFFSETS_VIEW>)
+    {}
+
+    /**
+     * Checks whether the offsets are empty.
+     *
+     * \return True when no offset array is available, otherwise false.
+     */
+    bool isEmpty() const noexcept
+    {
+        return m_readOffset == nullptr;
+    }
+
+    /**
+     * Gets the byte offset of the element.
+     *
+     * \param index Index of the element.
+     *
+     * \return Byte offset of the element in the buffer or error code (InvalidIndex when the offset array is
+     *         shorter).
+     */
+    Result<size_t> getByteOffset(size_t index) const noexcept
+    {
+        if (m_readOffset == nullptr)
+        {
+            return Result<size_t>::error(ErrorCode::InvalidIndex);
+        }
+
+        return m_readOffset(m_buffer, m_bitPosition, m_length, index);
+    }
+
+private:
+    using ReadOffsetFunc = Result<size_t> (*)(Span<const uint8_t>, size_t, size_t, size_t);
+
+    template <typename OFFSETS_VIEW>
+    static Result<size_t> readOffset(
+            Span<const uint8_t> buffer, size_t bitPosition, size_t length, size_t index) noexcept
+    {
+        auto result = OFFSETS_VIEW(buffer, bitPosition, length).at(index);
+        if (result.isError())
+        {
+            return Result<size_t>::error(result.getError());
+        }
+        return Result<size_t>::success(static_cast<size_t>(result.getValue()));
+    }
+
+    Span<const uint8_t> m_buffer;
+    size_t m_bitPosition;
+    size_t m_length;
+    ReadOffsetFunc m_readOffset;
+};
+
+/**
+ * Lazy read-only view of a Zserio array serialized in a buffer.
+ *
+ * The view holds only the buffer, the bit position of the first element and the array length. Elements are
+ * decoded on access by the view traits which define ValueType, IS_BITSIZEOF_CONSTANT, read() and skip()
+ * (bitSizeOf() is needed only for elements with constant bit size). Views generated for compound types
+ * in case of '-withViewCode' command line option satisfy the view traits as well.
+ *
+ * Elements with constant bit size and elements of aligned arrays with indexed offsets are accessed at once,
+ * other elements need to skip all preceding elements. Use iterators to visit all elements in linear time.
+ * The buffer must outlive the view.
+ */
+template <typename VIEW_TRAITS, ArrayType ARRAY_TYPE = ArrayType::NORMAL>
+class ArrayView
+{
+public:
+    /** Type of the decoded element. */
+    using ValueType = typename VIEW_TRAITS::ValueType;
+
+    /**
+     * Input iterator which decodes the elements sequentially.
+     *
+     * Dereferencing returns the element or error code. When the element cannot be skipped, the iterator keeps
+     * the error and reports it from all following dereferences.
+     */
+    class ConstIterator
+    {
+    public:
+        /** Iterator traits. */
+        /** \{ */
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Result<ValueType>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Result<ValueType>;
+        /** \} */
+
+        /**
+         * Constructor.
+         *
+         * \param view View of the array to iterate.
+         * \param index Index of the element.
+         * \param bitPosition Bit position of the element (before its alignment).
+         */
+        ConstIterator(const ArrayView* view, size_t index, size_t bitPosition) noexcept :
+                m_view(view),
+                m_index(index),
+                m_bitPosition(bitPosition),
+                m_error(ErrorCode::Success)
+        {}
+
+        /**
+         * Decodes the current element.
+         *
+         * \return Element or error code.
+         */
+        Result<ValueType> operator*() const noexcept
+        {
+            if (m_error != ErrorCode::Success)
+            {
+                return Result<ValueType>::error(m_error);
+            }
+
+            BitStreamReader in(m_view->m_buffer);
+            auto positionResult = in.setBitPosition(m_bitPosition);
+            if (positionResult.isError())
+            {
+                return Result<ValueType>::error(positionResult.getError());
+            }
+
+            return readElement(m_view->m_buffer, in);
+        }
+
+        /**
+         * Moves to the next element.
+         *
+         * \return Reference to this iterator.
+         */
+        ConstIterator& operator++() noexcept
+        {
+            if (m_error == ErrorCode::Success)
+            {
+                BitStreamReader in(m_view->m_buffer);
+                auto skipResult = in.setBitPosition(m_bitPosition);
+                if (!skipResult.isError())
+                {
+                    skipResult = skipElements(in, 1);
+                }
+                if (skipResult.isError())
+                {
+                    m_error = skipResult.getError();
+                }
+                m_bitPosition = in.getBitPosition();
+            }
+            ++m_index;
+
+            return *this;
+        }
+
+        /**
+         * Comparison operators. Only iterators of the same view can be compared.
+         *
+         * \param other Iterator to compare with.
+         *
+         * \return Result of the comparison.
+         * \{
+         */
+        bool operator==(const ConstIterator& other) const noexcept
+        {
+            return m_index == other.m_index;
+        }
+
+        bool operator!=(const ConstIterator& other) const noexcept
+        {
+            return m_index != other.m_index;
+        }
+        /**
+         * \}
+         */
+
+        /**
+         * Gets index of the current element.
+         *
+         * \return Index of the element.
+         */
+        size_t getIndex() const noexcept
+        {
+            return m_index;
+        }
+
+    private:
+        const ArrayView* m_view;
+        size_t m_index;
+        size_t m_bitPosition;
+        ErrorCode m_error;
+    };
+
+    /**
+     * Default constructor which creates an empty view.
+     */
+    ArrayView() noexcept :
+            m_bitPosition(0),
+            m_length(0)
+    {}
+
+    /**
+     * Constructor.
+     *
+     * \param buffer Buffer which contains the serialized array.
+     * \param bitPosition Bit position of the first element (after the length of auto arrays).
+     * \param length Number of elements.
+     */
+    ArrayView(Span<const uint8_t> buffer, size_t bitPosition, size_t length) noexcept :
+            m_buffer(buffer),
+            m_bitPosition(bitPosition),
+            m_length(length)
+    {}
+
+    /**
+     * Constructor for aligned arrays with indexed offsets.
+     *
+     * \param buffer Buffer which contains the serialized array.
+     * \param bitPosition Bit position of the first element (after the length of auto arrays).
+     * \param length Number of elements.
+     * \param offsets Byte offsets of the elements.
+     */
+    ArrayView(Span<const uint8_t> buffer, size_t bitPosition, size_t length, const ArrayViewOffsets& offsets) noexcept :
+            m_buffer(buffer),
+            m_bitPosition(bitPosition),
+            m_length(length),
+            m_offsets(offsets)
+    {
+        static_assert(ARRAY_TYPE == ArrayType::ALIGNED || ARRAY_TYPE == ArrayType::ALIGNED_AUTO,
+                "Only aligned arrays can have indexed offsets!");
+    }
+
+    /**
+     * Creates the view of the array which starts at the current position of the reader.
+     *
+     * Only the length of auto arrays is read, elements are not touched.
+     *
+     * \param buffer Buffer read by the reader.
+     * \param in Bit stream reader positioned at the array.
+     * \param arrayLength Array length, not used for auto and implicit arrays.
+     *
+     * \return View of the array or error code.
+     */
+    static Result<ArrayView> create(Span<const uint8_t> buffer, BitStreamReader& in, size_t arrayLength = 0) noexcept
+    {
+        auto lengthResult = readArrayLength(in, arrayLength);
+        if (lengthResult.isError())
+        {
+            return Result<ArrayView>::error(lengthResult.getError());
+        }
+
+        return Result<ArrayView>::success(ArrayView(buffer, in.getBitPosition(), lengthResult.getValue()));
+    }
+
+    /**
+     * Creates the view of the aligned array with indexed offsets which starts at the current position
+     * of the reader.
+     *
+     * \param buffer Buffer read by the reader.
+     * \param in Bit stream reader positioned at the array.
+     * \param arrayLength Array length, not used for auto arrays.
+     * \param offsets Byte offsets of the elements.
+     *
+     * \return View of the array or error code.
+     */
+    static Result<ArrayView> create(Span<const uint8_t> buffer, BitStreamReader& in, size_t arrayLength,
+            const ArrayViewOffsets& offsets) noexcept
+    {
+        auto lengthResult = readArrayLength(in, arrayLength);
+        if (lengthResult.isError())
+        {
+            return Result<ArrayView>::error(lengthResult.getError());
+        }
+
+        return Result<ArrayView>::success(
+                ArrayView(buffer, in.getBitPosition(), lengthResult.getValue(), offsets));
+    }
+
+    /**
+     * Gets number of elements.
+     *
+     * \return Array length.
+     */
+    size_t size() const noexcept
+    {
+        return m_length;
+    }
+
+    /**
+     * Checks whether the array is empty.
+     *
+     * \return True when the array has no elements, otherwise false.
+     */
+    bool empty() const noexcept
+    {
+        return m_length == 0;
+    }
+
+    /**
+     * Decodes the element at the given index.
+     *
+     * \param index Index of the element.
+     *
+     * \return Element or error code (InvalidIndex when the index is out of range).
+     */
+    Result<ValueType> at(size_t index) const noexcept
+    {
+        if (index >= m_length)
+        {
+            return Result<ValueType>::error(ErrorCode::InvalidIndex);
+        }
+
+        BitStreamReader in(m_buffer);
+        auto seekResult = seekElement(in, index);
+        if (seekResult.isError())
+        {
+            return Result<ValueType>::error(seekResult.getError());
+        }
+
+        return readElement(m_buffer, in);
+    }
+
+    /**
+     * Decodes the element at the given index.
+     *
+     * \param index Index of the element.
+     *
+     * \return Element or error code (InvalidIndex when the index is out of range).
+     */
+    Result<ValueType> operator[](size_t index) const noexcept
+    {
+        return at(index);
+    }
+
+    /**
+     * Gets iterator to the first element.
+     *
+     * \return Begin iterator.
+     */
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(this, 0, m_bitPosition);
+    }
+
+    /**
+     * Gets iterator behind the last element.
+     *
+     * \return End iterator.
+     */
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(this, m_length, 0);
+    }
+
+    /**
+     * Gets bit position of the first element in the buffer.
+     *
+     * \return Bit position of the first element.
+     */
+    size_t getBitPosition() const noexcept
+    {
+        return m_bitPosition;
+    }
+
+    /**
+     * Gets the buffer which contains the serialized array.
+     *
+     * \return Buffer of the array.
+     */
+    Span<const uint8_t> getBuffer() const noexcept
+    {
+        return m_buffer;
+    }
+
+private:
+    Result<void> seekElement(BitStreamReader& in, size_t index) const noexcept
+    {
+        if (index != 0 && !m_offsets.isEmpty())
+        {
+            auto offsetResult = m_offsets.getByteOffset(index);
+            if (offsetResult.isError())
+            {
+                return Result<void>::error(offsetResult.getError());
+            }
+            if (offsetResult.getValue() > in.getBufferBitSize() / 8)
+            {
+                return Result<void>::error(ErrorCode::EndOfStream);
+            }
+            return in.setBitPosition(offsetResult.getValue() * 8);
+        }
+
+        auto positionResult = in.setBitPosition(m_bitPosition);
+        if (positionResult.isError())
+        {
+            return positionResult;
+        }
+        return skipElements(in, index);
+    }
+
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ != ArrayType::AUTO && ARRAY_TYPE_ != ArrayType::ALIGNED_AUTO &&
+                            ARRAY_TYPE_ != ArrayType::IMPLICIT,
+                    int>::type = 0>
+    static Result<size_t> readArrayLength(BitStreamReader&, size_t arrayLength) noexcept
+    {
+        return Result<size_t>::success(arrayLength);
+    }
+
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ == ArrayType::AUTO || ARRAY_TYPE_ == ArrayType::ALIGNED_AUTO,
+                    int>::type = 0>
+    static Result<size_t> readArrayLength(BitStreamReader& in, size_t) noexcept
+    {
+        auto result = in.readVarSize();
+        if (result.isError())
+        {
+            return Result<size_t>::error(result.getError());
+        }
+        return Result<size_t>::success(static_cast<size_t>(result.getValue()));
+    }
+
+    template <ArrayType ARRAY_TYPE_ = ARRAY_TYPE,
+            typename std::enable_if<ARRAY_TYPE_ == ArrayType::IMPLICIT, int>::type = 0>
+    static Result<size_t> readArrayLength(BitStreamReader& in, size_t) noexcept
+    {
+        static_assert(VIEW_TRAITS::IS_BITSIZEOF_CONSTANT, "Implicit array elements must have constant bit size!");
+
+        auto sizeResult = VIEW_TRAITS::bitSizeOf();
+        if (sizeResult.isError())
+        {
+            return Result<size_t>::error(sizeResult.getError());
+        }
+        const size_t elementBitSize = sizeResult.getValue();
+        if (elementBitSize == 0)
+        {
+            return Result<size_t>::error(ErrorCode::DivisionByZero);
+        }
+        return Result<size_t>::success((in.getBufferBitSize() - in.getBitPosition()) / elementBitSize);
+    }
+
+    static Result<void> alignElement(BitStreamReader& in) noexcept
+    {
+        if (ARRAY_TYPE == ArrayType::ALIGNED || ARRAY_TYPE == ArrayType::ALIGNED_AUTO)
+        {
+            return in.alignTo(8);
+        }
+        return Result<void>::success();
+    }
+
+    static Result<ValueType> readElement(Span<const uint8_t> buffer, BitStreamReader& in) noexcept
+    {
+        auto alignResult = alignElement(in);
+        if (alignResult.isError())
+        {
+            return Result<ValueType>::error(alignResult.getError());
+        }
+        return VIEW_TRAITS::read(buffer, in);
+    }
+
+    // elements with constant bit size are skipped at once, aligned elements have the stride rounded up to bytes
+    template <typename VIEW_TRAITS_ = VIEW_TRAITS,
+            typename std::enable_if<VIEW_TRAITS_::IS_BITSIZEOF_CONSTANT, int>::type = 0>
+    static Result<void> skipElements(BitStreamReader& in, size_t skipLength) noexcept
+    {
+        if (skipLength == 0)
+        {
+            return Result<void>::success();
+        }
+
+        auto sizeResult = VIEW_TRAITS::bitSizeOf();
+        if (sizeResult.isError())
+        {
+            return Result<void>::error(sizeResult.getError());
+        }
+        size_t elementBitSize = sizeResult.getValue();
+        if (ARRAY_TYPE == ArrayType::ALIGNED || ARRAY_TYPE == ArrayType::ALIGNED_AUTO)
+        {
+            auto alignResult = alignElement(in);
+            if (alignResult.isError())
+            {
+                return alignResult;
+            }
+            elementBitSize = (elementBitSize + 7) / 8 * 8;
+        }
+        if (elementBitSize != 0 && skipLength > (in.getBufferBitSize() - in.getBitPosition()) / elementBitSize)
+        {
+            return Result<void>::error(ErrorCode::EndOfStream);
+        }
+
+        return in.skipBits(skipLength * elementBitSize);
+    }
+
+    template <typename VIEW_TRAITS_ = VIEW_TRAITS,
+            typename std::enable_if<!VIEW_TRAITS_::IS_BITSIZEOF_CONSTANT, int>::type = 0>
+    static Result<void> skipElements(BitStreamReader& in, size_t skipLength) noexcept
+    {
+        for (size_t index = 0; index < skipLength; ++index)
+        {
+            auto alignResult = alignElement(in);
+            if (alignResult.isError())
+            {
+                return alignResult;
+            }
+            auto skipResult = VIEW_TRAITS::skip(in);
+            if (skipResult.isError())
+            {
+                return skipResult;
+            }
+        }
+        return Result<void>::success();
+    }
+
+    Span<const uint8_t> m_buffer;
+    size_t m_bitPosition;
+    size_t m_length;
+    ArrayViewOffsets m_offsets;
+};
+
+} // namespace zserio
+
+#endif // ZSERIO_ARRAY_VIEW_H_INC
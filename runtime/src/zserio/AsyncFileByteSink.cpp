@@ -0,0 +1,338 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "zserio/AsyncFileByteSink.h"
+#include "zserio/ErrorCode.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ZSERIO_ASYNC_FILE_BYTE_SINK_POSIX
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace zserio
+{
+
+constexpr size_t AsyncFileByteSink::DEFAULT_NUM_BUFFERS;
+constexpr size_t AsyncFileByteSink::DEFAULT_BUFFER_BYTE_SIZE;
+constexpr std::chrono::milliseconds AsyncFileByteSink::DEFAULT_WAIT_TIMEOUT;
+
+struct AsyncFileByteSink::State
+{
+    // buffers are owned either by the writing thread (current buffer), or by the queue of full buffers,
+    // or by the background thread while it writes them, or they are free
+    std::vector<std::vector<uint8_t>> buffers;
+    std::vector<size_t> byteSizes;
+    std::deque<size_t> fullBuffers;
+    std::vector<size_t> freeBuffers;
+    size_t currentBuffer = 0;
+    bool hasCurrentBuffer = false;
+    std::chrono::milliseconds waitTimeout{0};
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    ErrorCode error = ErrorCode::Success;
+    bool isWriting = false;
+    bool isStopping = false;
+    bool isClosed = false;
+    std::thread thread;
+
+#ifdef ZSERIO_ASYNC_FILE_BYTE_SINK_POSIX
+    int fd = -1;
+#else
+    std::ofstream stream;
+#endif
+
+    ErrorCode writeFile(const uint8_t* data, size_t byteSize) noexcept
+    {
+#ifdef ZSERIO_ASYNC_FILE_BYTE_SINK_POSIX
+        while (byteSize > 0)
+        {
+            const ssize_t written = ::write(fd, data, byteSize);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return ErrorCode::FileWriteFailed;
+            }
+            data += written;
+            byteSize -= static_cast<size_t>(written);
+        }
+
+        // the data are on the disk when the buffer is released
+#ifdef __APPLE__
+        if (::fsync(fd) != 0)
+#else
+        if (::fdatasync(fd) != 0)
+#endif
+        {
+            return ErrorCode::FileWriteFailed;
+        }
+#else
+        if (!stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(byteSize)) ||
+                !stream.flush())
+        {
+            return ErrorCode::FileWriteFailed;
+        }
+#endif
+
+        return ErrorCode::Success;
+    }
+
+    ErrorCode closeFile() noexcept
+    {
+#ifdef ZSERIO_ASYNC_FILE_BYTE_SINK_POSIX
+        const int result = ::close(fd);
+        fd = -1;
+        return (result == 0) ? ErrorCode::Success : ErrorCode::FileCloseFailed;
+#else
+        stream.close();
+        return stream ? ErrorCode::Success : ErrorCode::FileCloseFailed;
+#endif
+    }
+
+    void runBackgroundWriter() noexcept
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            condition.wait(lock, [this] {
+                return !fullBuffers.empty() || isStopping;
+            });
+            if (fullBuffers.empty())
+            {
+                return;
+            }
+
+            const size_t index = fullBuffers.front();
+            fullBuffers.pop_front();
+            isWriting = true;
+            // after an error, the following buffers are only released to keep the file contiguous
+            const bool isFailed = (error != ErrorCode::Success);
+            lock.unlock();
+
+            const ErrorCode writeError =
+                    isFailed ? ErrorCode::Success : writeFile(buffers[index].data(), byteSizes[index]);
+
+            lock.lock();
+            if (writeError != ErrorCode::Success && error == ErrorCode::Success)
+            {
+                error = writeError;
+            }
+            isWriting = false;
+            freeBuffers.push_back(index);
+            condition.notify_all();
+        }
+    }
+
+    // must be called with the locked mutex
+    void submitCurrentBuffer() noexcept
+    {
+        fullBuffers.push_back(currentBuffer);
+        hasCurrentBuffer = false;
+        condition.notify_all();
+    }
+
+    // must be called with the locked mutex
+    Result<void> waitForFreeBuffers(std::unique_lock<std::mutex>& lock, size_t numBuffers) noexcept
+    {
+        const bool isReady = condition.wait_for(lock, waitTimeout, [this, numBuffers] {
+            return freeBuffers.size() >= numBuffers || error != ErrorCode::Success;
+        });
+        if (error != ErrorCode::Success)
+        {
+            return Result<void>::error(error);
+        }
+
+        return isReady ? Result<void>::success() : Result<void>::error(ErrorCode::InsufficientCapacity);
+    }
+};
+
+Result<AsyncFileByteSink> AsyncFileByteSink::open(const std::string& fileName, size_t numBuffers,
+        size_t bufferByteSize, std::chrono::milliseconds waitTimeout) noexcept
+{
+    std::unique_ptr<State> state(new State());
+
+#ifdef ZSERIO_ASYNC_FILE_BYTE_SINK_POSIX
+    state->fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (state->fd == -1)
+    {
+        return Result<AsyncFileByteSink>::error(ErrorCode::FileOpenFailed);
+    }
+#else
+    state->stream.open(fileName.c_str(), std::ofstream::binary | std::ofstream::trunc);
+    if (!state->stream)
+    {
+        return Result<AsyncFileByteSink>::error(ErrorCode::FileOpenFailed);
+    }
+#endif
+
+    // Note: resize() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+    // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+    numBuffers = std::max<size_t>(numBuffers, 2);
+    state->buffers.resize(numBuffers);
+    state->byteSizes.resize(numBuffers, 0);
+    state->freeBuffers.reserve(numBuffers);
+    for (size_t i = numBuffers; i > 0; --i)
+    {
+        state->buffers[i - 1].resize(std::max<size_t>(bufferByteSize, 1));
+        state->freeBuffers.push_back(i - 1);
+    }
+    state->waitTimeout = waitTimeout;
+
+    State* statePtr = state.get();
+    state->thread = std::thread([statePtr] {
+        statePtr->runBackgroundWriter();
+    });
+
+    return Result<AsyncFileByteSink>::success(AsyncFileByteSink(std::move(state)));
+}
+
+AsyncFileByteSink::AsyncFileByteSink(std::unique_ptr<State>&& state) noexcept :
+        m_state(std::move(state))
+{}
+
+AsyncFileByteSink::~AsyncFileByteSink()
+{
+    if (m_state && !m_state->isClosed)
+    {
+        (void)close();
+    }
+}
+
+AsyncFileByteSink::AsyncFileByteSink(AsyncFileByteSink&& other) noexcept :
+        m_state(std::move(other.m_state))
+{}
+
+AsyncFileByteSink& AsyncFileByteSink::operator=(AsyncFileByteSink&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_state && !m_state->isClosed)
+        {
+            (void)close();
+        }
+        m_state = std::move(other.m_state);
+    }
+
+    return *this;
+}
+
+Result<void> AsyncFileByteSink::write(Span<const uint8_t> data) noexcept
+{
+    if (!m_state || m_state->isClosed)
+    {
+        return Result<void>::error(ErrorCode::StreamClosed);
+    }
+
+    State& state = *m_state;
+    std::unique_lock<std::mutex> lock(state.mutex);
+    if (state.error != ErrorCode::Success)
+    {
+        return Result<void>::error(state.error);
+    }
+
+    // waits for all buffers needed by the data before copying, thus the data are not accepted partially
+    const size_t bufferByteSize = state.buffers[0].size();
+    const size_t currentFreeByteSize =
+            state.hasCurrentBuffer ? bufferByteSize - state.byteSizes[state.currentBuffer] : 0;
+    if (data.size() > currentFreeByteSize)
+    {
+        const size_t numNeededBuffers = (data.size() - currentFreeByteSize + bufferByteSize - 1) / bufferByteSize;
+        const size_t numOtherBuffers = state.buffers.size() - (state.hasCurrentBuffer ? 1 : 0);
+        auto waitResult = state.waitForFreeBuffers(lock, std::min(numNeededBuffers, numOtherBuffers));
+        if (waitResult.isError())
+        {
+            return waitResult;
+        }
+    }
+
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        if (!state.hasCurrentBuffer)
+        {
+            // waits only when the data are larger than all other buffers
+            auto waitResult = state.waitForFreeBuffers(lock, 1);
+            if (waitResult.isError())
+            {
+                return waitResult;
+            }
+            state.currentBuffer = state.freeBuffers.back();
+            state.freeBuffers.pop_back();
+            state.byteSizes[state.currentBuffer] = 0;
+            state.hasCurrentBuffer = true;
+        }
+
+        size_t& byteSize = state.byteSizes[state.currentBuffer];
+        const size_t copySize = std::min(data.size() - offset, bufferByteSize - byteSize);
+        std::memcpy(state.buffers[state.currentBuffer].data() + byteSize, data.data() + offset, copySize);
+        byteSize += copySize;
+        offset += copySize;
+        if (byteSize == bufferByteSize)
+        {
+            state.submitCurrentBuffer();
+        }
+    }
+
+    return Result<void>::success();
+}
+
+Result<void> AsyncFileByteSink::flush() noexcept
+{
+    if (!m_state || m_state->isClosed)
+    {
+        return Result<void>::error(ErrorCode::StreamClosed);
+    }
+
+    State& state = *m_state;
+    std::unique_lock<std::mutex> lock(state.mutex);
+    if (state.hasCurrentBuffer && state.byteSizes[state.currentBuffer] > 0)
+    {
+        state.submitCurrentBuffer();
+    }
+
+    state.condition.wait(lock, [&state] {
+        return state.fullBuffers.empty() && !state.isWriting;
+    });
+
+    return (state.error != ErrorCode::Success) ? Result<void>::error(state.error) : Result<void>::success();
+}
+
+Result<void> AsyncFileByteSink::close() noexcept
+{
+    if (!m_state || m_state->isClosed)
+    {
+        return Result<void>::error(ErrorCode::StreamClosed);
+    }
+
+    State& state = *m_state;
+    auto flushResult = flush();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.isStopping = true;
+        state.condition.notify_all();
+    }
+    state.thread.join();
+    state.isClosed = true;
+
+    const ErrorCode closeError = state.closeFile();
+    if (flushResult.isError())
+    {
+        return flushResult;
+    }
+
+    return (closeError != ErrorCode::Success) ? Result<void>::error(closeError) : Result<void>::success();
+}
+
+} // namespace zserio
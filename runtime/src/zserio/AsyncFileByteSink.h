@@ -0,0 +1,132 @@
+/**
+ * \file
+ * Byte sink which writes a file asynchronously in a background thread.
+ *
+ * These utilities are not used by generated code and they are provided only for user convenience.
+ *
+ * \note Please note that file operations allocate memory as needed and are not designed to use allocators.
+ */
+
+#ifndef ZSERIO_ASYNC_FILE_BYTE_SINK_H_INC
+#define ZSERIO_ASYNC_FILE_BYTE_SINK_H_INC
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "zserio/IByteSink.h"
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+/**
+ * Byte sink which collects written bytes in a ring of buffers and writes full buffers to a file in a background
+ * thread.
+ *
+ * Written bytes are copied into the current buffer. When the buffer fills, it is handed over to the background
+ * thread which writes it to the file and, on POSIX systems, synchronizes the file data to the disk by
+ * fdatasync(). Meanwhile the next buffer is filled, thus disk latencies do not stall the writing thread.
+ *
+ * When the disk cannot keep up and no buffer is free, write() waits at most for the configured timeout and then
+ * fails with InsufficientCapacity. Data which fit into the buffers are either accepted whole or rejected, thus
+ * a message can be dropped and writing can continue. Only data larger than all other buffers can be accepted
+ * partially. Errors of the background thread are reported by the following call of write(), flush() or close().
+ *
+ * All buffers are allocated when the file is opened, writing does not allocate any memory.
+ *
+ * The sink can be used only by a single writing thread.
+ *
+ * IMPORTANT: When building with -fno-exceptions, vector and thread operations that would normally throw will
+ * instead cause std::abort() (GCC) or undefined behavior (other implementations).
+ */
+class AsyncFileByteSink : public IByteSink
+{
+public:
+    /** Default number of buffers. */
+    static constexpr size_t DEFAULT_NUM_BUFFERS = 2;
+
+    /** Default byte size of each buffer. */
+    static constexpr size_t DEFAULT_BUFFER_BYTE_SIZE = 1024 * 1024;
+
+    /** Default time for which write() waits for a free buffer. */
+    static constexpr std::chrono::milliseconds DEFAULT_WAIT_TIMEOUT = std::chrono::milliseconds(1000);
+
+    /**
+     * Creates or truncates given file for writing and starts the background thread.
+     *
+     * \param fileName File to write.
+     * \param numBuffers Number of buffers, at least two buffers are used.
+     * \param bufferByteSize Byte size of each buffer.
+     * \param waitTimeout Time for which write() waits for a free buffer.
+     *
+     * \return Result containing the sink, or error code.
+     */
+    static Result<AsyncFileByteSink> open(const std::string& fileName, size_t numBuffers = DEFAULT_NUM_BUFFERS,
+            size_t bufferByteSize = DEFAULT_BUFFER_BYTE_SIZE,
+            std::chrono::milliseconds waitTimeout = DEFAULT_WAIT_TIMEOUT) noexcept;
+
+    /**
+     * Destructor which writes the remaining bytes and closes the file. Errors are lost, use close() to get them.
+     */
+    ~AsyncFileByteSink() override;
+
+    /**
+     * Copying is disallowed, the background thread is owned!
+     * \{
+     */
+    AsyncFileByteSink(const AsyncFileByteSink&) = delete;
+    AsyncFileByteSink& operator=(const AsyncFileByteSink&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Move constructor and assignment operator.
+     * \{
+     */
+    AsyncFileByteSink(AsyncFileByteSink&& other) noexcept;
+    AsyncFileByteSink& operator=(AsyncFileByteSink&& other) noexcept;
+    /**
+     * \}
+     */
+
+    /**
+     * Copies given bytes into the buffers.
+     *
+     * \param data Bytes to write.
+     *
+     * \return Success when the bytes have been accepted, InsufficientCapacity when no buffer has been freed
+     *         within the timeout, or error code of a previous background write.
+     */
+    Result<void> write(Span<const uint8_t> data) noexcept override;
+
+    /**
+     * Hands over the partially filled buffer and waits until all accepted bytes are written to the file.
+     *
+     * \return Success or error code of the background writes.
+     */
+    Result<void> flush() noexcept;
+
+    /**
+     * Writes the remaining bytes, stops the background thread and closes the file.
+     *
+     * Nothing can be written after closing, further writes fail with StreamClosed.
+     *
+     * \return Success or error code.
+     */
+    Result<void> close() noexcept;
+
+private:
+    struct State;
+
+    explicit AsyncFileByteSink(std::unique_ptr<State>&& state) noexcept;
+
+    std::unique_ptr<State> m_state;
+};
+
+} // namespace zserio
+
+#endif // ZSERIO_ASYNC_FILE_BYTE_SINK_H_INC
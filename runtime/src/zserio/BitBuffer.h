@@ -295,7 +295,8 @@ Result<BasicBitBuffer<ALLOC>> BasicBitBuffer<ALLOC>::fromSpan(Span<const uint8_t
 template <typename ALLOC>
 Result<BasicBitBuffer<ALLOC>> BasicBitBuffer<ALLOC>::fromVector(vector<uint8_t, ALLOC>&& buffer) noexcept
 {
-    BasicBitBuffer<ALLOC> bitBuffer;
+    // the allocator of the vector is kept, thus its storage is taken over
+    BasicBitBuffer<ALLOC> bitBuffer(buffer.get_allocator());
     bitBuffer.m_buffer = std::move(buffer);
     bitBuffer.m_bitSize = 8 * bitBuffer.m_buffer.size();
     return Result<BasicBitBuffer<ALLOC>>::success(std::move(bitBuffer));
@@ -310,7 +311,8 @@ Result<BasicBitBuffer<ALLOC>> BasicBitBuffer<ALLOC>::fromVector(vector<uint8_t,
         return Result<BasicBitBuffer<ALLOC>>::error(ErrorCode::WrongBufferBitSize);
     }
     
-    BasicBitBuffer<ALLOC> bitBuffer;
+    // the allocator of the vector is kept, thus its storage is taken over
+    BasicBitBuffer<ALLOC> bitBuffer(buffer.get_allocator());
     bitBuffer.m_buffer = std::move(buffer);
     bitBuffer.m_bitSize = bitSize;
     return Result<BasicBitBuffer<ALLOC>>::success(std::move(bitBuffer));
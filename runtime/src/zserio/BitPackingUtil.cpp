@@ -0,0 +1,696 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#include "zserio/BitPackingUtil.h"
+
+#if !defined(ZSERIO_RUNTIME_SIMD_DISABLED) && \
+        (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#if defined(__GNUC__) || defined(__clang__)
+#define ZSERIO_SIMD_X86
+#define ZSERIO_SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER)
+#define ZSERIO_SIMD_X86
+#define ZSERIO_SIMD_TARGET(isa)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#endif
+
+namespace zserio
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// SIMD unpacking of 32-bit lanes loads 4 bytes per field, thus the field must fit into 4 bytes at any bit offset
+const uint8_t MAX_SIMD_UNPACK32_BITS = 25;
+// SIMD unpacking of 64-bit lanes loads 8 bytes per field, thus the field must fit into 8 bytes at any bit offset
+const uint8_t MAX_SIMD_UNPACK64_BITS = 57;
+// SIMD packing merges pairs of fields, the merged pair must fit into a single 32-bit append
+const uint8_t MAX_SIMD_PACK32_BITS = 16;
+
+inline uint64_t loadBigEndian64(const uint8_t* src)
+{
+    return static_cast<uint64_t>(src[0]) << 56U | static_cast<uint64_t>(src[1]) << 48U |
+            static_cast<uint64_t>(src[2]) << 40U | static_cast<uint64_t>(src[3]) << 32U |
+            static_cast<uint64_t>(src[4]) << 24U | static_cast<uint64_t>(src[5]) << 16U |
+            static_cast<uint64_t>(src[6]) << 8U | static_cast<uint64_t>(src[7]);
+}
+
+inline void storeBigEndian64(uint8_t* dst, uint64_t value)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        dst[i] = static_cast<uint8_t>(value >> (56U - 8U * i));
+    }
+}
+
+inline uint64_t loadBigEndian64Partial(const uint8_t* src, size_t numBytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < numBytes && i < 8; ++i)
+    {
+        value |= static_cast<uint64_t>(src[i]) << (56U - 8U * i);
+    }
+    return value;
+}
+
+/** Extracts a single big-endian field of 1 - 64 bits without touching bytes behind srcByteSize. */
+inline uint64_t extractBits(const uint8_t* src, size_t srcByteSize, size_t bitPosition, uint8_t numBits)
+{
+    const size_t byteIndex = bitPosition >> 3U;
+    const uint8_t shift = static_cast<uint8_t>(bitPosition & 0x07U);
+    const size_t availableBytes = srcByteSize - byteIndex;
+    uint64_t window = (availableBytes >= 8) ? loadBigEndian64(src + byteIndex)
+                                            : loadBigEndian64Partial(src + byteIndex, availableBytes);
+    window <<= shift;
+    if (shift + numBits > 64)
+    {
+        // 9th byte is needed only for wide fields which do not start at a byte boundary
+        window |= static_cast<uint64_t>(src[byteIndex + 8] >> (8U - shift));
+    }
+
+    return window >> (64U - numBits);
+}
+
+template <typename T>
+void unpackBitsScalar(
+        const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, T* dst, size_t count)
+{
+    if (numBits == 0)
+    {
+        std::fill(dst, dst + count, static_cast<T>(0));
+        return;
+    }
+
+    size_t bitPosition = bitOffset;
+    for (size_t i = 0; i < count; ++i)
+    {
+        dst[i] = static_cast<T>(extractBits(src, srcByteSize, bitPosition, numBits));
+        bitPosition += numBits;
+    }
+}
+
+template <typename T>
+void loadBigEndianScalar(const uint8_t* src, T* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        T value = 0;
+        for (size_t byte = 0; byte < sizeof(T); ++byte)
+        {
+            value = static_cast<T>((value << 8U) | src[i * sizeof(T) + byte]);
+        }
+        dst[i] = value;
+    }
+}
+
+template <typename T>
+void storeBigEndianScalar(uint8_t* dst, const T* src, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (size_t byte = 0; byte < sizeof(T); ++byte)
+        {
+            dst[i * sizeof(T) + byte] = static_cast<uint8_t>(src[i] >> (8U * (sizeof(T) - 1 - byte)));
+        }
+    }
+}
+
+/**
+ * Appends big-endian bit fields to the destination buffer.
+ *
+ * Whole 32-bit words are stored at once, bits of the destination outside of the written run are preserved.
+ */
+class BitAccumulator
+{
+public:
+    BitAccumulator(uint8_t* dst, size_t bitOffset) :
+            m_out(dst + bitOffset / 8),
+            m_value(0),
+            m_numBits(static_cast<uint8_t>(bitOffset % 8))
+    {
+        if (m_numBits != 0)
+        {
+            // keep bits which are already written in the first byte
+            m_value = static_cast<uint64_t>(*m_out >> (8U - m_numBits));
+        }
+    }
+
+    /** Appends 1 - 32 bits. */
+    void append(uint64_t bits, uint8_t numBits)
+    {
+        m_value = (m_value << numBits) | bits;
+        m_numBits = static_cast<uint8_t>(m_numBits + numBits);
+        if (m_numBits >= 32)
+        {
+            m_numBits = static_cast<uint8_t>(m_numBits - 32);
+            const uint32_t word = static_cast<uint32_t>(m_value >> m_numBits);
+            m_out[0] = static_cast<uint8_t>(word >> 24U);
+            m_out[1] = static_cast<uint8_t>(word >> 16U);
+            m_out[2] = static_cast<uint8_t>(word >> 8U);
+            m_out[3] = static_cast<uint8_t>(word);
+            m_out += 4;
+        }
+    }
+
+    /** Appends 1 - 64 bits. */
+    void appendWide(uint64_t bits, uint8_t numBits)
+    {
+        if (numBits > 32)
+        {
+            append(bits >> 32U, static_cast<uint8_t>(numBits - 32));
+            append(bits & UINT64_C(0xFFFFFFFF), 32);
+        }
+        else
+        {
+            append(bits, numBits);
+        }
+    }
+
+    /** Flushes remaining bits. */
+    void finish()
+    {
+        while (m_numBits >= 8)
+        {
+            m_numBits = static_cast<uint8_t>(m_numBits - 8);
+            *m_out++ = static_cast<uint8_t>(m_value >> m_numBits);
+        }
+
+        if (m_numBits != 0)
+        {
+            // keep bits which follow the written run in the last byte
+            const uint8_t keptBits = static_cast<uint8_t>(*m_out & (0xFFU >> m_numBits));
+            *m_out = static_cast<uint8_t>((m_value << (8U - m_numBits)) | keptBits);
+        }
+    }
+
+private:
+    uint8_t* m_out;
+    uint64_t m_value;
+    uint8_t m_numBits;
+};
+
+#ifdef ZSERIO_SIMD_X86
+/**
+ * Layout of a group of 8 fields which always occupies exactly numBits bytes.
+ *
+ * Fields 0 - 3 are loaded from the group start, fields 4 - 7 from the byte where the field 4 starts.
+ */
+struct GroupLayout
+{
+    GroupLayout(size_t bitOffset, uint8_t numBits)
+    {
+        const size_t startBit = bitOffset & 0x07U;
+        secondHalfByte = static_cast<uint32_t>((startBit + 4U * numBits) >> 3U);
+        for (size_t j = 0; j < 8; ++j)
+        {
+            const size_t fieldBit = startBit + j * numBits;
+            const uint32_t fieldByte = static_cast<uint32_t>(fieldBit >> 3U);
+            const uint32_t halfByte = (j < 4) ? 0 : secondHalfByte;
+            byteOffsets[j] = static_cast<int32_t>(fieldByte);
+            shifts[j] = static_cast<uint32_t>(fieldBit & 0x07U);
+            multipliers[j] = UINT32_C(1) << shifts[j];
+            shifts64[j] = shifts[j];
+            // 4 big-endian bytes of the field go to a little-endian 32-bit lane
+            for (uint32_t byte = 0; byte < 4; ++byte)
+            {
+                shuffle[j * 4 + byte] = static_cast<uint8_t>(fieldByte - halfByte + 3 - byte);
+            }
+        }
+    }
+
+    alignas(32) uint8_t shuffle[32];
+    alignas(32) uint32_t shifts[8];
+    alignas(32) uint32_t multipliers[8];
+    alignas(32) uint64_t shifts64[8];
+    alignas(32) int32_t byteOffsets[8];
+    uint32_t secondHalfByte;
+};
+
+const std::array<uint8_t, 16> BSWAP16_MASK = {{1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14}};
+const std::array<uint8_t, 16> BSWAP32_MASK = {{3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12}};
+const std::array<uint8_t, 16> BSWAP64_MASK = {{7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8}};
+
+ZSERIO_SIMD_TARGET("avx2")
+size_t unpackBits32Avx2(
+        const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, uint32_t* dst, size_t count)
+{
+    const GroupLayout layout(bitOffset, numBits);
+    const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(layout.shuffle));
+    const __m256i shifts = _mm256_load_si256(reinterpret_cast<const __m256i*>(layout.shifts));
+    const __m128i rightShift = _mm_cvtsi32_si128(32 - numBits);
+
+    size_t i = 0;
+    size_t groupByte = bitOffset >> 3U;
+    while (i + 8 <= count && groupByte + layout.secondHalfByte + 16 <= srcByteSize)
+    {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + groupByte));
+        const __m128i high =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + groupByte + layout.secondHalfByte));
+        __m256i values = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        values = _mm256_shuffle_epi8(values, shuffle);
+        values = _mm256_sllv_epi32(values, shifts);
+        values = _mm256_srl_epi32(values, rightShift);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), values);
+
+        i += 8;
+        groupByte += numBits;
+    }
+
+    return i;
+}
+
+ZSERIO_SIMD_TARGET("sse4.1")
+size_t unpackBits32Sse41(
+        const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, uint32_t* dst, size_t count)
+{
+    const GroupLayout layout(bitOffset, numBits);
+    const __m128i shuffleLow = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.shuffle));
+    const __m128i shuffleHigh = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.shuffle + 16));
+    const __m128i multipliersLow = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.multipliers));
+    const __m128i multipliersHigh = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.multipliers + 4));
+    const __m128i rightShift = _mm_cvtsi32_si128(32 - numBits);
+
+    size_t i = 0;
+    size_t groupByte = bitOffset >> 3U;
+    while (i + 8 <= count && groupByte + layout.secondHalfByte + 16 <= srcByteSize)
+    {
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + groupByte));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + groupByte + layout.secondHalfByte));
+        // SSE4.1 has no variable shift, multiplication by power of two is used instead
+        low = _mm_srl_epi32(_mm_mullo_epi32(_mm_shuffle_epi8(low, shuffleLow), multipliersLow), rightShift);
+        high = _mm_srl_epi32(_mm_mullo_epi32(_mm_shuffle_epi8(high, shuffleHigh), multipliersHigh), rightShift);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 4), high);
+
+        i += 8;
+        groupByte += numBits;
+    }
+
+    return i;
+}
+
+ZSERIO_SIMD_TARGET("avx2")
+size_t unpackBits64Avx2(
+        const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, uint64_t* dst, size_t count)
+{
+    const GroupLayout layout(bitOffset, numBits);
+    const __m128i byteOffsetsLow = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.byteOffsets));
+    const __m128i byteOffsetsHigh = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.byteOffsets + 4));
+    const __m256i shiftsLow = _mm256_load_si256(reinterpret_cast<const __m256i*>(layout.shifts64));
+    const __m256i shiftsHigh = _mm256_load_si256(reinterpret_cast<const __m256i*>(layout.shifts64 + 4));
+    const __m256i byteSwap = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(BSWAP64_MASK.data())));
+    const __m128i rightShift = _mm_cvtsi32_si128(64 - numBits);
+    const size_t lastFieldByte = static_cast<size_t>(layout.byteOffsets[7]);
+
+    size_t i = 0;
+    size_t groupByte = bitOffset >> 3U;
+    while (i + 8 <= count && groupByte + lastFieldByte + 8 <= srcByteSize)
+    {
+        const long long* group = reinterpret_cast<const long long*>(src + groupByte);
+        __m256i low = _mm256_i32gather_epi64(group, byteOffsetsLow, 1);
+        __m256i high = _mm256_i32gather_epi64(group, byteOffsetsHigh, 1);
+        low = _mm256_srl_epi64(_mm256_sllv_epi64(_mm256_shuffle_epi8(low, byteSwap), shiftsLow), rightShift);
+        high = _mm256_srl_epi64(_mm256_sllv_epi64(_mm256_shuffle_epi8(high, byteSwap), shiftsHigh), rightShift);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 4), high);
+
+        i += 8;
+        groupByte += numBits;
+    }
+
+    return i;
+}
+
+ZSERIO_SIMD_TARGET("avx2")
+size_t packBits32Avx2(BitAccumulator& accumulator, uint8_t numBits, const uint32_t* src, size_t count)
+{
+    const __m128i shift = _mm_cvtsi32_si128(numBits);
+    const __m128i pairShift = _mm_cvtsi32_si128(2 * numBits);
+    const __m256i lowMask = _mm256_set1_epi64x(static_cast<long long>(UINT64_C(0xFFFFFFFF)));
+    alignas(32) uint64_t merged[4];
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // each 64-bit lane holds two consecutive values, merge them into a single field of 2 * numBits
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i first = _mm256_and_si256(values, lowMask);
+        const __m256i second = _mm256_srli_epi64(values, 32);
+        __m256i pairs = _mm256_or_si256(_mm256_sll_epi64(first, shift), second);
+        if (numBits <= MAX_SIMD_PACK32_BITS / 2)
+        {
+            // merge neighbouring pairs as well, lanes 0 and 2 hold fields of 4 * numBits
+            pairs = _mm256_or_si256(_mm256_sll_epi64(pairs, pairShift), _mm256_srli_si256(pairs, 8));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(merged), pairs);
+            accumulator.append(merged[0], static_cast<uint8_t>(4 * numBits));
+            accumulator.append(merged[2], static_cast<uint8_t>(4 * numBits));
+        }
+        else
+        {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(merged), pairs);
+            for (size_t k = 0; k < 4; ++k)
+            {
+                accumulator.append(merged[k], static_cast<uint8_t>(2 * numBits));
+            }
+        }
+    }
+
+    return i;
+}
+
+ZSERIO_SIMD_TARGET("sse4.1")
+size_t packBits32Sse41(BitAccumulator& accumulator, uint8_t numBits, const uint32_t* src, size_t count)
+{
+    const __m128i shift = _mm_cvtsi32_si128(numBits);
+    const __m128i lowMask = _mm_set1_epi64x(static_cast<long long>(UINT64_C(0xFFFFFFFF)));
+    alignas(16) uint64_t merged[2];
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // each 64-bit lane holds two consecutive values, merge them into a single field of 2 * numBits
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i first = _mm_and_si128(values, lowMask);
+        const __m128i second = _mm_srli_epi64(values, 32);
+        _mm_store_si128(reinterpret_cast<__m128i*>(merged), _mm_or_si128(_mm_sll_epi64(first, shift), second));
+        accumulator.append(merged[0], static_cast<uint8_t>(2 * numBits));
+        accumulator.append(merged[1], static_cast<uint8_t>(2 * numBits));
+    }
+
+    return i;
+}
+
+ZSERIO_SIMD_TARGET("avx2")
+size_t swapBytesAvx2(const uint8_t* src, uint8_t* dst, size_t numBytes, const std::array<uint8_t, 16>& mask)
+{
+    const __m256i byteSwap =
+            _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data())));
+
+    size_t i = 0;
+    for (; i + 32 <= numBytes; i += 32)
+    {
+        const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(values, byteSwap));
+    }
+
+    return i;
+}
+
+ZSERIO_SIMD_TARGET("sse4.1")
+size_t swapBytesSse41(const uint8_t* src, uint8_t* dst, size_t numBytes, const std::array<uint8_t, 16>& mask)
+{
+    const __m128i byteSwap = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data()));
+
+    size_t i = 0;
+    for (; i + 16 <= numBytes; i += 16)
+    {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(values, byteSwap));
+    }
+
+    return i;
+}
+
+/** Swaps bytes of the leading part of the run, returns number of processed values. */
+template <typename T>
+size_t swapBytesSimd(const uint8_t* src, uint8_t* dst, size_t count, const std::array<uint8_t, 16>& mask)
+{
+    switch (getSimdLevel())
+    {
+    case SimdLevel::AVX2:
+        return swapBytesAvx2(src, dst, count * sizeof(T), mask) / sizeof(T);
+    case SimdLevel::SSE41:
+        return swapBytesSse41(src, dst, count * sizeof(T), mask) / sizeof(T);
+    default:
+        return 0;
+    }
+}
+#endif
+
+SimdLevel detectSimdLevel()
+{
+#ifdef ZSERIO_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool hasSse41 = (info[2] & (1 << 19)) != 0;
+    const bool hasOsXsave = (info[2] & (1 << 27)) != 0;
+    const bool hasAvx = (info[2] & (1 << 28)) != 0;
+    bool hasAvx2 = false;
+    // AVX state must be enabled by the operating system
+    if (maxLeaf >= 7 && hasOsXsave && hasAvx && (_xgetbv(0) & 0x06U) == 0x06U)
+    {
+        __cpuidex(info, 7, 0);
+        hasAvx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool hasSse41 = __builtin_cpu_supports("sse4.1") != 0;
+    const bool hasAvx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+    if (hasAvx2)
+    {
+        return SimdLevel::AVX2;
+    }
+    if (hasSse41)
+    {
+        return SimdLevel::SSE41;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel getSupportedSimdLevel()
+{
+    static const SimdLevel supportedLevel = detectSimdLevel();
+    return supportedLevel;
+}
+
+std::atomic<SimdLevel>& getSimdLevelStorage()
+{
+    static std::atomic<SimdLevel> level(getSupportedSimdLevel());
+    return level;
+}
+
+} // namespace
+
+SimdLevel getSimdLevel() noexcept
+{
+    return getSimdLevelStorage().load(std::memory_order_relaxed);
+}
+
+SimdLevel setSimdLevel(SimdLevel level) noexcept
+{
+    const SimdLevel supportedLevel = getSupportedSimdLevel();
+    const SimdLevel newLevel = (static_cast<uint8_t>(level) > static_cast<uint8_t>(supportedLevel))
+            ? supportedLevel
+            : level;
+    return getSimdLevelStorage().exchange(newLevel, std::memory_order_relaxed);
+}
+
+void unpackBits(const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, uint32_t* dst,
+        size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    if (numBits != 0 && numBits <= MAX_SIMD_UNPACK32_BITS)
+    {
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX2:
+            done = unpackBits32Avx2(src, srcByteSize, bitOffset, numBits, dst, count);
+            break;
+        case SimdLevel::SSE41:
+            done = unpackBits32Sse41(src, srcByteSize, bitOffset, numBits, dst, count);
+            break;
+        default:
+            break;
+        }
+    }
+#endif
+    unpackBitsScalar(src, srcByteSize, bitOffset + done * numBits, numBits, dst + done, count - done);
+}
+
+void unpackBits(const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, uint64_t* dst,
+        size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    if (numBits != 0 && numBits <= MAX_SIMD_UNPACK64_BITS && getSimdLevel() == SimdLevel::AVX2)
+    {
+        done = unpackBits64Avx2(src, srcByteSize, bitOffset, numBits, dst, count);
+    }
+#endif
+    unpackBitsScalar(src, srcByteSize, bitOffset + done * numBits, numBits, dst + done, count - done);
+}
+
+void packBits(uint8_t* dst, size_t bitOffset, uint8_t numBits, const uint32_t* src, size_t count) noexcept
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    BitAccumulator accumulator(dst, bitOffset);
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    if (numBits <= MAX_SIMD_PACK32_BITS)
+    {
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX2:
+            done = packBits32Avx2(accumulator, numBits, src, count);
+            break;
+        case SimdLevel::SSE41:
+            done = packBits32Sse41(accumulator, numBits, src, count);
+            break;
+        default:
+            break;
+        }
+    }
+#endif
+    for (size_t i = done; i < count; ++i)
+    {
+        accumulator.append(src[i], numBits);
+    }
+    accumulator.finish();
+}
+
+void packBits(uint8_t* dst, size_t bitOffset, uint8_t numBits, const uint64_t* src, size_t count) noexcept
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    BitAccumulator accumulator(dst, bitOffset);
+    for (size_t i = 0; i < count; ++i)
+    {
+        accumulator.appendWide(src[i], numBits);
+    }
+    accumulator.finish();
+}
+
+void unpackBytes(const uint8_t* src, uint8_t bitOffset, uint8_t* dst, size_t count) noexcept
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (bitOffset == 0)
+    {
+        (void)std::memcpy(dst, src, count);
+        return;
+    }
+
+    const uint8_t rightShift = static_cast<uint8_t>(8U - bitOffset);
+    size_t i = 0;
+    // the run spans count + 1 source bytes, thus the second load never reads behind the run
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint64_t value = loadBigEndian64(src + i) << bitOffset | loadBigEndian64(src + i + 1) >> rightShift;
+        storeBigEndian64(dst + i, value);
+    }
+    for (; i < count; ++i)
+    {
+        dst[i] = static_cast<uint8_t>(src[i] << bitOffset | src[i + 1] >> rightShift);
+    }
+}
+
+void packBytes(uint8_t* dst, uint8_t bitOffset, const uint8_t* src, size_t count) noexcept
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (bitOffset == 0)
+    {
+        (void)std::memcpy(dst, src, count);
+        return;
+    }
+
+    // destination byte i + 1 merges low bits of source byte i with high bits of source byte i + 1
+    const uint8_t leftShift = static_cast<uint8_t>(8U - bitOffset);
+    const uint8_t headMask = static_cast<uint8_t>(0xFFU << leftShift);
+    dst[0] = static_cast<uint8_t>((dst[0] & headMask) | src[0] >> bitOffset);
+    size_t i = 1;
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint64_t value = loadBigEndian64(src + i - 1) << leftShift | loadBigEndian64(src + i) >> bitOffset;
+        storeBigEndian64(dst + i, value);
+    }
+    for (; i < count; ++i)
+    {
+        dst[i] = static_cast<uint8_t>(src[i - 1] << leftShift | src[i] >> bitOffset);
+    }
+    dst[count] = static_cast<uint8_t>(src[count - 1] << leftShift | (dst[count] & ~headMask));
+}
+
+void loadBigEndian(const uint8_t* src, uint16_t* dst, size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    done = swapBytesSimd<uint16_t>(src, reinterpret_cast<uint8_t*>(dst), count, BSWAP16_MASK);
+#endif
+    loadBigEndianScalar(src + done * sizeof(uint16_t), dst + done, count - done);
+}
+
+void loadBigEndian(const uint8_t* src, uint32_t* dst, size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    done = swapBytesSimd<uint32_t>(src, reinterpret_cast<uint8_t*>(dst), count, BSWAP32_MASK);
+#endif
+    loadBigEndianScalar(src + done * sizeof(uint32_t), dst + done, count - done);
+}
+
+void loadBigEndian(const uint8_t* src, uint64_t* dst, size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    done = swapBytesSimd<uint64_t>(src, reinterpret_cast<uint8_t*>(dst), count, BSWAP64_MASK);
+#endif
+    loadBigEndianScalar(src + done * sizeof(uint64_t), dst + done, count - done);
+}
+
+void storeBigEndian(uint8_t* dst, const uint16_t* src, size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    done = swapBytesSimd<uint16_t>(reinterpret_cast<const uint8_t*>(src), dst, count, BSWAP16_MASK);
+#endif
+    storeBigEndianScalar(dst + done * sizeof(uint16_t), src + done, count - done);
+}
+
+void storeBigEndian(uint8_t* dst, const uint32_t* src, size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    done = swapBytesSimd<uint32_t>(reinterpret_cast<const uint8_t*>(src), dst, count, BSWAP32_MASK);
+#endif
+    storeBigEndianScalar(dst + done * sizeof(uint32_t), src + done, count - done);
+}
+
+void storeBigEndian(uint8_t* dst, const uint64_t* src, size_t count) noexcept
+{
+    size_t done = 0;
+#ifdef ZSERIO_SIMD_X86
+    done = swapBytesSimd<uint64_t>(reinterpret_cast<const uint8_t*>(src), dst, count, BSWAP64_MASK);
+#endif
+    storeBigEndianScalar(dst + done * sizeof(uint64_t), src + done, count - done);
+}
+
+} // namespace detail
+
+} // namespace zserio
@@ -0,0 +1,158 @@
+#ifndef ZSERIO_BIT_PACKING_UTIL_H_INC
+#define ZSERIO_BIT_PACKING_UTIL_H_INC
+
+#include <cstddef>
+
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+namespace detail
+{
+
+/**
+ * Instruction set used by the bit packing kernels.
+ */
+enum class SimdLevel : uint8_t
+{
+    SCALAR, /**< Portable scalar kernels. */
+    SSE41, /**< x86 SSE4.1 kernels. */
+    AVX2 /**< x86 AVX2 kernels. */
+};
+
+/**
+ * Gets the instruction set used by the bit packing kernels.
+ *
+ * The best instruction set supported by the running CPU is detected on the first call. SIMD kernels are never
+ * used when the runtime is built with ZSERIO_RUNTIME_SIMD_DISABLED.
+ *
+ * \return Instruction set currently in use.
+ */
+SimdLevel getSimdLevel() noexcept;
+
+/**
+ * Sets the instruction set used by the bit packing kernels.
+ *
+ * Intended for tests and benchmarks. Levels not supported by the running CPU are lowered to the best supported
+ * one.
+ *
+ * \param level Requested instruction set.
+ *
+ * \return Previously used instruction set.
+ */
+SimdLevel setSimdLevel(SimdLevel level) noexcept;
+
+/**
+ * Unpacks a run of big-endian bit fields into 32-bit lanes.
+ *
+ * The source must contain all (bitOffset + count * numBits + 7) / 8 bytes of the run, no byte behind
+ * srcByteSize is ever touched.
+ *
+ * \param src Source buffer.
+ * \param srcByteSize Number of readable bytes in the source buffer.
+ * \param bitOffset Bit offset of the first field in the source buffer.
+ * \param numBits Number of bits of each field (0 - 32).
+ * \param dst Destination values.
+ * \param count Number of fields to unpack.
+ */
+void unpackBits(const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, uint32_t* dst,
+        size_t count) noexcept;
+
+/**
+ * Unpacks a run of big-endian bit fields into 64-bit lanes.
+ *
+ * The source must contain all (bitOffset + count * numBits + 7) / 8 bytes of the run, no byte behind
+ * srcByteSize is ever touched.
+ *
+ * \param src Source buffer.
+ * \param srcByteSize Number of readable bytes in the source buffer.
+ * \param bitOffset Bit offset of the first field in the source buffer.
+ * \param numBits Number of bits of each field (0 - 64).
+ * \param dst Destination values.
+ * \param count Number of fields to unpack.
+ */
+void unpackBits(const uint8_t* src, size_t srcByteSize, size_t bitOffset, uint8_t numBits, uint64_t* dst,
+        size_t count) noexcept;
+
+/**
+ * Packs 32-bit lanes into a run of big-endian bit fields.
+ *
+ * Bits of the destination outside of the run are preserved. Values must already fit into numBits bits.
+ *
+ * \param dst Destination buffer large enough for the whole run.
+ * \param bitOffset Bit offset of the first field in the destination buffer.
+ * \param numBits Number of bits of each field (1 - 32).
+ * \param src Values to pack.
+ * \param count Number of values to pack.
+ */
+void packBits(uint8_t* dst, size_t bitOffset, uint8_t numBits, const uint32_t* src, size_t count) noexcept;
+
+/**
+ * Packs 64-bit lanes into a run of big-endian bit fields.
+ *
+ * Bits of the destination outside of the run are preserved. Values must already fit into numBits bits.
+ *
+ * \param dst Destination buffer large enough for the whole run.
+ * \param bitOffset Bit offset of the first field in the destination buffer.
+ * \param numBits Number of bits of each field (1 - 64).
+ * \param src Values to pack.
+ * \param count Number of values to pack.
+ */
+void packBits(uint8_t* dst, size_t bitOffset, uint8_t numBits, const uint64_t* src, size_t count) noexcept;
+
+/**
+ * Copies bytes which start at an arbitrary bit offset of the source buffer.
+ *
+ * Eight bytes are shifted and merged per iteration.
+ *
+ * \param src Source buffer containing all (bitOffset + count * 8 + 7) / 8 bytes of the run.
+ * \param bitOffset Bit offset of the first byte in the source buffer (0 - 7).
+ * \param dst Destination bytes.
+ * \param count Number of bytes to copy.
+ */
+void unpackBytes(const uint8_t* src, uint8_t bitOffset, uint8_t* dst, size_t count) noexcept;
+
+/**
+ * Copies bytes to an arbitrary bit offset of the destination buffer.
+ *
+ * Eight bytes are shifted and merged per iteration. Bits of the destination outside of the run are preserved.
+ *
+ * \param dst Destination buffer containing all (bitOffset + count * 8 + 7) / 8 bytes of the run.
+ * \param bitOffset Bit offset of the first byte in the destination buffer (0 - 7).
+ * \param src Source bytes.
+ * \param count Number of bytes to copy.
+ */
+void packBytes(uint8_t* dst, uint8_t bitOffset, const uint8_t* src, size_t count) noexcept;
+
+/**
+ * Loads byte aligned big-endian values.
+ *
+ * \param src Source buffer containing count * sizeof(value) bytes.
+ * \param dst Destination values.
+ * \param count Number of values to load.
+ * \{
+ */
+void loadBigEndian(const uint8_t* src, uint16_t* dst, size_t count) noexcept;
+void loadBigEndian(const uint8_t* src, uint32_t* dst, size_t count) noexcept;
+void loadBigEndian(const uint8_t* src, uint64_t* dst, size_t count) noexcept;
+/** \} */
+
+/**
+ * Stores values as byte aligned big-endian values.
+ *
+ * \param dst Destination buffer large enough for count * sizeof(value) bytes.
+ * \param src Values to store.
+ * \param count Number of values to store.
+ * \{
+ */
+void storeBigEndian(uint8_t* dst, const uint16_t* src, size_t count) noexcept;
+void storeBigEndian(uint8_t* dst, const uint32_t* src, size_t count) noexcept;
+void storeBigEndian(uint8_t* dst, const uint64_t* src, size_t count) noexcept;
+/** \} */
+
+} // namespace detail
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_BIT_PACKING_UTIL_H_INC
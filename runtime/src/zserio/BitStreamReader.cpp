@@ -1,10 +1,32 @@
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
+#include "zserio/BitPackingUtil.h"
 #include "zserio/BitStreamReader.h"
 #include "zserio/FloatUtil.h"
 #include "zserio/RuntimeArch.h"
 
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+// reads of windowed readers are kept out of line and cold, so that they neither grow the fast paths of plain
+// readers nor use up the inlining budget of this unit, which the unchecked cache read needs in every fast path
+#if defined(__GNUC__) || defined(__clang__)
+#define ZSERIO_ALWAYS_INLINE inline __attribute__((always_inline))
+#define ZSERIO_COLD __attribute__((noinline, cold))
+#elif defined(_MSC_VER)
+#define ZSERIO_ALWAYS_INLINE __forceinline
+#define ZSERIO_COLD __declspec(noinline)
+#else
+#define ZSERIO_ALWAYS_INLINE inline
+#define ZSERIO_COLD
+#endif
+
 namespace zserio
 {
 
@@ -143,6 +165,11 @@ const uint8_t VARUINT_HAS_NEXT = UINT8_C(0x80);
 
 const uint32_t VARSIZE_MAX_VALUE = (UINT32_C(1) << 31U) - 1;
 
+// shorter arrays are read value by value, setup of the unpacking kernels would not pay off
+const size_t MIN_UNPACK_ARRAY_SIZE = 16;
+// number of values unpacked at once when the destination is narrower than 32 bits
+const size_t UNPACK_BLOCK_SIZE = 64;
+
 #ifdef ZSERIO_RUNTIME_64BIT
 inline BaseType parse64(Span<const uint8_t>::const_iterator bufferIt)
 {
@@ -196,8 +223,60 @@ inline BaseType parse8(Span<const uint8_t>::const_iterator bufferIt)
     return static_cast<BaseType>(*bufferIt);
 }
 
-// Note: Exception throwing functions removed - all validation is now done in public methods
-// that return Result<T>. The internal readBitsImpl is only called after validation.
+/** Loads a whole big-endian cache word by a single unaligned load and a byte swap. */
+inline BaseType loadCacheWord(Span<const uint8_t>::const_iterator bufferIt)
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    BaseType word;
+    (void)std::memcpy(&word, bufferIt, sizeof(word));
+#ifdef ZSERIO_RUNTIME_64BIT
+    return __builtin_bswap64(word);
+#else
+    return __builtin_bswap32(word);
+#endif
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    BaseType word;
+    (void)std::memcpy(&word, bufferIt, sizeof(word));
+    return word;
+#elif defined(_MSC_VER)
+    // all platforms supported by MSVC are little endian
+    BaseType word;
+    (void)std::memcpy(&word, bufferIt, sizeof(word));
+#ifdef ZSERIO_RUNTIME_64BIT
+    return _byteswap_uint64(word);
+#else
+    return _byteswap_ulong(word);
+#endif
+#elif defined(ZSERIO_RUNTIME_64BIT)
+    return parse64(bufferIt);
+#else
+    return parse32(bufferIt);
+#endif
+}
+
+/**
+ * Validates the buffer once when the reader is constructed. Read methods then only check the end of stream.
+ */
+inline ErrorCode validateBuffer(Span<const uint8_t> buffer, size_t bufferBitSize)
+{
+    if (buffer.size() > MAX_BUFFER_SIZE)
+    {
+        return ErrorCode::BufferSizeExceeded;
+    }
+
+    if (buffer.size() < (bufferBitSize + 7) / 8)
+    {
+        return ErrorCode::WrongBufferBitSize;
+    }
+
+    return ErrorCode::Success;
+}
+
+/** Error to report when a read does not fit into the buffer (invalid buffer is reported as empty). */
+inline ErrorCode endOfStreamError(const ReaderContext& ctx)
+{
+    return (ctx.bufferError != ErrorCode::Success) ? ctx.bufferError : ErrorCode::EndOfStream;
+}
 
 /** Loads next 32/64 bits to 32/64 bit-cache. */
 inline void loadCacheNext(ReaderContext& ctx, uint8_t numBits)
@@ -208,16 +287,13 @@ inline void loadCacheNext(ReaderContext& ctx, uint8_t numBits)
     const size_t byteIndex = ctx.bitIndex >> 3U;
     if (ctx.bufferBitSize >= ctx.bitIndex + cacheBitSize)
     {
-        ctx.cache =
-#ifdef ZSERIO_RUNTIME_64BIT
-                parse64(ctx.buffer.begin() + byteIndex);
-#else
-                parse32(ctx.buffer.begin() + byteIndex);
-#endif
+        ctx.cache = loadCacheWord(ctx.buffer.begin() + byteIndex);
         ctx.cacheNumBits = cacheBitSize;
     }
     else
     {
+        // only the tail of the buffer is loaded byte by byte
+
         // This should never happen as we validate in public methods
         // In debug builds, we could assert here
         // assert(ctx.bitIndex + numBits <= ctx.bufferBitSize);
@@ -262,7 +338,7 @@ inline void loadCacheNext(ReaderContext& ctx, uint8_t numBits)
 }
 
 /** Unchecked implementation of readBits. */
-inline BaseType readBitsImpl(ReaderContext& ctx, uint8_t numBits)
+ZSERIO_ALWAYS_INLINE BaseType readBitsImpl(ReaderContext& ctx, uint8_t numBits)
 {
     BaseType value = 0;
     if (ctx.cacheNumBits < numBits)
@@ -321,52 +397,751 @@ inline uint64_t readBits64Impl(ReaderContext& ctx, uint8_t numBits)
 
     return value;
 }
+
+/** Unchecked implementation of readSignedBits64. Always reads > 32bit! */
+inline int64_t readSignedBits64Impl(ReaderContext& ctx, uint8_t numBits)
+{
+    int64_t value = static_cast<int64_t>(readBits64Impl(ctx, numBits));
+
+    // Skip the signed overflow correction if numBits == 64.
+    // In that case, the value that comes out the readBits function
+    // is already correct.
+    const bool needsSignExtension =
+            numBits < 64 && (static_cast<uint64_t>(value) >= (UINT64_C(1) << (numBits - 1)));
+    if (needsSignExtension)
+    {
+        value = static_cast<int64_t>(static_cast<uint64_t>(value) - (UINT64_C(1) << numBits));
+    }
+
+    return value;
+}
 #endif
 
+/** Checks that the whole run of values of numBits bits each fits into the stream. */
+template <typename T>
+inline ErrorCode checkBitsArray(const ReaderContext& ctx, Span<T> values, uint8_t numBits)
+{
+    if (numBits > sizeof(T) * 8)
+    {
+        return ErrorCode::InvalidNumBits;
+    }
+
+    // division prevents overflow of values.size() * numBits
+    if (numBits != 0 && values.size() > (ctx.bufferBitSize - ctx.bitIndex) / numBits)
+    {
+        return endOfStreamError(ctx);
+    }
+
+    return ErrorCode::Success;
+}
+
+/** Moves the reader to the given position which must lie within the buffer. */
+inline void seekImpl(ReaderContext& ctx, BitPosType position)
+{
+    ctx.bitIndex = position & ~static_cast<BitPosType>(0x07U);
+    ctx.cacheNumBits = 0;
+    const uint8_t skip = static_cast<uint8_t>(position & 0x07U);
+    if (skip != 0)
+    {
+        (void)readBitsImpl(ctx, skip);
+    }
+}
+
+/** Unpacks values which are narrower than 32 bits through a block of 32-bit lanes. */
+template <typename T>
+inline void unpackNarrowValues(const ReaderContext& ctx, BitPosType position, uint8_t numBits, T* values,
+        size_t count)
+{
+    std::array<uint32_t, UNPACK_BLOCK_SIZE> block;
+    while (count > 0)
+    {
+        const size_t blockCount = std::min(count, UNPACK_BLOCK_SIZE);
+        detail::unpackBits(ctx.buffer.data(), ctx.buffer.size(), position, numBits, block.data(), blockCount);
+        for (size_t i = 0; i < blockCount; ++i)
+        {
+            values[i] = static_cast<T>(block[i]);
+        }
+        position += blockCount * numBits;
+        values += blockCount;
+        count -= blockCount;
+    }
+}
+
+inline void unpackValues(const ReaderContext& ctx, BitPosType position, uint8_t numBits, uint8_t* values,
+        size_t count)
+{
+    if (numBits == 8 && (position & 0x07U) == 0)
+    {
+        std::memcpy(values, ctx.buffer.data() + position / 8, count);
+    }
+    else
+    {
+        unpackNarrowValues(ctx, position, numBits, values, count);
+    }
+}
+
+inline void unpackValues(const ReaderContext& ctx, BitPosType position, uint8_t numBits, uint16_t* values,
+        size_t count)
+{
+    if (numBits == 16 && (position & 0x07U) == 0)
+    {
+        detail::loadBigEndian(ctx.buffer.data() + position / 8, values, count);
+    }
+    else
+    {
+        unpackNarrowValues(ctx, position, numBits, values, count);
+    }
+}
+
+inline void unpackValues(const ReaderContext& ctx, BitPosType position, uint8_t numBits, uint32_t* values,
+        size_t count)
+{
+    if (numBits == 32 && (position & 0x07U) == 0)
+    {
+        detail::loadBigEndian(ctx.buffer.data() + position / 8, values, count);
+    }
+    else
+    {
+        detail::unpackBits(ctx.buffer.data(), ctx.buffer.size(), position, numBits, values, count);
+    }
+}
+
+inline void unpackValues(const ReaderContext& ctx, BitPosType position, uint8_t numBits, uint64_t* values,
+        size_t count)
+{
+    if (numBits == 64 && (position & 0x07U) == 0)
+    {
+        detail::loadBigEndian(ctx.buffer.data() + position / 8, values, count);
+    }
+    else
+    {
+        detail::unpackBits(ctx.buffer.data(), ctx.buffer.size(), position, numBits, values, count);
+    }
+}
+
+/** Unpacks the whole run of unsigned values directly from the buffer bypassing the cache. */
+template <typename T>
+inline void unpackBitsArray(ReaderContext& ctx, Span<T> values, uint8_t numBits)
+{
+    const BitPosType position = ctx.bitIndex;
+    unpackValues(ctx, position, numBits, values.data(), values.size());
+    seekImpl(ctx, position + values.size() * numBits);
+}
+
+/** Unpacks the whole run of signed values directly from the buffer bypassing the cache. */
+template <typename T>
+inline void unpackSignedBitsArray(ReaderContext& ctx, Span<T> values, uint8_t numBits)
+{
+    // signed and unsigned variants of the same type may alias each other
+    using UnsignedType = typename std::make_unsigned<T>::type;
+    UnsignedType* unsignedValues = reinterpret_cast<UnsignedType*>(values.data());
+    const BitPosType position = ctx.bitIndex;
+    unpackValues(ctx, position, numBits, unsignedValues, values.size());
+    seekImpl(ctx, position + values.size() * numBits);
+
+    if (numBits != 0 && numBits < sizeof(T) * 8)
+    {
+        const UnsignedType signBit = static_cast<UnsignedType>(static_cast<UnsignedType>(1) << (numBits - 1));
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            unsignedValues[i] = static_cast<UnsignedType>((unsignedValues[i] ^ signBit) - signBit);
+        }
+    }
+}
+
+/** Unchecked implementation of readBitsArray. */
+template <typename T>
+inline void readBitsArrayImpl(ReaderContext& ctx, Span<T> values, uint8_t numBits)
+{
+    if (values.size() >= MIN_UNPACK_ARRAY_SIZE)
+    {
+        unpackBitsArray(ctx, values, numBits);
+        return;
+    }
+
+    for (T& value : values)
+    {
+        value = static_cast<T>(readBitsImpl(ctx, numBits));
+    }
+}
+
+/** Unchecked implementation of readSignedBitsArray. */
+template <typename T>
+inline void readSignedBitsArrayImpl(ReaderContext& ctx, Span<T> values, uint8_t numBits)
+{
+    if (values.size() >= MIN_UNPACK_ARRAY_SIZE)
+    {
+        unpackSignedBitsArray(ctx, values, numBits);
+        return;
+    }
+
+    for (T& value : values)
+    {
+        value = static_cast<T>(readSignedBitsImpl(ctx, numBits));
+    }
+}
+
+/** Checked implementation of bulk unsigned reads up to 32-bits. */
+template <typename T>
+inline Result<void> readBitsArrayChecked(ReaderContext& ctx, Span<T> values, uint8_t numBits)
+{
+    const ErrorCode errorCode = checkBitsArray(ctx, values, numBits);
+    if (errorCode != ErrorCode::Success)
+    {
+        return Result<void>::error(errorCode);
+    }
+
+    readBitsArrayImpl(ctx, values, numBits);
+    return Result<void>::success();
+}
+
+/** Checked implementation of bulk signed reads up to 32-bits. */
+template <typename T>
+inline Result<void> readSignedBitsArrayChecked(ReaderContext& ctx, Span<T> values, uint8_t numBits)
+{
+    const ErrorCode errorCode = checkBitsArray(ctx, values, numBits);
+    if (errorCode != ErrorCode::Success)
+    {
+        return Result<void>::error(errorCode);
+    }
+
+    readSignedBitsArrayImpl(ctx, values, numBits);
+    return Result<void>::success();
+}
+
+/** Bulk read of a run of values which fits into the window of a windowed reader. */
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<uint8_t> values, uint8_t numBits)
+{
+    return windowReader.readBitsArray(values, numBits);
+}
+
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<uint16_t> values, uint8_t numBits)
+{
+    return windowReader.readBitsArray(values, numBits);
+}
+
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<uint32_t> values, uint8_t numBits)
+{
+    return windowReader.readBitsArray(values, numBits);
+}
+
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<uint64_t> values, uint8_t numBits)
+{
+    return windowReader.readBits64Array(values, numBits);
+}
+
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<int8_t> values, uint8_t numBits)
+{
+    return windowReader.readSignedBitsArray(values, numBits);
+}
+
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<int16_t> values, uint8_t numBits)
+{
+    return windowReader.readSignedBitsArray(values, numBits);
+}
+
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<int32_t> values, uint8_t numBits)
+{
+    return windowReader.readSignedBitsArray(values, numBits);
+}
+
+inline Result<void> readBitsArrayOf(BitStreamReader& windowReader, Span<int64_t> values, uint8_t numBits)
+{
+    return windowReader.readSignedBits64Array(values, numBits);
+}
+
+/** Reads bytes of the stream straight from the buffer, the stream does not need to be byte aligned. */
+template <bool IS_ALIGNED>
+struct UncheckedByteSource
+{
+    UncheckedByteSource(const uint8_t* buffer, BitPosType bitPosition) :
+            bytes(buffer + bitPosition / 8),
+            shift(static_cast<uint8_t>(bitPosition & 0x07U))
+    {}
+
+    uint8_t get(size_t index) const
+    {
+        return IS_ALIGNED ? bytes[index]
+                          : static_cast<uint8_t>((bytes[index] << shift) | (bytes[index + 1] >> (8U - shift)));
+    }
+
+    const uint8_t* bytes;
+    uint8_t shift;
+};
+
+/**
+ * Decodes a single variable integer without any bounds checks.
+ *
+ * The ladder is unrolled by the compiler, branches only depend on has-next flags which are well predicted
+ * for arrays of similar values.
+ *
+ * \return Number of bytes of the variable integer.
+ */
+template <size_t MAX_VAR_BYTES, bool HAS_SIGN, typename BYTE_SOURCE>
+inline size_t decodeVarNum(const BYTE_SOURCE& source, uint64_t& absValue, bool& isNegative)
+{
+    uint8_t byte = source.get(0);
+    isNegative = HAS_SIGN && (byte & VARINT_SIGN_1) != 0;
+    uint64_t value = byte & (HAS_SIGN ? VARINT_BYTE_1 : VARUINT_BYTE);
+    bool hasNext = (byte & (HAS_SIGN ? VARINT_HAS_NEXT_1 : VARUINT_HAS_NEXT)) != 0;
+
+    size_t numVarBytes = 1;
+    for (; hasNext && numVarBytes + 1 < MAX_VAR_BYTES; ++numVarBytes)
+    {
+        byte = source.get(numVarBytes);
+        value = value << 7U | static_cast<uint8_t>(byte & VARUINT_BYTE);
+        hasNext = (byte & VARUINT_HAS_NEXT) != 0;
+    }
+
+    // the last byte of the maximum range has no has-next flag and carries full 8 bits
+    if (hasNext)
+    {
+        value = value << 8U | source.get(numVarBytes);
+        ++numVarBytes;
+    }
+
+    absValue = value;
+    return numVarBytes;
+}
+
+struct VarInt16Format
+{
+    using Type = int16_t;
+    static const size_t MAX_VAR_BYTES = 2;
+    static const bool HAS_SIGN = true;
+
+    static bool convert(uint64_t absValue, bool isNegative, int16_t& value)
+    {
+        const uint16_t result = static_cast<uint16_t>(absValue);
+        value = isNegative ? static_cast<int16_t>(-result) : static_cast<int16_t>(result);
+        return true;
+    }
+
+    static Result<int16_t> read(BitStreamReader& reader)
+    {
+        return reader.readVarInt16();
+    }
+};
+
+struct VarInt32Format
+{
+    using Type = int32_t;
+    static const size_t MAX_VAR_BYTES = 4;
+    static const bool HAS_SIGN = true;
+
+    static bool convert(uint64_t absValue, bool isNegative, int32_t& value)
+    {
+        const uint32_t result = static_cast<uint32_t>(absValue);
+        value = isNegative ? -static_cast<int32_t>(result) : static_cast<int32_t>(result);
+        return true;
+    }
+
+    static Result<int32_t> read(BitStreamReader& reader)
+    {
+        return reader.readVarInt32();
+    }
+};
+
+struct VarInt64Format
+{
+    using Type = int64_t;
+    static const size_t MAX_VAR_BYTES = 8;
+    static const bool HAS_SIGN = true;
+
+    static bool convert(uint64_t absValue, bool isNegative, int64_t& value)
+    {
+        value = isNegative ? -static_cast<int64_t>(absValue) : static_cast<int64_t>(absValue);
+        return true;
+    }
+
+    static Result<int64_t> read(BitStreamReader& reader)
+    {
+        return reader.readVarInt64();
+    }
+};
+
+struct VarIntFormat
+{
+    using Type = int64_t;
+    static const size_t MAX_VAR_BYTES = 9;
+    static const bool HAS_SIGN = true;
+
+    static bool convert(uint64_t absValue, bool isNegative, int64_t& value)
+    {
+        // INT64_MIN is encoded as -0
+        value = isNegative ? (absValue == 0 ? INT64_MIN : -static_cast<int64_t>(absValue))
+                           : static_cast<int64_t>(absValue);
+        return true;
+    }
+
+    static Result<int64_t> read(BitStreamReader& reader)
+    {
+        return reader.readVarInt();
+    }
+};
+
+template <typename T, size_t MAX_VAR_BYTES_, Result<T> (BitStreamReader::*READ)()>
+struct UnsignedVarNumFormat
+{
+    using Type = T;
+    static const size_t MAX_VAR_BYTES = MAX_VAR_BYTES_;
+    static const bool HAS_SIGN = false;
+
+    static bool convert(uint64_t absValue, bool, T& value)
+    {
+        value = static_cast<T>(absValue);
+        return true;
+    }
+
+    static Result<T> read(BitStreamReader& reader)
+    {
+        return (reader.*READ)();
+    }
+};
+
+using VarUInt16Format = UnsignedVarNumFormat<uint16_t, 2, &BitStreamReader::readVarUInt16>;
+using VarUInt32Format = UnsignedVarNumFormat<uint32_t, 4, &BitStreamReader::readVarUInt32>;
+using VarUInt64Format = UnsignedVarNumFormat<uint64_t, 8, &BitStreamReader::readVarUInt64>;
+using VarUIntFormat = UnsignedVarNumFormat<uint64_t, 9, &BitStreamReader::readVarUInt>;
+
+struct VarSizeFormat
+{
+    using Type = uint32_t;
+    static const size_t MAX_VAR_BYTES = 5;
+    static const bool HAS_SIGN = false;
+
+    static bool convert(uint64_t absValue, bool, uint32_t& value)
+    {
+        value = static_cast<uint32_t>(absValue);
+        return absValue <= VARSIZE_MAX_VALUE;
+    }
+
+    static Result<uint32_t> read(BitStreamReader& reader)
+    {
+        return reader.readVarSize();
+    }
+};
+
+/**
+ * Decodes variable integers straight from the buffer while a variable integer of the maximum length still fits
+ * into the stream.
+ *
+ * \return Number of decoded values.
+ */
+template <typename FORMAT, bool IS_ALIGNED>
+inline size_t decodeVarNumRun(ReaderContext& ctx, Span<typename FORMAT::Type> values, bool& isInRange)
+{
+    // unaligned byte source touches one more byte
+    static const size_t FAST_PATH_BIT_SIZE = (FORMAT::MAX_VAR_BYTES + (IS_ALIGNED ? 0 : 1)) * 8;
+
+    BitPosType position = ctx.bitIndex;
+    size_t index = 0;
+    isInRange = true;
+    if (position + FAST_PATH_BIT_SIZE <= ctx.bufferBitSize)
+    {
+        const BitPosType fastPathEnd = ctx.bufferBitSize - FAST_PATH_BIT_SIZE;
+        while (index < values.size() && position <= fastPathEnd)
+        {
+            uint64_t absValue = 0;
+            bool isNegative = false;
+            position += 8 *
+                    decodeVarNum<FORMAT::MAX_VAR_BYTES, FORMAT::HAS_SIGN>(
+                            UncheckedByteSource<IS_ALIGNED>(ctx.buffer.data(), position), absValue, isNegative);
+            isInRange = FORMAT::convert(absValue, isNegative, values[index]);
+            if (!isInRange)
+            {
+                break;
+            }
+            ++index;
+        }
+        seekImpl(ctx, position);
+    }
+
+    return index;
+}
+
+/** Implementation of bulk reads of variable integers. */
+template <typename FORMAT>
+inline Result<void> readVarNumArrayImpl(
+        BitStreamReader& reader, ReaderContext& ctx, Span<typename FORMAT::Type> values)
+{
+    // variable integers are whole bytes, thus alignment of the position never changes
+    bool isInRange = true;
+    const size_t numDecoded = ((ctx.bitIndex & 0x07U) == 0)
+            ? decodeVarNumRun<FORMAT, true>(ctx, values, isInRange)
+            : decodeVarNumRun<FORMAT, false>(ctx, values, isInRange);
+    if (!isInRange)
+    {
+        return Result<void>::error(ErrorCode::OutOfRange);
+    }
+
+    // values near the end of the stream are read by the checked ladder
+    for (size_t index = numDecoded; index < values.size(); ++index)
+    {
+        auto result = FORMAT::read(reader);
+        if (result.isError())
+        {
+            return Result<void>::error(result.getError());
+        }
+        values[index] = result.getValue();
+    }
+
+    return Result<void>::success();
+}
+
 } // namespace
 
 BitStreamReader::ReaderContext::ReaderContext(Span<const uint8_t> readBuffer, size_t readBufferBitSize) :
         buffer(readBuffer),
-        bufferBitSize(readBufferBitSize),
+        bufferError(validateBuffer(readBuffer, readBufferBitSize)),
+        bufferBitSize(bufferError == ErrorCode::Success ? readBufferBitSize : 0),
         cache(0),
         cacheNumBits(0),
         bitIndex(0)
-{
-    // Validation moved to read methods to allow Result<T> error handling
-}
+{}
+
+BitStreamReader::ReaderContext::ReaderContext(ErrorCode error) noexcept :
+        buffer(),
+        bufferError(error),
+        bufferBitSize(0),
+        cache(0),
+        cacheNumBits(0),
+        bitIndex(0)
+{}
+
+BitStreamReader::ReaderContext::ReaderContext(ReaderContext&& other) noexcept :
+        buffer(other.buffer),
+        bufferError(other.bufferError),
+        bufferBitSize(other.bufferBitSize),
+        cache(other.cache),
+        cacheNumBits(other.cacheNumBits),
+        bitIndex(other.bitIndex)
+{}
+
+BitStreamReader::BitStreamReader(BitStreamReader&& other) noexcept :
+        m_context(other.m_windowState != nullptr ? ReaderContext(ErrorCode::InvalidOperation)
+                                                 : std::move(other.m_context)),
+        m_windowState(nullptr)
+{}
 
 BitStreamReader::BitStreamReader(const uint8_t* buffer, size_t bufferByteSize) :
         BitStreamReader(Span<const uint8_t>(buffer, bufferByteSize))
 {}
 
 BitStreamReader::BitStreamReader(Span<const uint8_t> buffer) :
-        m_context(buffer, buffer.size() * 8)
+        m_context(buffer, buffer.size() * 8),
+        m_windowState(nullptr)
 {}
 
 BitStreamReader::BitStreamReader(Span<const uint8_t> buffer, size_t bufferBitSize) :
-        m_context(buffer, bufferBitSize)
-{
-    // Validation moved to read methods to allow Result<T> error handling
-}
+        m_context(buffer, bufferBitSize),
+        m_windowState(nullptr)
+{}
 
 BitStreamReader::BitStreamReader(const uint8_t* buffer, size_t bufferBitSize, BitsTag) :
-        m_context(Span<const uint8_t>(buffer, (bufferBitSize + 7) / 8), bufferBitSize)
+        m_context(Span<const uint8_t>(buffer, (bufferBitSize + 7) / 8), bufferBitSize),
+        m_windowState(nullptr)
 {}
 
-Result<uint32_t> BitStreamReader::readBits(uint8_t numBits) noexcept
+BitStreamReader::WindowState::WindowState(RefillFunc windowRefillFunc, size_t windowStreamBitSize) noexcept :
+        refillFunc(windowRefillFunc),
+        streamBitSize(windowStreamBitSize),
+        bufferBitSize(0),
+        bitPosition(0),
+        isStable(false),
+        refillError(ErrorCode::Success)
+{}
+
+BitStreamReader::BitStreamReader(WindowState& windowState) noexcept :
+        m_context(Span<const uint8_t>(), 0),
+        m_windowState(&windowState)
+{}
+
+Result<BitStreamReader> BitStreamReader::create(Span<const uint8_t> buffer) noexcept
 {
-    // Validate buffer size
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
+    // buffer size is validated before the bit size, so the multiplication cannot be misinterpreted
+    return create(buffer, buffer.size() * 8);
+}
+
+Result<BitStreamReader> BitStreamReader::create(Span<const uint8_t> buffer, size_t bufferBitSize) noexcept
+{
+    const ErrorCode bufferError = validateBuffer(buffer, bufferBitSize);
+    if (bufferError != ErrorCode::Success)
     {
-        return Result<uint32_t>::error(ErrorCode::BufferSizeExceeded);
+        return Result<BitStreamReader>::error(bufferError);
     }
-    
-    // Validate buffer bit size
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
+
+    return Result<BitStreamReader>::success(BitStreamReader(buffer, bufferBitSize));
+}
+
+template <typename T, typename READ>
+ZSERIO_COLD Result<T> BitStreamReader::readWindowed(size_t numBits, READ read) noexcept
+{
+    if (m_windowState == nullptr)
     {
-        return Result<uint32_t>::error(ErrorCode::WrongBufferBitSize);
+        return Result<T>::error(endOfStreamError(m_context));
     }
-    
+
+    const ErrorCode errorCode = prepareWindow(numBits);
+    if (errorCode != ErrorCode::Success)
+    {
+        return Result<T>::error(errorCode);
+    }
+
+    BitStreamReader windowReader = openWindow();
+    Result<T> result = read(windowReader);
+    closeWindow(windowReader);
+
+    return result;
+}
+
+template <typename T>
+ZSERIO_COLD Result<void> BitStreamReader::readWindowedBitsArray(Span<T> values, uint8_t numBits) noexcept
+{
+    if (numBits > sizeof(T) * 8)
+    {
+        return Result<void>::error(ErrorCode::InvalidNumBits);
+    }
+
+    // the whole array is checked against the stream so that a failed read does not move the reader
+    const BitPosType beginBitPosition = m_context.bitIndex;
+    if (numBits != 0 && values.size() > (m_windowState->streamBitSize - beginBitPosition) / numBits)
+    {
+        return Result<void>::error(ErrorCode::EndOfStream);
+    }
+
+    // values within a window are read in bulk, a value which crosses the window end gets a window of its own
+    size_t index = 0;
+    while (index < values.size())
+    {
+        ErrorCode errorCode = prepareWindow(numBits);
+        if (errorCode == ErrorCode::Success)
+        {
+            BitStreamReader windowReader = openWindow();
+            const size_t numWindowBits = windowReader.m_context.bufferBitSize - windowReader.m_context.bitIndex;
+            const size_t numFitting = std::min(values.size() - index,
+                    (numBits != 0) ? numWindowBits / numBits : values.size());
+            if (numFitting > 0)
+            {
+                errorCode = readBitsArrayOf(windowReader, values.subspan(index, numFitting), numBits).getError();
+                closeWindow(windowReader);
+                index += numFitting;
+            }
+            else
+            {
+                errorCode = ErrorCode::EndOfStream;
+            }
+        }
+
+        if (errorCode != ErrorCode::Success)
+        {
+            // streams of unknown size fail only at their end, the reader returns to the array begin
+            m_context.bitIndex = beginBitPosition;
+            m_context.cacheNumBits = 0;
+            return Result<void>::error(errorCode);
+        }
+    }
+
+    return Result<void>::success();
+}
+
+template <typename FORMAT>
+ZSERIO_COLD Result<void> BitStreamReader::readWindowedVarNumArray(Span<typename FORMAT::Type> values) noexcept
+{
+    size_t index = 0;
+    while (index < values.size())
+    {
+        // values are decoded straight from the window until the longest value does not fit into it
+        const ErrorCode errorCode = prepareWindow(FORMAT::MAX_VAR_BYTES * 8);
+        if (errorCode != ErrorCode::Success)
+        {
+            return Result<void>::error(errorCode);
+        }
+
+        BitStreamReader windowReader = openWindow();
+        ReaderContext& windowContext = windowReader.m_context;
+        bool isInRange = true;
+        const Span<typename FORMAT::Type> rest = values.subspan(index);
+        index += ((windowContext.bitIndex & 0x07U) == 0)
+                ? decodeVarNumRun<FORMAT, true>(windowContext, rest, isInRange)
+                : decodeVarNumRun<FORMAT, false>(windowContext, rest, isInRange);
+        closeWindow(windowReader);
+        if (!isInRange)
+        {
+            return Result<void>::error(ErrorCode::OutOfRange);
+        }
+
+        // a value near the window end is read by the checked ladder which moves the window
+        if (index < values.size())
+        {
+            auto result = FORMAT::read(*this);
+            if (result.isError())
+            {
+                return Result<void>::error(result.getError());
+            }
+            values[index++] = result.getValue();
+        }
+    }
+
+    return Result<void>::success();
+}
+
+ErrorCode BitStreamReader::prepareWindow(size_t numBits) noexcept
+{
+    WindowState& window = *m_windowState;
+    const BitPosType bitPosition = m_context.bitIndex;
+    numBits = std::min(numBits, window.streamBitSize - bitPosition);
+    if (bitPosition >= window.bitPosition && bitPosition - window.bitPosition + numBits <= window.bufferBitSize)
+    {
+        return ErrorCode::Success;
+    }
+
+    // refill errors are sticky and reported instead of the end of stream
+    if (window.refillError == ErrorCode::Success)
+    {
+        window.refillError = window.refillFunc(*this, bitPosition, numBits).getError();
+    }
+    if (window.refillError != ErrorCode::Success)
+    {
+        return window.refillError;
+    }
+
+    // the new window can end before the requested bits when the stream is shorter than expected
+    if (bitPosition < window.bitPosition || bitPosition - window.bitPosition > window.bufferBitSize)
+    {
+        return ErrorCode::EndOfStream;
+    }
+
+    return ErrorCode::Success;
+}
+
+BitStreamReader BitStreamReader::openWindow() const noexcept
+{
+    const WindowState& window = *m_windowState;
+    BitStreamReader windowReader(window.buffer, window.bufferBitSize);
+    ReaderContext& windowContext = windowReader.m_context;
+    windowContext.cache = m_context.cache;
+    windowContext.cacheNumBits = m_context.cacheNumBits;
+    windowContext.bitIndex = m_context.bitIndex - window.bitPosition;
+    if (windowContext.cacheNumBits == 0)
+    {
+        // position of a windowed reader is not aligned after a seek
+        seekImpl(windowContext, windowContext.bitIndex);
+    }
+
+    return windowReader;
+}
+
+void BitStreamReader::closeWindow(const BitStreamReader& windowReader) noexcept
+{
+    const ReaderContext& windowContext = windowReader.m_context;
+    m_context.cache = windowContext.cache;
+    m_context.cacheNumBits = windowContext.cacheNumBits;
+    m_context.bitIndex = m_windowState->bitPosition + windowContext.bitIndex;
+}
+
+Result<uint32_t> BitStreamReader::readBits(uint8_t numBits) noexcept
+{
     // Check num bits
     if (numBits > 32)
     {
@@ -376,7 +1151,7 @@ Result<uint32_t> BitStreamReader::readBits(uint8_t numBits) noexcept
     // Check if we have enough bits to read
     if (m_context.bitIndex + numBits > m_context.bufferBitSize)
     {
-        return Result<uint32_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint32_t>(numBits, [numBits](BitStreamReader& reader) { return reader.readBits(numBits); });
     }
 
     return Result<uint32_t>::success(static_cast<uint32_t>(readBitsImpl(m_context, numBits)));
@@ -384,18 +1159,6 @@ Result<uint32_t> BitStreamReader::readBits(uint8_t numBits) noexcept
 
 Result<uint64_t> BitStreamReader::readBits64(uint8_t numBits) noexcept
 {
-    // Validate buffer size
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<uint64_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    // Validate buffer bit size
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<uint64_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-    
     // Check num bits
     if (numBits > 64)
     {
@@ -405,7 +1168,8 @@ Result<uint64_t> BitStreamReader::readBits64(uint8_t numBits) noexcept
     // Check if we have enough bits to read
     if (m_context.bitIndex + numBits > m_context.bufferBitSize)
     {
-        return Result<uint64_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint64_t>(numBits,
+                [numBits](BitStreamReader& reader) { return reader.readBits64(numBits); });
     }
 
 #ifdef ZSERIO_RUNTIME_64BIT
@@ -422,18 +1186,6 @@ Result<uint64_t> BitStreamReader::readBits64(uint8_t numBits) noexcept
 
 Result<int64_t> BitStreamReader::readSignedBits64(uint8_t numBits) noexcept
 {
-    // Validate buffer size
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<int64_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    // Validate buffer bit size
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<int64_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-    
     // Check num bits
     if (numBits > 64)
     {
@@ -443,7 +1195,8 @@ Result<int64_t> BitStreamReader::readSignedBits64(uint8_t numBits) noexcept
     // Check if we have enough bits to read
     if (m_context.bitIndex + numBits > m_context.bufferBitSize)
     {
-        return Result<int64_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<int64_t>(numBits,
+                [numBits](BitStreamReader& reader) { return reader.readSignedBits64(numBits); });
     }
 
 #ifdef ZSERIO_RUNTIME_64BIT
@@ -454,36 +1207,12 @@ Result<int64_t> BitStreamReader::readSignedBits64(uint8_t numBits) noexcept
         return Result<int64_t>::success(readSignedBitsImpl(m_context, numBits));
     }
 
-    int64_t value = static_cast<int64_t>(readBits64Impl(m_context, numBits));
-
-    // Skip the signed overflow correction if numBits == 64.
-    // In that case, the value that comes out the readBits function
-    // is already correct.
-    const bool needsSignExtension =
-            numBits < 64 && (static_cast<uint64_t>(value) >= (UINT64_C(1) << (numBits - 1)));
-    if (needsSignExtension)
-    {
-        value = static_cast<int64_t>(static_cast<uint64_t>(value) - (UINT64_C(1) << numBits));
-    }
-
-    return Result<int64_t>::success(value);
+    return Result<int64_t>::success(readSignedBits64Impl(m_context, numBits));
 #endif
 }
 
 Result<int32_t> BitStreamReader::readSignedBits(uint8_t numBits) noexcept
 {
-    // Validate buffer size
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<int32_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    // Validate buffer bit size
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<int32_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-    
     // Check num bits
     if (numBits > 32)
     {
@@ -493,29 +1222,149 @@ Result<int32_t> BitStreamReader::readSignedBits(uint8_t numBits) noexcept
     // Check if we have enough bits to read
     if (m_context.bitIndex + numBits > m_context.bufferBitSize)
     {
-        return Result<int32_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<int32_t>(numBits,
+                [numBits](BitStreamReader& reader) { return reader.readSignedBits(numBits); });
     }
 
     return Result<int32_t>::success(static_cast<int32_t>(readSignedBitsImpl(m_context, numBits)));
 }
 
-Result<int64_t> BitStreamReader::readVarInt64() noexcept
+Result<void> BitStreamReader::readBitsArray(Span<uint8_t> values, uint8_t numBits) noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
+    if (m_windowState != nullptr)
     {
-        return Result<int64_t>::error(ErrorCode::BufferSizeExceeded);
+        return readWindowedBitsArray(values, numBits);
     }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
+
+    return readBitsArrayChecked(m_context, values, numBits);
+}
+
+Result<void> BitStreamReader::readBitsArray(Span<uint16_t> values, uint8_t numBits) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedBitsArray(values, numBits);
+    }
+
+    return readBitsArrayChecked(m_context, values, numBits);
+}
+
+Result<void> BitStreamReader::readBitsArray(Span<uint32_t> values, uint8_t numBits) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedBitsArray(values, numBits);
+    }
+
+    return readBitsArrayChecked(m_context, values, numBits);
+}
+
+Result<void> BitStreamReader::readBits64Array(Span<uint64_t> values, uint8_t numBits) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedBitsArray(values, numBits);
+    }
+
+#ifdef ZSERIO_RUNTIME_64BIT
+    return readBitsArrayChecked(m_context, values, numBits);
+#else
+    if (numBits <= 32)
+    {
+        return readBitsArrayChecked(m_context, values, numBits);
+    }
+
+    const ErrorCode errorCode = checkBitsArray(m_context, values, numBits);
+    if (errorCode != ErrorCode::Success)
     {
-        return Result<int64_t>::error(ErrorCode::WrongBufferBitSize);
+        return Result<void>::error(errorCode);
     }
 
+    if (values.size() >= MIN_UNPACK_ARRAY_SIZE)
+    {
+        unpackBitsArray(m_context, values, numBits);
+        return Result<void>::success();
+    }
+
+    for (uint64_t& value : values)
+    {
+        value = readBits64Impl(m_context, numBits);
+    }
+    return Result<void>::success();
+#endif
+}
+
+Result<void> BitStreamReader::readSignedBitsArray(Span<int8_t> values, uint8_t numBits) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedBitsArray(values, numBits);
+    }
+
+    return readSignedBitsArrayChecked(m_context, values, numBits);
+}
+
+Result<void> BitStreamReader::readSignedBitsArray(Span<int16_t> values, uint8_t numBits) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedBitsArray(values, numBits);
+    }
+
+    return readSignedBitsArrayChecked(m_context, values, numBits);
+}
+
+Result<void> BitStreamReader::readSignedBitsArray(Span<int32_t> values, uint8_t numBits) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedBitsArray(values, numBits);
+    }
+
+    return readSignedBitsArrayChecked(m_context, values, numBits);
+}
+
+Result<void> BitStreamReader::readSignedBits64Array(Span<int64_t> values, uint8_t numBits) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedBitsArray(values, numBits);
+    }
+
+#ifdef ZSERIO_RUNTIME_64BIT
+    return readSignedBitsArrayChecked(m_context, values, numBits);
+#else
+    if (numBits <= 32)
+    {
+        return readSignedBitsArrayChecked(m_context, values, numBits);
+    }
+
+    const ErrorCode errorCode = checkBitsArray(m_context, values, numBits);
+    if (errorCode != ErrorCode::Success)
+    {
+        return Result<void>::error(errorCode);
+    }
+
+    if (values.size() >= MIN_UNPACK_ARRAY_SIZE)
+    {
+        unpackSignedBitsArray(m_context, values, numBits);
+        return Result<void>::success();
+    }
+
+    for (int64_t& value : values)
+    {
+        value = readSignedBits64Impl(m_context, numBits);
+    }
+    return Result<void>::success();
+#endif
+}
+
+Result<int64_t> BitStreamReader::readVarInt64() noexcept
+{
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<int64_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<int64_t>(64, [](BitStreamReader& reader) { return reader.readVarInt64(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -608,22 +1457,11 @@ Result<int64_t> BitStreamReader::readVarInt64() noexcept
 }
 
 Result<int32_t> BitStreamReader::readVarInt32() noexcept
-{
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<int32_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<int32_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
+{
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<int32_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<int32_t>(32, [](BitStreamReader& reader) { return reader.readVarInt32(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -669,21 +1507,10 @@ Result<int32_t> BitStreamReader::readVarInt32() noexcept
 
 Result<int16_t> BitStreamReader::readVarInt16() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<int16_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<int16_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<int16_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<int16_t>(16, [](BitStreamReader& reader) { return reader.readVarInt16(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -706,21 +1533,10 @@ Result<int16_t> BitStreamReader::readVarInt16() noexcept
 
 Result<uint64_t> BitStreamReader::readVarUInt64() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<uint64_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<uint64_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<uint64_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint64_t>(64, [](BitStreamReader& reader) { return reader.readVarUInt64(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -813,21 +1629,10 @@ Result<uint64_t> BitStreamReader::readVarUInt64() noexcept
 
 Result<uint32_t> BitStreamReader::readVarUInt32() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<uint32_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<uint32_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<uint32_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint32_t>(32, [](BitStreamReader& reader) { return reader.readVarUInt32(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -872,21 +1677,10 @@ Result<uint32_t> BitStreamReader::readVarUInt32() noexcept
 
 Result<uint16_t> BitStreamReader::readVarUInt16() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<uint16_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<uint16_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<uint16_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint16_t>(16, [](BitStreamReader& reader) { return reader.readVarUInt16(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -908,21 +1702,10 @@ Result<uint16_t> BitStreamReader::readVarUInt16() noexcept
 
 Result<int64_t> BitStreamReader::readVarInt() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<int64_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<int64_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<int64_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<int64_t>(72, [](BitStreamReader& reader) { return reader.readVarInt(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -1029,21 +1812,10 @@ Result<int64_t> BitStreamReader::readVarInt() noexcept
 
 Result<uint64_t> BitStreamReader::readVarUInt() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<uint64_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<uint64_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<uint64_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint64_t>(72, [](BitStreamReader& reader) { return reader.readVarUInt(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -1148,21 +1920,10 @@ Result<uint64_t> BitStreamReader::readVarUInt() noexcept
 
 Result<float> BitStreamReader::readFloat16() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<float>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<float>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have 16 bits to read
     if (m_context.bitIndex + 16 > m_context.bufferBitSize)
     {
-        return Result<float>::error(ErrorCode::EndOfStream);
+        return readWindowed<float>(16, [](BitStreamReader& reader) { return reader.readFloat16(); });
     }
 
     const uint16_t halfPrecisionFloatValue = static_cast<uint16_t>(readBitsImpl(m_context, 16));
@@ -1171,21 +1932,10 @@ Result<float> BitStreamReader::readFloat16() noexcept
 
 Result<float> BitStreamReader::readFloat32() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<float>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<float>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have 32 bits to read
     if (m_context.bitIndex + 32 > m_context.bufferBitSize)
     {
-        return Result<float>::error(ErrorCode::EndOfStream);
+        return readWindowed<float>(32, [](BitStreamReader& reader) { return reader.readFloat32(); });
     }
 
     const uint32_t singlePrecisionFloatValue = static_cast<uint32_t>(readBitsImpl(m_context, 32));
@@ -1194,21 +1944,10 @@ Result<float> BitStreamReader::readFloat32() noexcept
 
 Result<double> BitStreamReader::readFloat64() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<double>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<double>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have 64 bits to read
     if (m_context.bitIndex + 64 > m_context.bufferBitSize)
     {
-        return Result<double>::error(ErrorCode::EndOfStream);
+        return readWindowed<double>(64, [](BitStreamReader& reader) { return reader.readFloat64(); });
     }
 
     const uint64_t doublePrecisionFloatValue = readBitsImpl(m_context, 64);
@@ -1217,21 +1956,10 @@ Result<double> BitStreamReader::readFloat64() noexcept
 
 Result<uint32_t> BitStreamReader::readVarSize() noexcept
 {
-    // First check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
-    {
-        return Result<uint32_t>::error(ErrorCode::BufferSizeExceeded);
-    }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
-    {
-        return Result<uint32_t>::error(ErrorCode::WrongBufferBitSize);
-    }
-
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<uint32_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint32_t>(40, [](BitStreamReader& reader) { return reader.readVarSize(); });
     }
 
     uint8_t byte = static_cast<uint8_t>(readBitsImpl(m_context, 8)); // byte 1
@@ -1291,30 +2019,242 @@ Result<uint32_t> BitStreamReader::readVarSize() noexcept
     return Result<uint32_t>::success(result);
 }
 
-Result<bool> BitStreamReader::readBool() noexcept
+Result<void> BitStreamReader::readVarInt16Array(Span<int16_t> values) noexcept
 {
-    // Check buffer validations
-    if (m_context.buffer.size() > MAX_BUFFER_SIZE)
+    if (m_windowState != nullptr)
     {
-        return Result<bool>::error(ErrorCode::BufferSizeExceeded);
+        return readWindowedVarNumArray<VarInt16Format>(values);
     }
-    
-    if (m_context.buffer.size() < (m_context.bufferBitSize + 7) / 8)
+
+    return readVarNumArrayImpl<VarInt16Format>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarInt32Array(Span<int32_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarInt32Format>(values);
+    }
+
+    return readVarNumArrayImpl<VarInt32Format>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarInt64Array(Span<int64_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarInt64Format>(values);
+    }
+
+    return readVarNumArrayImpl<VarInt64Format>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarIntArray(Span<int64_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarIntFormat>(values);
+    }
+
+    return readVarNumArrayImpl<VarIntFormat>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarUInt16Array(Span<uint16_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarUInt16Format>(values);
+    }
+
+    return readVarNumArrayImpl<VarUInt16Format>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarUInt32Array(Span<uint32_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarUInt32Format>(values);
+    }
+
+    return readVarNumArrayImpl<VarUInt32Format>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarUInt64Array(Span<uint64_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarUInt64Format>(values);
+    }
+
+    return readVarNumArrayImpl<VarUInt64Format>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarUIntArray(Span<uint64_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarUIntFormat>(values);
+    }
+
+    return readVarNumArrayImpl<VarUIntFormat>(*this, m_context, values);
+}
+
+Result<void> BitStreamReader::readVarSizeArray(Span<uint32_t> values) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedVarNumArray<VarSizeFormat>(values);
+    }
+
+    return readVarNumArrayImpl<VarSizeFormat>(*this, m_context, values);
+}
+
+Result<BytesView> BitStreamReader::readBytesView() noexcept
+{
+    size_t len = 0;
+    const auto bytesResult = readAlignedBytes(len);
+    if (bytesResult.isError())
+    {
+        return Result<BytesView>::error(bytesResult.getError());
+    }
+
+    return Result<BytesView>::success(BytesView(bytesResult.getValue(), len));
+}
+
+Result<StringView> BitStreamReader::readStringView() noexcept
+{
+    size_t len = 0;
+    const auto bytesResult = readAlignedBytes(len);
+    if (bytesResult.isError())
     {
-        return Result<bool>::error(ErrorCode::WrongBufferBitSize);
+        return Result<StringView>::error(bytesResult.getError());
     }
 
+    return Result<StringView>::success(StringView(reinterpret_cast<const char*>(bytesResult.getValue()), len));
+}
+
+Result<bool> BitStreamReader::readBool() noexcept
+{
     // Check if we have at least one bit to read
     if (m_context.bitIndex + 1 > m_context.bufferBitSize)
     {
-        return Result<bool>::error(ErrorCode::EndOfStream);
+        return readWindowed<bool>(1, [](BitStreamReader& reader) { return reader.readBool(); });
     }
 
     return Result<bool>::success(readBitsImpl(m_context, 1) != 0);
 }
 
+Result<const uint8_t*> BitStreamReader::readAlignedBytes(size_t& len) noexcept
+{
+    // the length is a whole number of bytes, thus the alignment can be checked before reading it
+    if ((m_context.bitIndex & 0x07U) != 0)
+    {
+        return Result<const uint8_t*>::error(ErrorCode::InvalidAlignment);
+    }
+
+    const BitPosType beginBitPosition = m_context.bitIndex;
+    auto lenResult = readVarSize();
+    if (lenResult.isError())
+    {
+        return Result<const uint8_t*>::error(lenResult.getError());
+    }
+
+    len = static_cast<size_t>(lenResult.getValue());
+    if (m_windowState != nullptr)
+    {
+        return readWindowedAlignedBytes(beginBitPosition, len);
+    }
+
+    const BitPosType dataBitPosition = m_context.bitIndex;
+    if (len > (m_context.bufferBitSize - dataBitPosition) / 8)
+    {
+        seekImpl(m_context, beginBitPosition);
+        return Result<const uint8_t*>::error(ErrorCode::EndOfStream);
+    }
+
+    seekImpl(m_context, dataBitPosition + len * 8);
+    return Result<const uint8_t*>::success(m_context.buffer.data() + dataBitPosition / 8);
+}
+
+Result<void> BitStreamReader::readRawBytes(Span<uint8_t> data) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return readWindowedRawBytes(data);
+    }
+
+    const BitPosType beginBitPosition = m_context.bitIndex;
+    if (data.size() > (m_context.bufferBitSize - beginBitPosition) / 8)
+    {
+        return Result<void>::error(endOfStreamError(m_context));
+    }
+
+    detail::unpackBytes(m_context.buffer.data() + beginBitPosition / 8,
+            static_cast<uint8_t>(beginBitPosition & 0x07U), data.data(), data.size());
+    seekImpl(m_context, beginBitPosition + data.size() * 8);
+
+    return Result<void>::success();
+}
+
+Result<size_t> BitStreamReader::readWindowBits(
+        size_t numBits, const uint8_t*& data, uint8_t& bitOffset, bool& isStable) noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        // only the bits of the current window are returned, the window is moved when it is exhausted
+        const ErrorCode errorCode = prepareWindow(std::min<size_t>(numBits, 8));
+        if (errorCode != ErrorCode::Success)
+        {
+            return Result<size_t>::error(errorCode);
+        }
+
+        BitStreamReader windowReader = openWindow();
+        auto result = windowReader.readWindowBits(numBits, data, bitOffset, isStable);
+        closeWindow(windowReader);
+        isStable = m_windowState->isStable;
+        return result;
+    }
+
+    // the whole buffer of a plain reader is a single window
+    const BitPosType bitPosition = m_context.bitIndex;
+    if (bitPosition >= m_context.bufferBitSize)
+    {
+        return Result<size_t>::error(endOfStreamError(m_context));
+    }
+
+    const size_t numWindowBits = std::min(numBits, m_context.bufferBitSize - bitPosition);
+    data = m_context.buffer.data() + bitPosition / 8;
+    bitOffset = static_cast<uint8_t>(bitPosition & 0x07U);
+    isStable = true;
+    seekImpl(m_context, bitPosition + numWindowBits);
+
+    return Result<size_t>::success(numWindowBits);
+}
+
+Result<BitStreamReader> BitStreamReader::fork(BitPosType bitPosition) const noexcept
+{
+    if (m_windowState != nullptr)
+    {
+        return Result<BitStreamReader>::error(ErrorCode::InvalidOperation);
+    }
+
+    BitStreamReader reader(m_context.buffer, m_context.bufferBitSize);
+    auto positionResult = reader.setBitPosition(bitPosition);
+    if (positionResult.isError())
+    {
+        return Result<BitStreamReader>::error(positionResult.getError());
+    }
+
+    return Result<BitStreamReader>::success(std::move(reader));
+}
+
 Result<void> BitStreamReader::setBitPosition(BitPosType position) noexcept
 {
+    if (m_windowState != nullptr)
+    {
+        return setWindowedBitPosition(position);
+    }
+
     if (position > m_context.bufferBitSize)
     {
         return Result<void>::error(ErrorCode::InvalidBitPosition);
@@ -1345,7 +2285,12 @@ Result<void> BitStreamReader::alignTo(size_t alignment) noexcept
         // Use readBitsImpl directly to avoid recursive Result handling
         if (m_context.bitIndex + skip > m_context.bufferBitSize)
         {
-            return Result<void>::error(ErrorCode::EndOfStream);
+            // windowed readers hold no buffer, they only move their position
+            if (m_windowState == nullptr || skip > m_windowState->streamBitSize - m_context.bitIndex)
+            {
+                return Result<void>::error(ErrorCode::EndOfStream);
+            }
+            return setWindowedBitPosition(m_context.bitIndex + skip);
         }
         
         if (skip <= 64)
@@ -1362,12 +2307,170 @@ Result<void> BitStreamReader::alignTo(size_t alignment) noexcept
     return Result<void>::success();
 }
 
+Result<void> BitStreamReader::skipBits(size_t numBits) noexcept
+{
+    const BitPosType bitPosition = getBitPosition();
+    if (numBits > getBufferBitSize() - bitPosition)
+    {
+        return Result<void>::error(ErrorCode::EndOfStream);
+    }
+
+    return setBitPosition(bitPosition + numBits);
+}
+
+Result<void> BitStreamReader::skipBytes() noexcept
+{
+    auto lenResult = readVarSize();
+    if (lenResult.isError())
+    {
+        return Result<void>::error(lenResult.getError());
+    }
+
+    const size_t len = static_cast<size_t>(lenResult.getValue());
+    if (len > (getBufferBitSize() - getBitPosition()) / 8)
+    {
+        return Result<void>::error(ErrorCode::EndOfStream);
+    }
+
+    return skipBits(len * 8);
+}
+
+Result<void> BitStreamReader::skipBitBuffer() noexcept
+{
+    auto bitSizeResult = readVarSize();
+    if (bitSizeResult.isError())
+    {
+        return Result<void>::error(bitSizeResult.getError());
+    }
+
+    return skipBits(static_cast<size_t>(bitSizeResult.getValue()));
+}
+
+void BitStreamReader::setWindow(
+        Span<const uint8_t> window, size_t windowBitSize, BitPosType windowBitPosition, bool isStable) noexcept
+{
+    // position and cache of the reader are kept, the window only gives access to the bytes around the position
+    m_windowState->buffer = window;
+    m_windowState->bufferBitSize = windowBitSize;
+    m_windowState->bitPosition = windowBitPosition;
+    m_windowState->isStable = isStable;
+}
+
+Result<const uint8_t*> BitStreamReader::readWindowedAlignedBytes(BitPosType beginBitPosition, size_t len) noexcept
+{
+    WindowState& window = *m_windowState;
+    const BitPosType dataBitPosition = m_context.bitIndex;
+    ErrorCode errorCode = ErrorCode::EndOfStream;
+    if (len <= (window.streamBitSize - dataBitPosition) / 8)
+    {
+        errorCode = prepareWindow(len * 8);
+    }
+    if (errorCode == ErrorCode::Success && !window.isStable && window.refillError == ErrorCode::Success)
+    {
+        // the window can be left by a previous read across a seam while the bytes lie in a stable buffer
+        window.refillError = window.refillFunc(*this, dataBitPosition, len * 8).getError();
+        errorCode = window.refillError;
+        if (errorCode == ErrorCode::Success && dataBitPosition < window.bitPosition)
+        {
+            errorCode = ErrorCode::EndOfStream;
+        }
+    }
+    if (errorCode == ErrorCode::Success && len > (window.bufferBitSize - (dataBitPosition - window.bitPosition)) / 8)
+    {
+        errorCode = ErrorCode::EndOfStream;
+    }
+    if (errorCode == ErrorCode::Success && !window.isStable)
+    {
+        errorCode = ErrorCode::InvalidPointer;
+    }
+    if (errorCode != ErrorCode::Success)
+    {
+        m_context.bitIndex = beginBitPosition;
+        m_context.cacheNumBits = 0;
+        return Result<const uint8_t*>::error(errorCode);
+    }
+
+    m_context.bitIndex = dataBitPosition + len * 8;
+    m_context.cacheNumBits = 0;
+    return Result<const uint8_t*>::success(window.buffer.data() + (dataBitPosition - window.bitPosition) / 8);
+}
+
+Result<void> BitStreamReader::readWindowedRawBytes(Span<uint8_t> data) noexcept
+{
+    const BitPosType beginBitPosition = m_context.bitIndex;
+    if (data.size() > (m_windowState->streamBitSize - beginBitPosition) / 8)
+    {
+        return Result<void>::error(ErrorCode::EndOfStream);
+    }
+
+    // bytes are copied window by window
+    while (!data.empty())
+    {
+        ErrorCode errorCode = prepareWindow(8);
+        if (errorCode == ErrorCode::Success)
+        {
+            BitStreamReader windowReader = openWindow();
+            const size_t numBytes = std::min(data.size(),
+                    (windowReader.m_context.bufferBitSize - windowReader.m_context.bitIndex) / 8);
+            if (numBytes > 0)
+            {
+                errorCode = windowReader.readRawBytes(data.subspan(0, numBytes)).getError();
+                closeWindow(windowReader);
+                data = data.subspan(numBytes);
+            }
+            else
+            {
+                errorCode = ErrorCode::EndOfStream;
+            }
+        }
+
+        if (errorCode != ErrorCode::Success)
+        {
+            // streams of unknown size fail only at their end, the reader returns to the begin
+            m_context.bitIndex = beginBitPosition;
+            m_context.cacheNumBits = 0;
+            return Result<void>::error(errorCode);
+        }
+    }
+
+    return Result<void>::success();
+}
+
+Result<void> BitStreamReader::setWindowedBitPosition(BitPosType position) noexcept
+{
+    WindowState& window = *m_windowState;
+    if (position > window.streamBitSize)
+    {
+        return Result<void>::error(ErrorCode::InvalidBitPosition);
+    }
+
+    // the window is moved eagerly, so that a position which cannot be reached is reported by the seek
+    if (position < window.bitPosition || position - window.bitPosition > window.bufferBitSize)
+    {
+        auto refillResult = window.refillFunc(*this, position, 0);
+        if (refillResult.isError())
+        {
+            return refillResult;
+        }
+        if (position < window.bitPosition || position - window.bitPosition > window.bufferBitSize)
+        {
+            return Result<void>::error(ErrorCode::InvalidBitPosition);
+        }
+    }
+
+    // cache is filled by the next read within the window
+    m_context.bitIndex = position;
+    m_context.cacheNumBits = 0;
+
+    return Result<void>::success();
+}
+
 Result<uint8_t> BitStreamReader::readByte() noexcept
 {
     // Check if we have at least one byte to read
     if (m_context.bitIndex + 8 > m_context.bufferBitSize)
     {
-        return Result<uint8_t>::error(ErrorCode::EndOfStream);
+        return readWindowed<uint8_t>(8, [](BitStreamReader& reader) { return reader.readByte(); });
     }
     
     return Result<uint8_t>::success(static_cast<uint8_t>(readBitsImpl(m_context, 8)));
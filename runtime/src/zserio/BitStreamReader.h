@@ -12,6 +12,7 @@
 #include "zserio/Result.h"
 #include "zserio/Span.h"
 #include "zserio/String.h"
+#include "zserio/StringView.h"
 #include "zserio/Types.h"
 #include "zserio/Vector.h"
 
@@ -20,6 +21,10 @@ namespace zserio
 
 /**
  * Reader class which allows to read various data from the bit stream.
+ *
+ * The buffer is validated only once at construction. Use create() factory methods to get the validation error
+ * immediately. Readers constructed directly over an invalid buffer behave as empty and report the validation
+ * error from the first read.
  */
 class BitStreamReader
 {
@@ -40,26 +45,40 @@ public:
          */
         explicit ReaderContext(Span<const uint8_t> readBuffer, size_t readBufferBitSize);
 
+        /**
+         * Constructor of an empty context which reports the given error from all reads.
+         *
+         * \param error Error to report.
+         */
+        explicit ReaderContext(ErrorCode error) noexcept;
+
         /**
          * Destructor.
          */
         ~ReaderContext() = default;
 
         /**
-         * Copying and moving is disallowed!
+         * Move constructor.
+         *
+         * \param other Context to move from.
+         */
+        ReaderContext(ReaderContext&& other) noexcept;
+
+        /**
+         * Copying and assignment is disallowed!
          * \{
          */
         ReaderContext(const ReaderContext&) = delete;
         ReaderContext& operator=(const ReaderContext&) = delete;
 
-        ReaderContext(const ReaderContext&&) = delete;
-        ReaderContext& operator=(const ReaderContext&&) = delete;
+        ReaderContext& operator=(ReaderContext&&) = delete;
         /**
          * \}
          */
 
         Span<const uint8_t> buffer; /**< Buffer to read from. */
-        const BitPosType bufferBitSize; /**< Size of the buffer in bits. */
+        const ErrorCode bufferError; /**< Result of the buffer validation done once at construction. */
+        const BitPosType bufferBitSize; /**< Size of the buffer in bits (zero if the buffer is invalid). */
 
         uintptr_t cache; /**< Bit cache to optimize bit reading. */
         uint8_t cacheNumBits; /**< Num bits available in the bit cache. */
@@ -108,11 +127,69 @@ public:
             BitStreamReader(bitBuffer.getData(), bitBuffer.getBitSize())
     {}
 
+    /**
+     * Factory method for construction with validation.
+     *
+     * The buffer is validated only once here, read methods then only check the end of stream.
+     *
+     * \param buffer Buffer to read.
+     *
+     * \return Result with BitStreamReader on success, error code on failure.
+     */
+    static Result<BitStreamReader> create(Span<const uint8_t> buffer) noexcept;
+
+    /**
+     * Factory method for construction with validation.
+     *
+     * The buffer is validated only once here, read methods then only check the end of stream.
+     *
+     * \param buffer Buffer to read.
+     * \param bufferBitSize Size of the buffer in bits.
+     *
+     * \return Result with BitStreamReader on success, error code on failure.
+     */
+    static Result<BitStreamReader> create(Span<const uint8_t> buffer, size_t bufferBitSize) noexcept;
+
+    /**
+     * Factory method for construction from bit buffer with validation.
+     *
+     * \param bitBuffer Bit buffer to read from.
+     *
+     * \return Result with BitStreamReader on success, error code on failure.
+     */
+    template <typename ALLOC>
+    static Result<BitStreamReader> create(const BasicBitBuffer<ALLOC>& bitBuffer) noexcept
+    {
+        return create(bitBuffer.getData(), bitBuffer.getBitSize());
+    }
+
     /**
      * Destructor.
      */
     ~BitStreamReader() = default;
 
+    /**
+     * Move constructor.
+     *
+     * The window state of a windowed reader is owned by the derived reader, thus moving the base of a windowed
+     * reader gives an empty reader which reports InvalidOperation from all reads.
+     *
+     * \param other Reader to move from.
+     */
+    BitStreamReader(BitStreamReader&& other) noexcept;
+
+    /**
+     * Copying and assignment is disallowed!
+     * \{
+     */
+    BitStreamReader(const BitStreamReader&) = delete;
+    BitStreamReader& operator=(const BitStreamReader&) = delete;
+
+    BitStreamReader& operator=(BitStreamReader&&) = delete;
+    /**
+     * \}
+     */
+
     /**
      * Reads unsigned bits up to 32-bits.
      *
@@ -149,6 +226,62 @@ public:
      */
     Result<int64_t> readSignedBits64(uint8_t numBits = 64) noexcept;
 
+    /**
+     * Reads a run of unsigned bit fields up to 32-bits each into preallocated storage.
+     *
+     * The end of stream is checked only once for the whole run. Nothing is read on error.
+     *
+     * \param values Storage for the read values, its size defines number of values to read.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Result indicating success or error code.
+     * \{
+     */
+    Result<void> readBitsArray(Span<uint8_t> values, uint8_t numBits) noexcept;
+    Result<void> readBitsArray(Span<uint16_t> values, uint8_t numBits) noexcept;
+    Result<void> readBitsArray(Span<uint32_t> values, uint8_t numBits) noexcept;
+    /** \} */
+
+    /**
+     * Reads a run of unsigned bit fields up to 64-bits each into preallocated storage.
+     *
+     * The end of stream is checked only once for the whole run. Nothing is read on error.
+     *
+     * \param values Storage for the read values, its size defines number of values to read.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Result indicating success or error code.
+     */
+    Result<void> readBits64Array(Span<uint64_t> values, uint8_t numBits) noexcept;
+
+    /**
+     * Reads a run of signed bit fields up to 32-bits each into preallocated storage.
+     *
+     * The end of stream is checked only once for the whole run. Nothing is read on error.
+     *
+     * \param values Storage for the read values, its size defines number of values to read.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Result indicating success or error code.
+     * \{
+     */
+    Result<void> readSignedBitsArray(Span<int8_t> values, uint8_t numBits) noexcept;
+    Result<void> readSignedBitsArray(Span<int16_t> values, uint8_t numBits) noexcept;
+    Result<void> readSignedBitsArray(Span<int32_t> values, uint8_t numBits) noexcept;
+    /** \} */
+
+    /**
+     * Reads a run of signed bit fields up to 64-bits each into preallocated storage.
+     *
+     * The end of stream is checked only once for the whole run. Nothing is read on error.
+     *
+     * \param values Storage for the read values, its size defines number of values to read.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Result indicating success or error code.
+     */
+    Result<void> readSignedBits64Array(Span<int64_t> values, uint8_t numBits) noexcept;
+
     /**
      * Reads signed variable integer up to 64 bits.
      *
@@ -212,6 +345,41 @@ public:
      */
     Result<uint32_t> readVarSize() noexcept;
 
+    /**
+     * Reads a run of signed variable integers into preallocated storage.
+     *
+     * Values are decoded straight from the buffer while a value of the maximum length still fits into
+     * the stream, remaining values are read one by one. Values read before an error are kept.
+     *
+     * \param values Storage for the read values, its size defines number of values to read.
+     *
+     * \return Result indicating success or error code.
+     * \{
+     */
+    Result<void> readVarInt16Array(Span<int16_t> values) noexcept;
+    Result<void> readVarInt32Array(Span<int32_t> values) noexcept;
+    Result<void> readVarInt64Array(Span<int64_t> values) noexcept;
+    Result<void> readVarIntArray(Span<int64_t> values) noexcept;
+    /** \} */
+
+    /**
+     * Reads a run of unsigned variable integers into preallocated storage.
+     *
+     * Values are decoded straight from the buffer while a value of the maximum length still fits into
+     * the stream, remaining values are read one by one. Values read before an error are kept.
+     *
+     * \param values Storage for the read values, its size defines number of values to read.
+     *
+     * \return Result indicating success or error code.
+     * \{
+     */
+    Result<void> readVarUInt16Array(Span<uint16_t> values) noexcept;
+    Result<void> readVarUInt32Array(Span<uint32_t> values) noexcept;
+    Result<void> readVarUInt64Array(Span<uint64_t> values) noexcept;
+    Result<void> readVarUIntArray(Span<uint64_t> values) noexcept;
+    Result<void> readVarSizeArray(Span<uint32_t> values) noexcept;
+    /** \} */
+
     /**
      * Reads 16-bit float.
      *
@@ -251,20 +419,20 @@ public:
         const size_t len = static_cast<size_t>(lenResult.getValue());
         
         const BitPosType beginBitPosition = getBitPosition();
-        if ((beginBitPosition & 0x07U) != 0)
+        if (len > (getBufferBitSize() - beginBitPosition) / 8)
         {
-            // we are not aligned to byte
-            vector<uint8_t, ALLOC> value{alloc};
-            // TODO: This reserve() may abort if allocation fails with -fno-exceptions!
-            value.reserve(len);
-            for (size_t i = 0; i < len; ++i)
+            // do not allocate for a length which cannot be read
+            return Result<vector<uint8_t, ALLOC>>::error(ErrorCode::EndOfStream);
+        }
+        if ((beginBitPosition & 0x07U) != 0 || m_windowState != nullptr)
+        {
+            // we are not aligned to byte or the bytes can span more windows
+            // TODO: This constructor may abort if allocation fails with -fno-exceptions!
+            vector<uint8_t, ALLOC> value(len, 0, alloc);
+            auto readResult = readRawBytes(Span<uint8_t>(value.data(), len));
+            if (readResult.isError())
             {
-                auto byteResult = readByte();
-                if (byteResult.isError())
-                {
-                    return Result<vector<uint8_t, ALLOC>>::error(byteResult.getError());
-                }
-                value.push_back(byteResult.getValue());
+                return Result<vector<uint8_t, ALLOC>>::error(readResult.getError());
             }
             return Result<vector<uint8_t, ALLOC>>::success(std::move(value));
         }
@@ -300,23 +468,23 @@ public:
         const size_t len = static_cast<size_t>(lenResult.getValue());
         
         const BitPosType beginBitPosition = getBitPosition();
-        if ((beginBitPosition & 0x07U) != 0)
+        if (len > (getBufferBitSize() - beginBitPosition) / 8)
         {
-            // we are not aligned to byte
-            string<ALLOC> value{alloc};
-            // TODO: This reserve() may abort if allocation fails with -fno-exceptions!
-            value.reserve(len);
-            for (size_t i = 0; i < len; ++i)
+            // do not allocate for a length which cannot be read
+            return Result<string<ALLOC>>::error(ErrorCode::EndOfStream);
+        }
+        if ((beginBitPosition & 0x07U) != 0 || m_windowState != nullptr)
+        {
+            // we are not aligned to byte or the string can span more windows
+            // TODO: This constructor may abort if allocation fails with -fno-exceptions!
+            string<ALLOC> value(len, '\0', alloc);
+            if (len > 0)
             {
-                using char_traits = std::char_traits<char>;
-                auto byteResult = readByte();
-                if (byteResult.isError())
+                auto readResult = readRawBytes(Span<uint8_t>(reinterpret_cast<uint8_t*>(&value[0]), len));
+                if (readResult.isError())
                 {
-                    return Result<string<ALLOC>>::error(byteResult.getError());
+                    return Result<string<ALLOC>>::error(readResult.getError());
                 }
-                const char readCharacter =
-                        char_traits::to_char_type(static_cast<char_traits::int_type>(byteResult.getValue()));
-                value.push_back(readCharacter);
             }
             return Result<string<ALLOC>>::success(std::move(value));
         }
@@ -333,6 +501,28 @@ public:
         }
     }
 
+    /**
+     * Reads bytes without copying them.
+     *
+     * The returned view points into the buffer of this reader and thus it is valid only as long as the buffer.
+     * Bytes can be viewed only at byte aligned positions.
+     *
+     * \return Result with view of read bytes or error code (InvalidAlignment when the position is not aligned,
+     *         InvalidPointer when a windowed reader does not hold the bytes in a stable buffer).
+     */
+    Result<BytesView> readBytesView() noexcept;
+
+    /**
+     * Reads an UTF-8 string without copying it.
+     *
+     * The returned view points into the buffer of this reader and thus it is valid only as long as the buffer.
+     * Strings can be viewed only at byte aligned positions.
+     *
+     * \return Result with view of read string or error code (InvalidAlignment when the position is not aligned,
+     *         InvalidPointer when a windowed reader does not hold the string in a stable buffer).
+     */
+    Result<StringView> readStringView() noexcept;
+
     /**
      * Reads bool as a single bit.
      *
@@ -358,35 +548,24 @@ public:
         const size_t bitSize = static_cast<size_t>(sizeResult.getValue());
         const size_t numBytesToRead = bitSize / 8;
         const uint8_t numRestBits = static_cast<uint8_t>(bitSize - numBytesToRead * 8);
-        
-        // TODO: BitBuffer constructor may abort if allocation fails with -fno-exceptions!
-        BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>> bitBuffer(bitSize, allocator);
-        Span<uint8_t> buffer = bitBuffer.getData();
-        const BitPosType beginBitPosition = getBitPosition();
-        const Span<uint8_t>::iterator itEnd = buffer.begin() + numBytesToRead;
-        if ((beginBitPosition & 0x07U) != 0)
+        if (bitSize > getBufferBitSize() - getBitPosition())
         {
-            // we are not aligned to byte
-            for (Span<uint8_t>::iterator it = buffer.begin(); it != itEnd; ++it)
-            {
-                auto byteResult = readBits(8);
-                if (byteResult.isError())
-                {
-                    return Result<BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>>>::error(byteResult.getError());
-                }
-                *it = static_cast<uint8_t>(byteResult.getValue());
-            }
+            // do not allocate for a size which cannot be read
+            return Result<BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>>>::error(ErrorCode::EndOfStream);
         }
-        else
+
+        auto bitBufferResult = BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>>::create(bitSize, allocator);
+        if (bitBufferResult.isError())
         {
-            // we are aligned to byte
-            auto setPosResult = setBitPosition(beginBitPosition + numBytesToRead * 8);
-            if (setPosResult.isError())
-            {
-                return Result<BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>>>::error(setPosResult.getError());
-            }
-            Span<const uint8_t>::const_iterator sourceIt = m_context.buffer.begin() + beginBitPosition / 8;
-            (void)std::copy(sourceIt, sourceIt + numBytesToRead, buffer.begin());
+            return Result<BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>>>::error(bitBufferResult.getError());
+        }
+        BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>> bitBuffer = std::move(bitBufferResult.getValue());
+        Span<uint8_t> buffer = bitBuffer.getData();
+        const Span<uint8_t>::iterator itEnd = buffer.begin() + numBytesToRead;
+        auto readResult = readRawBytes(buffer.first(numBytesToRead));
+        if (readResult.isError())
+        {
+            return Result<BasicBitBuffer<RebindAlloc<ALLOC, uint8_t>>>::error(readResult.getError());
         }
 
         if (numRestBits > 0)
@@ -430,6 +609,40 @@ public:
      */
     Result<void> alignTo(size_t alignment) noexcept;
 
+    /**
+     * Moves current bit position forward by the given number of bits without reading them.
+     *
+     * \param numBits Number of bits to skip.
+     *
+     * \return Result indicating success or error code (EndOfStream when the bits are not available).
+     */
+    Result<void> skipBits(size_t numBits) noexcept;
+
+    /**
+     * Skips bytes without reading them. Only the length prefix is read.
+     *
+     * \return Result indicating success or error code.
+     */
+    Result<void> skipBytes() noexcept;
+
+    /**
+     * Skips an UTF-8 string without reading it. Only the length prefix is read.
+     *
+     * \return Result indicating success or error code.
+     */
+    Result<void> skipString() noexcept
+    {
+        // strings are encoded as bytes
+        return skipBytes();
+    }
+
+    /**
+     * Skips a bit buffer without reading it. Only the bit size prefix is read.
+     *
+     * \return Result indicating success or error code.
+     */
+    Result<void> skipBitBuffer() noexcept;
+
     /**
      * Gets size of the underlying buffer in bits.
      *
@@ -437,13 +650,100 @@ public:
      */
     size_t getBufferBitSize() const
     {
-        return m_context.bufferBitSize;
+        return (m_windowState != nullptr) ? m_windowState->streamBitSize : m_context.bufferBitSize;
     }
 
+    /**
+     * Creates an independent reader of the same buffer positioned at the given bit position.
+     *
+     * Readers of disjoint parts of the buffer can be used concurrently. Windowed readers cannot be forked.
+     *
+     * \param bitPosition Bit position of the new reader.
+     *
+     * \return New reader or error code (InvalidOperation for windowed readers).
+     */
+    Result<BitStreamReader> fork(BitPosType bitPosition) const noexcept;
+
+protected:
+    /**
+     * Function which moves the window of a windowed reader.
+     *
+     * The function must pass a window which contains the bits [bitPosition, bitPosition + numBits), or all
+     * remaining bits of the stream when there are less of them, to setWindow(). The window must start at a
+     * byte aligned position not behind bitPosition and all its bytes except the last one of the stream must
+     * be whole. When the function fails, the last window passed to setWindow() must stay valid.
+     */
+    using RefillFunc = Result<void> (*)(BitStreamReader& reader, BitPosType bitPosition, size_t numBits);
+
+    /**
+     * State of a windowed reader which reads the stream through a sequence of windows.
+     *
+     * The state is owned by the windowed reader, the reader context of the base reader holds no buffer thus
+     * all reads of a windowed reader leave the fast path and are done within the current window.
+     */
+    struct WindowState
+    {
+        /**
+         * Constructor.
+         *
+         * \param windowRefillFunc Function called when a read does not fit into the current window.
+         * \param windowStreamBitSize Size of the whole stream in bits.
+         */
+        WindowState(RefillFunc windowRefillFunc, size_t windowStreamBitSize) noexcept;
+
+        RefillFunc refillFunc; /**< Function which moves the window. */
+        size_t streamBitSize; /**< Size of the whole stream in bits. */
+        Span<const uint8_t> buffer; /**< Bytes of the current window. */
+        BitPosType bufferBitSize; /**< Number of valid bits in the current window. */
+        BitPosType bitPosition; /**< Bit position of the first bit of the current window in the stream. */
+        bool isStable; /**< True when the window bytes outlive the reader. */
+        ErrorCode refillError; /**< First error of the refill function, reported instead of the end of stream. */
+    };
+
+    /**
+     * Constructor of a windowed reader.
+     *
+     * The reader starts at bit position zero without any window, the first read calls the refill function.
+     * The window state is only stored, thus it can be a member of the derived reader which is not yet constructed.
+     *
+     * \param windowState State of the windowed reader which must outlive the reader.
+     */
+    explicit BitStreamReader(WindowState& windowState) noexcept;
+
+    /**
+     * Sets the current window of a windowed reader.
+     *
+     * \param window Bytes of the window.
+     * \param windowBitSize Number of valid bits in the window.
+     * \param windowBitPosition Bit position of the first bit of the window in the stream.
+     * \param isStable True when the window bytes outlive the reader, thus views into them can be returned.
+     */
+    void setWindow(Span<const uint8_t> window, size_t windowBitSize, BitPosType windowBitPosition,
+            bool isStable) noexcept;
+
 private:
+    friend class BitStreamWriter;
+
     Result<uint8_t> readByte() noexcept;
+    Result<const uint8_t*> readAlignedBytes(size_t& len) noexcept;
+    Result<void> readRawBytes(Span<uint8_t> data) noexcept;
+    Result<size_t> readWindowBits(size_t numBits, const uint8_t*& data, uint8_t& bitOffset, bool& isStable) noexcept;
+
+    template <typename T, typename READ>
+    Result<T> readWindowed(size_t numBits, READ read) noexcept;
+    template <typename T>
+    Result<void> readWindowedBitsArray(Span<T> values, uint8_t numBits) noexcept;
+    template <typename FORMAT>
+    Result<void> readWindowedVarNumArray(Span<typename FORMAT::Type> values) noexcept;
+    Result<const uint8_t*> readWindowedAlignedBytes(BitPosType beginBitPosition, size_t len) noexcept;
+    Result<void> readWindowedRawBytes(Span<uint8_t> data) noexcept;
+    Result<void> setWindowedBitPosition(BitPosType position) noexcept;
+    ErrorCode prepareWindow(size_t numBits) noexcept;
+    BitStreamReader openWindow() const noexcept;
+    void closeWindow(const BitStreamReader& windowReader) noexcept;
 
     ReaderContext m_context;
+    WindowState* m_windowState;
 };
 
 } // namespace zserio
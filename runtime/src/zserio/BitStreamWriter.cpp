@@ -2,9 +2,18 @@
 #include <array>
 #include <cstring>
 #include <fstream>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <utility>
 
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+#include "zserio/BitPackingUtil.h"
 #include "zserio/BitSizeOfCalculator.h"
+#include "zserio/BitStreamReader.h"
 #include "zserio/BitStreamWriter.h"
 #include "zserio/FloatUtil.h"
 
@@ -323,10 +332,158 @@ static const std::array<int64_t, 65> MAX_I64_VALUES = {
         0x7fffffffffffffffLL,
 };
 
+// writers with grow function get long arrays in chunks, thus their buffers need not hold a whole array
+static const size_t GROW_CHUNK_BIT_SIZE = 32 * 1024 * 8;
+
+namespace
+{
+
+// number of values packed at once when they must be widened or masked first
+const size_t PACK_BLOCK_SIZE = 64;
+
+template <typename T>
+bool unsignedValuesFit(Span<const T> values, uint8_t numBits)
+{
+    T orValue = 0;
+    for (T value : values)
+    {
+        orValue = static_cast<T>(orValue | value);
+    }
+
+    return orValue <= MAX_U64_VALUES[numBits];
+}
+
+template <typename T>
+bool signedValuesFit(Span<const T> values, uint8_t numBits)
+{
+    T minValue = 0;
+    T maxValue = 0;
+    for (T value : values)
+    {
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    return minValue >= MIN_I64_VALUES[numBits] && maxValue <= MAX_I64_VALUES[numBits];
+}
+
+/** Packs values through a block of 32/64-bit lanes keeping only numBits bits of each value. */
+template <typename LANE_TYPE, typename T>
+void packBlocks(uint8_t* buffer, size_t position, uint8_t numBits, const T* values, size_t count)
+{
+    using UnsignedType = typename std::make_unsigned<T>::type;
+    const LANE_TYPE mask = static_cast<LANE_TYPE>(MAX_U64_VALUES[numBits]);
+    std::array<LANE_TYPE, PACK_BLOCK_SIZE> block;
+    while (count > 0)
+    {
+        const size_t blockCount = std::min(count, PACK_BLOCK_SIZE);
+        for (size_t i = 0; i < blockCount; ++i)
+        {
+            block[i] = static_cast<LANE_TYPE>(static_cast<UnsignedType>(values[i])) & mask;
+        }
+        detail::packBits(buffer, position, numBits, block.data(), blockCount);
+        position += blockCount * numBits;
+        values += blockCount;
+        count -= blockCount;
+    }
+}
+
+void packValues(uint8_t* buffer, size_t position, uint8_t numBits, const uint8_t* values, size_t count)
+{
+    if (numBits == 8 && (position & 0x07U) == 0)
+    {
+        std::memcpy(buffer + position / 8, values, count);
+    }
+    else
+    {
+        packBlocks<uint32_t>(buffer, position, numBits, values, count);
+    }
+}
+
+void packValues(uint8_t* buffer, size_t position, uint8_t numBits, const uint16_t* values, size_t count)
+{
+    if (numBits == 16 && (position & 0x07U) == 0)
+    {
+        detail::storeBigEndian(buffer + position / 8, values, count);
+    }
+    else
+    {
+        packBlocks<uint32_t>(buffer, position, numBits, values, count);
+    }
+}
+
+void packValues(uint8_t* buffer, size_t position, uint8_t numBits, const uint32_t* values, size_t count)
+{
+    if (numBits == 32 && (position & 0x07U) == 0)
+    {
+        detail::storeBigEndian(buffer + position / 8, values, count);
+    }
+    else
+    {
+        detail::packBits(buffer, position, numBits, values, count);
+    }
+}
+
+void packValues(uint8_t* buffer, size_t position, uint8_t numBits, const uint64_t* values, size_t count)
+{
+    if (numBits == 64 && (position & 0x07U) == 0)
+    {
+        detail::storeBigEndian(buffer + position / 8, values, count);
+    }
+    else
+    {
+        detail::packBits(buffer, position, numBits, values, count);
+    }
+}
+
+template <typename T>
+void packSignedValues(uint8_t* buffer, size_t position, uint8_t numBits, const T* values, size_t count)
+{
+    using UnsignedType = typename std::make_unsigned<T>::type;
+    if (numBits == sizeof(T) * 8)
+    {
+        // signed and unsigned variants of the same type may alias each other
+        packValues(buffer, position, numBits, reinterpret_cast<const UnsignedType*>(values), count);
+    }
+    else
+    {
+        using LaneType = typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type;
+        packBlocks<LaneType>(buffer, position, numBits, values, count);
+    }
+}
+
+// stores 64 bits of the write cache as 8 big-endian bytes by a single unaligned store
+inline void storeCacheWord(uint8_t* buffer, uint64_t value)
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = __builtin_bswap64(value);
+    std::memcpy(buffer, &value, sizeof(value));
+#elif defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    std::memcpy(buffer, &value, sizeof(value));
+#elif defined(_MSC_VER)
+    value = _byteswap_uint64(value);
+    std::memcpy(buffer, &value, sizeof(value));
+#else
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        buffer[i] = static_cast<uint8_t>(value >> (56U - 8U * i));
+    }
+#endif
+}
+
+} // namespace
+
 BitStreamWriter::BitStreamWriter(uint8_t* buffer, size_t bufferBitSize, BitsTag) noexcept :
         m_buffer(buffer, (bufferBitSize + 7) / 8),
         m_bitIndex(0),
-        m_bufferBitSize(bufferBitSize)
+        m_bufferBitSize(bufferBitSize),
+        m_cache(0),
+        m_cacheNumBits(0),
+        m_hasWriteCache(false),
+        m_growFunc(nullptr),
+        m_rawBytesFunc(nullptr),
+        m_bitPositionBase(0),
+        m_offsetPatcher(nullptr)
 {}
 
 BitStreamWriter::BitStreamWriter(uint8_t* buffer, size_t bufferByteSize) noexcept :
@@ -336,17 +493,160 @@ BitStreamWriter::BitStreamWriter(uint8_t* buffer, size_t bufferByteSize) noexcep
 BitStreamWriter::BitStreamWriter(Span<uint8_t> buffer) noexcept :
         m_buffer(buffer),
         m_bitIndex(0),
-        m_bufferBitSize(buffer.size() * 8)
+        m_bufferBitSize(buffer.size() * 8),
+        m_cache(0),
+        m_cacheNumBits(0),
+        m_hasWriteCache(false),
+        m_growFunc(nullptr),
+        m_rawBytesFunc(nullptr),
+        m_bitPositionBase(0),
+        m_offsetPatcher(nullptr)
 {}
 
 BitStreamWriter::BitStreamWriter(Span<uint8_t> buffer, size_t bufferBitSize) noexcept :
         m_buffer(buffer),
         m_bitIndex(0),
-        m_bufferBitSize(bufferBitSize)
+        m_bufferBitSize(bufferBitSize),
+        m_cache(0),
+        m_cacheNumBits(0),
+        m_hasWriteCache(false),
+        m_growFunc(nullptr),
+        m_rawBytesFunc(nullptr),
+        m_bitPositionBase(0),
+        m_offsetPatcher(nullptr)
 {
     // Note: Buffer size validation is deferred to the factory method
 }
 
+BitStreamWriter::BitStreamWriter(GrowFunc growFunc) noexcept :
+        m_buffer(),
+        m_bitIndex(0),
+        m_bufferBitSize(0),
+        m_cache(0),
+        m_cacheNumBits(0),
+        m_hasWriteCache(false),
+        m_growFunc(growFunc),
+        m_rawBytesFunc(nullptr),
+        m_bitPositionBase(0),
+        m_offsetPatcher(nullptr)
+{}
+
+BitStreamWriter::~BitStreamWriter()
+{
+    flush();
+}
+
+BitStreamWriter::BitStreamWriter(BitStreamWriter&& other) noexcept :
+        m_buffer(other.m_buffer),
+        m_bitIndex(other.m_bitIndex),
+        m_bufferBitSize(other.m_bufferBitSize),
+        m_cache(other.m_cache),
+        m_cacheNumBits(other.m_cacheNumBits),
+        m_hasWriteCache(other.m_hasWriteCache),
+        m_growFunc(other.m_growFunc),
+        m_rawBytesFunc(other.m_rawBytesFunc),
+        m_bitPositionBase(other.m_bitPositionBase),
+        m_offsetPatcher(other.m_offsetPatcher)
+{
+    // cached bits are flushed by the new owner only
+    other.m_cacheNumBits = 0;
+}
+
+BitStreamWriter& BitStreamWriter::operator=(BitStreamWriter&& other) noexcept
+{
+    if (this != &other)
+    {
+        flush();
+        m_buffer = other.m_buffer;
+        m_bitIndex = other.m_bitIndex;
+        m_bufferBitSize = other.m_bufferBitSize;
+        m_cache = other.m_cache;
+        m_cacheNumBits = other.m_cacheNumBits;
+        m_hasWriteCache = other.m_hasWriteCache;
+        m_growFunc = other.m_growFunc;
+        m_rawBytesFunc = other.m_rawBytesFunc;
+        m_bitPositionBase = other.m_bitPositionBase;
+        m_offsetPatcher = other.m_offsetPatcher;
+        other.m_cacheNumBits = 0;
+    }
+    return *this;
+}
+
+void BitStreamWriter::enableWriteCache() noexcept
+{
+    if (hasWriteBuffer() && !m_hasWriteCache)
+    {
+        m_hasWriteCache = true;
+        reloadCache();
+    }
+}
+
+void BitStreamWriter::flush() const noexcept
+{
+    if (m_cacheNumBits == 0)
+    {
+        return;
+    }
+
+    // cache starts always at a byte aligned position, keep the cache untouched to allow repeated flushing
+    uint8_t* buffer = m_buffer.data() + (m_bitIndex - m_cacheNumBits) / 8;
+    uint8_t restNumBits = m_cacheNumBits;
+    while (restNumBits >= 8)
+    {
+        restNumBits = static_cast<uint8_t>(restNumBits - 8);
+        *buffer++ = static_cast<uint8_t>(m_cache >> restNumBits);
+    }
+
+    if (restNumBits > 0)
+    {
+        const uint8_t shiftNum = static_cast<uint8_t>(8 - restNumBits);
+        const uint8_t maskedByte = static_cast<uint8_t>(*buffer & (0xFFU >> restNumBits));
+        *buffer = static_cast<uint8_t>(maskedByte | ((m_cache & MAX_U64_VALUES[restNumBits]) << shiftNum));
+    }
+}
+
+void BitStreamWriter::setRawBytesFunc(RawBytesFunc rawBytesFunc) noexcept
+{
+    m_rawBytesFunc = rawBytesFunc;
+}
+
+void BitStreamWriter::setGrownBuffer(Span<uint8_t> buffer) noexcept
+{
+    m_buffer = buffer;
+    m_bufferBitSize = buffer.size() * 8;
+}
+
+void BitStreamWriter::detachBuffer() noexcept
+{
+    flush();
+    m_buffer = Span<uint8_t>();
+    m_bitIndex = 0;
+    m_bufferBitSize = 0;
+    m_cache = 0;
+    m_cacheNumBits = 0;
+    m_bitPositionBase = 0;
+}
+
+void BitStreamWriter::startSegment(size_t skipByteSize) noexcept
+{
+    flush();
+    m_bitPositionBase += m_bitIndex + skipByteSize * 8;
+    m_buffer = Span<uint8_t>();
+    m_bitIndex = 0;
+    m_bufferBitSize = 0;
+    m_cache = 0;
+    m_cacheNumBits = 0;
+}
+
+void BitStreamWriter::discardBytes(size_t byteSize) noexcept
+{
+    m_bitPositionBase += byteSize * 8;
+    m_bitIndex -= byteSize * 8;
+    m_cache = 0;
+    m_cacheNumBits = 0;
+    reloadCache();
+}
+
 Result<BitStreamWriter> BitStreamWriter::create(Span<uint8_t> buffer, size_t bufferBitSize) noexcept
 {
     if (buffer.size() < (bufferBitSize + 7) / 8)
@@ -398,6 +698,108 @@ Result<void> BitStreamWriter::writeSignedBits64(int64_t data, uint8_t numBits) n
     return writeUnsignedBits64(static_cast<uint64_t>(data) & MAX_U64_VALUES[numBits], numBits);
 }
 
+template <typename T>
+Result<void> BitStreamWriter::writeBitsArrayImpl(Span<const T> values, uint8_t numBits) noexcept
+{
+    if (numBits == 0 || numBits > sizeof(T) * 8 || !unsignedValuesFit(values, numBits))
+    {
+        return Result<void>::error(ErrorCode::InvalidParameter);
+    }
+
+    const size_t chunkSize = (m_growFunc != nullptr) ? GROW_CHUNK_BIT_SIZE / numBits : values.size();
+    size_t index = 0;
+    do
+    {
+        const size_t numValues = std::min(chunkSize, values.size() - index);
+        auto result = checkBitsArrayCapacity(numValues, numBits);
+        if (result.isError())
+        {
+            return result;
+        }
+
+        if (hasWriteBuffer() && numValues > 0)
+        {
+            flush();
+            packValues(m_buffer.data(), m_bitIndex, numBits, values.data() + index, numValues);
+        }
+        moveCache(m_bitIndex + numValues * numBits);
+        index += numValues;
+    } while (index < values.size());
+
+    return Result<void>::success();
+}
+
+template <typename T>
+Result<void> BitStreamWriter::writeSignedBitsArrayImpl(Span<const T> values, uint8_t numBits) noexcept
+{
+    if (numBits == 0 || numBits > sizeof(T) * 8 || !signedValuesFit(values, numBits))
+    {
+        return Result<void>::error(ErrorCode::InvalidParameter);
+    }
+
+    const size_t chunkSize = (m_growFunc != nullptr) ? GROW_CHUNK_BIT_SIZE / numBits : values.size();
+    size_t index = 0;
+    do
+    {
+        const size_t numValues = std::min(chunkSize, values.size() - index);
+        auto result = checkBitsArrayCapacity(numValues, numBits);
+        if (result.isError())
+        {
+            return result;
+        }
+
+        if (hasWriteBuffer() && numValues > 0)
+        {
+            flush();
+            packSignedValues(m_buffer.data(), m_bitIndex, numBits, values.data() + index, numValues);
+        }
+        moveCache(m_bitIndex + numValues * numBits);
+        index += numValues;
+    } while (index < values.size());
+
+    return Result<void>::success();
+}
+
+Result<void> BitStreamWriter::writeBitsArray(Span<const uint8_t> values, uint8_t numBits) noexcept
+{
+    return writeBitsArrayImpl(values, numBits);
+}
+
+Result<void> BitStreamWriter::writeBitsArray(Span<const uint16_t> values, uint8_t numBits) noexcept
+{
+    return writeBitsArrayImpl(values, numBits);
+}
+
+Result<void> BitStreamWriter::writeBitsArray(Span<const uint32_t> values, uint8_t numBits) noexcept
+{
+    return writeBitsArrayImpl(values, numBits);
+}
+
+Result<void> BitStreamWriter::writeBits64Array(Span<const uint64_t> values, uint8_t numBits) noexcept
+{
+    return writeBitsArrayImpl(values, numBits);
+}
+
+Result<void> BitStreamWriter::writeSignedBitsArray(Span<const int8_t> values, uint8_t numBits) noexcept
+{
+    return writeSignedBitsArrayImpl(values, numBits);
+}
+
+Result<void> BitStreamWriter::writeSignedBitsArray(Span<const int16_t> values, uint8_t numBits) noexcept
+{
+    return writeSignedBitsArrayImpl(values, numBits);
+}
+
+Result<void> BitStreamWriter::writeSignedBitsArray(Span<const int32_t> values, uint8_t numBits) noexcept
+{
+    return writeSignedBitsArrayImpl(values, numBits);
+}
+
+Result<void> BitStreamWriter::writeSignedBits64Array(Span<const int64_t> values, uint8_t numBits) noexcept
+{
+    return writeSignedBitsArrayImpl(values, numBits);
+}
+
 Result<void> BitStreamWriter::writeVarInt64(int64_t data) noexcept
 {
     auto sizeResult = zserio::bitSizeOfVarInt64(data);
@@ -528,33 +930,7 @@ Result<void> BitStreamWriter::writeBytes(Span<const uint8_t> data) noexcept
         return sizeResult;
     }
 
-    const BitPosType beginBitPosition = getBitPosition();
-    if ((beginBitPosition & 0x07U) != 0)
-    {
-        // we are not aligned to byte
-        for (size_t i = 0; i < len; ++i)
-        {
-            auto result = writeBits(data[i], 8);
-            if (result.isError())
-            {
-                return result;
-            }
-        }
-    }
-    else
-    {
-        // we are aligned to bytes
-        auto posResult = setBitPosition(beginBitPosition + len * 8);
-        if (posResult.isError())
-        {
-            return posResult;
-        }
-        if (hasWriteBuffer())
-        {
-            (void)std::copy(data.begin(), data.end(), m_buffer.begin() + beginBitPosition / 8);
-        }
-    }
-    return Result<void>::success();
+    return writeRawBytes(data);
 }
 
 Result<void> BitStreamWriter::writeString(StringView data) noexcept
@@ -572,52 +948,102 @@ Result<void> BitStreamWriter::writeString(StringView data) noexcept
         return sizeResult;
     }
 
-    const BitPosType beginBitPosition = getBitPosition();
-    if ((beginBitPosition & 0x07U) != 0)
+    return writeRawBytes(Span<const uint8_t>(reinterpret_cast<const uint8_t*>(data.data()), len));
+}
+
+Result<void> BitStreamWriter::writeBool(bool data) noexcept
+{
+    return writeBits((data ? 1 : 0), 1);
+}
+
+Result<void> BitStreamWriter::writeBitsFrom(BitStreamReader& in, size_t numBits) noexcept
+{
+    const BitPosType beginBitPosition = in.getBitPosition();
+    if (numBits > in.getBufferBitSize() - beginBitPosition)
+    {
+        return Result<void>::error(ErrorCode::EndOfStream);
+    }
+
+    // fixed buffer is checked before the leading bits are written
+    if (m_growFunc == nullptr && hasWriteBuffer() && numBits > m_bufferBitSize - m_bitIndex)
     {
-        // we are not aligned to byte
-        for (size_t i = 0; i < len; ++i)
-        {
-            auto result = writeBits(static_cast<uint32_t>(std::char_traits<char>::to_int_type(data[i])), 8);
-            if (result.isError())
-            {
-                return result;
-            }
-        }
+        return Result<void>::error(ErrorCode::BufferOverflow);
     }
-    else
+
+    // bits are copied window by window, bytes of unstable windows must not be referenced
+    while (numBits > 0)
     {
-        // we are aligned to bytes
-        auto posResult = setBitPosition(beginBitPosition + len * 8);
-        if (posResult.isError())
+        const uint8_t* data = nullptr;
+        uint8_t bitOffset = 0;
+        bool isStable = false;
+        auto readResult = in.readWindowBits(numBits, data, bitOffset, isStable);
+        if (readResult.isError())
         {
-            return posResult;
+            (void)in.setBitPosition(beginBitPosition);
+            return Result<void>::error(readResult.getError());
         }
-        if (hasWriteBuffer())
+
+        const size_t numWindowBits = readResult.getValue();
+        auto writeResult = writeWindowBits(data, bitOffset, numWindowBits, isStable);
+        if (writeResult.isError())
         {
-            (void)std::copy(data.begin(), data.begin() + len, m_buffer.data() + beginBitPosition / 8);
+            (void)in.setBitPosition(beginBitPosition);
+            return writeResult;
         }
+        numBits -= numWindowBits;
     }
+
     return Result<void>::success();
 }
 
-Result<void> BitStreamWriter::writeBool(bool data) noexcept
+Result<BitStreamWriter> BitStreamWriter::fork(BitPosType beginBitPosition, BitPosType endBitPosition) const noexcept
 {
-    return writeBits((data ? 1 : 0), 1);
+    if (m_growFunc != nullptr || m_buffer.data() == nullptr)
+    {
+        return Result<BitStreamWriter>::error(ErrorCode::InvalidOperation);
+    }
+    if (beginBitPosition > endBitPosition)
+    {
+        return Result<BitStreamWriter>::error(ErrorCode::InvalidParameter);
+    }
+    if (endBitPosition > m_bufferBitSize)
+    {
+        return Result<BitStreamWriter>::error(ErrorCode::BufferOverflow);
+    }
+
+    BitStreamWriter writer(m_buffer.data(), endBitPosition, BitsTag());
+    if (m_hasWriteCache)
+    {
+        writer.enableWriteCache();
+    }
+    auto positionResult = writer.setBitPosition(beginBitPosition);
+    if (positionResult.isError())
+    {
+        return Result<BitStreamWriter>::error(positionResult.getError());
+    }
+
+    return Result<BitStreamWriter>::success(std::move(writer));
 }
 
 Result<void> BitStreamWriter::setBitPosition(BitPosType position) noexcept
 {
+    // bits of previous segments and discarded bytes are not accessible anymore
+    if (position < m_bitPositionBase)
+    {
+        return Result<void>::error(ErrorCode::InvalidParameter);
+    }
+
     if (hasWriteBuffer())
     {
-        auto result = checkCapacity(position);
+        auto result = checkCapacity(position - m_bitPositionBase);
         if (result.isError())
         {
             return result;
         }
     }
 
-    m_bitIndex = position;
+    // the grow function can discard bytes and move the base
+    moveCache(position - m_bitPositionBase);
     return Result<void>::success();
 }
 
@@ -634,16 +1060,23 @@ Result<void> BitStreamWriter::alignTo(size_t alignment) noexcept
 
 const uint8_t* BitStreamWriter::getWriteBuffer() const noexcept
 {
+    flush();
     return m_buffer.data();
 }
 
 Span<const uint8_t> BitStreamWriter::getBuffer() const noexcept
 {
+    flush();
     return m_buffer;
 }
 
 Result<void> BitStreamWriter::writeUnsignedBits(uint32_t data, uint8_t numBits) noexcept
 {
+    if (m_hasWriteCache)
+    {
+        return writeUnsignedBits64(data, numBits);
+    }
+
     if (!hasWriteBuffer())
     {
         m_bitIndex += numBits;
@@ -696,6 +1129,18 @@ Result<void> BitStreamWriter::writeUnsignedBits(uint32_t data, uint8_t numBits)
 
 inline Result<void> BitStreamWriter::writeUnsignedBits64(uint64_t data, uint8_t numBits) noexcept
 {
+    if (m_hasWriteCache)
+    {
+        auto result = checkCapacity(m_bitIndex + numBits);
+        if (result.isError())
+        {
+            return result;
+        }
+
+        writeCachedBits(data, numBits);
+        return Result<void>::success();
+    }
+
     if (numBits <= 32)
     {
         return writeUnsignedBits(static_cast<uint32_t>(data), numBits);
@@ -768,13 +1213,150 @@ inline Result<void> BitStreamWriter::writeVarNum(
     return Result<void>::success();
 }
 
-inline Result<void> BitStreamWriter::checkCapacity(size_t bitSize) const noexcept
+Result<void> BitStreamWriter::writeRawBytes(Span<const uint8_t> data, bool canReference) noexcept
+{
+    if (m_rawBytesFunc != nullptr && canReference && (m_bitIndex & 0x07U) == 0)
+    {
+        auto takeResult = m_rawBytesFunc(*this, data);
+        if (takeResult.isError())
+        {
+            return Result<void>::error(takeResult.getError());
+        }
+        if (takeResult.getValue())
+        {
+            return Result<void>::success();
+        }
+    }
+
+    const size_t chunkSize = (m_growFunc != nullptr) ? GROW_CHUNK_BIT_SIZE / 8 : data.size();
+    size_t index = 0;
+    do
+    {
+        const size_t numBytes = std::min(chunkSize, data.size() - index);
+        auto capacityResult = checkBitsArrayCapacity(numBytes, 8);
+        if (capacityResult.isError())
+        {
+            return capacityResult;
+        }
+
+        if (hasWriteBuffer())
+        {
+            flush();
+            detail::packBytes(m_buffer.data() + m_bitIndex / 8, static_cast<uint8_t>(m_bitIndex & 0x07U),
+                    data.data() + index, numBytes);
+        }
+        moveCache(m_bitIndex + numBytes * 8);
+        index += numBytes;
+    } while (index < data.size());
+
+    return Result<void>::success();
+}
+
+Result<void> BitStreamWriter::writeWindowBits(
+        const uint8_t* data, uint8_t bitOffset, size_t numBits, bool canReference) noexcept
+{
+    // leading bits up to the next source byte boundary
+    if (bitOffset != 0)
+    {
+        const uint8_t numLeadingBits = static_cast<uint8_t>(std::min<size_t>(numBits, 8U - bitOffset));
+        const uint32_t leadingBits = (static_cast<uint32_t>(*data) >> (8U - bitOffset - numLeadingBits)) &
+                ((1U << numLeadingBits) - 1U);
+        auto result = writeUnsignedBits(leadingBits, numLeadingBits);
+        if (result.isError())
+        {
+            return result;
+        }
+        numBits -= numLeadingBits;
+        ++data;
+    }
+
+    // whole source bytes are copied when the destination is aligned, otherwise they are shifted and merged
+    const size_t numBytes = numBits / 8;
+    if (numBytes > 0)
+    {
+        auto result = writeRawBytes(Span<const uint8_t>(data, numBytes), canReference);
+        if (result.isError())
+        {
+            return result;
+        }
+    }
+
+    const uint8_t numRestBits = static_cast<uint8_t>(numBits % 8);
+    if (numRestBits > 0)
+    {
+        return writeUnsignedBits(static_cast<uint32_t>(data[numBytes]) >> (8U - numRestBits), numRestBits);
+    }
+
+    return Result<void>::success();
+}
+
+inline void BitStreamWriter::writeCachedBits(uint64_t data, uint8_t numBits) noexcept
+{
+    const uint8_t freeNumBits = static_cast<uint8_t>(64 - m_cacheNumBits);
+    if (numBits < freeNumBits)
+    {
+        m_cache = (m_cache << numBits) | data;
+        m_cacheNumBits = static_cast<uint8_t>(m_cacheNumBits + numBits);
+    }
+    else
+    {
+        // complete the cache word and store it, the rest of data starts a new word
+        const uint8_t restNumBits = static_cast<uint8_t>(numBits - freeNumBits);
+        const uint64_t word = (freeNumBits == 64) ? data : ((m_cache << freeNumBits) | (data >> restNumBits));
+        storeCacheWord(m_buffer.data() + (m_bitIndex - m_cacheNumBits) / 8, word);
+        m_cache = data & MAX_U64_VALUES[restNumBits];
+        m_cacheNumBits = restNumBits;
+    }
+    m_bitIndex += numBits;
+}
+
+void BitStreamWriter::moveCache(size_t bitIndex) noexcept
+{
+    // pending bits must be stored before the reload, which would drop them otherwise
+    flush();
+    m_bitIndex = bitIndex;
+    reloadCache();
+}
+
+void BitStreamWriter::reloadCache() noexcept
+{
+    if (!m_hasWriteCache)
+    {
+        return;
+    }
+
+    // cache must start at a byte aligned position, load already written bits of the current byte
+    m_cacheNumBits = static_cast<uint8_t>(m_bitIndex & 0x07U);
+    m_cache = (m_cacheNumBits > 0) ? static_cast<uint64_t>(m_buffer[m_bitIndex / 8] >> (8 - m_cacheNumBits)) : 0;
+}
+
+inline Result<void> BitStreamWriter::checkCapacity(size_t bitSize) noexcept
 {
     if (bitSize > m_bufferBitSize)
     {
+        if (m_growFunc != nullptr)
+        {
+            return m_growFunc(*this, bitSize);
+        }
         return Result<void>::error(ErrorCode::BufferOverflow);
     }
     return Result<void>::success();
 }
 
+inline Result<void> BitStreamWriter::checkBitsArrayCapacity(size_t numValues, uint8_t numBits) noexcept
+{
+    // division prevents overflow of numValues * numBits
+    const size_t maxBitSize = (hasWriteBuffer() && m_growFunc == nullptr) ? m_bufferBitSize
+                                                                           : std::numeric_limits<size_t>::max();
+    if (m_bitIndex > maxBitSize || numValues > (maxBitSize - m_bitIndex) / numBits)
+    {
+        return Result<void>::error(ErrorCode::BufferOverflow);
+    }
+    if (m_growFunc != nullptr)
+    {
+        return checkCapacity(m_bitIndex + numValues * numBits);
+    }
+    return Result<void>::success();
+}
+
 } // namespace zserio
@@ -16,6 +16,9 @@
 namespace zserio
 {
 
+class BitStreamReader;
+class IOffsetPatcher;
+
 /**
  * Writer class which allows to write various data to the bit stream.
  */
@@ -81,8 +84,10 @@ public:
 
     /**
      * Destructor.
+     *
+     * Flushes bits held in the write cache to the buffer.
      */
-    ~BitStreamWriter() = default;
+    ~BitStreamWriter();
 
     /**
      * Copying is disallowed, moving is allowed!
@@ -91,12 +96,28 @@ public:
     BitStreamWriter(const BitStreamWriter&) = delete;
     BitStreamWriter& operator=(const BitStreamWriter&) = delete;
 
-    BitStreamWriter(BitStreamWriter&&) = default;
-    BitStreamWriter& operator=(BitStreamWriter&&) = default;
+    BitStreamWriter(BitStreamWriter&& other) noexcept;
+    BitStreamWriter& operator=(BitStreamWriter&& other) noexcept;
     /**
      * \}
      */
 
+    /**
+     * Enables the 64-bit write cache.
+     *
+     * Written bits are collected in a 64-bit accumulator which is stored to the buffer by whole words. Bits held
+     * in the accumulator are flushed to the buffer by flush(), setBitPosition(), getWriteBuffer(), getBuffer()
+     * and by the destructor. The buffer must not be inspected directly before one of these calls.
+     */
+    void enableWriteCache() noexcept;
+
+    /**
+     * Flushes bits held in the write cache to the buffer.
+     *
+     * Does nothing when the write cache is not enabled.
+     */
+    void flush() const noexcept;
+
     /**
      * Writes unsigned bits up to 32 bits.
      *
@@ -137,6 +158,62 @@ public:
      */
     Result<void> writeSignedBits64(int64_t data, uint8_t numBits = 64) noexcept;
 
+    /**
+     * Writes a run of unsigned bit fields up to 32 bits each.
+     *
+     * Values and the buffer capacity are checked only once for the whole run. Nothing is written on error.
+     *
+     * \param values Values to write.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Success or error code.
+     * \{
+     */
+    Result<void> writeBitsArray(Span<const uint8_t> values, uint8_t numBits) noexcept;
+    Result<void> writeBitsArray(Span<const uint16_t> values, uint8_t numBits) noexcept;
+    Result<void> writeBitsArray(Span<const uint32_t> values, uint8_t numBits) noexcept;
+    /** \} */
+
+    /**
+     * Writes a run of unsigned bit fields up to 64 bits each.
+     *
+     * Values and the buffer capacity are checked only once for the whole run. Nothing is written on error.
+     *
+     * \param values Values to write.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Success or error code.
+     */
+    Result<void> writeBits64Array(Span<const uint64_t> values, uint8_t numBits) noexcept;
+
+    /**
+     * Writes a run of signed bit fields up to 32 bits each.
+     *
+     * Values and the buffer capacity are checked only once for the whole run. Nothing is written on error.
+     *
+     * \param values Values to write.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Success or error code.
+     * \{
+     */
+    Result<void> writeSignedBitsArray(Span<const int8_t> values, uint8_t numBits) noexcept;
+    Result<void> writeSignedBitsArray(Span<const int16_t> values, uint8_t numBits) noexcept;
+    Result<void> writeSignedBitsArray(Span<const int32_t> values, uint8_t numBits) noexcept;
+    /** \} */
+
+    /**
+     * Writes a run of signed bit fields up to 64 bits each.
+     *
+     * Values and the buffer capacity are checked only once for the whole run. Nothing is written on error.
+     *
+     * \param values Values to write.
+     * \param numBits Number of bits of each value.
+     *
+     * \return Success or error code.
+     */
+    Result<void> writeSignedBits64Array(Span<const int64_t> values, uint8_t numBits) noexcept;
+
     /**
      * Writes signed variable integer up to 64 bits.
      *
@@ -298,33 +375,11 @@ public:
         Span<const uint8_t> buffer = bitBuffer.getData();
         size_t numBytesToWrite = bitSize / 8;
         const uint8_t numRestBits = static_cast<uint8_t>(bitSize - numBytesToWrite * 8);
-        const BitPosType beginBitPosition = getBitPosition();
         const Span<const uint8_t>::iterator itEnd = buffer.begin() + numBytesToWrite;
-        if ((beginBitPosition & 0x07U) != 0)
-        {
-            // we are not aligned to byte
-            for (Span<const uint8_t>::iterator it = buffer.begin(); it != itEnd; ++it)
-            {
-                auto result = writeUnsignedBits(*it, 8);
-                if (result.isError())
-                {
-                    return result;
-                }
-            }
-        }
-        else
+        auto bytesResult = writeRawBytes(buffer.first(numBytesToWrite));
+        if (bytesResult.isError())
         {
-            // we are aligned to byte
-            auto posResult = setBitPosition(beginBitPosition + numBytesToWrite * 8);
-            if (posResult.isError())
-            {
-                return posResult;
-            }
-            if (hasWriteBuffer())
-            {
-                (void)std::copy(buffer.begin(), buffer.begin() + numBytesToWrite,
-                        m_buffer.data() + beginBitPosition / 8);
-            }
+            return bytesResult;
         }
 
         if (numRestBits > 0)
@@ -339,6 +394,21 @@ public:
         return Result<void>::success();
     }
 
+    /**
+     * Copies encoded bits from the bit stream reader without decoding them.
+     *
+     * The bits are copied by memcpy when both streams are at the same bit offset within a byte, otherwise the
+     * source bytes are shifted and merged into the destination. Referencing writers like
+     * SegmentedBitStreamWriter can reference large ranges of readers whose buffer outlives them.
+     *
+     * \param in Bit stream reader positioned at the first bit to copy.
+     * \param numBits Number of bits to copy.
+     *
+     * \return Success or error code. On error the reader stays at its original position, a writer with
+     *         a fixed buffer too small for the bits reports BufferOverflow before it writes anything.
+     */
+    Result<void> writeBitsFrom(BitStreamReader& in, size_t numBits) noexcept;
+
     /**
      * Gets current bit position.
      *
@@ -346,7 +416,7 @@ public:
      */
     BitPosType getBitPosition() const
     {
-        return m_bitIndex;
+        return m_bitPositionBase + m_bitIndex;
     }
 
     /**
@@ -374,7 +444,7 @@ public:
      */
     bool hasWriteBuffer() const
     {
-        return m_buffer.data() != nullptr;
+        return m_buffer.data() != nullptr || m_growFunc != nullptr;
     }
 
     /**
@@ -391,6 +461,28 @@ public:
      */
     Span<const uint8_t> getBuffer() const noexcept;
 
+    /**
+     * Sets offset patcher used by single pass serialization.
+     *
+     * When set, generated code registers offset fields in the patcher instead of checking their values.
+     *
+     * \param offsetPatcher Offset patcher to use or nullptr to check offsets.
+     */
+    void setOffsetPatcher(IOffsetPatcher* offsetPatcher) noexcept
+    {
+        m_offsetPatcher = offsetPatcher;
+    }
+
+    /**
+     * Gets offset patcher used by single pass serialization.
+     *
+     * \return Offset patcher or nullptr when offsets are checked.
+     */
+    IOffsetPatcher* getOffsetPatcher() const noexcept
+    {
+        return m_offsetPatcher;
+    }
+
     /**
      * Gets size of the underlying buffer in bits.
      *
@@ -401,6 +493,86 @@ public:
         return m_bufferBitSize;
     }
 
+    /**
+     * Creates an independent writer of the given bit range of the same buffer.
+     *
+     * Writers of disjoint bytes of the buffer can be used concurrently. The new writer cannot write behind
+     * the end of the range and it does not use the offset patcher. Bits held in the write cache of this writer
+     * are not visible to the new writer, call flush() before. Writers which grow their buffer cannot be forked.
+     *
+     * \param beginBitPosition Bit position of the new writer.
+     * \param endBitPosition Bit position of the end of the range.
+     *
+     * \return New writer or error code (InvalidOperation for growing writers).
+     */
+    Result<BitStreamWriter> fork(BitPosType beginBitPosition, BitPosType endBitPosition) const noexcept;
+
+protected:
+    /**
+     * Function which grows the buffer of the writer to hold at least the given number of bits.
+     *
+     * The function must pass the grown buffer, which already contains all bytes written so far, to
+     * setGrownBuffer().
+     */
+    using GrowFunc = Result<void> (*)(BitStreamWriter& writer, size_t bitSize);
+
+    /**
+     * Constructor of a writer which grows its buffer on demand.
+     *
+     * \param growFunc Function called when the current buffer is too small.
+     */
+    explicit BitStreamWriter(GrowFunc growFunc) noexcept;
+
+    /**
+     * Function which can take over byte aligned raw bytes instead of copying them into the buffer.
+     *
+     * The function returns true when it has taken over the bytes. It must call startSegment() with the size of
+     * the bytes then. When it returns false, the bytes are copied as usual.
+     */
+    using RawBytesFunc = Result<bool> (*)(BitStreamWriter& writer, Span<const uint8_t> data);
+
+    /**
+     * Sets the function which can take over raw bytes.
+     *
+     * A separate setter keeps BitStreamWriter(nullptr, 0) unambiguous.
+     *
+     * \param rawBytesFunc Function called for byte aligned raw bytes of bytes, strings and bit buffers.
+     */
+    void setRawBytesFunc(RawBytesFunc rawBytesFunc) noexcept;
+
+    /**
+     * Sets the grown buffer.
+     *
+     * \param buffer Grown buffer which contains all bytes written so far.
+     */
+    void setGrownBuffer(Span<uint8_t> buffer) noexcept;
+
+    /**
+     * Flushes the write cache and detaches the buffer. The writer starts again at bit position zero.
+     */
+    void detachBuffer() noexcept;
+
+    /**
+     * Flushes the write cache and detaches the buffer to continue in a new buffer.
+     *
+     * Bit positions continue after the skipped bytes, the new buffer is requested from the grow function on
+     * the next write. The current bit position must be byte aligned.
+     *
+     * \param skipByteSize Number of bytes which are skipped because they are not stored in any buffer.
+     */
+    void startSegment(size_t skipByteSize) noexcept;
+
+    /**
+     * Discards leading bytes of the buffer which have been stored elsewhere, e.g. flushed to a file.
+     *
+     * Bit positions continue unchanged. The caller must flush the write cache and move the bytes which follow
+     * the discarded ones to the beginning of the buffer before. The discarded bytes must be whole bytes before
+     * the current bit position.
+     *
+     * \param byteSize Number of discarded bytes.
+     */
+    void discardBytes(size_t byteSize) noexcept;
+
 private:
     Result<void> writeUnsignedBits(uint32_t data, uint8_t numBits) noexcept;
     Result<void> writeUnsignedBits64(uint64_t data, uint8_t numBits) noexcept;
@@ -408,11 +580,33 @@ private:
     Result<void> writeUnsignedVarNum(uint64_t value, size_t maxVarBytes, size_t numVarBytes) noexcept;
     Result<void> writeVarNum(uint64_t value, bool hasSign, bool isNegative, size_t maxVarBytes, size_t numVarBytes) noexcept;
 
-    Result<void> checkCapacity(size_t bitSize) const noexcept;
+    Result<void> writeRawBytes(Span<const uint8_t> data, bool canReference = true) noexcept;
+    Result<void> writeWindowBits(const uint8_t* data, uint8_t bitOffset, size_t numBits, bool canReference) noexcept;
+    void writeCachedBits(uint64_t data, uint8_t numBits) noexcept;
+    void moveCache(size_t bitIndex) noexcept;
+    void reloadCache() noexcept;
+
+    Result<void> checkCapacity(size_t bitSize) noexcept;
+    Result<void> checkBitsArrayCapacity(size_t numValues, uint8_t numBits) noexcept;
+
+    template <typename T>
+    Result<void> writeBitsArrayImpl(Span<const T> values, uint8_t numBits) noexcept;
+    template <typename T>
+    Result<void> writeSignedBitsArrayImpl(Span<const T> values, uint8_t numBits) noexcept;
 
     Span<uint8_t> m_buffer;
     size_t m_bitIndex;
     size_t m_bufferBitSize;
+
+    // bits written since the last byte aligned position not yet stored to the buffer, right aligned
+    uint64_t m_cache;
+    uint8_t m_cacheNumBits;
+    bool m_hasWriteCache;
+
+    GrowFunc m_growFunc;
+    RawBytesFunc m_rawBytesFunc;
+    size_t m_bitPositionBase;
+    IOffsetPatcher* m_offsetPatcher;
 };
 
 } // namespace zserio
@@ -0,0 +1,154 @@
+#ifndef ZSERIO_FIELD_MASK_H_INC
+#define ZSERIO_FIELD_MASK_H_INC
+
+#include <cstddef>
+
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+/**
+ * Set of fields of a structure which is used by the projection read generated in case of '-withProjectionCode'
+ * command line option.
+ *
+ * Each field is identified by its index in the structure, thus at most MAX_NUM_FIELDS fields are supported.
+ * Generated structures provide the masks of their fields as FIELD_name constants which can be combined by the
+ * operator|.
+ */
+class FieldMask
+{
+public:
+    /** Maximum number of fields which can be stored in the mask. */
+    static constexpr size_t MAX_NUM_FIELDS = 64;
+
+    /**
+     * Default constructor which creates an empty mask.
+     */
+    constexpr FieldMask() noexcept :
+            m_bits(0)
+    {}
+
+    /**
+     * Creates mask containing a single field.
+     *
+     * \param fieldIndex Index of the field in the structure, must be less than MAX_NUM_FIELDS.
+     *
+     * \return Mask containing the field.
+     */
+    static constexpr FieldMask field(size_t fieldIndex) noexcept
+    {
+        return FieldMask(static_cast<uint64_t>(1) << fieldIndex);
+    }
+
+    /**
+     * Creates mask containing all fields.
+     *
+     * \return Mask containing all fields.
+     */
+    static constexpr FieldMask all() noexcept
+    {
+        return FieldMask(~static_cast<uint64_t>(0));
+    }
+
+    /**
+     * Checks whether this mask contains all fields of the given mask.
+     *
+     * \param fields Fields to check.
+     *
+     * \return True when all given fields are contained in this mask, otherwise false.
+     */
+    constexpr bool contains(FieldMask fields) const noexcept
+    {
+        return (m_bits & fields.m_bits) == fields.m_bits;
+    }
+
+    /**
+     * Checks whether this mask is empty.
+     *
+     * \return True when this mask does not contain any field, otherwise false.
+     */
+    constexpr bool isEmpty() const noexcept
+    {
+        return m_bits == 0;
+    }
+
+    /**
+     * Gets the underlying bits of the mask, bit i corresponds to the field with index i.
+     *
+     * \return Bits of the mask.
+     */
+    constexpr uint64_t getBits() const noexcept
+    {
+        return m_bits;
+    }
+
+    /**
+     * Union of two masks.
+     *
+     * \param other Mask to unite with.
+     *
+     * \return Mask containing fields of both masks.
+     */
+    constexpr FieldMask operator|(FieldMask other) const noexcept
+    {
+        return FieldMask(m_bits | other.m_bits);
+    }
+
+    /**
+     * Intersection of two masks.
+     *
+     * \param other Mask to intersect with.
+     *
+     * \return Mask containing fields which are in both masks.
+     */
+    constexpr FieldMask operator&(FieldMask other) const noexcept
+    {
+        return FieldMask(m_bits & other.m_bits);
+    }
+
+    /**
+     * Adds fields of the other mask to this mask.
+     *
+     * \param other Mask to add.
+     *
+     * \return Reference to this mask.
+     */
+    FieldMask& operator|=(FieldMask other) noexcept
+    {
+        m_bits |= other.m_bits;
+        return *this;
+    }
+
+    /**
+     * Comparison operators.
+     *
+     * \param other Mask to compare with.
+     *
+     * \return Result of the comparison.
+     * \{
+     */
+    constexpr bool operator==(FieldMask other) const noexcept
+    {
+        return m_bits == other.m_bits;
+    }
+
+    constexpr bool operator!=(FieldMask other) const noexcept
+    {
+        return m_bits != other.m_bits;
+    }
+    /**
+     * \}
+     */
+
+private:
+    explicit constexpr FieldMask(uint64_t bits) noexcept :
+            m_bits(bits)
+    {}
+
+    uint64_t m_bits;
+};
+
+} // namespace zserio
+
+#endif // ZSERIO_FIELD_MASK_H_INC
@@ -1,3 +1,5 @@
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 
 #include "zserio/FileUtil.h"
@@ -5,6 +7,12 @@
 #include "zserio/Result.h"
 #include "zserio/ErrorCode.h"
 
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace zserio
 {
 
@@ -25,6 +33,44 @@ Result<void> writeBufferToFile(const uint8_t* buffer, size_t bitSize, BitsTag, c
     return Result<void>::success();
 }
 
+std::string getTemporaryFileName(const std::string& fileName) noexcept
+{
+    static std::atomic<unsigned long> counter(0);
+#ifdef _WIN32
+    const long processId = static_cast<long>(_getpid());
+#else
+    const long processId = static_cast<long>(getpid());
+#endif
+
+    // TODO: The file name concatenation may abort if allocation fails with -fno-exceptions!
+    return fileName + "." + std::to_string(processId) + "." + std::to_string(counter++) + ".tmp";
+}
+
+Result<void> replaceFile(const std::string& fileName, const std::string& newFileName) noexcept
+{
+    if (std::rename(fileName.c_str(), newFileName.c_str()) == 0)
+    {
+        return Result<void>::success();
+    }
+
+#ifdef _WIN32
+    // rename does not replace existing files on Windows
+    if (std::remove(newFileName.c_str()) == 0 && std::rename(fileName.c_str(), newFileName.c_str()) == 0)
+    {
+        return Result<void>::success();
+    }
+#endif
+
+    return Result<void>::error(ErrorCode::FileWriteFailed);
+}
+
+Result<void> writeBufferToSink(const BitStreamWriter& writer, IByteSink& sink) noexcept
+{
+    // single write, thus a sink which rejects data on backpressure does not accept the buffer partially
+    const size_t byteSize = (writer.getBitPosition() + 7) / 8;
+    return sink.write(Span<const uint8_t>(writer.getWriteBuffer(), byteSize));
+}
+
 Result<BitBuffer> readBufferFromFile(const std::string& fileName) noexcept
 {
     std::ifstream stream(fileName.c_str(), std::ifstream::binary);
@@ -34,10 +80,11 @@ Result<BitBuffer> readBufferFromFile(const std::string& fileName) noexcept
     }
 
     (void)stream.seekg(0, stream.end);
-    const std::streampos fileSize = stream.tellg();
+    // the position is compared as a 64-bit offset, narrowing it would misinterpret files of 2 GiB or more
+    const std::streamoff fileSize = stream.tellg();
     (void)stream.seekg(0);
 
-    if (static_cast<int>(fileSize) == -1)
+    if (fileSize == -1)
     {
         return Result<BitBuffer>::error(ErrorCode::FileSeekFailed);
     }
@@ -65,4 +112,86 @@ Result<BitBuffer> readBufferFromFile(const std::string& fileName) noexcept
     return Result<BitBuffer>::success(std::move(bitBuffer));
 }
 
+Result<FileByteSource> FileByteSource::open(const std::string& fileName) noexcept
+{
+    std::ifstream stream(fileName.c_str(), std::ifstream::binary);
+    if (!stream)
+    {
+        return Result<FileByteSource>::error(ErrorCode::FileOpenFailed);
+    }
+
+    // the size is only a hint for the reader, pipes and other special files do not know it
+    size_t byteSize = UNKNOWN_BYTE_SIZE;
+    const std::streamoff fileSize = stream.seekg(0, stream.end).tellg();
+    if (fileSize != -1 && static_cast<uint64_t>(fileSize) < UNKNOWN_BYTE_SIZE)
+    {
+        byteSize = static_cast<size_t>(fileSize);
+    }
+    stream.clear();
+    if (!stream.seekg(0))
+    {
+        return Result<FileByteSource>::error(ErrorCode::FileSeekFailed);
+    }
+
+    return Result<FileByteSource>::success(FileByteSource(std::move(stream), byteSize));
+}
+
+FileByteSource::FileByteSource(std::ifstream&& stream, size_t byteSize) noexcept :
+        m_stream(std::move(stream)),
+        m_byteSize(byteSize)
+{}
+
+Result<size_t> FileByteSource::read(Span<uint8_t> buffer) noexcept
+{
+    (void)m_stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (m_stream.bad())
+    {
+        return Result<size_t>::error(ErrorCode::FileReadFailed);
+    }
+
+    // short read at the end of the file sets the fail bit, following reads return zero bytes
+    return Result<size_t>::success(static_cast<size_t>(m_stream.gcount()));
+}
+
+size_t FileByteSource::getByteSize() const noexcept
+{
+    return m_byteSize;
+}
+
+Result<FileByteSink> FileByteSink::open(const std::string& fileName) noexcept
+{
+    std::ofstream stream(fileName.c_str(), std::ofstream::binary | std::ofstream::trunc);
+    if (!stream)
+    {
+        return Result<FileByteSink>::error(ErrorCode::FileOpenFailed);
+    }
+
+    return Result<FileByteSink>::success(FileByteSink(std::move(stream)));
+}
+
+FileByteSink::FileByteSink(std::ofstream&& stream) noexcept :
+        m_stream(std::move(stream))
+{}
+
+Result<void> FileByteSink::write(Span<const uint8_t> data) noexcept
+{
+    if (!m_stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())))
+    {
+        return Result<void>::error(ErrorCode::FileWriteFailed);
+    }
+
+    return Result<void>::success();
+}
+
+Result<void> FileByteSink::close() noexcept
+{
+    m_stream.close();
+    if (!m_stream)
+    {
+        return Result<void>::error(ErrorCode::FileCloseFailed);
+    }
+
+    return Result<void>::success();
+}
+
 } // namespace zserio
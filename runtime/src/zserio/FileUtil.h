@@ -10,9 +10,14 @@
 #ifndef ZSERIO_FILE_UTIL_H_INC
 #define ZSERIO_FILE_UTIL_H_INC
 
+#include <fstream>
+#include <string>
+
 #include "zserio/BitBuffer.h"
 #include "zserio/BitStreamReader.h"
 #include "zserio/BitStreamWriter.h"
+#include "zserio/IByteSink.h"
+#include "zserio/IByteSource.h"
 #include "zserio/Result.h"
 #include "zserio/ErrorCode.h"
 
@@ -28,6 +33,85 @@ namespace zserio
  */
 Result<BitBuffer> readBufferFromFile(const std::string& fileName) noexcept;
 
+/**
+ * Byte source which reads a file sequentially, see StreamingBitStreamReader.
+ */
+class FileByteSource : public IByteSource
+{
+public:
+    /**
+     * Opens given file for reading.
+     *
+     * \param fileName File to read.
+     *
+     * \return Result containing the source, or error code.
+     */
+    static Result<FileByteSource> open(const std::string& fileName) noexcept;
+
+    /**
+     * Method generated by default.
+     * \{
+     */
+    ~FileByteSource() override = default;
+
+    FileByteSource(FileByteSource&&) = default;
+    FileByteSource& operator=(FileByteSource&&) = default;
+    /**
+     * \}
+     */
+
+    Result<size_t> read(Span<uint8_t> buffer) noexcept override;
+    size_t getByteSize() const noexcept override;
+
+private:
+    FileByteSource(std::ifstream&& stream, size_t byteSize) noexcept;
+
+    std::ifstream m_stream;
+    size_t m_byteSize;
+};
+
+/**
+ * Byte sink which writes a file sequentially, see StreamingBitStreamWriter.
+ */
+class FileByteSink : public IByteSink
+{
+public:
+    /**
+     * Creates or truncates given file for writing.
+     *
+     * \param fileName File to write.
+     *
+     * \return Result containing the sink, or error code.
+     */
+    static Result<FileByteSink> open(const std::string& fileName) noexcept;
+
+    /**
+     * Method generated by default.
+     * \{
+     */
+    ~FileByteSink() override = default;
+
+    FileByteSink(FileByteSink&&) = default;
+    FileByteSink& operator=(FileByteSink&&) = default;
+    /**
+     * \}
+     */
+
+    Result<void> write(Span<const uint8_t> data) noexcept override;
+
+    /**
+     * Closes the file. Buffered bytes are written, errors which would be lost in the destructor are reported.
+     *
+     * \return Success or error code.
+     */
+    Result<void> close() noexcept;
+
+private:
+    explicit FileByteSink(std::ofstream&& stream) noexcept;
+
+    std::ofstream m_stream;
+};
+
 /**
  * Writes given buffer to file.
  *
@@ -86,6 +170,42 @@ inline Result<void> writeBufferToFile(const BitStreamWriter& writer, const std::
     return writeBufferToFile(writer.getWriteBuffer(), writer.getBitPosition(), BitsTag(), fileName);
 }
 
+/**
+ * Gets a unique name of a temporary file in the same directory as the given file.
+ *
+ * The name is made unique by the process ID and by a counter of the process, thus concurrent writers of the same
+ * file, either threads or processes, never share the temporary file.
+ *
+ * \param fileName Name of the file which the temporary file belongs to.
+ *
+ * \return Name of the temporary file.
+ */
+std::string getTemporaryFileName(const std::string& fileName) noexcept;
+
+/**
+ * Renames given file, the file with the new name is replaced if it exists.
+ *
+ * On POSIX systems, the file is replaced atomically, thus readers see either the old or the new file.
+ *
+ * \param fileName Name of the file to rename.
+ * \param newFileName New name of the file.
+ *
+ * \return Result<void> indicating success or error code.
+ */
+Result<void> replaceFile(const std::string& fileName, const std::string& newFileName) noexcept;
+
+/**
+ * Writes write-buffer of the given bit stream writer to byte sink, e.g. to AsyncFileByteSink.
+ *
+ * The buffer is written by a single write of whole bytes, thus consecutive buffers are written byte aligned.
+ *
+ * \param writer Bit stream writer to use.
+ * \param sink Byte sink to write to.
+ *
+ * \return Result<void> indicating success or error code.
+ */
+Result<void> writeBufferToSink(const BitStreamWriter& writer, IByteSink& sink) noexcept;
+
 } // namespace zserio
 
 #endif // ZSERIO_FILE_UTIL_H_INC
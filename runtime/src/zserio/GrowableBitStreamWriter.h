@@ -0,0 +1,176 @@
+#ifndef ZSERIO_GROWABLE_BIT_STREAM_WRITER_H_INC
+#define ZSERIO_GROWABLE_BIT_STREAM_WRITER_H_INC
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "zserio/BitBuffer.h"
+#include "zserio/BitStreamWriter.h"
+#include "zserio/ErrorCode.h"
+#include "zserio/Result.h"
+#include "zserio/Vector.h"
+
+namespace zserio
+{
+
+/**
+ * Bit stream writer which owns its buffer and grows it on demand.
+ *
+ * The buffer grows geometrically, thus the bit size of the written data does not need to be known in advance
+ * and many messages can be appended to the same buffer. Written data are taken over by release().
+ *
+ * Growing beyond the maximum byte size given at construction is reported as AllocationFailed.
+ *
+ * IMPORTANT: When building with -fno-exceptions, vector operations that would normally throw std::bad_alloc
+ * will instead cause std::abort() (GCC) or undefined behavior (other implementations). In functional safety
+ * environments, limit the maximum byte size to the memory which is guaranteed to be available.
+ */
+template <typename ALLOC = std::allocator<uint8_t>>
+class BasicGrowableBitStreamWriter : public BitStreamWriter
+{
+public:
+    static_assert(std::is_same<uint8_t, typename ALLOC::value_type>::value,
+            "Allocator with uint8_t value_type is required!");
+
+    using allocator_type = ALLOC;
+
+    /**
+     * Constructor - cannot fail, no memory is allocated until the first write.
+     *
+     * \param allocator Allocator to use for the buffer.
+     */
+    explicit BasicGrowableBitStreamWriter(const ALLOC& allocator = ALLOC()) noexcept :
+            BasicGrowableBitStreamWriter(std::numeric_limits<size_t>::max(), allocator)
+    {}
+
+    /**
+     * Constructor with limited buffer size - cannot fail, no memory is allocated until the first write.
+     *
+     * \param maxByteSize Maximum byte size of the buffer.
+     * \param allocator Allocator to use for the buffer.
+     */
+    explicit BasicGrowableBitStreamWriter(size_t maxByteSize, const ALLOC& allocator = ALLOC()) noexcept :
+            BitStreamWriter(&grow),
+            m_bytes(allocator),
+            m_maxByteSize(std::min(maxByteSize, m_bytes.max_size()))
+    {}
+
+    /**
+     * Destructor.
+     */
+    ~BasicGrowableBitStreamWriter()
+    {
+        // the buffer dies before the base class would flush into it
+        detachBuffer();
+    }
+
+    /**
+     * Copying and move assignment is disallowed, move construction is allowed!
+     * \{
+     */
+    BasicGrowableBitStreamWriter(const BasicGrowableBitStreamWriter&) = delete;
+    BasicGrowableBitStreamWriter& operator=(const BasicGrowableBitStreamWriter&) = delete;
+
+    BasicGrowableBitStreamWriter(BasicGrowableBitStreamWriter&& other) noexcept :
+            BitStreamWriter(std::move(other)),
+            m_bytes(std::move(other.m_bytes)),
+            m_maxByteSize(other.m_maxByteSize)
+    {
+        // moving of the vector keeps its storage, thus the buffer taken over by the base class stays valid
+        other.detachBuffer();
+    }
+    BasicGrowableBitStreamWriter& operator=(BasicGrowableBitStreamWriter&&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Gets copy of the allocator used for the buffer.
+     *
+     * \return Allocator used for the buffer.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return m_bytes.get_allocator();
+    }
+
+    /**
+     * Ensures that the buffer can hold the given number of bits without further growing.
+     *
+     * \param bitSize Number of bits to reserve.
+     *
+     * \return Success or AllocationFailed when the bit size exceeds the maximum byte size.
+     */
+    Result<void> reserve(size_t bitSize) noexcept
+    {
+        return (bitSize > getBufferBitSize()) ? grow(*this, bitSize) : Result<void>::success();
+    }
+
+    /**
+     * Moves all bits up to the current bit position to a bit buffer.
+     *
+     * The writer is empty afterwards and can be used again.
+     *
+     * \return Result containing bit buffer with the written data or error code.
+     */
+    Result<BasicBitBuffer<ALLOC>> release() noexcept
+    {
+        const size_t bitSize = getBitPosition();
+        detachBuffer();
+
+        vector<uint8_t, ALLOC> bytes(std::move(m_bytes));
+        m_bytes.clear();
+        bytes.resize((bitSize + 7) / 8);
+
+        // unused bits of the last byte must be zero
+        const uint8_t numLastBits = static_cast<uint8_t>(bitSize % 8);
+        if (numLastBits > 0)
+        {
+            bytes.back() = static_cast<uint8_t>(bytes.back() & (0xFFU << (8U - numLastBits)));
+        }
+
+        return BasicBitBuffer<ALLOC>::fromVector(std::move(bytes), bitSize);
+    }
+
+private:
+    // minimum byte size of the first allocation
+    static constexpr size_t MIN_BYTE_SIZE = 64;
+
+    static Result<void> grow(BitStreamWriter& writer, size_t bitSize) noexcept
+    {
+        BasicGrowableBitStreamWriter& self = static_cast<BasicGrowableBitStreamWriter&>(writer);
+        vector<uint8_t, ALLOC>& bytes = self.m_bytes;
+
+        const size_t byteSize = bitSize / 8 + ((bitSize % 8 != 0) ? 1 : 0);
+        const size_t maxByteSize = self.m_maxByteSize;
+        if (byteSize > maxByteSize)
+        {
+            return Result<void>::error(ErrorCode::AllocationFailed);
+        }
+
+        // geometric growth keeps appending amortized constant
+        const size_t grownByteSize = (bytes.size() > maxByteSize / 2) ? maxByteSize : bytes.size() * 2;
+        const size_t newByteSize =
+                std::min(std::max(byteSize, std::max(grownByteSize, MIN_BYTE_SIZE)), maxByteSize);
+
+        // TODO: This resize() may abort if allocation fails with -fno-exceptions!
+        bytes.resize(newByteSize, 0);
+        self.setGrownBuffer(Span<uint8_t>(bytes.data(), bytes.size()));
+        return Result<void>::success();
+    }
+
+    vector<uint8_t, ALLOC> m_bytes;
+    size_t m_maxByteSize;
+};
+
+template <typename ALLOC>
+constexpr size_t BasicGrowableBitStreamWriter<ALLOC>::MIN_BYTE_SIZE;
+
+/** Typedef to growable bit stream writer provided for convenience - using std::allocator<uint8_t>. */
+using GrowableBitStreamWriter = BasicGrowableBitStreamWriter<>;
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_GROWABLE_BIT_STREAM_WRITER_H_INC
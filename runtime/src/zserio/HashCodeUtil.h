@@ -9,6 +9,8 @@
 #include "zserio/Enums.h"
 #include "zserio/FloatUtil.h"
 #include "zserio/OptionalHolder.h"
+#include "zserio/Span.h"
+#include "zserio/StringView.h"
 #include "zserio/Types.h"
 
 namespace zserio
@@ -109,6 +111,48 @@ inline uint32_t calcHashCode(
     return result;
 }
 
+/**
+ * Calculates hash code of the given string view using the given seed value.
+ *
+ * The hash code is the same as the hash code of a string with the same content.
+ *
+ * \param seedValue Seed value (current hash code).
+ * \param stringValue Value for which to calculate the hash code.
+ *
+ * \return Calculated hash code.
+ */
+inline uint32_t calcHashCode(uint32_t seedValue, StringView stringValue)
+{
+    uint32_t result = seedValue;
+    for (auto element : stringValue)
+    {
+        result = calcHashCode(result, element);
+    }
+
+    return result;
+}
+
+/**
+ * Calculates hash code of the given bytes view using the given seed value.
+ *
+ * The hash code is the same as the hash code of a bytes vector with the same content.
+ *
+ * \param seedValue Seed value (current hash code).
+ * \param bytesValue Value for which to calculate the hash code.
+ *
+ * \return Calculated hash code.
+ */
+inline uint32_t calcHashCode(uint32_t seedValue, BytesView bytesValue)
+{
+    uint32_t result = seedValue;
+    for (uint8_t element : bytesValue)
+    {
+        result = calcHashCode(result, element);
+    }
+
+    return result;
+}
+
 /**
  * Calculates hash code of the given enum item using the given seed value.
  *
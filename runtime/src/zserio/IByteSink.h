@@ -0,0 +1,34 @@
+#ifndef ZSERIO_IBYTE_SINK_H_INC
+#define ZSERIO_IBYTE_SINK_H_INC
+
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+/**
+ * Interface for sinks of bytes, e.g. files, pipes or network streams.
+ *
+ * Sinks are written strictly sequentially by StreamingBitStreamWriter, they do not need to support seeking.
+ */
+class IByteSink
+{
+public:
+    /** Destructor. */
+    virtual ~IByteSink() = default;
+
+    /**
+     * Writes given bytes to the sink.
+     *
+     * \param data Bytes to write.
+     *
+     * \return Success when all bytes have been written, or error code.
+     */
+    virtual Result<void> write(Span<const uint8_t> data) noexcept = 0;
+};
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_IBYTE_SINK_H_INC
@@ -0,0 +1,49 @@
+#ifndef ZSERIO_IBYTE_SOURCE_H_INC
+#define ZSERIO_IBYTE_SOURCE_H_INC
+
+#include <limits>
+
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+/**
+ * Interface for pull based sources of bytes, e.g. files, pipes or network streams.
+ *
+ * Sources are read strictly sequentially by StreamingBitStreamReader, they do not need to support seeking.
+ */
+class IByteSource
+{
+public:
+    /** Byte size returned by sources which do not know their size in advance. */
+    static constexpr size_t UNKNOWN_BYTE_SIZE = std::numeric_limits<size_t>::max();
+
+    /** Destructor. */
+    virtual ~IByteSource() = default;
+
+    /**
+     * Reads next bytes from the source.
+     *
+     * \param buffer Buffer to fill.
+     *
+     * \return Result containing number of read bytes which is zero only at the end of the source, or error code.
+     */
+    virtual Result<size_t> read(Span<uint8_t> buffer) noexcept = 0;
+
+    /**
+     * Gets size of the whole source.
+     *
+     * \return Size of the source in bytes or UNKNOWN_BYTE_SIZE.
+     */
+    virtual size_t getByteSize() const noexcept
+    {
+        return UNKNOWN_BYTE_SIZE;
+    }
+};
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_IBYTE_SOURCE_H_INC
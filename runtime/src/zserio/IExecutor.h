@@ -0,0 +1,86 @@
+#ifndef ZSERIO_IEXECUTOR_H_INC
+#define ZSERIO_IEXECUTOR_H_INC
+
+#include <cstddef>
+
+namespace zserio
+{
+
+/**
+ * Interface for executors which run independent tasks concurrently, e.g. thread pools.
+ *
+ * Used by parallel reading and writing of large arrays and by deserializeBatch(). Applications can plug in
+ * their own thread pools by implementing this interface, the runtime provides ThreadPoolExecutor.
+ */
+class IExecutor
+{
+public:
+    /** Function which runs the single task by the worker with the given index. */
+    using TaskFunc = void (*)(void* context, size_t taskIndex, size_t workerIndex);
+
+    /** Destructor. */
+    virtual ~IExecutor() = default;
+
+    /**
+     * Gets number of tasks which can run concurrently, used to split the work into tasks.
+     *
+     * \return Number of concurrently running tasks, one when the executor runs the tasks sequentially.
+     */
+    virtual size_t getConcurrency() const noexcept = 0;
+
+    /**
+     * Runs the tasks with indices [0, numTasks) and waits until all of them finish.
+     *
+     * Tasks can run in any order and in any thread including the calling one. Each task gets the index
+     * of the worker which runs it, the index is less than getConcurrency() and tasks of a single call with
+     * the same worker index never run concurrently. Thus tasks can use per-worker resources without locking.
+     * Implementations must support calls from within a running task, e.g. by running the nested tasks
+     * in the calling thread.
+     *
+     * \param numTasks Number of tasks to run.
+     * \param task Function which runs the single task.
+     * \param context Context passed to the function.
+     */
+    virtual void run(size_t numTasks, TaskFunc task, void* context) noexcept = 0;
+};
+
+/**
+ * Runs the tasks with indices [0, numTasks) by the executor using the given functor.
+ *
+ * \param executor Executor to use.
+ * \param numTasks Number of tasks to run.
+ * \param func Functor called with the index of the task, must not throw.
+ */
+template <typename FUNC>
+void runTasks(IExecutor& executor, size_t numTasks, FUNC& func) noexcept
+{
+    executor.run(
+            numTasks,
+            [](void* context, size_t taskIndex, size_t) {
+                (*static_cast<FUNC*>(context))(taskIndex);
+            },
+            &func);
+}
+
+/**
+ * Runs the tasks with indices [0, numTasks) by the executor using the given functor which needs the index
+ * of the worker.
+ *
+ * \param executor Executor to use.
+ * \param numTasks Number of tasks to run.
+ * \param func Functor called with the index of the task and the index of the worker, must not throw.
+ */
+template <typename FUNC>
+void runWorkerTasks(IExecutor& executor, size_t numTasks, FUNC& func) noexcept
+{
+    executor.run(
+            numTasks,
+            [](void* context, size_t taskIndex, size_t workerIndex) {
+                (*static_cast<FUNC*>(context))(taskIndex, workerIndex);
+            },
+            &func);
+}
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_IEXECUTOR_H_INC
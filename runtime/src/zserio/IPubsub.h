@@ -7,6 +7,7 @@
 #include "zserio/Span.h"
 #include "zserio/StringView.h"
 #include "zserio/Types.h"
+#include "zserio/Vector.h"
 
 namespace zserio
 {
@@ -43,6 +44,39 @@ public:
      */
     virtual Result<void> publish(StringView topic, Span<const uint8_t> data, void* context) noexcept = 0;
 
+    /**
+     * Publishes given data split into segments as a specified topic.
+     *
+     * The segments are published as one message. The default implementation coalesces the segments and calls
+     * publish(), backends which support gather writes should override it to avoid the copy.
+     *
+     * \param topic Topic definition.
+     * \param segments Segments of the data to publish in stream order.
+     * \param context Context specific for a particular Pub/Sub implementation.
+     *
+     * \return Success or error code on failure.
+     */
+    virtual Result<void> publishSegments(
+            StringView topic, Span<const Span<const uint8_t>> segments, void* context) noexcept
+    {
+        size_t byteSize = 0;
+        for (const Span<const uint8_t>& segment : segments)
+        {
+            byteSize += segment.size();
+        }
+
+        // Note: reserve() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+        // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+        vector<uint8_t> data;
+        data.reserve(byteSize);
+        for (const Span<const uint8_t>& segment : segments)
+        {
+            data.insert(data.end(), segment.begin(), segment.end());
+        }
+
+        return publish(topic, Span<const uint8_t>(data.data(), data.size()), context);
+    }
+
     /**
      * Subscribes a topic.
      *
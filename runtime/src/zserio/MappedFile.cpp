@@ -0,0 +1,166 @@
+#include <fstream>
+#include <limits>
+
+#include "zserio/ErrorCode.h"
+#include "zserio/MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ZSERIO_MAPPED_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace zserio
+{
+
+namespace
+{
+
+Result<void> readFile(const std::string& fileName, std::vector<uint8_t>& buffer) noexcept
+{
+    std::ifstream stream(fileName.c_str(), std::ifstream::binary);
+    if (!stream)
+    {
+        return Result<void>::error(ErrorCode::FileOpenFailed);
+    }
+
+    (void)stream.seekg(0, stream.end);
+    // the position is compared as a 64-bit offset, narrowing it would misinterpret files of 2 GiB or more
+    const std::streamoff fileSize = stream.tellg();
+    (void)stream.seekg(0);
+
+    if (fileSize == -1)
+    {
+        return Result<void>::error(ErrorCode::FileSeekFailed);
+    }
+
+    if (static_cast<uint64_t>(fileSize) > std::numeric_limits<size_t>::max() / 8)
+    {
+        return Result<void>::error(ErrorCode::BufferSizeExceeded);
+    }
+
+    // Note: resize() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+    // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+    buffer.resize(static_cast<size_t>(fileSize));
+    if (!stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+    {
+        return Result<void>::error(ErrorCode::FileReadFailed);
+    }
+
+    return Result<void>::success();
+}
+
+} // namespace
+
+Result<MappedFile> MappedFile::open(const std::string& fileName) noexcept
+{
+    MappedFile mappedFile;
+
+#ifdef ZSERIO_MAPPED_FILE_MMAP
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return Result<MappedFile>::error(ErrorCode::FileOpenFailed);
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0)
+    {
+        (void)::close(fd);
+        return Result<MappedFile>::error(ErrorCode::FileReadFailed);
+    }
+
+    // bit positions of the reader must not overflow
+    if (static_cast<uint64_t>(fileStat.st_size) > std::numeric_limits<size_t>::max() / 8)
+    {
+        (void)::close(fd);
+        return Result<MappedFile>::error(ErrorCode::BufferSizeExceeded);
+    }
+
+    // empty files cannot be mapped, other files which cannot be mapped are read into a buffer
+    const size_t byteSize = static_cast<size_t>(fileStat.st_size);
+    if (byteSize > 0 && S_ISREG(fileStat.st_mode))
+    {
+        void* data = ::mmap(nullptr, byteSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            mappedFile.m_data = static_cast<const uint8_t*>(data);
+            mappedFile.m_byteSize = byteSize;
+            mappedFile.m_isMapped = true;
+        }
+    }
+    (void)::close(fd);
+
+    if (mappedFile.m_isMapped || (byteSize == 0 && S_ISREG(fileStat.st_mode)))
+    {
+        return Result<MappedFile>::success(std::move(mappedFile));
+    }
+#endif
+
+    auto readResult = readFile(fileName, mappedFile.m_buffer);
+    if (readResult.isError())
+    {
+        return Result<MappedFile>::error(readResult.getError());
+    }
+    mappedFile.m_data = mappedFile.m_buffer.data();
+    mappedFile.m_byteSize = mappedFile.m_buffer.size();
+
+    return Result<MappedFile>::success(std::move(mappedFile));
+}
+
+MappedFile::MappedFile() noexcept :
+        m_data(nullptr),
+        m_byteSize(0),
+        m_isMapped(false)
+{}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+        m_data(other.m_data),
+        m_byteSize(other.m_byteSize),
+        m_isMapped(other.m_isMapped),
+        m_buffer(std::move(other.m_buffer))
+{
+    other.m_data = nullptr;
+    other.m_byteSize = 0;
+    other.m_isMapped = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        m_data = other.m_data;
+        m_byteSize = other.m_byteSize;
+        m_isMapped = other.m_isMapped;
+        m_buffer = std::move(other.m_buffer);
+        other.m_data = nullptr;
+        other.m_byteSize = 0;
+        other.m_isMapped = false;
+    }
+
+    return *this;
+}
+
+void MappedFile::close() noexcept
+{
+#ifdef ZSERIO_MAPPED_FILE_MMAP
+    if (m_isMapped)
+    {
+        (void)::munmap(const_cast<uint8_t*>(m_data), m_byteSize);
+    }
+#endif
+    m_data = nullptr;
+    m_byteSize = 0;
+    m_isMapped = false;
+    m_buffer.clear();
+}
+
+} // namespace zserio
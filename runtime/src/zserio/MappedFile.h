@@ -0,0 +1,104 @@
+/**
+ * \file
+ * Read-only memory mapped file.
+ *
+ * These utilities are not used by generated code and they are provided only for user convenience.
+ *
+ * \note Please note that file operations allocate memory as needed and are not designed to use allocators.
+ */
+
+#ifndef ZSERIO_MAPPED_FILE_H_INC
+#define ZSERIO_MAPPED_FILE_H_INC
+
+#include <string>
+#include <vector>
+
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+/**
+ * Read-only view of the whole file contents.
+ *
+ * The file is mapped into memory on POSIX systems, thus opening does not read the file and only the touched
+ * pages are loaded. On other systems, or when the file cannot be mapped, the contents are read into a buffer.
+ *
+ * Objects deserialized with views into the file contents must not outlive the mapped file.
+ */
+class MappedFile
+{
+public:
+    /**
+     * Opens and maps given file.
+     *
+     * \param fileName File to map.
+     *
+     * \return Result containing the mapped file, or error code.
+     */
+    static Result<MappedFile> open(const std::string& fileName) noexcept;
+
+    /**
+     * Empty constructor.
+     */
+    MappedFile() noexcept;
+
+    /**
+     * Destructor which unmaps the file.
+     */
+    ~MappedFile();
+
+    /**
+     * Copying is disallowed, the mapping is owned!
+     * \{
+     */
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Move constructor and assignment operator.
+     * \{
+     */
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    /**
+     * \}
+     */
+
+    /**
+     * Gets the file contents.
+     *
+     * \return Bytes of the file which are valid until the mapped file is destroyed.
+     */
+    Span<const uint8_t> getData() const noexcept
+    {
+        return Span<const uint8_t>(m_data, m_byteSize);
+    }
+
+    /**
+     * Checks whether the file is really mapped or whether it has been read into a buffer.
+     *
+     * \return True when the file is mapped into memory.
+     */
+    bool isMapped() const noexcept
+    {
+        return m_isMapped;
+    }
+
+private:
+    void close() noexcept;
+
+    const uint8_t* m_data;
+    size_t m_byteSize;
+    bool m_isMapped;
+    std::vector<uint8_t> m_buffer;
+};
+
+} // namespace zserio
+
+#endif // ZSERIO_MAPPED_FILE_H_INC
@@ -0,0 +1,185 @@
+#ifndef ZSERIO_OFFSET_PATCHER_H_INC
+#define ZSERIO_OFFSET_PATCHER_H_INC
+
+#include <cstring>
+#include <memory>
+
+#include "zserio/BitStreamWriter.h"
+#include "zserio/ErrorCode.h"
+#include "zserio/RebindAlloc.h"
+#include "zserio/Result.h"
+#include "zserio/Types.h"
+#include "zserio/Vector.h"
+
+namespace zserio
+{
+
+/**
+ * Interface which collects offsets to be filled in after the labeled fields have been written.
+ *
+ * Used by single pass serialization where initializeOffsets() is not called before writing. Generated code
+ * registers a slot when it writes a field used as an offset and resolves the slot when it reaches the labeled
+ * field. Offset fields are identified by the object which contains them and by their name.
+ */
+class IOffsetPatcher
+{
+public:
+    /** Destructor. */
+    virtual ~IOffsetPatcher() = default;
+
+    /**
+     * Registers an offset field which has just been written.
+     *
+     * \param owner Object which contains the offset field.
+     * \param fieldName Name of the offset field.
+     * \param bitPosition Bit position of the offset field or of the first element of an array of offsets.
+     * \param numBits Bit size of the offset field or of one element of an array of offsets.
+     *
+     * \return Success or error code.
+     */
+    virtual Result<void> addSlot(
+            const void* owner, const char* fieldName, size_t bitPosition, uint8_t numBits) noexcept = 0;
+
+    /**
+     * Resolves an offset field to the byte offset of its labeled field.
+     *
+     * \param owner Object which contains the offset field.
+     * \param fieldName Name of the offset field.
+     * \param index Element index for arrays of offsets, zero otherwise.
+     * \param byteOffset Byte offset of the labeled field.
+     *
+     * \return Success or InvalidOffset when the offset field has not been written yet.
+     */
+    virtual Result<void> resolve(
+            const void* owner, const char* fieldName, size_t index, size_t byteOffset) noexcept = 0;
+};
+
+/**
+ * Offset patcher which keeps the slots in memory and patches the written buffer at the end.
+ *
+ * Generated write() methods cannot return errors, thus the first error of resolve() is kept and reported by
+ * apply().
+ */
+template <typename ALLOC = std::allocator<uint8_t>>
+class BasicOffsetPatcher : public IOffsetPatcher
+{
+public:
+    using allocator_type = ALLOC;
+
+    /**
+     * Constructor.
+     *
+     * \param allocator Allocator to use for the slots.
+     */
+    explicit BasicOffsetPatcher(const ALLOC& allocator = ALLOC()) noexcept :
+            m_slots(allocator),
+            m_patches(allocator),
+            m_error(ErrorCode::Success)
+    {}
+
+    Result<void> addSlot(
+            const void* owner, const char* fieldName, size_t bitPosition, uint8_t numBits) noexcept override
+    {
+        // Note: push_back() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+        // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+        m_slots.push_back(Slot{owner, fieldName, bitPosition, numBits});
+        return Result<void>::success();
+    }
+
+    Result<void> resolve(
+            const void* owner, const char* fieldName, size_t index, size_t byteOffset) noexcept override
+    {
+        // labels usually follow their offset fields closely, search from the most recent slot
+        for (size_t i = m_slots.size(); i > 0; --i)
+        {
+            const Slot& slot = m_slots[i - 1];
+            if (slot.owner == owner && std::strcmp(slot.fieldName, fieldName) == 0)
+            {
+                m_patches.push_back(Patch{slot.bitPosition + index * slot.numBits, slot.numBits, byteOffset});
+                return Result<void>::success();
+            }
+        }
+
+        if (m_error == ErrorCode::Success)
+        {
+            m_error = ErrorCode::InvalidOffset;
+        }
+        return Result<void>::error(ErrorCode::InvalidOffset);
+    }
+
+    /**
+     * Writes all resolved offsets to the buffer of the given writer.
+     *
+     * The bit position of the writer is kept.
+     *
+     * \param writer Writer which has written the whole object.
+     *
+     * \return Success, the first error of resolve(), OutOfRange when an offset does not fit into its field,
+     *         or other error code.
+     */
+    Result<void> apply(BitStreamWriter& writer) const noexcept
+    {
+        if (m_error != ErrorCode::Success)
+        {
+            return Result<void>::error(m_error);
+        }
+
+        const size_t endBitPosition = writer.getBitPosition();
+        for (const Patch& patch : m_patches)
+        {
+            if (patch.numBits < 64 && (static_cast<uint64_t>(patch.byteOffset) >> patch.numBits) != 0)
+            {
+                return Result<void>::error(ErrorCode::OutOfRange);
+            }
+
+            auto result = writer.setBitPosition(patch.bitPosition);
+            if (result.isSuccess())
+            {
+                result = writer.writeBits64(static_cast<uint64_t>(patch.byteOffset), patch.numBits);
+            }
+            if (result.isError())
+            {
+                return result;
+            }
+        }
+
+        return writer.setBitPosition(endBitPosition);
+    }
+
+    /**
+     * Forgets all slots, resolved offsets and the kept error.
+     */
+    void clear() noexcept
+    {
+        m_slots.clear();
+        m_patches.clear();
+        m_error = ErrorCode::Success;
+    }
+
+private:
+    struct Slot
+    {
+        const void* owner;
+        const char* fieldName;
+        size_t bitPosition;
+        uint8_t numBits;
+    };
+
+    struct Patch
+    {
+        size_t bitPosition;
+        uint8_t numBits;
+        size_t byteOffset;
+    };
+
+    vector<Slot, RebindAlloc<ALLOC, Slot>> m_slots;
+    vector<Patch, RebindAlloc<ALLOC, Patch>> m_patches;
+    ErrorCode m_error;
+};
+
+/** Typedef to offset patcher provided for convenience - using std::allocator<uint8_t>. */
+using OffsetPatcher = BasicOffsetPatcher<>;
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_OFFSET_PATCHER_H_INC
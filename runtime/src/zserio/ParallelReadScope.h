@@ -0,0 +1,80 @@
+#ifndef ZSERIO_PARALLEL_READ_SCOPE_H_INC
+#define ZSERIO_PARALLEL_READ_SCOPE_H_INC
+
+#include "zserio/IExecutor.h"
+
+namespace zserio
+{
+
+namespace detail
+{
+
+// executor used by array reads of the current thread, nullptr when arrays are read sequentially
+inline IExecutor*& parallelReadExecutor() noexcept
+{
+    static thread_local IExecutor* executor = nullptr;
+    return executor;
+}
+
+} // namespace detail
+
+/**
+ * Scope which enables parallel reading of arrays in the current thread.
+ *
+ * While the scope exists, aligned arrays with indexed offsets read by generated objects in the current thread
+ * are decoded concurrently by the given executor, see Array::read(). Other arrays and reads in other threads
+ * are not affected. Scopes can be nested, the previous executor is restored when the scope ends.
+ *
+ * Elements are allocated by the worker threads, thus only arrays with stateless allocators (e.g. std::allocator)
+ * are read concurrently. Arrays with stateful allocators, e.g. polymorphic allocators whose memory resource
+ * need not be thread-safe, are read sequentially.
+ *
+ * Example:
+ * \code{.cpp}
+ *     zserio::ThreadPoolExecutor executor;
+ *     zserio::ParallelReadScope parallelReadScope(executor);
+ *     auto result = zserio::deserialize<Tile>(buffer);
+ * \endcode
+ */
+class ParallelReadScope
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param executor Executor to use for reading of arrays, must outlive the scope.
+     */
+    explicit ParallelReadScope(IExecutor& executor) noexcept :
+            m_previousExecutor(detail::parallelReadExecutor())
+    {
+        detail::parallelReadExecutor() = &executor;
+    }
+
+    /**
+     * Destructor which restores the previous executor.
+     */
+    ~ParallelReadScope()
+    {
+        detail::parallelReadExecutor() = m_previousExecutor;
+    }
+
+    /**
+     * Copying and moving is disallowed!
+     * \{
+     */
+    ParallelReadScope(const ParallelReadScope&) = delete;
+    ParallelReadScope& operator=(const ParallelReadScope&) = delete;
+
+    ParallelReadScope(ParallelReadScope&&) = delete;
+    ParallelReadScope& operator=(ParallelReadScope&&) = delete;
+    /**
+     * \}
+     */
+
+private:
+    IExecutor* m_previousExecutor;
+};
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_PARALLEL_READ_SCOPE_H_INC
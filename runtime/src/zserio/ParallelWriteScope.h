@@ -0,0 +1,77 @@
+#ifndef ZSERIO_PARALLEL_WRITE_SCOPE_H_INC
+#define ZSERIO_PARALLEL_WRITE_SCOPE_H_INC
+
+#include "zserio/IExecutor.h"
+
+namespace zserio
+{
+
+namespace detail
+{
+
+// executor used by array writes of the current thread, nullptr when arrays are written sequentially
+inline IExecutor*& parallelWriteExecutor() noexcept
+{
+    static thread_local IExecutor* executor = nullptr;
+    return executor;
+}
+
+} // namespace detail
+
+/**
+ * Scope which enables parallel writing of arrays in the current thread.
+ *
+ * While the scope exists, bit sizes of aligned arrays of compounds written by generated objects in the current
+ * thread are calculated and their elements are written concurrently by the given executor, see Array::write().
+ * Other arrays, growing writers and writes in other threads are not affected. Scopes can be nested,
+ * the previous executor is restored when the scope ends.
+ *
+ * Example:
+ * \code{.cpp}
+ *     zserio::ThreadPoolExecutor executor;
+ *     zserio::ParallelWriteScope parallelWriteScope(executor);
+ *     auto bufferResult = zserio::serialize(tile);
+ * \endcode
+ */
+class ParallelWriteScope
+{
+public:
+    /**
+     * Constructor.
+     *
+     * \param executor Executor to use for writing of arrays, must outlive the scope.
+     */
+    explicit ParallelWriteScope(IExecutor& executor) noexcept :
+            m_previousExecutor(detail::parallelWriteExecutor())
+    {
+        detail::parallelWriteExecutor() = &executor;
+    }
+
+    /**
+     * Destructor which restores the previous executor.
+     */
+    ~ParallelWriteScope()
+    {
+        detail::parallelWriteExecutor() = m_previousExecutor;
+    }
+
+    /**
+     * Copying and moving is disallowed!
+     * \{
+     */
+    ParallelWriteScope(const ParallelWriteScope&) = delete;
+    ParallelWriteScope& operator=(const ParallelWriteScope&) = delete;
+
+    ParallelWriteScope(ParallelWriteScope&&) = delete;
+    ParallelWriteScope& operator=(ParallelWriteScope&&) = delete;
+    /**
+     * \}
+     */
+
+private:
+    IExecutor* m_previousExecutor;
+};
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_PARALLEL_WRITE_SCOPE_H_INC
@@ -0,0 +1,177 @@
+#ifndef ZSERIO_SEGMENTED_BIT_STREAM_READER_H_INC
+#define ZSERIO_SEGMENTED_BIT_STREAM_READER_H_INC
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "zserio/BitStreamReader.h"
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Vector.h"
+
+namespace zserio
+{
+
+/**
+ * Bit stream reader over a list of non-contiguous segments, e.g. a chain of transport chunks.
+ *
+ * Reads within a segment use the segment directly. Only values which cross a segment boundary are read through
+ * a small seam buffer which joins the end of one segment with the beginning of the following ones. Views
+ * returned by readBytesView() and readStringView() point into the segments, values which cross a boundary
+ * cannot be viewed and are reported as InvalidPointer.
+ *
+ * The segments and the list of segments must outlive the reader.
+ *
+ * IMPORTANT: When building with -fno-exceptions, vector operations that would normally throw std::bad_alloc
+ * will instead cause std::abort() (GCC) or undefined behavior (other implementations).
+ */
+template <typename ALLOC = std::allocator<uint8_t>>
+class BasicSegmentedBitStreamReader : public BitStreamReader
+{
+public:
+    static_assert(std::is_same<uint8_t, typename ALLOC::value_type>::value,
+            "Allocator with uint8_t value_type is required!");
+
+    using allocator_type = ALLOC;
+
+    /**
+     * Constructor.
+     *
+     * \param segments Segments of the stream in stream order, empty segments are allowed.
+     * \param allocator Allocator to use for the seam buffer.
+     */
+    explicit BasicSegmentedBitStreamReader(
+            Span<const Span<const uint8_t>> segments, const ALLOC& allocator = ALLOC()) noexcept :
+            BitStreamReader(m_state),
+            m_state(&refill, getByteSize(segments) * 8),
+            m_segments(segments),
+            m_byteSize(getByteSize(segments)),
+            m_segmentIndex(0),
+            m_segmentByteStart(0),
+            m_seam(allocator)
+    {}
+
+    /**
+     * Destructor.
+     */
+    ~BasicSegmentedBitStreamReader() = default;
+
+    /**
+     * Copying and moving is disallowed, the current window can point to the seam buffer!
+     * \{
+     */
+    BasicSegmentedBitStreamReader(const BasicSegmentedBitStreamReader&) = delete;
+    BasicSegmentedBitStreamReader& operator=(const BasicSegmentedBitStreamReader&) = delete;
+
+    BasicSegmentedBitStreamReader(BasicSegmentedBitStreamReader&&) = delete;
+    BasicSegmentedBitStreamReader& operator=(BasicSegmentedBitStreamReader&&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Gets copy of the allocator used for the seam buffer.
+     *
+     * \return Allocator used for the seam buffer.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return m_seam.get_allocator();
+    }
+
+private:
+    // minimum byte size of the seam, few bytes more let the bit cache load whole words
+    static constexpr size_t MIN_SEAM_BYTE_SIZE = 16;
+
+    static size_t getByteSize(Span<const Span<const uint8_t>> segments) noexcept
+    {
+        size_t byteSize = 0;
+        for (const Span<const uint8_t>& segment : segments)
+        {
+            byteSize += segment.size();
+        }
+        return byteSize;
+    }
+
+    // moves the current segment to the one which contains the given byte
+    void seekSegment(size_t byteIndex) noexcept
+    {
+        while (byteIndex < m_segmentByteStart)
+        {
+            --m_segmentIndex;
+            m_segmentByteStart -= m_segments[m_segmentIndex].size();
+        }
+        while (byteIndex >= m_segmentByteStart + m_segments[m_segmentIndex].size())
+        {
+            m_segmentByteStart += m_segments[m_segmentIndex].size();
+            ++m_segmentIndex;
+        }
+    }
+
+    static Result<void> refill(BitStreamReader& reader, BitPosType bitPosition, size_t numBits) noexcept
+    {
+        BasicSegmentedBitStreamReader& self = static_cast<BasicSegmentedBitStreamReader&>(reader);
+        if (self.m_byteSize == 0)
+        {
+            return Result<void>::success();
+        }
+
+        // the end of the stream is covered by the last segment
+        const size_t beginByte = std::min(bitPosition / 8, self.m_byteSize - 1);
+        const size_t endByte = std::min(self.m_byteSize, std::max(beginByte + 1, (bitPosition + numBits + 7) / 8));
+        self.seekSegment(beginByte);
+
+        const Span<const uint8_t> segment = self.m_segments[self.m_segmentIndex];
+        if (endByte <= self.m_segmentByteStart + segment.size())
+        {
+            self.setWindow(segment, segment.size() * 8, self.m_segmentByteStart * 8, true);
+            return Result<void>::success();
+        }
+
+        // the read crosses the segment boundary, join the following segments in the seam
+        const size_t seamByteSize = std::min(self.m_byteSize, std::max(endByte, beginByte + MIN_SEAM_BYTE_SIZE)) -
+                beginByte;
+        // Note: resize() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+        // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+        self.m_seam.resize(seamByteSize);
+
+        size_t seamIndex = 0;
+        size_t segmentIndex = self.m_segmentIndex;
+        size_t segmentOffset = beginByte - self.m_segmentByteStart;
+        while (seamIndex < seamByteSize)
+        {
+            const Span<const uint8_t> source = self.m_segments[segmentIndex];
+            const size_t numBytes = std::min(seamByteSize - seamIndex, source.size() - segmentOffset);
+            if (numBytes > 0)
+            {
+                std::memcpy(self.m_seam.data() + seamIndex, source.data() + segmentOffset, numBytes);
+            }
+            seamIndex += numBytes;
+            segmentOffset = 0;
+            ++segmentIndex;
+        }
+
+        self.setWindow(Span<const uint8_t>(self.m_seam.data(), seamByteSize), seamByteSize * 8, beginByte * 8,
+                false);
+        return Result<void>::success();
+    }
+
+    WindowState m_state;
+    Span<const Span<const uint8_t>> m_segments;
+    size_t m_byteSize;
+    size_t m_segmentIndex;
+    size_t m_segmentByteStart;
+    vector<uint8_t, ALLOC> m_seam;
+};
+
+template <typename ALLOC>
+constexpr size_t BasicSegmentedBitStreamReader<ALLOC>::MIN_SEAM_BYTE_SIZE;
+
+/** Typedef to segmented bit stream reader provided for convenience - using std::allocator<uint8_t>. */
+using SegmentedBitStreamReader = BasicSegmentedBitStreamReader<>;
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_SEGMENTED_BIT_STREAM_READER_H_INC
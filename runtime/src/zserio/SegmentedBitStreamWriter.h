@@ -0,0 +1,219 @@
+#ifndef ZSERIO_SEGMENTED_BIT_STREAM_WRITER_H_INC
+#define ZSERIO_SEGMENTED_BIT_STREAM_WRITER_H_INC
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+#include "zserio/BitStreamWriter.h"
+#include "zserio/ErrorCode.h"
+#include "zserio/RebindAlloc.h"
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Vector.h"
+
+namespace zserio
+{
+
+/**
+ * Bit stream writer which produces a list of segments instead of one contiguous buffer.
+ *
+ * Large byte aligned payloads of bytes, strings and bit buffers are not copied. They are referenced by their own
+ * segments which are interleaved with owned segments holding the rest of the written data. The segments can be
+ * handed over to gather writes like writev() or to IPubsub::publishSegments() without any coalescing copy.
+ *
+ * Referenced payloads must stay valid and unchanged until the segments have been consumed. Payloads which
+ * are not byte aligned or which are smaller than the given minimum are copied as usual. Bit positions
+ * still count all written bits, but setBitPosition() cannot go back before the last referenced payload.
+ *
+ * IMPORTANT: When building with -fno-exceptions, vector operations that would normally throw std::bad_alloc
+ * will instead cause std::abort() (GCC) or undefined behavior (other implementations).
+ */
+template <typename ALLOC = std::allocator<uint8_t>>
+class BasicSegmentedBitStreamWriter : public BitStreamWriter
+{
+public:
+    static_assert(std::is_same<uint8_t, typename ALLOC::value_type>::value,
+            "Allocator with uint8_t value_type is required!");
+
+    using allocator_type = ALLOC;
+
+    /** Default minimum byte size of payloads which are referenced instead of copied. */
+    static constexpr size_t DEFAULT_MIN_REFERENCE_BYTE_SIZE = 4096;
+
+    /**
+     * Constructor - cannot fail, no memory is allocated until the first write.
+     *
+     * \param allocator Allocator to use for the owned segments.
+     */
+    explicit BasicSegmentedBitStreamWriter(const ALLOC& allocator = ALLOC()) noexcept :
+            BasicSegmentedBitStreamWriter(DEFAULT_MIN_REFERENCE_BYTE_SIZE, allocator)
+    {}
+
+    /**
+     * Constructor with custom threshold - cannot fail, no memory is allocated until the first write.
+     *
+     * \param minReferenceByteSize Minimum byte size of payloads which are referenced instead of copied.
+     * \param allocator Allocator to use for the owned segments.
+     */
+    explicit BasicSegmentedBitStreamWriter(size_t minReferenceByteSize, const ALLOC& allocator = ALLOC()) noexcept :
+            BitStreamWriter(&grow),
+            m_chunks(allocator),
+            m_segments(allocator),
+            m_minReferenceByteSize(std::max<size_t>(minReferenceByteSize, 1)),
+            m_numClosedSegments(0),
+            m_closedByteSize(0),
+            m_hasOpenChunk(false)
+    {
+        setRawBytesFunc(&takeRawBytes);
+    }
+
+    /**
+     * Destructor.
+     */
+    ~BasicSegmentedBitStreamWriter()
+    {
+        // the chunks die before the base class would flush into them
+        detachBuffer();
+    }
+
+    /**
+     * Copying and assignment is disallowed, referenced segments point to the owned chunks!
+     * \{
+     */
+    BasicSegmentedBitStreamWriter(const BasicSegmentedBitStreamWriter&) = delete;
+    BasicSegmentedBitStreamWriter& operator=(const BasicSegmentedBitStreamWriter&) = delete;
+
+    BasicSegmentedBitStreamWriter(BasicSegmentedBitStreamWriter&&) = delete;
+    BasicSegmentedBitStreamWriter& operator=(BasicSegmentedBitStreamWriter&&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Gets copy of the allocator used for the owned segments.
+     *
+     * \return Allocator used for the owned segments.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return m_chunks.get_allocator();
+    }
+
+    /**
+     * Gets all segments written so far in stream order.
+     *
+     * The segments hold getBitPosition() bits, unused bits of the last byte of the last segment are zero.
+     * The returned segments are valid until the next write or clear().
+     *
+     * \return Segments of the written data.
+     */
+    Span<const Span<const uint8_t>> getSegments() noexcept
+    {
+        flush();
+        m_segments.resize(m_numClosedSegments);
+
+        const size_t bitSize = getBitPosition() - m_closedByteSize * 8;
+        if (m_hasOpenChunk && bitSize > 0)
+        {
+            vector<uint8_t, ALLOC>& chunk = m_chunks.back();
+            const size_t byteSize = (bitSize + 7) / 8;
+            const uint8_t numLastBits = static_cast<uint8_t>(bitSize % 8);
+            if (numLastBits > 0)
+            {
+                chunk[byteSize - 1] = static_cast<uint8_t>(chunk[byteSize - 1] & (0xFFU << (8U - numLastBits)));
+            }
+            m_segments.push_back(Span<const uint8_t>(chunk.data(), byteSize));
+        }
+
+        return Span<const Span<const uint8_t>>(m_segments.data(), m_segments.size());
+    }
+
+    /**
+     * Forgets all written data. The writer starts again at bit position zero.
+     */
+    void clear() noexcept
+    {
+        detachBuffer();
+        m_chunks.clear();
+        m_segments.clear();
+        m_numClosedSegments = 0;
+        m_closedByteSize = 0;
+        m_hasOpenChunk = false;
+    }
+
+private:
+    using Chunk = vector<uint8_t, ALLOC>;
+
+    // minimum byte size of the first allocation of each owned chunk
+    static constexpr size_t MIN_BYTE_SIZE = 256;
+
+    static Result<void> grow(BitStreamWriter& writer, size_t bitSize) noexcept
+    {
+        BasicSegmentedBitStreamWriter& self = static_cast<BasicSegmentedBitStreamWriter&>(writer);
+        if (!self.m_hasOpenChunk)
+        {
+            // Note: emplace_back() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+            // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+            self.m_chunks.emplace_back(self.get_allocator());
+            self.m_hasOpenChunk = true;
+        }
+
+        Chunk& chunk = self.m_chunks.back();
+        const size_t byteSize = bitSize / 8 + ((bitSize % 8 != 0) ? 1 : 0);
+        if (byteSize > chunk.max_size())
+        {
+            return Result<void>::error(ErrorCode::AllocationFailed);
+        }
+
+        // geometric growth keeps appending amortized constant
+        const size_t grownByteSize = (chunk.size() > chunk.max_size() / 2) ? chunk.max_size() : chunk.size() * 2;
+        chunk.resize(std::max(byteSize, std::max(grownByteSize, MIN_BYTE_SIZE)), 0);
+        self.setGrownBuffer(Span<uint8_t>(chunk.data(), chunk.size()));
+        return Result<void>::success();
+    }
+
+    static Result<bool> takeRawBytes(BitStreamWriter& writer, Span<const uint8_t> data) noexcept
+    {
+        BasicSegmentedBitStreamWriter& self = static_cast<BasicSegmentedBitStreamWriter&>(writer);
+        if (data.size() < self.m_minReferenceByteSize)
+        {
+            return Result<bool>::success(false);
+        }
+
+        // close the open chunk at the current byte aligned position, the chunk is never resized again
+        const size_t byteSize = (writer.getBitPosition() / 8) - self.m_closedByteSize;
+        self.startSegment(data.size());
+        self.m_segments.resize(self.m_numClosedSegments);
+        if (self.m_hasOpenChunk && byteSize > 0)
+        {
+            self.m_segments.push_back(Span<const uint8_t>(self.m_chunks.back().data(), byteSize));
+        }
+        self.m_hasOpenChunk = false;
+        self.m_segments.push_back(data);
+
+        self.m_numClosedSegments = self.m_segments.size();
+        self.m_closedByteSize += byteSize + data.size();
+        return Result<bool>::success(true);
+    }
+
+    vector<Chunk, RebindAlloc<ALLOC, Chunk>> m_chunks;
+    vector<Span<const uint8_t>, RebindAlloc<ALLOC, Span<const uint8_t>>> m_segments;
+    size_t m_minReferenceByteSize;
+    size_t m_numClosedSegments;
+    size_t m_closedByteSize;
+    bool m_hasOpenChunk;
+};
+
+template <typename ALLOC>
+constexpr size_t BasicSegmentedBitStreamWriter<ALLOC>::DEFAULT_MIN_REFERENCE_BYTE_SIZE;
+
+template <typename ALLOC>
+constexpr size_t BasicSegmentedBitStreamWriter<ALLOC>::MIN_BYTE_SIZE;
+
+/** Typedef to segmented bit stream writer provided for convenience - using std::allocator<uint8_t>. */
+using SegmentedBitStreamWriter = BasicSegmentedBitStreamWriter<>;
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_SEGMENTED_BIT_STREAM_WRITER_H_INC
@@ -10,9 +10,20 @@
 #ifndef ZSERIO_SERIALIZE_UTIL_H_INC
 #define ZSERIO_SERIALIZE_UTIL_H_INC
 
+#include <cstdio>
+#include <string>
+
 #include "zserio/BitStreamReader.h"
 #include "zserio/BitStreamWriter.h"
 #include "zserio/FileUtil.h"
+#include "zserio/GrowableBitStreamWriter.h"
+#include "zserio/IExecutor.h"
+#include "zserio/MappedFile.h"
+#include "zserio/OffsetPatcher.h"
+#include "zserio/RebindAlloc.h"
+#include "zserio/SegmentedBitStreamReader.h"
+#include "zserio/StreamingBitStreamReader.h"
+#include "zserio/StreamingBitStreamWriter.h"
 #include "zserio/Result.h"
 #include "zserio/ErrorCode.h"
 #include "zserio/Traits.h"
@@ -99,6 +110,7 @@ Result<BasicBitBuffer<ALLOC>> serialize(T& object, const ALLOC& allocator, ARGS&
     }
     BasicBitBuffer<ALLOC> bitBuffer = bufferResult.moveValue();
     BitStreamWriter writer(bitBuffer);
+    writer.enableWriteCache();
     
     // Write object
     auto writeResult = object.write(writer);
@@ -106,10 +118,40 @@ Result<BasicBitBuffer<ALLOC>> serialize(T& object, const ALLOC& allocator, ARGS&
     {
         return Result<BasicBitBuffer<ALLOC>>::error(writeResult.getError());
     }
+    writer.flush();
     
     return Result<BasicBitBuffer<ALLOC>>::success(std::move(bitBuffer));
 }
 
+template <typename T, typename ALLOC, typename... ARGS>
+Result<BasicBitBuffer<ALLOC>> serializeSinglePass(T& object, const ALLOC& allocator, ARGS&&... arguments) noexcept
+{
+    auto initResult = detail::initialize(object, std::forward<ARGS>(arguments)...);
+    if (initResult.isError())
+    {
+        return Result<BasicBitBuffer<ALLOC>>::error(initResult.getError());
+    }
+
+    BasicGrowableBitStreamWriter<ALLOC> writer(allocator);
+    writer.enableWriteCache();
+    BasicOffsetPatcher<ALLOC> offsetPatcher(allocator);
+    writer.setOffsetPatcher(&offsetPatcher);
+
+    auto writeResult = object.write(writer);
+    if (writeResult.isError())
+    {
+        return Result<BasicBitBuffer<ALLOC>>::error(writeResult.getError());
+    }
+
+    auto patchResult = offsetPatcher.apply(writer);
+    if (patchResult.isError())
+    {
+        return Result<BasicBitBuffer<ALLOC>>::error(patchResult.getError());
+    }
+
+    return writer.release();
+}
+
 } // namespace detail
 
 /**
@@ -177,6 +219,49 @@ Result<BasicBitBuffer<ALLOC>> serialize(T& object, ARGS&&... arguments) noexcept
     return detail::serialize(object, ALLOC(), std::forward<ARGS>(arguments)...);
 }
 
+/**
+ * Serializes given generated object to bit buffer in a single pass using given allocator.
+ *
+ * Unlike serialize(), `initializeOffsets()` is not called. The object is written once into a growing buffer.
+ * Offset fields are written as patch slots and filled in when their labeled fields are reached, thus offset
+ * fields of the object itself are left untouched. Objects without offsets are simply written once.
+ *
+ * Before serialization, the method properly calls on the given zserio object methods `initialize()`
+ * (if exits) and `initializeChildren()` (if exists).
+ *
+ * \param object Generated object to serialize.
+ * \param allocator Allocator to use to allocate bit buffer.
+ * \param arguments Object's actual parameters for initialize() method (optional).
+ *
+ * \return Result containing bit buffer with the serialized object, or error code.
+ */
+template <typename T, typename ALLOC, typename... ARGS,
+        typename std::enable_if<!std::is_enum<T>::value && is_allocator<ALLOC>::value, int>::type = 0>
+Result<BasicBitBuffer<ALLOC>> serializeSinglePass(T& object, const ALLOC& allocator, ARGS&&... arguments) noexcept
+{
+    return detail::serializeSinglePass(object, allocator, std::forward<ARGS>(arguments)...);
+}
+
+/**
+ * Serializes given generated object to bit buffer in a single pass using default allocator
+ * 'std::allocator<uint8_t>'.
+ *
+ * See serializeSinglePass() with allocator for details.
+ *
+ * \param object Generated object to serialize.
+ * \param arguments Object's actual parameters for initialize() method (optional).
+ *
+ * \return Result containing bit buffer with the serialized object, or error code.
+ */
+template <typename T, typename ALLOC = typename detail::allocator_chooser<T>::type, typename... ARGS,
+        typename std::enable_if<!std::is_enum<T>::value &&
+                        !is_first_allocator<typename std::decay<ARGS>::type...>::value,
+                int>::type = 0>
+Result<BasicBitBuffer<ALLOC>> serializeSinglePass(T& object, ARGS&&... arguments) noexcept
+{
+    return detail::serializeSinglePass(object, ALLOC(), std::forward<ARGS>(arguments)...);
+}
+
 /**
  * Serializes given generated enum to bit buffer.
  *
@@ -455,9 +540,155 @@ typename std::enable_if<std::is_enum<T>::value, Result<T>>::type deserializeFrom
     return zserio::read<T>(reader);
 }
 
+/**
+ * Deserializes many independent buffers to instances of generated object concurrently.
+ *
+ * Each buffer is deserialized as by deserializeFromBytes() by a single task of the executor. Allocators
+ * of the read objects are created by the allocator factory for the worker which reads the object, thus each
+ * worker can use its own memory resource and no allocator is shared across threads. The factory is called
+ * concurrently with different worker indices. The vector of results is allocated by the allocator of the worker
+ * zero before the reading starts.
+ *
+ * Example:
+ * \code{.cpp}
+ *     #include <zserio/SerializeUtil.h>
+ *     #include <zserio/ThreadPoolExecutor.h>
+ *
+ *     zserio::ThreadPoolExecutor executor;
+ *     std::vector<SomeMemoryResource> resources(executor.getConcurrency());
+ *     auto allocatorFactory = [&resources](size_t workerIndex) {
+ *         return zserio::pmr::PropagatingPolymorphicAllocator<>(&resources[workerIndex]);
+ *     };
+ *     auto readObjectResults = zserio::deserializeBatch<SomeZserioObject>(buffers, executor, allocatorFactory);
+ *     for (auto& readObjectResult : readObjectResults) {
+ *         if (readObjectResult.isError()) {
+ *             // handle error
+ *         }
+ *     }
+ * \endcode
+ *
+ * \param buffers Buffers to deserialize.
+ * \param executor Executor which runs the deserialization of the buffers.
+ * \param allocatorFactory Functor which returns the allocator to use by the worker with the given index.
+ * \param arguments Object's actual parameters for object's read constructor shared by all buffers (optional).
+ *
+ * \return Vector of results in order of the buffers.
+ */
+template <typename T, typename ALLOCATOR_FACTORY, typename... ARGS>
+vector<Result<T>, RebindAlloc<typename T::allocator_type, Result<T>>> deserializeBatch(
+        Span<const Span<const uint8_t>> buffers, IExecutor& executor, ALLOCATOR_FACTORY& allocatorFactory,
+        const ARGS&... arguments) noexcept
+{
+    using ResultAllocator = RebindAlloc<typename T::allocator_type, Result<T>>;
+
+    // TODO: These allocations may abort if allocation fails with -fno-exceptions!
+    vector<Result<T>, ResultAllocator> results{ResultAllocator(allocatorFactory(0))};
+    results.reserve(buffers.size());
+    for (size_t index = 0; index < buffers.size(); ++index)
+    {
+        // replaced by the result of the task
+        results.push_back(Result<T>::error(ErrorCode::InvalidOperation));
+    }
+
+    auto deserializeBuffer = [&](size_t index, size_t workerIndex) {
+        BitStreamReader reader(buffers[index]);
+        results[index] = T::deserialize(reader, arguments..., allocatorFactory(workerIndex));
+    };
+    runWorkerTasks(executor, buffers.size(), deserializeBuffer);
+
+    return results;
+}
+
+/**
+ * Deserializes given segments of bytes to instance of generated object.
+ *
+ * The segments are read in place without joining them into one buffer, see SegmentedBitStreamReader.
+ *
+ * Example:
+ * \code{.cpp}
+ *     #include <zserio/SerializeUtil.h>
+ *
+ *     const zserio::Span<const uint8_t> segments[] = {firstChunk, secondChunk};
+ *     auto readObjectResult = zserio::deserializeFromSegments<SomeZserioObject>(segments);
+ *     if (readObjectResult.isError()) {
+ *         // handle error
+ *     }
+ *     SomeZserioObject readObject = readObjectResult.moveValue();
+ * \endcode
+ *
+ * \param segments Segments of bytes to use in stream order.
+ * \param arguments Object's actual parameters together with allocator for object's read constructor (optional).
+ *
+ * \return Result containing generated object created from the given segments, or error code.
+ */
+template <typename T, typename... ARGS>
+typename std::enable_if<!std::is_enum<T>::value, Result<T>>::type deserializeFromSegments(
+        Span<const Span<const uint8_t>> segments, ARGS&&... arguments) noexcept
+{
+    SegmentedBitStreamReader reader(segments);
+    return T::deserialize(reader, std::forward<ARGS>(arguments)...);
+}
+
+/**
+ * Serializes given generated object to byte sink.
+ *
+ * Before serialization, the method properly calls on the given zserio object methods `initialize()`
+ * (if exits), `initializeChildren()` (if exists) and `initializeOffsets()`. The object is written through
+ * a bounded buffer which is flushed to the sink whenever it fills, see StreamingBitStreamWriter.
+ *
+ * Example:
+ * \code{.cpp}
+ *     #include <zserio/SerializeUtil.h>
+ *
+ *     SomeZserioObject object;
+ *     auto result = zserio::serializeToStream(object, sink);
+ *     if (result.isError()) {
+ *         // handle error
+ *     }
+ * \endcode
+ *
+ * \param object Generated object to serialize.
+ * \param sink Sink to write.
+ * \param arguments Object's actual parameters for initialize() method (optional).
+ *
+ * \return Result<void> indicating success or error code. The sink can contain partial data on error.
+ */
+template <typename T, typename... ARGS>
+typename std::enable_if<!std::is_enum<T>::value, Result<void>>::type serializeToStream(
+        T& object, IByteSink& sink, ARGS&&... arguments) noexcept
+{
+    auto initResult = detail::initialize(object, std::forward<ARGS>(arguments)...);
+    if (initResult.isError())
+    {
+        return initResult;
+    }
+
+    // offsets must be known in advance, flushed bytes cannot be patched
+    auto bitSizeResult = object.initializeOffsets();
+    if (bitSizeResult.isError())
+    {
+        return Result<void>::error(bitSizeResult.getError());
+    }
+
+    StreamingBitStreamWriter writer(sink);
+    writer.enableWriteCache();
+    auto writeResult = object.write(writer);
+    if (writeResult.isError())
+    {
+        return writeResult;
+    }
+
+    return writer.finish();
+}
+
 /**
  * Serializes given generated object to file.
  *
+ * The object is streamed to the file through a bounded buffer, thus the whole serialized object is never
+ * held in memory, see serializeToStream(). The object is written to a temporary file with a unique name next
+ * to the file, see getTemporaryFileName(). The temporary file replaces the file only when the whole object has
+ * been written, otherwise it is removed.
+ *
  * Example:
  * \code{.cpp}
  *     #include <zserio/SerializeUtil.h>
@@ -473,12 +704,57 @@ typename std::enable_if<std::is_enum<T>::value, Result<T>>::type deserializeFrom
  * \param fileName File name to write.
  * \param arguments Object's actual parameters for initialize() method (optional).
  *
- * \return Result<void> indicating success or error code.
+ * \return Result<void> indicating success or error code. The file is left untouched on error.
  */
 template <typename T, typename... ARGS>
-Result<void> serializeToFile(T& object, const std::string& fileName, ARGS&&... arguments) noexcept
+typename std::enable_if<!std::is_enum<T>::value, Result<void>>::type serializeToFile(
+        T& object, const std::string& fileName, ARGS&&... arguments) noexcept
 {
-    auto bitBufferResult = serialize(object, std::forward<ARGS>(arguments)...);
+    const std::string tempFileName = getTemporaryFileName(fileName);
+    auto sinkResult = FileByteSink::open(tempFileName);
+    if (sinkResult.isError())
+    {
+        static_cast<void>(std::remove(tempFileName.c_str()));
+        return Result<void>::error(sinkResult.getError());
+    }
+
+    auto serializeResult = serializeToStream(object, sinkResult.getValue(), std::forward<ARGS>(arguments)...);
+    auto closeResult = sinkResult.getValue().close();
+    auto replaceResult = (serializeResult.isSuccess() && closeResult.isSuccess())
+            ? replaceFile(tempFileName, fileName)
+            : Result<void>::error(serializeResult.isError() ? serializeResult.getError() : closeResult.getError());
+    if (replaceResult.isError())
+    {
+        static_cast<void>(std::remove(tempFileName.c_str()));
+    }
+
+    return replaceResult;
+}
+
+/**
+ * Serializes given generated enum to file.
+ *
+ * Example:
+ * \code{.cpp}
+ *     #include <zserio/SerializeUtil.h>
+ *
+ *     const SomeZserioEnum enumValue = SomeZserioEnum::SomeEnumValue;
+ *     auto result = zserio::serializeToFile(enumValue, "FileName.bin");
+ *     if (result.isError()) {
+ *         // handle error
+ *     }
+ * \endcode
+ *
+ * \param enumValue Generated enum to serialize.
+ * \param fileName File name to write.
+ *
+ * \return Result<void> indicating success or error code.
+ */
+template <typename T>
+typename std::enable_if<std::is_enum<T>::value, Result<void>>::type serializeToFile(
+        T enumValue, const std::string& fileName) noexcept
+{
+    auto bitBufferResult = serialize(enumValue);
     if (bitBufferResult.isError())
     {
         return Result<void>::error(bitBufferResult.getError());
@@ -524,6 +800,73 @@ Result<T> deserializeFromFile(const std::string& fileName, ARGS&&... arguments)
     return deserialize<T>(bitBufferResult.getValue(), std::forward<ARGS>(arguments)...);
 }
 
+/**
+ * Deserializes given memory mapped file to instance of generated object.
+ *
+ * Unlike deserializeFromFile(), the file contents are neither allocated nor copied, the reader reads directly
+ * from the mapping. Views into the file contents, e.g. from readBytesView() or readStringView(), stay valid
+ * as long as the mapped file exists.
+ *
+ * Example:
+ * \code{.cpp}
+ *     #include <zserio/SerializeUtil.h>
+ *
+ *     auto mappedFileResult = zserio::MappedFile::open("FileName.bin");
+ *     if (mappedFileResult.isError()) {
+ *         // handle error
+ *     }
+ *     auto readObjectResult = zserio::deserializeFromMappedFile<SomeZserioObject>(mappedFileResult.getValue());
+ *     if (readObjectResult.isError()) {
+ *         // handle error
+ *     }
+ *     SomeZserioObject readObject = readObjectResult.moveValue();
+ * \endcode
+ *
+ * \param mappedFile Mapped file to use.
+ * \param arguments Object's arguments (optional).
+ *
+ * \return Result containing generated object created from the given file contents, or error code.
+ */
+template <typename T, typename... ARGS>
+Result<T> deserializeFromMappedFile(const MappedFile& mappedFile, ARGS&&... arguments) noexcept
+{
+    return deserializeFromBytes<T>(mappedFile.getData(), std::forward<ARGS>(arguments)...);
+}
+
+/**
+ * Deserializes instance of generated object from given byte source.
+ *
+ * Unlike deserializeFromFile(), the stream is not loaded into memory as a whole, it is pulled from the source
+ * through a bounded window while reading, see StreamingBitStreamReader.
+ *
+ * Example:
+ * \code{.cpp}
+ *     #include <zserio/SerializeUtil.h>
+ *
+ *     auto sourceResult = zserio::FileByteSource::open("FileName.bin");
+ *     if (sourceResult.isError()) {
+ *         // handle error
+ *     }
+ *     auto readObjectResult = zserio::deserializeFromStream<SomeZserioObject>(sourceResult.getValue());
+ *     if (readObjectResult.isError()) {
+ *         // handle error
+ *     }
+ *     SomeZserioObject readObject = readObjectResult.moveValue();
+ * \endcode
+ *
+ * \param source Source of the stream.
+ * \param arguments Object's actual parameters together with allocator for object's read constructor (optional).
+ *
+ * \return Result containing generated object created from the given source, or error code.
+ */
+template <typename T, typename... ARGS>
+typename std::enable_if<!std::is_enum<T>::value, Result<T>>::type deserializeFromStream(
+        IByteSource& source, ARGS&&... arguments) noexcept
+{
+    StreamingBitStreamReader reader(source);
+    return T::deserialize(reader, std::forward<ARGS>(arguments)...);
+}
+
 } // namespace zserio
 
 #endif // ZSERIO_SERIALIZE_UTIL_H_INC
\ No newline at end of file
@@ -1,8 +1,10 @@
 #ifndef ZSERIO_SPAN_H_INC
 #define ZSERIO_SPAN_H_INC
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <type_traits>
@@ -396,6 +398,53 @@ private:
     detail::SpanStorage<T, Extent> m_storage;
 };
 
+/**
+ * Read-only view of bytes, e.g. of bytes read straight from a bit stream buffer.
+ */
+using BytesView = Span<const uint8_t>;
+
+/**
+ * Compares elements of two spans.
+ *
+ * \param lhs Left hand side span.
+ * \param rhs Right hand side span.
+ *
+ * \return True when both spans contain the same elements, false otherwise.
+ */
+template <typename T, std::size_t LhsExtent, std::size_t RhsExtent>
+bool operator==(const Span<T, LhsExtent>& lhs, const Span<T, RhsExtent>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/**
+ * Compares elements of two spans.
+ *
+ * \param lhs Left hand side span.
+ * \param rhs Right hand side span.
+ *
+ * \return True when the spans differ in at least one element, false otherwise.
+ */
+template <typename T, std::size_t LhsExtent, std::size_t RhsExtent>
+bool operator!=(const Span<T, LhsExtent>& lhs, const Span<T, RhsExtent>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/**
+ * Compares elements of two spans lexicographically.
+ *
+ * \param lhs Left hand side span.
+ * \param rhs Right hand side span.
+ *
+ * \return True when the left hand side span is lexicographically less than the right hand side span.
+ */
+template <typename T, std::size_t LhsExtent, std::size_t RhsExtent>
+bool operator<(const Span<T, LhsExtent>& lhs, const Span<T, RhsExtent>& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
 } // namespace zserio
 
 #endif // ZSERIO_SPAN_H_INC
@@ -0,0 +1,209 @@
+#ifndef ZSERIO_STREAMING_BIT_STREAM_READER_H_INC
+#define ZSERIO_STREAMING_BIT_STREAM_READER_H_INC
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "zserio/BitStreamReader.h"
+#include "zserio/ErrorCode.h"
+#include "zserio/IByteSource.h"
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Vector.h"
+
+namespace zserio
+{
+
+/**
+ * Bit stream reader which pulls the stream from a byte source while reading.
+ *
+ * Only a bounded window of the stream is kept in memory, thus streams larger than the available memory can be
+ * read. The window holds at least the given number of bytes before the byte of the current position, thus
+ * setBitPosition() can go back to any position within them, no matter how the current position was reached.
+ * Going further back can fail with SeekError, going forward skips the bytes of the source.
+ *
+ * The window is overwritten while reading, thus readBytesView() and readStringView() always fail with
+ * InvalidPointer. When the source does not know its size, getBufferBitSize() returns the maximum size_t
+ * value and the end of the stream is detected only when the source is exhausted.
+ *
+ * The source must outlive the reader. The reader pulls bytes ahead of the current position, thus the source
+ * cannot be shared with other readers.
+ *
+ * IMPORTANT: When building with -fno-exceptions, vector operations that would normally throw std::bad_alloc
+ * will instead cause std::abort() (GCC) or undefined behavior (other implementations).
+ */
+template <typename ALLOC = std::allocator<uint8_t>>
+class BasicStreamingBitStreamReader : public BitStreamReader
+{
+public:
+    static_assert(std::is_same<uint8_t, typename ALLOC::value_type>::value,
+            "Allocator with uint8_t value_type is required!");
+
+    using allocator_type = ALLOC;
+
+    /** Default number of bytes kept behind the current position. */
+    static constexpr size_t DEFAULT_BACKWARD_BYTE_SIZE = 64 * 1024;
+
+    /** Default number of bytes pulled from the source at once. */
+    static constexpr size_t DEFAULT_READ_BYTE_SIZE = 64 * 1024;
+
+    /**
+     * Constructor - cannot fail, nothing is read until the first read from the stream.
+     *
+     * \param source Source of the stream.
+     * \param allocator Allocator to use for the window.
+     */
+    explicit BasicStreamingBitStreamReader(IByteSource& source, const ALLOC& allocator = ALLOC()) noexcept :
+            BasicStreamingBitStreamReader(source, DEFAULT_BACKWARD_BYTE_SIZE, DEFAULT_READ_BYTE_SIZE, allocator)
+    {}
+
+    /**
+     * Constructor with custom window - cannot fail, nothing is read until the first read from the stream.
+     *
+     * \param source Source of the stream.
+     * \param backwardByteSize Number of bytes before the byte of the current position which setBitPosition()
+     *                         can always reach.
+     * \param readByteSize Number of bytes pulled from the source at once.
+     * \param allocator Allocator to use for the window.
+     */
+    BasicStreamingBitStreamReader(IByteSource& source, size_t backwardByteSize, size_t readByteSize,
+            const ALLOC& allocator = ALLOC()) noexcept :
+            BitStreamReader(m_state),
+            m_state(&refill, getStreamBitSize(source)),
+            m_source(source),
+            m_window(allocator),
+            m_backwardByteSize(backwardByteSize),
+            m_readByteSize(std::max<size_t>(readByteSize, 1)),
+            m_windowByteStart(0),
+            m_windowByteSize(0)
+    {}
+
+    /**
+     * Destructor.
+     */
+    ~BasicStreamingBitStreamReader() = default;
+
+    /**
+     * Copying and moving is disallowed, the current window points to the owned buffer!
+     * \{
+     */
+    BasicStreamingBitStreamReader(const BasicStreamingBitStreamReader&) = delete;
+    BasicStreamingBitStreamReader& operator=(const BasicStreamingBitStreamReader&) = delete;
+
+    BasicStreamingBitStreamReader(BasicStreamingBitStreamReader&&) = delete;
+    BasicStreamingBitStreamReader& operator=(BasicStreamingBitStreamReader&&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Gets copy of the allocator used for the window.
+     *
+     * \return Allocator used for the window.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return m_window.get_allocator();
+    }
+
+private:
+    static size_t getStreamBitSize(const IByteSource& source) noexcept
+    {
+        const size_t byteSize = source.getByteSize();
+        return (byteSize > std::numeric_limits<size_t>::max() / 8) ? std::numeric_limits<size_t>::max()
+                                                                     : byteSize * 8;
+    }
+
+    // drops the bytes before the given stream byte, the rest is moved to the beginning of the window
+    void dropBytes(size_t byteIndex) noexcept
+    {
+        const size_t numBytes = byteIndex - m_windowByteStart;
+        if (numBytes > 0)
+        {
+            m_windowByteSize -= numBytes;
+            std::memmove(m_window.data(), m_window.data() + numBytes, m_windowByteSize);
+            m_windowByteStart = byteIndex;
+        }
+    }
+
+    static Result<void> refill(BitStreamReader& reader, BitPosType bitPosition, size_t numBits) noexcept
+    {
+        BasicStreamingBitStreamReader& self = static_cast<BasicStreamingBitStreamReader&>(reader);
+        const size_t beginByte = bitPosition / 8;
+        if (beginByte < self.m_windowByteStart)
+        {
+            // the source cannot be rewound
+            return Result<void>::error(ErrorCode::SeekError);
+        }
+
+        const size_t endByte =
+                std::min(reader.getBufferBitSize() / 8, beginByte + (bitPosition % 8 + numBits + 7) / 8);
+        // the reader is at the given position after the refill (refills are done for the current position or
+        // for the target of a seek), thus the kept bytes are anchored to the position of the reader
+        const size_t keepByteStart = beginByte - std::min(beginByte, self.m_backwardByteSize);
+        ErrorCode errorCode = ErrorCode::Success;
+        while (self.m_windowByteStart + self.m_windowByteSize < endByte)
+        {
+            // bytes skipped by a forward seek are dropped as soon as they are read
+            const size_t windowByteEnd = self.m_windowByteStart + self.m_windowByteSize;
+            if (self.m_window.size() - self.m_windowByteSize < self.m_readByteSize)
+            {
+                self.dropBytes(std::max(self.m_windowByteStart, std::min(keepByteStart, windowByteEnd)));
+            }
+
+            const size_t readByteSize = (windowByteEnd < beginByte)
+                    ? self.m_readByteSize
+                    : std::max(self.m_readByteSize, endByte - windowByteEnd);
+            if (self.m_window.size() - self.m_windowByteSize < readByteSize)
+            {
+                // Note: resize() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+                // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+                self.m_window.resize(self.m_windowByteSize + readByteSize);
+            }
+
+            auto readResult = self.m_source.read(Span<uint8_t>(
+                    self.m_window.data() + self.m_windowByteSize, self.m_window.size() - self.m_windowByteSize));
+            if (readResult.isError())
+            {
+                errorCode = readResult.getError();
+                break;
+            }
+            if (readResult.getValue() == 0)
+            {
+                // end of the source, the reader reports the end of the stream
+                break;
+            }
+            self.m_windowByteSize += readResult.getValue();
+        }
+
+        // the window is set even on error, the buffer could have been moved
+        self.setWindow(Span<const uint8_t>(self.m_window.data(), self.m_windowByteSize),
+                std::min(self.m_windowByteSize * 8, reader.getBufferBitSize() - self.m_windowByteStart * 8),
+                self.m_windowByteStart * 8, false);
+        return (errorCode == ErrorCode::Success) ? Result<void>::success() : Result<void>::error(errorCode);
+    }
+
+    WindowState m_state;
+    IByteSource& m_source;
+    vector<uint8_t, ALLOC> m_window;
+    size_t m_backwardByteSize;
+    size_t m_readByteSize;
+    size_t m_windowByteStart;
+    size_t m_windowByteSize;
+};
+
+template <typename ALLOC>
+constexpr size_t BasicStreamingBitStreamReader<ALLOC>::DEFAULT_BACKWARD_BYTE_SIZE;
+
+template <typename ALLOC>
+constexpr size_t BasicStreamingBitStreamReader<ALLOC>::DEFAULT_READ_BYTE_SIZE;
+
+/** Typedef to streaming bit stream reader provided for convenience - using std::allocator<uint8_t>. */
+using StreamingBitStreamReader = BasicStreamingBitStreamReader<>;
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_STREAMING_BIT_STREAM_READER_H_INC
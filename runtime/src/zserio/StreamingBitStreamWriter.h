@@ -0,0 +1,233 @@
+#ifndef ZSERIO_STREAMING_BIT_STREAM_WRITER_H_INC
+#define ZSERIO_STREAMING_BIT_STREAM_WRITER_H_INC
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "zserio/BitStreamWriter.h"
+#include "zserio/ErrorCode.h"
+#include "zserio/IByteSink.h"
+#include "zserio/Result.h"
+#include "zserio/Span.h"
+#include "zserio/Vector.h"
+
+namespace zserio
+{
+
+/**
+ * Bit stream writer which flushes written bytes to a byte sink whenever its buffer fills.
+ *
+ * Peak memory is bounded by the buffer size regardless of the size of the written stream. Arrays of bit fields
+ * and payloads of bytes, strings and bit buffers are written in chunks of 32 KiB, thus a smaller buffer grows
+ * at most to the chunk size. Byte aligned payloads which are at least as large as the buffer are passed to
+ * the sink directly.
+ *
+ * Flushed bytes cannot be rewritten, thus setBitPosition() cannot go back before the start of the buffer.
+ * Offsets must be known before writing, see initializeOffsets().
+ *
+ * IMPORTANT: When building with -fno-exceptions, vector operations that would normally throw std::bad_alloc
+ * will instead cause std::abort() (GCC) or undefined behavior (other implementations).
+ */
+template <typename ALLOC = std::allocator<uint8_t>>
+class BasicStreamingBitStreamWriter : public BitStreamWriter
+{
+public:
+    static_assert(std::is_same<uint8_t, typename ALLOC::value_type>::value,
+            "Allocator with uint8_t value_type is required!");
+
+    using allocator_type = ALLOC;
+
+    /** Default byte size of the buffer. */
+    static constexpr size_t DEFAULT_BUFFER_BYTE_SIZE = 64 * 1024;
+
+    /**
+     * Constructor - cannot fail, no memory is allocated until the first write.
+     *
+     * \param sink Sink to flush the written bytes to.
+     * \param allocator Allocator to use for the buffer.
+     */
+    explicit BasicStreamingBitStreamWriter(IByteSink& sink, const ALLOC& allocator = ALLOC()) noexcept :
+            BasicStreamingBitStreamWriter(sink, DEFAULT_BUFFER_BYTE_SIZE, allocator)
+    {}
+
+    /**
+     * Constructor with custom buffer size - cannot fail, no memory is allocated until the first write.
+     *
+     * \param sink Sink to flush the written bytes to.
+     * \param bufferByteSize Byte size of the buffer.
+     * \param allocator Allocator to use for the buffer.
+     */
+    BasicStreamingBitStreamWriter(IByteSink& sink, size_t bufferByteSize, const ALLOC& allocator = ALLOC()) noexcept :
+            BitStreamWriter(&grow),
+            m_sink(sink),
+            m_buffer(allocator),
+            m_bufferByteSize(std::max<size_t>(bufferByteSize, 8)),
+            m_flushedByteSize(0),
+            m_isFinished(false)
+    {
+        setRawBytesFunc(&takeRawBytes);
+    }
+
+    /**
+     * Destructor.
+     *
+     * Bytes which have not been flushed by finish() are lost.
+     */
+    ~BasicStreamingBitStreamWriter()
+    {
+        // the buffer dies before the base class would flush into it
+        detachBuffer();
+    }
+
+    /**
+     * Copying and moving is disallowed, the writer writes into the owned buffer!
+     * \{
+     */
+    BasicStreamingBitStreamWriter(const BasicStreamingBitStreamWriter&) = delete;
+    BasicStreamingBitStreamWriter& operator=(const BasicStreamingBitStreamWriter&) = delete;
+
+    BasicStreamingBitStreamWriter(BasicStreamingBitStreamWriter&&) = delete;
+    BasicStreamingBitStreamWriter& operator=(BasicStreamingBitStreamWriter&&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Gets copy of the allocator used for the buffer.
+     *
+     * \return Allocator used for the buffer.
+     */
+    allocator_type get_allocator() const noexcept
+    {
+        return m_buffer.get_allocator();
+    }
+
+    /**
+     * Flushes all remaining bytes to the sink. Unused bits of the last byte are zero.
+     *
+     * Nothing can be written after finishing, further writes fail with StreamClosed.
+     *
+     * \return Success or error code of the sink.
+     */
+    Result<void> finish() noexcept
+    {
+        if (m_isFinished)
+        {
+            return Result<void>::error(ErrorCode::StreamClosed);
+        }
+
+        flush();
+        const size_t bitSize = getBitPosition() - m_flushedByteSize * 8;
+        const size_t byteSize = (bitSize + 7) / 8;
+        const uint8_t numLastBits = static_cast<uint8_t>(bitSize % 8);
+        if (numLastBits > 0)
+        {
+            m_buffer[byteSize - 1] = static_cast<uint8_t>(m_buffer[byteSize - 1] & (0xFFU << (8U - numLastBits)));
+        }
+
+        m_isFinished = true;
+        detachBuffer();
+        return (byteSize > 0) ? m_sink.write(Span<const uint8_t>(m_buffer.data(), byteSize))
+                              : Result<void>::success();
+    }
+
+private:
+    // flushes whole bytes before the current position and moves the rest to the beginning of the buffer
+    Result<void> flushBytes() noexcept
+    {
+        flush();
+        const size_t byteSize = (getBitPosition() / 8) - m_flushedByteSize;
+        if (byteSize == 0)
+        {
+            return Result<void>::success();
+        }
+
+        auto writeResult = m_sink.write(Span<const uint8_t>(m_buffer.data(), byteSize));
+        if (writeResult.isError())
+        {
+            return writeResult;
+        }
+
+        // bytes behind the position can be written already when the position has been moved back
+        std::memmove(m_buffer.data(), m_buffer.data() + byteSize, m_buffer.size() - byteSize);
+        discardBytes(byteSize);
+        m_flushedByteSize += byteSize;
+        return Result<void>::success();
+    }
+
+    static Result<void> grow(BitStreamWriter& writer, size_t bitSize) noexcept
+    {
+        BasicStreamingBitStreamWriter& self = static_cast<BasicStreamingBitStreamWriter&>(writer);
+        if (self.m_isFinished)
+        {
+            return Result<void>::error(ErrorCode::StreamClosed);
+        }
+
+        // the requested size is relative to the buffer start which moves by the flushed bytes
+        const size_t oldFlushedByteSize = self.m_flushedByteSize;
+        auto flushResult = self.flushBytes();
+        if (flushResult.isError())
+        {
+            return flushResult;
+        }
+
+        const size_t requiredBitSize = bitSize - (self.m_flushedByteSize - oldFlushedByteSize) * 8;
+        const size_t requiredByteSize = requiredBitSize / 8 + ((requiredBitSize % 8 != 0) ? 1 : 0);
+        if (requiredByteSize > self.m_buffer.max_size())
+        {
+            return Result<void>::error(ErrorCode::AllocationFailed);
+        }
+
+        if (requiredByteSize > self.m_buffer.size() || self.m_buffer.size() < self.m_bufferByteSize)
+        {
+            // Note: resize() can fail with std::bad_alloc, but with -fno-exceptions this becomes
+            // std::abort() or undefined behavior. In safe environments, ensure sufficient memory.
+            self.m_buffer.resize(std::max(requiredByteSize, self.m_bufferByteSize), 0);
+        }
+        self.setGrownBuffer(Span<uint8_t>(self.m_buffer.data(), self.m_buffer.size()));
+        return Result<void>::success();
+    }
+
+    static Result<bool> takeRawBytes(BitStreamWriter& writer, Span<const uint8_t> data) noexcept
+    {
+        BasicStreamingBitStreamWriter& self = static_cast<BasicStreamingBitStreamWriter&>(writer);
+        if (data.size() < self.m_bufferByteSize || self.m_isFinished)
+        {
+            return Result<bool>::success(false);
+        }
+
+        auto flushResult = self.flushBytes();
+        if (flushResult.isError())
+        {
+            return Result<bool>::error(flushResult.getError());
+        }
+
+        auto writeResult = self.m_sink.write(data);
+        if (writeResult.isError())
+        {
+            return Result<bool>::error(writeResult.getError());
+        }
+
+        self.startSegment(data.size());
+        self.m_flushedByteSize += data.size();
+        return Result<bool>::success(true);
+    }
+
+    IByteSink& m_sink;
+    vector<uint8_t, ALLOC> m_buffer;
+    size_t m_bufferByteSize;
+    size_t m_flushedByteSize;
+    bool m_isFinished;
+};
+
+template <typename ALLOC>
+constexpr size_t BasicStreamingBitStreamWriter<ALLOC>::DEFAULT_BUFFER_BYTE_SIZE;
+
+/** Typedef to streaming bit stream writer provided for convenience - using std::allocator<uint8_t>. */
+using StreamingBitStreamWriter = BasicStreamingBitStreamWriter<>;
+
+} // namespace zserio
+
+#endif // ifndef ZSERIO_STREAMING_BIT_STREAM_WRITER_H_INC
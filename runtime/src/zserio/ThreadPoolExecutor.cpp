@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "zserio/ThreadPoolExecutor.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+// set while the thread runs tasks of any executor, nested runs are sequential to prevent deadlocks
+thread_local bool t_isRunningTasks = false;
+thread_local size_t t_workerIndex = 0;
+
+// maximum number of tasks of a single job, task indices of a worker are packed into one atomic word
+const size_t MAX_JOB_NUM_TASKS = std::numeric_limits<uint32_t>::max();
+
+// remaining task indices [begin, end) of a single worker, padded to prevent false sharing
+struct WorkerTasks
+{
+    std::atomic<uint64_t> range;
+    char padding[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+uint64_t packRange(size_t begin, size_t end)
+{
+    return (static_cast<uint64_t>(begin) << 32U) | static_cast<uint64_t>(end);
+}
+
+size_t rangeBegin(uint64_t range)
+{
+    return static_cast<size_t>(range >> 32U);
+}
+
+size_t rangeEnd(uint64_t range)
+{
+    return static_cast<size_t>(range & 0xFFFFFFFFU);
+}
+
+// tasks of a single run() call, lives on the stack of the calling thread
+struct Job
+{
+    Job(size_t jobFirstTask, IExecutor::TaskFunc jobTask, void* jobContext, WorkerTasks* jobWorkerTasks,
+            size_t jobNumWorkers) :
+            firstTask(jobFirstTask),
+            task(jobTask),
+            context(jobContext),
+            workerTasks(jobWorkerTasks),
+            numWorkers(jobNumWorkers)
+    {}
+
+    void execute(size_t workerIndex) noexcept
+    {
+        const bool wasRunningTasks = t_isRunningTasks;
+        const size_t previousWorkerIndex = t_workerIndex;
+        t_isRunningTasks = true;
+        t_workerIndex = workerIndex;
+        size_t taskIndex = 0;
+        while (popTask(workerIndex, taskIndex) || stealTask(workerIndex, taskIndex))
+        {
+            task(context, firstTask + taskIndex, workerIndex);
+        }
+        t_isRunningTasks = wasRunningTasks;
+        t_workerIndex = previousWorkerIndex;
+    }
+
+    // takes the first task of the own range
+    bool popTask(size_t workerIndex, size_t& taskIndex) noexcept
+    {
+        std::atomic<uint64_t>& range = workerTasks[workerIndex].range;
+        uint64_t value = range.load();
+        while (rangeBegin(value) < rangeEnd(value))
+        {
+            if (range.compare_exchange_weak(value, packRange(rangeBegin(value) + 1, rangeEnd(value))))
+            {
+                taskIndex = rangeBegin(value);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // takes the upper half of the range of another worker, the rest of it becomes the own range
+    bool stealTask(size_t workerIndex, size_t& taskIndex) noexcept
+    {
+        for (size_t i = 1; i < numWorkers; ++i)
+        {
+            std::atomic<uint64_t>& victimRange = workerTasks[(workerIndex + i) % numWorkers].range;
+            uint64_t value = victimRange.load();
+            while (rangeBegin(value) < rangeEnd(value))
+            {
+                const size_t begin = rangeBegin(value);
+                const size_t end = rangeEnd(value);
+                const size_t stolenBegin = begin + (end - begin) / 2;
+                if (victimRange.compare_exchange_weak(value, packRange(begin, stolenBegin)))
+                {
+                    workerTasks[workerIndex].range.store(packRange(stolenBegin + 1, end));
+                    taskIndex = stolenBegin;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    const size_t firstTask;
+    const IExecutor::TaskFunc task;
+    void* const context;
+    WorkerTasks* const workerTasks;
+    const size_t numWorkers;
+};
+
+} // namespace
+
+struct ThreadPoolExecutor::State
+{
+    std::vector<std::thread> threads;
+
+    // task ranges of the calling thread and of the worker threads, used by one job at a time
+    std::unique_ptr<WorkerTasks[]> workerTasks;
+
+    // serializes concurrent callers of run()
+    std::mutex runMutex;
+
+    // guards the current job and the number of workers which joined it
+    std::mutex mutex;
+    std::condition_variable jobCondition;
+    std::condition_variable doneCondition;
+    Job* job = nullptr;
+    uint64_t jobId = 0;
+    size_t numActiveWorkers = 0;
+    bool isStopping = false;
+
+    void runWorker(size_t workerIndex) noexcept
+    {
+        uint64_t lastJobId = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            jobCondition.wait(lock, [this, lastJobId] {
+                return isStopping || (job != nullptr && jobId != lastJobId);
+            });
+            if (isStopping)
+            {
+                return;
+            }
+
+            // the job stays alive until all joined workers leave it
+            Job* const currentJob = job;
+            lastJobId = jobId;
+            ++numActiveWorkers;
+            lock.unlock();
+
+            currentJob->execute(workerIndex);
+
+            lock.lock();
+            if (--numActiveWorkers == 0)
+            {
+                doneCondition.notify_all();
+            }
+        }
+    }
+
+    void runJob(size_t firstTask, size_t numTasks, TaskFunc task, void* context) noexcept
+    {
+        // tasks are shared evenly, workers which do not join the job in time are robbed by the others
+        const size_t numWorkers = threads.size() + 1;
+        for (size_t workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+        {
+            workerTasks[workerIndex].range.store(packRange(numTasks * workerIndex / numWorkers,
+                    numTasks * (workerIndex + 1) / numWorkers));
+        }
+
+        Job currentJob(firstTask, task, context, workerTasks.get(), numWorkers);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &currentJob;
+            ++jobId;
+        }
+        jobCondition.notify_all();
+
+        currentJob.execute(0);
+
+        // no worker can join the job anymore, wait for the workers which are still running its tasks
+        std::unique_lock<std::mutex> lock(mutex);
+        job = nullptr;
+        doneCondition.wait(lock, [this] {
+            return numActiveWorkers == 0;
+        });
+    }
+};
+
+ThreadPoolExecutor::ThreadPoolExecutor(size_t numThreads) :
+        m_state(new State())
+{
+    if (numThreads == 0)
+    {
+        const size_t numHardwareThreads = std::thread::hardware_concurrency();
+        numThreads = (numHardwareThreads > 1) ? numHardwareThreads - 1 : 0;
+    }
+
+    // Note: thread creation can fail with std::system_error, but with -fno-exceptions this becomes
+    // std::abort() or undefined behavior.
+    State* statePtr = m_state.get();
+    m_state->workerTasks.reset(new WorkerTasks[numThreads + 1]);
+    m_state->threads.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        m_state->threads.emplace_back([statePtr, i] {
+            statePtr->runWorker(i + 1);
+        });
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->isStopping = true;
+    }
+    m_state->jobCondition.notify_all();
+    for (std::thread& thread : m_state->threads)
+    {
+        thread.join();
+    }
+}
+
+size_t ThreadPoolExecutor::getConcurrency() const noexcept
+{
+    return m_state->threads.size() + 1;
+}
+
+void ThreadPoolExecutor::run(size_t numTasks, TaskFunc task, void* context) noexcept
+{
+    if (numTasks < 2 || m_state->threads.empty() || t_isRunningTasks)
+    {
+        // nested tasks keep the worker index of the running task
+        const bool wasRunningTasks = t_isRunningTasks;
+        const size_t previousWorkerIndex = t_workerIndex;
+        const size_t workerIndex = wasRunningTasks ? t_workerIndex : 0;
+        t_isRunningTasks = true;
+        t_workerIndex = workerIndex;
+        for (size_t taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            task(context, taskIndex, workerIndex);
+        }
+        t_isRunningTasks = wasRunningTasks;
+        t_workerIndex = previousWorkerIndex;
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(m_state->runMutex);
+    for (size_t firstTask = 0; firstTask < numTasks; firstTask += MAX_JOB_NUM_TASKS)
+    {
+        m_state->runJob(firstTask, std::min(numTasks - firstTask, MAX_JOB_NUM_TASKS), task, context);
+    }
+}
+
+} // namespace zserio
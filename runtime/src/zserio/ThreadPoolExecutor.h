@@ -0,0 +1,87 @@
+/**
+ * \file
+ * Executor which runs tasks by a pool of worker threads.
+ *
+ * These utilities are not used by generated code and they are provided only for user convenience.
+ */
+
+#ifndef ZSERIO_THREAD_POOL_EXECUTOR_H_INC
+#define ZSERIO_THREAD_POOL_EXECUTOR_H_INC
+
+#include <memory>
+
+#include "zserio/IExecutor.h"
+#include "zserio/Types.h"
+
+namespace zserio
+{
+
+/**
+ * Executor which runs tasks by a fixed pool of worker threads.
+ *
+ * Workers are started by the constructor and sleep while there is nothing to run. The calling thread of run()
+ * takes part in running the tasks as the worker with index zero, thus a pool with N worker threads runs up to
+ * N + 1 tasks concurrently. Tasks are distributed by work stealing: each worker starts with its own share of
+ * the task indices and steals half of the remaining share of another worker when it runs out of tasks. Thus
+ * many small tasks are run without contention and tasks of different durations are balanced.
+ *
+ * Concurrent calls of run() from several threads are served one after another. Calls of run() from within
+ * a running task run the nested tasks sequentially in the calling thread with the worker index of the running
+ * task.
+ *
+ * IMPORTANT: When building with -fno-exceptions, thread operations that would normally throw will instead
+ * cause std::abort() (GCC) or undefined behavior (other implementations).
+ */
+class ThreadPoolExecutor : public IExecutor
+{
+public:
+    /**
+     * Constructor which starts the worker threads.
+     *
+     * \param numThreads Number of worker threads, zero uses one less than the number of hardware threads.
+     */
+    explicit ThreadPoolExecutor(size_t numThreads = 0);
+
+    /**
+     * Destructor which stops the worker threads.
+     */
+    ~ThreadPoolExecutor() override;
+
+    /**
+     * Copying and moving is disallowed, the worker threads are owned!
+     * \{
+     */
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+
+    ThreadPoolExecutor(ThreadPoolExecutor&&) = delete;
+    ThreadPoolExecutor& operator=(ThreadPoolExecutor&&) = delete;
+    /**
+     * \}
+     */
+
+    /**
+     * Gets number of tasks which can run concurrently.
+     *
+     * \return Number of worker threads plus one for the calling thread.
+     */
+    size_t getConcurrency() const noexcept override;
+
+    /**
+     * Runs the tasks by the worker threads and the calling thread and waits until all of them finish.
+     *
+     * \param numTasks Number of tasks to run.
+     * \param task Function which runs the single task.
+     * \param context Context passed to the function.
+     */
+    void run(size_t numTasks, TaskFunc task, void* context) noexcept override;
+
+private:
+    struct State;
+
+    std::unique_ptr<State> m_state;
+};
+
+} // namespace zserio
+
+#endif // ZSERIO_THREAD_POOL_EXECUTOR_H_INC
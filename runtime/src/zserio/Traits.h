@@ -76,12 +76,42 @@ struct decltype_check_offset
     using type = U;
 };
 
+template <typename T, typename U = decltype(&T::resolveOffset)>
+struct decltype_resolve_offset
+{
+    using type = U;
+};
+
+template <typename T, typename U = decltype(&T::getOffset)>
+struct decltype_get_offset
+{
+    using type = U;
+};
+
 template <typename T, typename U = decltype(&T::initializeElement)>
 struct decltype_initialize_element
 {
     using type = U;
 };
 
+template <typename T, typename U = decltype(&T::readArray)>
+struct decltype_read_array
+{
+    using type = U;
+};
+
+template <typename T, typename U = decltype(&T::writeArray)>
+struct decltype_write_array
+{
+    using type = U;
+};
+
+template <typename T, typename U = decltype(&T::skip)>
+struct decltype_skip
+{
+    using type = U;
+};
+
 template <typename... T>
 struct make_void
 {
@@ -231,6 +261,36 @@ struct has_check_offset<T, detail::void_t<typename detail::decltype_check_offset
  * \}
  */
 
+/**
+ * Trait used to check whether the type T has resolveOffset method.
+ * \{
+ */
+template <typename T, typename = void>
+struct has_resolve_offset : std::false_type
+{};
+
+template <typename T>
+struct has_resolve_offset<T, detail::void_t<typename detail::decltype_resolve_offset<T>::type>> : std::true_type
+{};
+/**
+ * \}
+ */
+
+/**
+ * Trait used to check whether the type T has getOffset method.
+ * \{
+ */
+template <typename T, typename = void>
+struct has_get_offset : std::false_type
+{};
+
+template <typename T>
+struct has_get_offset<T, detail::void_t<typename detail::decltype_get_offset<T>::type>> : std::true_type
+{};
+/**
+ * \}
+ */
+
 /**
  * Trait used to check whether the type T has initializeElement method.
  * \{
@@ -247,6 +307,51 @@ struct has_initialize_element<T, detail::void_t<typename detail::decltype_initia
  * \}
  */
 
+/**
+ * Trait used to check whether the type T has readArray method.
+ * \{
+ */
+template <typename T, typename = void>
+struct has_read_array : std::false_type
+{};
+
+template <typename T>
+struct has_read_array<T, detail::void_t<typename detail::decltype_read_array<T>::type>> : std::true_type
+{};
+/**
+ * \}
+ */
+
+/**
+ * Trait used to check whether the type T has writeArray method.
+ * \{
+ */
+template <typename T, typename = void>
+struct has_write_array : std::false_type
+{};
+
+template <typename T>
+struct has_write_array<T, detail::void_t<typename detail::decltype_write_array<T>::type>> : std::true_type
+{};
+/**
+ * \}
+ */
+
+/**
+ * Trait used to check whether the type T has skip method.
+ * \{
+ */
+template <typename T, typename = void>
+struct has_skip : std::false_type
+{};
+
+template <typename T>
+struct has_skip<T, detail::void_t<typename detail::decltype_skip<T>::type>> : std::true_type
+{};
+/**
+ * \}
+ */
+
 /**
  * Trait used to check whether the type T is a zserio bitmask.
  * \{
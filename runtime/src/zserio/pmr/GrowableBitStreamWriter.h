@@ -0,0 +1,20 @@
+#ifndef ZSERIO_PMR_GROWABLE_BIT_STREAM_WRITER_H_INC
+#define ZSERIO_PMR_GROWABLE_BIT_STREAM_WRITER_H_INC
+
+#include "zserio/GrowableBitStreamWriter.h"
+#include "zserio/pmr/PolymorphicAllocator.h"
+
+namespace zserio
+{
+namespace pmr
+{
+
+/**
+ * Typedef to GrowableBitStreamWriter provided for convenience - using PropagatingPolymorphicAllocator<uint8_t>.
+ */
+using GrowableBitStreamWriter = BasicGrowableBitStreamWriter<PropagatingPolymorphicAllocator<uint8_t>>;
+
+} // namespace pmr
+} // namespace zserio
+
+#endif // ZSERIO_PMR_GROWABLE_BIT_STREAM_WRITER_H_INC
@@ -0,0 +1,141 @@
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#include "zserio/pmr/MonotonicBufferResource.h"
+
+namespace zserio
+{
+namespace pmr
+{
+
+constexpr size_t MonotonicBufferResource::DEFAULT_BLOCK_SIZE;
+
+MonotonicBufferResource::MonotonicBufferResource(MemoryResource* upstream) noexcept :
+        MonotonicBufferResource(nullptr, 0, upstream)
+{}
+
+MonotonicBufferResource::MonotonicBufferResource(size_t initialBlockSize, MemoryResource* upstream) noexcept :
+        MonotonicBufferResource(nullptr, 0, upstream)
+{
+    if (initialBlockSize > 0)
+    {
+        m_nextBlockSize = initialBlockSize;
+    }
+}
+
+MonotonicBufferResource::MonotonicBufferResource(
+        void* buffer, size_t bufferSize, MemoryResource* upstream) noexcept :
+        m_upstream(upstream),
+        m_initialBuffer(buffer),
+        m_initialBufferSize((buffer != nullptr) ? bufferSize : 0),
+        m_nextBlockSize((bufferSize > 0) ? bufferSize : DEFAULT_BLOCK_SIZE),
+        m_blocks(nullptr),
+        m_current(buffer),
+        m_remainingSize(m_initialBufferSize),
+        m_isExhausted(false)
+{}
+
+MonotonicBufferResource::~MonotonicBufferResource()
+{
+    release();
+}
+
+void MonotonicBufferResource::release() noexcept
+{
+    while (m_blocks != nullptr)
+    {
+        BlockHeader* const block = m_blocks;
+        m_blocks = block->next;
+        block->resource->deallocate(block, block->size, alignof(std::max_align_t));
+    }
+
+    m_current = m_initialBuffer;
+    m_remainingSize = m_initialBufferSize;
+    m_isExhausted = false;
+}
+
+void* MonotonicBufferResource::doAllocate(size_t bytes, size_t alignment)
+{
+    void* storage = allocateFromCurrent(bytes, alignment);
+    if (storage != nullptr)
+    {
+        return storage;
+    }
+
+    if (m_upstream != nullptr && allocateBlock(m_upstream, bytes, alignment))
+    {
+        return allocateFromCurrent(bytes, alignment);
+    }
+
+    // callers do not check for null pointer, thus the exhaustion is only recorded
+    m_isExhausted = true;
+    MemoryResource* const fallback = getDefaultResource();
+    if (fallback == this || fallback == m_upstream || !allocateBlock(fallback, bytes, alignment))
+    {
+        return nullptr;
+    }
+
+    return allocateFromCurrent(bytes, alignment);
+}
+
+void MonotonicBufferResource::doDeallocate(void*, size_t, size_t)
+{
+    // memory is released at once by release()
+}
+
+bool MonotonicBufferResource::doIsEqual(const MemoryResource& other) const noexcept
+{
+    return this == &other;
+}
+
+void* MonotonicBufferResource::allocateFromCurrent(size_t bytes, size_t alignment) noexcept
+{
+    if (m_current == nullptr)
+    {
+        return nullptr;
+    }
+
+    void* storage = m_current;
+    size_t space = m_remainingSize;
+    if (std::align(alignment, bytes, storage, space) == nullptr)
+    {
+        return nullptr;
+    }
+
+    m_current = static_cast<unsigned char*>(storage) + bytes;
+    m_remainingSize = space - bytes;
+    return storage;
+}
+
+bool MonotonicBufferResource::allocateBlock(MemoryResource* resource, size_t bytes, size_t alignment) noexcept
+{
+    // the block must hold the header and the storage aligned behind it
+    const size_t maxSize = std::numeric_limits<size_t>::max();
+    if (bytes > maxSize - sizeof(BlockHeader) - alignment)
+    {
+        return false;
+    }
+    const size_t minBlockSize = sizeof(BlockHeader) + alignment + bytes;
+    const size_t blockSize = (m_nextBlockSize > minBlockSize) ? m_nextBlockSize : minBlockSize;
+
+    void* const memory = resource->allocate(blockSize, alignof(std::max_align_t));
+    if (memory == nullptr)
+    {
+        return false;
+    }
+
+    BlockHeader* const block = static_cast<BlockHeader*>(memory);
+    block->next = m_blocks;
+    block->resource = resource;
+    block->size = blockSize;
+    m_blocks = block;
+
+    m_current = block + 1;
+    m_remainingSize = blockSize - sizeof(BlockHeader);
+    m_nextBlockSize = (blockSize > maxSize / 2) ? maxSize : blockSize * 2;
+    return true;
+}
+
+} // namespace pmr
+} // namespace zserio
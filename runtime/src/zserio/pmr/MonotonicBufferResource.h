@@ -0,0 +1,125 @@
+#ifndef ZSERIO_PMR_MONOTONIC_BUFFER_RESOURCE_H_INC
+#define ZSERIO_PMR_MONOTONIC_BUFFER_RESOURCE_H_INC
+
+#include <cstddef>
+
+#include "zserio/pmr/MemoryResource.h"
+
+namespace zserio
+{
+namespace pmr
+{
+
+/**
+ * Memory resource which allocates by bumping a pointer and releases all memory at once.
+ *
+ * Memory is allocated from the initial buffer given by the user and then from blocks of geometrically growing
+ * size allocated from the upstream resource. Deallocation does nothing, the memory is released by release()
+ * or by the destructor. Thus deserialization of a large tree of objects costs a few pointer bumps per object
+ * and the tree is destroyed in constant time. Objects must not be used after the memory is released.
+ *
+ * When neither the buffer nor the upstream resource can satisfy an allocation, the resource is marked as
+ * exhausted, see isExhausted(), and the memory is allocated from the default resource (getDefaultResource())
+ * instead. Standard containers and generated objects do not check the returned pointer, thus the resource never
+ * returns null pointer while the default resource can allocate. Without the upstream resource, the initial
+ * buffer is used until it is exhausted. Callers which need a bounded arena check isExhausted() after
+ * the deserialization.
+ *
+ * The resource is not thread-safe, use a separate resource per thread, e.g. per worker of deserializeBatch().
+ */
+class MonotonicBufferResource : public MemoryResource
+{
+public:
+    /**
+     * Constructor which allocates all memory from the upstream resource.
+     *
+     * \param upstream Upstream resource used for blocks of memory.
+     */
+    explicit MonotonicBufferResource(MemoryResource* upstream = getDefaultResource()) noexcept;
+
+    /**
+     * Constructor which allocates all memory from the upstream resource starting with the given block size.
+     *
+     * \param initialBlockSize Size of the first block allocated from the upstream resource.
+     * \param upstream Upstream resource used for blocks of memory.
+     */
+    explicit MonotonicBufferResource(
+            size_t initialBlockSize, MemoryResource* upstream = getDefaultResource()) noexcept;
+
+    /**
+     * Constructor which allocates from the given buffer first.
+     *
+     * \param buffer Initial buffer, must outlive the resource.
+     * \param bufferSize Size of the initial buffer in bytes.
+     * \param upstream Upstream resource used for blocks of memory when the buffer is exhausted or nullptr to use
+     *                 only the buffer until it is exhausted.
+     */
+    MonotonicBufferResource(
+            void* buffer, size_t bufferSize, MemoryResource* upstream = getDefaultResource()) noexcept;
+
+    /**
+     * Destructor which releases all blocks allocated from the upstream resource.
+     */
+    ~MonotonicBufferResource() override;
+
+    /**
+     * Releases all blocks allocated from the upstream resource at once.
+     *
+     * The following allocations start again at the beginning of the initial buffer and the exhausted state is
+     * cleared.
+     */
+    void release() noexcept;
+
+    /**
+     * Gets whether the buffer and the upstream resource could not satisfy an allocation since the construction
+     * or the last release().
+     *
+     * \return True when the default resource has been used instead, false otherwise.
+     */
+    bool isExhausted() const noexcept
+    {
+        return m_isExhausted;
+    }
+
+    /**
+     * Gets the upstream resource.
+     *
+     * \return Upstream resource or nullptr when only the initial buffer is used until it is exhausted.
+     */
+    MemoryResource* getUpstreamResource() const noexcept
+    {
+        return m_upstream;
+    }
+
+private:
+    // header of a block allocated from the upstream resource, the blocks are chained from the newest one
+    struct BlockHeader
+    {
+        BlockHeader* next;
+        MemoryResource* resource;
+        size_t size;
+    };
+
+    void* doAllocate(size_t bytes, size_t alignment) override;
+    void doDeallocate(void* storage, size_t bytes, size_t alignment) override;
+    bool doIsEqual(const MemoryResource& other) const noexcept override;
+
+    void* allocateFromCurrent(size_t bytes, size_t alignment) noexcept;
+    bool allocateBlock(MemoryResource* resource, size_t bytes, size_t alignment) noexcept;
+
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1024;
+
+    MemoryResource* m_upstream;
+    void* m_initialBuffer;
+    size_t m_initialBufferSize;
+    size_t m_nextBlockSize;
+    BlockHeader* m_blocks;
+    void* m_current;
+    size_t m_remainingSize;
+    bool m_isExhausted;
+};
+
+} // namespace pmr
+} // namespace zserio
+
+#endif // ZSERIO_PMR_MONOTONIC_BUFFER_RESOURCE_H_INC
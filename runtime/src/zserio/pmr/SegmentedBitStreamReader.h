@@ -0,0 +1,20 @@
+#ifndef ZSERIO_PMR_SEGMENTED_BIT_STREAM_READER_H_INC
+#define ZSERIO_PMR_SEGMENTED_BIT_STREAM_READER_H_INC
+
+#include "zserio/SegmentedBitStreamReader.h"
+#include "zserio/pmr/PolymorphicAllocator.h"
+
+namespace zserio
+{
+namespace pmr
+{
+
+/**
+ * Typedef to SegmentedBitStreamReader provided for convenience - using PropagatingPolymorphicAllocator<uint8_t>.
+ */
+using SegmentedBitStreamReader = BasicSegmentedBitStreamReader<PropagatingPolymorphicAllocator<uint8_t>>;
+
+} // namespace pmr
+} // namespace zserio
+
+#endif // ZSERIO_PMR_SEGMENTED_BIT_STREAM_READER_H_INC
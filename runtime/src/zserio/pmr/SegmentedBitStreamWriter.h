@@ -0,0 +1,20 @@
+#ifndef ZSERIO_PMR_SEGMENTED_BIT_STREAM_WRITER_H_INC
+#define ZSERIO_PMR_SEGMENTED_BIT_STREAM_WRITER_H_INC
+
+#include "zserio/SegmentedBitStreamWriter.h"
+#include "zserio/pmr/PolymorphicAllocator.h"
+
+namespace zserio
+{
+namespace pmr
+{
+
+/**
+ * Typedef to SegmentedBitStreamWriter provided for convenience - using PropagatingPolymorphicAllocator<uint8_t>.
+ */
+using SegmentedBitStreamWriter = BasicSegmentedBitStreamWriter<PropagatingPolymorphicAllocator<uint8_t>>;
+
+} // namespace pmr
+} // namespace zserio
+
+#endif // ZSERIO_PMR_SEGMENTED_BIT_STREAM_WRITER_H_INC
@@ -0,0 +1,20 @@
+#ifndef ZSERIO_PMR_STREAMING_BIT_STREAM_WRITER_H_INC
+#define ZSERIO_PMR_STREAMING_BIT_STREAM_WRITER_H_INC
+
+#include "zserio/StreamingBitStreamWriter.h"
+#include "zserio/pmr/PolymorphicAllocator.h"
+
+namespace zserio
+{
+namespace pmr
+{
+
+/**
+ * Typedef to StreamingBitStreamWriter provided for convenience - using PropagatingPolymorphicAllocator<uint8_t>.
+ */
+using StreamingBitStreamWriter = BasicStreamingBitStreamWriter<PropagatingPolymorphicAllocator<uint8_t>>;
+
+} // namespace pmr
+} // namespace zserio
+
+#endif // ZSERIO_PMR_STREAMING_BIT_STREAM_WRITER_H_INC
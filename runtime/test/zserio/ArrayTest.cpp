@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <limits>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -13,6 +16,9 @@
 #include "zserio/BitBuffer.h"
 #include "zserio/CppRuntimeException.h"
 #include "zserio/Enums.h"
+#include "zserio/ParallelReadScope.h"
+#include "zserio/ParallelWriteScope.h"
+#include "zserio/ThreadPoolExecutor.h"
 
 namespace zserio
 {
@@ -236,6 +242,165 @@ public:
     }
 };
 
+struct ParallelReadOwner
+{
+    std::vector<uint32_t> offsets;
+};
+
+class ParallelReadArrayExpressions
+{
+public:
+    using OwnerType = ParallelReadOwner;
+
+    static void checkOffset(const ParallelReadOwner&, size_t, size_t)
+    {}
+
+    static size_t getOffset(const ParallelReadOwner& owner, size_t index)
+    {
+        return owner.offsets[index];
+    }
+};
+
+// threads which allocated by ThreadCheckingAllocator
+struct AllocatingThreads
+{
+    std::thread::id ownerThreadId = std::this_thread::get_id();
+    std::atomic<size_t> numForeignAllocations{0};
+};
+
+// stateful allocator which counts allocations in other threads than the creating one
+template <typename T>
+class ThreadCheckingAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ThreadCheckingAllocator(AllocatingThreads& threads) noexcept :
+            m_threads(&threads)
+    {}
+
+    template <typename U>
+    ThreadCheckingAllocator(const ThreadCheckingAllocator<U>& other) noexcept :
+            m_threads(other.getThreads())
+    {}
+
+    T* allocate(size_t numElements)
+    {
+        if (std::this_thread::get_id() != m_threads->ownerThreadId)
+        {
+            ++m_threads->numForeignAllocations;
+        }
+        return std::allocator<T>().allocate(numElements);
+    }
+
+    void deallocate(T* pointer, size_t numElements) noexcept
+    {
+        std::allocator<T>().deallocate(pointer, numElements);
+    }
+
+    AllocatingThreads* getThreads() const noexcept
+    {
+        return m_threads;
+    }
+
+private:
+    AllocatingThreads* m_threads;
+};
+
+template <typename T, typename U>
+bool operator==(const ThreadCheckingAllocator<T>& lhs, const ThreadCheckingAllocator<U>& rhs)
+{
+    return lhs.getThreads() == rhs.getThreads();
+}
+
+template <typename T, typename U>
+bool operator!=(const ThreadCheckingAllocator<T>& lhs, const ThreadCheckingAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+const size_t PARALLEL_READ_NUM_ELEMENTS = 1000;
+
+// writes aligned varuint32 elements of different sizes and collects their offsets
+std::vector<uint8_t> writeParallelReadElements(ParallelReadOwner& owner, size_t& bitSize)
+{
+    std::vector<uint8_t> data(PARALLEL_READ_NUM_ELEMENTS * 5);
+    BitStreamWriter writer(data.data(), data.size());
+    for (size_t index = 0; index < PARALLEL_READ_NUM_ELEMENTS; ++index)
+    {
+        EXPECT_TRUE(writer.alignTo(8).isSuccess());
+        owner.offsets.push_back(static_cast<uint32_t>(writer.getBitPosition() / 8));
+        EXPECT_TRUE(writer.writeVarUInt32(static_cast<uint32_t>(index * index * 37)).isSuccess());
+    }
+    bitSize = writer.getBitPosition();
+    writer.flush();
+
+    return data;
+}
+
+
+// elements which take one byte at even byte positions and two bytes at odd byte positions, thus the bit size
+// of a range of elements depends on more than the byte alignment of its start
+struct BytePositionArrayTraits
+{
+    using ElementType = uint8_t;
+
+    static uint8_t elementBitSize(size_t bitPosition)
+    {
+        return ((bitPosition / 8) % 2 == 0) ? 8 : 16;
+    }
+
+    static Result<size_t> bitSizeOf(size_t bitPosition, ElementType)
+    {
+        return Result<size_t>::success(elementBitSize(bitPosition));
+    }
+
+    static Result<size_t> initializeOffsets(size_t bitPosition, ElementType)
+    {
+        return Result<size_t>::success(bitPosition + elementBitSize(bitPosition));
+    }
+
+    static Result<void> write(BitStreamWriter& out, ElementType element) noexcept
+    {
+        return out.writeBits(element, elementBitSize(out.getBitPosition()));
+    }
+
+    static constexpr bool IS_BITSIZEOF_CONSTANT = false;
+};
+
+// writes the array sequentially and by the executor to zeroed buffers and checks that they are equal
+template <typename ARRAY_T>
+void checkParallelWrite(const ARRAY_T& array, size_t numLeadingBits, IExecutor& executor)
+{
+    ParallelReadOwner owner;
+    const size_t bufferByteSize = array.getRawArray().size() * 5 + 1;
+
+    std::vector<uint8_t> expectedData(bufferByteSize);
+    BitStreamWriter sequentialWriter(expectedData.data(), expectedData.size());
+    if (numLeadingBits > 0)
+    {
+        ASSERT_TRUE(sequentialWriter.writeBits(0x5, static_cast<uint8_t>(numLeadingBits)).isSuccess());
+    }
+    ASSERT_TRUE(array.write(owner, sequentialWriter).isSuccess());
+    sequentialWriter.flush();
+
+    std::vector<uint8_t> data(bufferByteSize);
+    BitStreamWriter writer(data.data(), data.size());
+    if (numLeadingBits > 0)
+    {
+        ASSERT_TRUE(writer.writeBits(0x5, static_cast<uint8_t>(numLeadingBits)).isSuccess());
+    }
+    ASSERT_TRUE(array.write(owner, writer, executor).isSuccess());
+    writer.flush();
+
+    ASSERT_EQ(sequentialWriter.getBitPosition(), writer.getBitPosition()) << numLeadingBits;
+    ASSERT_EQ(expectedData, data) << numLeadingBits;
+
+    const size_t bitSize = sequentialWriter.getBitPosition() - numLeadingBits;
+    ASSERT_EQ(bitSize, array.bitSizeOf(owner, numLeadingBits).getValue()) << numLeadingBits;
+    ASSERT_EQ(bitSize, array.bitSizeOf(owner, numLeadingBits, executor).getValue()) << numLeadingBits;
+}
+
 } // namespace
 
 class ArrayTest : public ::testing::Test
@@ -1476,4 +1641,179 @@ TEST_F(ArrayTest, createOptionalArray)
     ASSERT_EQ(array, optionalArray->getRawArray());
 }
 
+TEST_F(ArrayTest, readHugeAutoLength)
+{
+    // the length of an auto array is rejected before the elements are allocated
+    std::array<uint8_t, 32> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    ASSERT_TRUE(writer.writeVarSize(1U << 28U).isSuccess());
+    writer.flush();
+
+    using StdIntArrayT = Array<std::vector<uint32_t>, StdIntArrayTraits<uint32_t>, ArrayType::AUTO>;
+    BitStreamReader stdIntReader(data.data(), data.size());
+    StdIntArrayT stdIntArray;
+    ASSERT_EQ(ErrorCode::EndOfStream, stdIntArray.read(stdIntReader).getError());
+    ASSERT_TRUE(stdIntArray.getRawArray().empty());
+
+    using VarIntArrayT = Array<std::vector<uint32_t>, VarIntNNArrayTraits<uint32_t>, ArrayType::AUTO>;
+    BitStreamReader varIntReader(data.data(), data.size());
+    VarIntArrayT varIntArray;
+    ASSERT_EQ(ErrorCode::EndOfStream, varIntArray.read(varIntReader).getError());
+    ASSERT_TRUE(varIntArray.getRawArray().empty());
+
+    // the elements which fit into the rest of the stream are read
+    using BitFieldArrayT = Array<std::vector<uint8_t>, BitFieldArrayTraits<uint8_t, 4>, ArrayType::NORMAL>;
+    BitStreamReader bitFieldReader(data.data(), data.size());
+    BitFieldArrayT bitFieldArray;
+    ASSERT_TRUE(bitFieldArray.read(bitFieldReader, data.size() * 2).isSuccess());
+    ASSERT_EQ(data.size() * 2, bitFieldArray.getRawArray().size());
+}
+
+TEST_F(ArrayTest, parallelReadAlignedArray)
+{
+    using ArrayT = Array<std::vector<uint32_t>, VarIntNNArrayTraits<uint32_t>, ArrayType::ALIGNED,
+            ParallelReadArrayExpressions>;
+
+    ParallelReadOwner owner;
+    size_t bitSize = 0;
+    const std::vector<uint8_t> data = writeParallelReadElements(owner, bitSize);
+
+    BitStreamReader sequentialReader(data.data(), bitSize, BitsTag());
+    ArrayT sequentialArray;
+    ASSERT_TRUE(sequentialArray.read(owner, sequentialReader, PARALLEL_READ_NUM_ELEMENTS).isSuccess());
+
+    ThreadPoolExecutor executor(4);
+    BitStreamReader reader(data.data(), bitSize, BitsTag());
+    ArrayT array;
+    ASSERT_TRUE(array.read(owner, reader, PARALLEL_READ_NUM_ELEMENTS, executor).isSuccess());
+    ASSERT_EQ(sequentialArray.getRawArray(), array.getRawArray());
+    ASSERT_EQ(bitSize, reader.getBitPosition());
+}
+
+TEST_F(ArrayTest, parallelReadInvalidOffset)
+{
+    using ArrayT = Array<std::vector<uint32_t>, VarIntNNArrayTraits<uint32_t>, ArrayType::ALIGNED,
+            ParallelReadArrayExpressions>;
+
+    ParallelReadOwner owner;
+    size_t bitSize = 0;
+    const std::vector<uint8_t> data = writeParallelReadElements(owner, bitSize);
+
+    // ranges start at the shifted offsets, thus the end of the first range does not meet the next range
+    for (size_t index = 1; index < owner.offsets.size(); ++index)
+    {
+        ++owner.offsets[index];
+    }
+
+    ThreadPoolExecutor executor(4);
+    BitStreamReader reader(data.data(), bitSize, BitsTag());
+    ArrayT array;
+    ASSERT_EQ(ErrorCode::InvalidOffset, array.read(owner, reader, PARALLEL_READ_NUM_ELEMENTS, executor).getError());
+    ASSERT_TRUE(array.getRawArray().empty());
+}
+
+TEST_F(ArrayTest, parallelReadScope)
+{
+    using Allocator = ThreadCheckingAllocator<uint32_t>;
+    using ArrayT = Array<std::vector<uint32_t>, VarIntNNArrayTraits<uint32_t>, ArrayType::ALIGNED,
+            ParallelReadArrayExpressions>;
+    using StatefulArrayT = Array<std::vector<uint32_t, Allocator>, VarIntNNArrayTraits<uint32_t>,
+            ArrayType::ALIGNED, ParallelReadArrayExpressions>;
+
+    ParallelReadOwner owner;
+    size_t bitSize = 0;
+    const std::vector<uint8_t> data = writeParallelReadElements(owner, bitSize);
+
+    ThreadPoolExecutor executor(4);
+    ParallelReadScope parallelReadScope(executor);
+
+    BitStreamReader reader(data.data(), bitSize, BitsTag());
+    ArrayT array;
+    ASSERT_TRUE(array.read(owner, reader, PARALLEL_READ_NUM_ELEMENTS).isSuccess());
+    ASSERT_EQ(bitSize, reader.getBitPosition());
+
+    // stateful allocators are used by the reading thread only
+    AllocatingThreads threads;
+    BitStreamReader statefulReader(data.data(), bitSize, BitsTag());
+    StatefulArrayT statefulArray{Allocator(threads)};
+    ASSERT_TRUE(statefulArray.read(owner, statefulReader, PARALLEL_READ_NUM_ELEMENTS).isSuccess());
+    ASSERT_EQ(bitSize, statefulReader.getBitPosition());
+    ASSERT_EQ(0U, threads.numForeignAllocations.load());
+    ASSERT_EQ(array.getRawArray().size(), statefulArray.getRawArray().size());
+    ASSERT_TRUE(std::equal(
+            array.getRawArray().begin(), array.getRawArray().end(), statefulArray.getRawArray().begin()));
+}
+
+TEST_F(ArrayTest, parallelWriteAlignedArray)
+{
+    using ArrayT = Array<std::vector<uint32_t>, VarIntNNArrayTraits<uint32_t>, ArrayType::ALIGNED,
+            ParallelReadArrayExpressions>;
+
+    std::vector<uint32_t> rawArray;
+    for (size_t index = 0; index < PARALLEL_READ_NUM_ELEMENTS; ++index)
+    {
+        rawArray.push_back(static_cast<uint32_t>(index * index * 37));
+    }
+    const ArrayT array(rawArray);
+
+    ThreadPoolExecutor executor(4);
+    for (size_t numLeadingBits : {size_t(0), size_t(3), size_t(8)})
+    {
+        checkParallelWrite(array, numLeadingBits, executor);
+    }
+
+    // too few elements for more ranges are written sequentially
+    const ArrayT shortArray(std::vector<uint32_t>{1000});
+    checkParallelWrite(shortArray, 3, executor);
+}
+
+TEST_F(ArrayTest, parallelWriteFallback)
+{
+    using ArrayT = Array<std::vector<uint8_t>, BytePositionArrayTraits, ArrayType::ALIGNED,
+            ParallelReadArrayExpressions>;
+
+    // ranges written at their estimated start positions do not end at the start of the next range
+    std::vector<uint8_t> rawArray;
+    for (size_t index = 0; index < PARALLEL_READ_NUM_ELEMENTS; ++index)
+    {
+        rawArray.push_back(static_cast<uint8_t>(index * 7));
+    }
+    const ArrayT array(rawArray);
+
+    ThreadPoolExecutor executor(4);
+    for (size_t numLeadingBits : {size_t(0), size_t(3), size_t(8)})
+    {
+        checkParallelWrite(array, numLeadingBits, executor);
+    }
+}
+
+TEST_F(ArrayTest, parallelWriteScope)
+{
+    using ArrayT = Array<std::vector<uint32_t>, VarIntNNArrayTraits<uint32_t>, ArrayType::ALIGNED,
+            ParallelReadArrayExpressions>;
+
+    ParallelReadOwner owner;
+    size_t bitSize = 0;
+    const std::vector<uint8_t> expectedData = writeParallelReadElements(owner, bitSize);
+    std::vector<uint32_t> rawArray;
+    for (size_t index = 0; index < PARALLEL_READ_NUM_ELEMENTS; ++index)
+    {
+        rawArray.push_back(static_cast<uint32_t>(index * index * 37));
+    }
+    ArrayT array(rawArray);
+
+    ThreadPoolExecutor executor(4);
+    ParallelWriteScope parallelWriteScope(executor);
+
+    ASSERT_EQ(bitSize, array.bitSizeOf(owner, 0).getValue());
+    ASSERT_EQ(bitSize, array.initializeOffsets(owner, 0).getValue());
+
+    std::vector<uint8_t> data(expectedData.size());
+    BitStreamWriter writer(data.data(), data.size());
+    ASSERT_TRUE(array.write(owner, writer).isSuccess());
+    ASSERT_EQ(bitSize, writer.getBitPosition());
+    writer.flush();
+    ASSERT_EQ(expectedData, data);
+}
+
 } // namespace zserio
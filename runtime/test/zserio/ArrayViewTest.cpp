@@ -0,0 +1,378 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/ArrayView.h"
+#include "zserio/BitStreamWriter.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+using UInt16ViewTraits = ValueViewTraits<StdIntArrayTraits<uint16_t>>;
+using VarUInt32ViewTraits = ValueViewTraits<VarIntNNArrayTraits<uint32_t>>;
+
+using UInt5ViewTraits = ValueViewTraits<BitFieldArrayTraits<uint8_t, 5>>;
+using UInt32ViewTraits = ValueViewTraits<StdIntArrayTraits<uint32_t>>;
+
+const std::vector<std::string> STRINGS = {"first", "", "third string", "4"};
+
+uint16_t createUInt16(size_t index)
+{
+    return static_cast<uint16_t>(index * 1001 + 7);
+}
+
+uint32_t createVarUInt32(size_t index)
+{
+    return static_cast<uint32_t>(index * index * index * 97);
+}
+
+// number of elements skipped by CountingViewTraits
+size_t numSkippedElements = 0;
+
+// byte elements which count their skips, their bit size is declared constant or variable
+template <bool IS_CONSTANT>
+struct CountingViewTraits
+{
+    using ValueType = uint8_t;
+
+    static constexpr bool IS_BITSIZEOF_CONSTANT = IS_CONSTANT;
+
+    static Result<size_t> bitSizeOf() noexcept
+    {
+        return Result<size_t>::success(8);
+    }
+
+    static Result<ValueType> read(Span<const uint8_t>, BitStreamReader& in) noexcept
+    {
+        auto result = in.readBits(8);
+        if (result.isError())
+        {
+            return Result<ValueType>::error(result.getError());
+        }
+        return Result<ValueType>::success(static_cast<ValueType>(result.getValue()));
+    }
+
+    static Result<void> skip(BitStreamReader& in) noexcept
+    {
+        ++numSkippedElements;
+        return in.skipBits(8);
+    }
+};
+
+// writes leading bits followed by the elements and trailing ones
+template <typename WRITE>
+std::vector<uint8_t> writeBuffer(uint8_t numLeadingBits, WRITE write)
+{
+    std::vector<uint8_t> buffer(256);
+    BitStreamWriter writer(buffer.data(), buffer.size());
+    if (numLeadingBits > 0)
+    {
+        EXPECT_TRUE(writer.writeBits(0, numLeadingBits).isSuccess());
+    }
+    write(writer);
+    EXPECT_TRUE(writer.writeBits(0xFF, 8).isSuccess());
+    writer.flush();
+    buffer.resize((writer.getBitPosition() + 7) / 8);
+    return buffer;
+}
+
+} // namespace
+
+TEST(ArrayViewTest, emptyConstructor)
+{
+    const ArrayView<UInt16ViewTraits> view;
+    ASSERT_EQ(0, view.size());
+    ASSERT_TRUE(view.empty());
+    ASSERT_EQ(0, view.getBitPosition());
+    ASSERT_TRUE(view.begin() == view.end());
+    ASSERT_EQ(ErrorCode::InvalidIndex, view.at(0).getError());
+}
+
+TEST(ArrayViewTest, valueElements)
+{
+    const size_t length = 10;
+    const std::vector<uint8_t> buffer = writeBuffer(3, [](BitStreamWriter& writer) {
+        for (size_t i = 0; i < length; ++i)
+        {
+            EXPECT_TRUE(writer.writeBits(createUInt16(i), 16).isSuccess());
+        }
+    });
+
+    const ArrayView<UInt16ViewTraits> view(Span<const uint8_t>(buffer), 3, length);
+    ASSERT_EQ(length, view.size());
+    ASSERT_FALSE(view.empty());
+    ASSERT_EQ(3, view.getBitPosition());
+    ASSERT_EQ(buffer.data(), view.getBuffer().data());
+    for (size_t i = length; i > 0; --i)
+    {
+        ASSERT_EQ(createUInt16(i - 1), view.at(i - 1).getValue());
+        ASSERT_EQ(createUInt16(i - 1), view[i - 1].getValue());
+    }
+    ASSERT_EQ(ErrorCode::InvalidIndex, view.at(length).getError());
+
+    size_t index = 0;
+    for (auto it = view.begin(); it != view.end(); ++it)
+    {
+        ASSERT_EQ(index, it.getIndex());
+        ASSERT_EQ(createUInt16(index), (*it).getValue());
+        ++index;
+    }
+    ASSERT_EQ(length, index);
+}
+
+TEST(ArrayViewTest, varSizeElements)
+{
+    const size_t length = 20;
+    const std::vector<uint8_t> buffer = writeBuffer(5, [](BitStreamWriter& writer) {
+        for (size_t i = 0; i < length; ++i)
+        {
+            EXPECT_TRUE(writer.writeVarUInt32(createVarUInt32(i)).isSuccess());
+        }
+    });
+
+    // elements are reached by skipping the preceding ones
+    const ArrayView<VarUInt32ViewTraits> view(Span<const uint8_t>(buffer), 5, length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        ASSERT_EQ(createVarUInt32(i), view.at(i).getValue()) << i;
+    }
+
+    size_t index = 0;
+    for (const auto& result : view)
+    {
+        ASSERT_EQ(createVarUInt32(index), result.getValue()) << index;
+        ++index;
+    }
+    ASSERT_EQ(length, index);
+}
+
+TEST(ArrayViewTest, stringElements)
+{
+    const std::vector<uint8_t> buffer = writeBuffer(0, [](BitStreamWriter& writer) {
+        for (const std::string& value : STRINGS)
+        {
+            EXPECT_TRUE(writer.writeString(StringView(value)).isSuccess());
+        }
+    });
+
+    // views point into the buffer
+    const ArrayView<StringViewTraits> view(Span<const uint8_t>(buffer), 0, STRINGS.size());
+    for (size_t i = STRINGS.size(); i > 0; --i)
+    {
+        const auto result = view.at(i - 1);
+        ASSERT_TRUE(result.isSuccess());
+        ASSERT_EQ(StringView(STRINGS[i - 1]), result.getValue());
+    }
+    ASSERT_EQ(reinterpret_cast<const char*>(buffer.data() + 1), view.at(0).getValue().data());
+
+    // strings of a normal array at an unaligned position cannot be viewed
+    const std::vector<uint8_t> unalignedBuffer = writeBuffer(3, [](BitStreamWriter& writer) {
+        EXPECT_TRUE(writer.writeString(StringView(STRINGS[0])).isSuccess());
+    });
+    const ArrayView<StringViewTraits> unalignedView(Span<const uint8_t>(unalignedBuffer), 3, 1);
+    ASSERT_EQ(ErrorCode::InvalidAlignment, unalignedView.at(0).getError());
+}
+
+TEST(ArrayViewTest, alignedBytesElements)
+{
+    const std::vector<std::vector<uint8_t>> values = {{0x01, 0x02}, {}, {0x03}};
+    const std::vector<uint8_t> buffer = writeBuffer(3, [&values](BitStreamWriter& writer) {
+        for (const std::vector<uint8_t>& value : values)
+        {
+            EXPECT_TRUE(writer.alignTo(8).isSuccess());
+            EXPECT_TRUE(writer.writeBytes(Span<const uint8_t>(value)).isSuccess());
+        }
+    });
+
+    // elements of aligned arrays are aligned before they are read
+    const ArrayView<BytesViewTraits, ArrayType::ALIGNED> view(Span<const uint8_t>(buffer), 3, values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        const auto result = view.at(i);
+        ASSERT_TRUE(result.isSuccess());
+        ASSERT_EQ(values[i], std::vector<uint8_t>(result.getValue().begin(), result.getValue().end()));
+    }
+    ASSERT_EQ(buffer.data() + 2, view.at(0).getValue().data());
+}
+
+TEST(ArrayViewTest, create)
+{
+    const size_t length = 4;
+    const std::vector<uint8_t> buffer = writeBuffer(0, [](BitStreamWriter& writer) {
+        EXPECT_TRUE(writer.writeVarSize(static_cast<uint32_t>(length)).isSuccess());
+        for (size_t i = 0; i < length; ++i)
+        {
+            EXPECT_TRUE(writer.writeBits(createUInt16(i), 16).isSuccess());
+        }
+    });
+
+    // only the length of auto arrays is read
+    BitStreamReader autoReader(buffer.data(), buffer.size());
+    const auto autoResult = ArrayView<UInt16ViewTraits, ArrayType::AUTO>::create(Span<const uint8_t>(buffer),
+            autoReader);
+    ASSERT_TRUE(autoResult.isSuccess());
+    ASSERT_EQ(length, autoResult.getValue().size());
+    ASSERT_EQ(8, autoResult.getValue().getBitPosition());
+    ASSERT_EQ(8, autoReader.getBitPosition());
+    ASSERT_EQ(createUInt16(3), autoResult.getValue().at(3).getValue());
+
+    BitStreamReader normalReader(buffer.data(), buffer.size());
+    ASSERT_TRUE(normalReader.skipBits(8).isSuccess());
+    const auto normalResult = ArrayView<UInt16ViewTraits>::create(Span<const uint8_t>(buffer), normalReader, 2);
+    ASSERT_TRUE(normalResult.isSuccess());
+    ASSERT_EQ(2, normalResult.getValue().size());
+    ASSERT_EQ(createUInt16(1), normalResult.getValue().at(1).getValue());
+
+    // implicit arrays take all whole elements up to the end of the buffer
+    BitStreamReader implicitReader(buffer.data(), buffer.size());
+    ASSERT_TRUE(implicitReader.skipBits(8).isSuccess());
+    const auto implicitResult = ArrayView<UInt16ViewTraits, ArrayType::IMPLICIT>::create(
+            Span<const uint8_t>(buffer), implicitReader);
+    ASSERT_TRUE(implicitResult.isSuccess());
+    ASSERT_EQ(length, implicitResult.getValue().size());
+
+    BitStreamReader emptyReader(buffer.data(), 0);
+    ASSERT_EQ(ErrorCode::EndOfStream,
+            (ArrayView<UInt16ViewTraits, ArrayType::AUTO>::create(Span<const uint8_t>(buffer), emptyReader)
+                            .getError()));
+}
+
+TEST(ArrayViewTest, truncatedBuffer)
+{
+    const std::vector<uint8_t> buffer = writeBuffer(0, [](BitStreamWriter& writer) {
+        EXPECT_TRUE(writer.writeVarUInt32(1).isSuccess());
+        EXPECT_TRUE(writer.writeVarUInt32(0x7FFFFFF).isSuccess());
+    });
+
+    // the length is longer than the buffer, elements behind it report errors
+    const Span<const uint8_t> span(buffer.data(), 3);
+    const ArrayView<VarUInt32ViewTraits> view(span, 0, 5);
+    ASSERT_EQ(1, view.at(0).getValue());
+    ASSERT_EQ(ErrorCode::EndOfStream, view.at(1).getError());
+    ASSERT_EQ(ErrorCode::EndOfStream, view.at(4).getError());
+
+    const ArrayView<UInt16ViewTraits> constantView(span, 0, 5);
+    ASSERT_TRUE(constantView.at(0).isSuccess());
+    ASSERT_EQ(ErrorCode::EndOfStream, constantView.at(4).getError());
+
+    // the iterator keeps the error of an element which cannot be skipped
+    auto it = view.begin();
+    ASSERT_EQ(1, (*it).getValue());
+    ++it;
+    ++it;
+    ASSERT_EQ(ErrorCode::EndOfStream, (*it).getError());
+    ++it;
+    ASSERT_EQ(ErrorCode::EndOfStream, (*it).getError());
+    ++it;
+    ++it;
+    ASSERT_TRUE(it == view.end());
+}
+
+TEST(ArrayViewTest, constantBitSizeAccess)
+{
+    const std::vector<uint8_t> buffer = writeBuffer(0, [](BitStreamWriter& writer) {
+        for (size_t i = 0; i < 100; ++i)
+        {
+            EXPECT_TRUE(writer.writeBits(static_cast<uint32_t>(i), 8).isSuccess());
+        }
+    });
+
+    // elements with constant bit size are reached without skipping the preceding ones
+    numSkippedElements = 0;
+    const ArrayView<CountingViewTraits<true>> view(Span<const uint8_t>(buffer), 0, 100);
+    ASSERT_EQ(99, view.at(99).getValue());
+    ASSERT_EQ(50, view.at(50).getValue());
+    ASSERT_EQ(0, numSkippedElements);
+
+    const ArrayView<CountingViewTraits<false>> variableView(Span<const uint8_t>(buffer), 0, 100);
+    ASSERT_EQ(50, variableView.at(50).getValue());
+    ASSERT_EQ(50, numSkippedElements);
+}
+
+TEST(ArrayViewTest, alignedConstantBitSizeAccess)
+{
+    const size_t length = 12;
+    const std::vector<uint8_t> buffer = writeBuffer(3, [](BitStreamWriter& writer) {
+        for (size_t i = 0; i < length; ++i)
+        {
+            EXPECT_TRUE(writer.alignTo(8).isSuccess());
+            EXPECT_TRUE(writer.writeBits(static_cast<uint32_t>(i * 3 % 32), 5).isSuccess());
+        }
+    });
+
+    // stride of aligned elements is rounded up to whole bytes
+    const ArrayView<UInt5ViewTraits, ArrayType::ALIGNED> view(Span<const uint8_t>(buffer), 3, length);
+    for (size_t i = length; i > 0; --i)
+    {
+        ASSERT_EQ((i - 1) * 3 % 32, view.at(i - 1).getValue()) << i - 1;
+    }
+    ASSERT_EQ(ErrorCode::InvalidIndex, view.at(length).getError());
+
+    size_t index = 0;
+    for (const auto& result : view)
+    {
+        ASSERT_EQ(index * 3 % 32, result.getValue()) << index;
+        ++index;
+    }
+    ASSERT_EQ(length, index);
+
+    // stride does not fit into the rest of the buffer
+    const ArrayView<UInt5ViewTraits, ArrayType::ALIGNED> longView(Span<const uint8_t>(buffer), 3, length + 2);
+    ASSERT_EQ(ErrorCode::EndOfStream, longView.at(length + 1).getError());
+}
+
+TEST(ArrayViewTest, indexedOffsetsAccess)
+{
+    // offsets array followed by elements separated by gaps which skipping would not see
+    const size_t length = 6;
+    const size_t firstByteOffset = 1 + length * 4;
+    const std::vector<uint8_t> buffer = writeBuffer(0, [](BitStreamWriter& writer) {
+        EXPECT_TRUE(writer.writeVarSize(static_cast<uint32_t>(length)).isSuccess());
+        for (size_t i = 0; i < length; ++i)
+        {
+            EXPECT_TRUE(writer.writeBits(static_cast<uint32_t>(firstByteOffset + i * 3), 32).isSuccess());
+        }
+        for (size_t i = 0; i < length; ++i)
+        {
+            EXPECT_TRUE(writer.writeBits(static_cast<uint32_t>(0xA0 + i), 8).isSuccess());
+            EXPECT_TRUE(writer.writeBits(0, 16).isSuccess());
+        }
+    });
+
+    BitStreamReader reader(buffer.data(), buffer.size());
+    const auto offsetsResult =
+            ArrayView<UInt32ViewTraits, ArrayType::AUTO>::create(Span<const uint8_t>(buffer), reader);
+    ASSERT_TRUE(offsetsResult.isSuccess());
+    const ArrayViewOffsets offsets(offsetsResult.getValue());
+    ASSERT_FALSE(offsets.isEmpty());
+    ASSERT_EQ(firstByteOffset + 3, offsets.getByteOffset(1).getValue());
+    ASSERT_EQ(ErrorCode::InvalidIndex, offsets.getByteOffset(length).getError());
+    ASSERT_TRUE(ArrayViewOffsets().isEmpty());
+    ASSERT_EQ(ErrorCode::InvalidIndex, ArrayViewOffsets().getByteOffset(0).getError());
+
+    // elements are read directly at their offsets
+    numSkippedElements = 0;
+    const ArrayView<CountingViewTraits<false>, ArrayType::ALIGNED> view(
+            Span<const uint8_t>(buffer), firstByteOffset * 8, length, offsets);
+    for (size_t i = length; i > 0; --i)
+    {
+        ASSERT_EQ(0xA0 + i - 1, view.at(i - 1).getValue()) << i - 1;
+    }
+    ASSERT_EQ(0, numSkippedElements);
+
+    // offset array shorter than the elements
+    const ArrayView<CountingViewTraits<false>, ArrayType::ALIGNED> longView(
+            Span<const uint8_t>(buffer), firstByteOffset * 8, length + 1, offsets);
+    ASSERT_EQ(ErrorCode::InvalidIndex, longView.at(length).getError());
+
+    // offsets behind the end of the buffer
+    const ArrayView<CountingViewTraits<false>, ArrayType::ALIGNED> shortView(
+            Span<const uint8_t>(buffer.data(), firstByteOffset + 3), firstByteOffset * 8, length, offsets);
+    ASSERT_EQ(0xA0, shortView.at(0).getValue());
+    ASSERT_EQ(ErrorCode::EndOfStream, shortView.at(2).getError());
+}
+
+} // namespace zserio
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/AsyncFileByteSink.h"
+#include "zserio/FileUtil.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace zserio
+{
+
+namespace
+{
+
+std::vector<uint8_t> createData(size_t byteSize, uint8_t seed)
+{
+    std::vector<uint8_t> data(byteSize);
+    for (size_t i = 0; i < byteSize; ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 13 + seed);
+    }
+    return data;
+}
+
+void checkFile(const std::string& fileName, const std::vector<uint8_t>& expectedData)
+{
+    const auto readResult = readBufferFromFile(fileName);
+    ASSERT_TRUE(readResult.isSuccess());
+    const BitBuffer& bitBuffer = readResult.getValue();
+    ASSERT_EQ(expectedData.size(), bitBuffer.getByteSize());
+    ASSERT_TRUE(std::equal(expectedData.begin(), expectedData.end(), bitBuffer.getBuffer()));
+}
+
+} // namespace
+
+TEST(AsyncFileByteSinkTest, write)
+{
+    const std::string fileName = "AsyncFileByteSinkTest_write.bin";
+    auto sinkResult = AsyncFileByteSink::open(fileName, 3, 64);
+    ASSERT_TRUE(sinkResult.isSuccess());
+    AsyncFileByteSink& sink = sinkResult.getValue();
+
+    // small writes fill the buffers, larger ones span more buffers
+    std::vector<uint8_t> expectedData;
+    for (size_t byteSize : {size_t(1), size_t(10), size_t(63), size_t(64), size_t(100), size_t(0), size_t(200)})
+    {
+        const std::vector<uint8_t> data = createData(byteSize, static_cast<uint8_t>(expectedData.size()));
+        ASSERT_TRUE(sink.write(Span<const uint8_t>(data)).isSuccess());
+        expectedData.insert(expectedData.end(), data.begin(), data.end());
+    }
+
+    ASSERT_TRUE(sink.flush().isSuccess());
+    checkFile(fileName, expectedData);
+
+    const std::vector<uint8_t> data = createData(30, 7);
+    ASSERT_TRUE(sink.write(Span<const uint8_t>(data)).isSuccess());
+    expectedData.insert(expectedData.end(), data.begin(), data.end());
+    ASSERT_TRUE(sink.close().isSuccess());
+    checkFile(fileName, expectedData);
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(AsyncFileByteSinkTest, writeLargerThanBuffers)
+{
+    const std::string fileName = "AsyncFileByteSinkTest_large.bin";
+    auto sinkResult = AsyncFileByteSink::open(fileName, 2, 16);
+    ASSERT_TRUE(sinkResult.isSuccess());
+    AsyncFileByteSink& sink = sinkResult.getValue();
+
+    // data larger than all buffers are written buffer by buffer
+    const std::vector<uint8_t> data = createData(1000, 3);
+    ASSERT_TRUE(sink.write(Span<const uint8_t>(data)).isSuccess());
+    ASSERT_TRUE(sink.close().isSuccess());
+    checkFile(fileName, data);
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(AsyncFileByteSinkTest, close)
+{
+    const std::string fileName = "AsyncFileByteSinkTest_close.bin";
+    auto sinkResult = AsyncFileByteSink::open(fileName);
+    ASSERT_TRUE(sinkResult.isSuccess());
+    AsyncFileByteSink& sink = sinkResult.getValue();
+    ASSERT_TRUE(sink.close().isSuccess());
+
+    const std::vector<uint8_t> data = createData(10, 0);
+    ASSERT_EQ(ErrorCode::StreamClosed, sink.write(Span<const uint8_t>(data)).getError());
+    ASSERT_EQ(ErrorCode::StreamClosed, sink.flush().getError());
+    ASSERT_EQ(ErrorCode::StreamClosed, sink.close().getError());
+    checkFile(fileName, std::vector<uint8_t>());
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(AsyncFileByteSinkTest, closeInDestructor)
+{
+    const std::string fileName = "AsyncFileByteSinkTest_destructor.bin";
+    const std::vector<uint8_t> data = createData(100, 5);
+    {
+        auto sinkResult = AsyncFileByteSink::open(fileName, 2, 64);
+        ASSERT_TRUE(sinkResult.isSuccess());
+        AsyncFileByteSink sink(std::move(sinkResult.getValue()));
+        ASSERT_TRUE(sink.write(Span<const uint8_t>(data)).isSuccess());
+    }
+    checkFile(fileName, data);
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(AsyncFileByteSinkTest, openFailed)
+{
+    ASSERT_EQ(ErrorCode::FileOpenFailed, AsyncFileByteSink::open("").getError());
+    ASSERT_EQ(ErrorCode::FileOpenFailed,
+            AsyncFileByteSink::open("AsyncFileByteSinkTest_missing_directory/file.bin").getError());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(AsyncFileByteSinkTest, waitTimeout)
+{
+    // nobody reads the pipe, thus the background write blocks once the pipe is full
+    const std::string fifoName = "AsyncFileByteSinkTest_fifo";
+    (void)std::remove(fifoName.c_str());
+    ASSERT_EQ(0, ::mkfifo(fifoName.c_str(), 0600));
+    const int readFd = ::open(fifoName.c_str(), O_RDONLY | O_NONBLOCK);
+    ASSERT_NE(-1, readFd);
+    ASSERT_EQ(0, ::fcntl(readFd, F_SETFL, ::fcntl(readFd, F_GETFL) & ~O_NONBLOCK));
+
+    const size_t bufferByteSize = 1024 * 1024;
+    auto sinkResult = AsyncFileByteSink::open(fifoName, 2, bufferByteSize, std::chrono::milliseconds(50));
+    ASSERT_TRUE(sinkResult.isSuccess());
+    AsyncFileByteSink& sink = sinkResult.getValue();
+
+    const std::vector<uint8_t> data = createData(bufferByteSize, 1);
+    ASSERT_TRUE(sink.write(Span<const uint8_t>(data)).isSuccess());
+    ASSERT_TRUE(sink.write(Span<const uint8_t>(data)).isSuccess());
+
+    // both buffers are busy, the message is rejected whole and writing can continue
+    const auto startTime = std::chrono::steady_clock::now();
+    ASSERT_EQ(ErrorCode::InsufficientCapacity, sink.write(Span<const uint8_t>(data.data(), 10)).getError());
+    ASSERT_GE(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(50));
+    ASSERT_EQ(ErrorCode::InsufficientCapacity, sink.write(Span<const uint8_t>(data.data(), 10)).getError());
+
+    // drain the pipe, pipes cannot be synchronized to the disk, thus the background writes fail afterwards
+    size_t numReadBytes = 0;
+    std::thread reader([readFd, &numReadBytes] {
+        std::vector<uint8_t> buffer(64 * 1024);
+        ssize_t readSize = 0;
+        while ((readSize = ::read(readFd, buffer.data(), buffer.size())) > 0)
+        {
+            numReadBytes += static_cast<size_t>(readSize);
+        }
+    });
+    ASSERT_TRUE(sink.close().isError());
+    reader.join();
+    ASSERT_EQ(bufferByteSize, numReadBytes);
+
+    ASSERT_EQ(0, ::close(readFd));
+    ASSERT_EQ(0, std::remove(fifoName.c_str()));
+}
+#endif
+
+} // namespace zserio
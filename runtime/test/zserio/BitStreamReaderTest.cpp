@@ -1,13 +1,220 @@
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <limits>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "zserio/BitPackingUtil.h"
 #include "zserio/BitStreamReader.h"
+#include "zserio/BitStreamWriter.h"
 #include "zserio/CppRuntimeException.h"
 
 namespace zserio
 {
 
+namespace
+{
+
+const std::array<detail::SimdLevel, 3> SIMD_LEVELS = {
+        detail::SimdLevel::SCALAR, detail::SimdLevel::SSE41, detail::SimdLevel::AVX2};
+
+// short runs go value by value, long runs are unpacked in bulk
+const std::array<size_t, 2> ARRAY_SIZES = {5, 100};
+
+const uint8_t MARKER = 0x5A;
+
+// restores the instruction set of the bit packing kernels
+class SimdLevelGuard
+{
+public:
+    explicit SimdLevelGuard(detail::SimdLevel level) :
+            m_previousLevel(detail::setSimdLevel(level))
+    {}
+
+    ~SimdLevelGuard()
+    {
+        detail::setSimdLevel(m_previousLevel);
+    }
+
+    SimdLevelGuard(const SimdLevelGuard&) = delete;
+    SimdLevelGuard& operator=(const SimdLevelGuard&) = delete;
+
+private:
+    detail::SimdLevel m_previousLevel;
+};
+
+uint64_t createValue(size_t index, uint8_t numBits)
+{
+    const uint64_t value = UINT64_C(0x9E3779B97F4A7C15) * (index + 1);
+    return (numBits == 64) ? value : value & ((UINT64_C(1) << numBits) - 1);
+}
+
+int64_t createSignedValue(size_t index, uint8_t numBits)
+{
+    const uint64_t value = createValue(index, numBits);
+    if (numBits == 64 || value < (UINT64_C(1) << (numBits - 1)))
+    {
+        return static_cast<int64_t>(value);
+    }
+    return static_cast<int64_t>(value - (UINT64_C(1) << (numBits - 1))) - (INT64_C(1) << (numBits - 1));
+}
+
+// writes the values value by value after the given number of leading bits followed by a marker
+std::vector<uint8_t> writeValues(size_t numValues, uint8_t numBits, uint8_t numLeadingBits, bool isSigned)
+{
+    std::vector<uint8_t> buffer((numLeadingBits + numValues * numBits + 8 + 7) / 8);
+    BitStreamWriter writer(buffer.data(), buffer.size());
+    if (numLeadingBits > 0)
+    {
+        EXPECT_TRUE(writer.writeBits(0, numLeadingBits).isSuccess());
+    }
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        const auto result = isSigned ? writer.writeSignedBits64(createSignedValue(i, numBits), numBits)
+                                     : writer.writeBits64(createValue(i, numBits), numBits);
+        EXPECT_TRUE(result.isSuccess());
+    }
+    EXPECT_TRUE(writer.writeBits(MARKER, 8).isSuccess());
+    writer.flush();
+    return buffer;
+}
+
+template <typename T, typename READ_FUNC>
+void checkReadBitsArray(uint8_t numBits, READ_FUNC readFunc)
+{
+    const bool isSigned = std::is_signed<T>::value;
+    for (detail::SimdLevel level : SIMD_LEVELS)
+    {
+        const SimdLevelGuard guard(level);
+        for (size_t numValues : ARRAY_SIZES)
+        {
+            for (uint8_t numLeadingBits = 0; numLeadingBits < 8; ++numLeadingBits)
+            {
+                const std::vector<uint8_t> buffer = writeValues(numValues, numBits, numLeadingBits, isSigned);
+                BitStreamReader reader(buffer.data(), buffer.size());
+                ASSERT_TRUE(reader.skipBits(numLeadingBits).isSuccess());
+
+                std::vector<T> values(numValues);
+                ASSERT_TRUE(readFunc(reader, Span<T>(values), numBits).isSuccess());
+                for (size_t i = 0; i < numValues; ++i)
+                {
+                    const T expected = static_cast<T>(
+                            isSigned ? createSignedValue(i, numBits) : static_cast<int64_t>(createValue(i, numBits)));
+                    ASSERT_EQ(expected, values[i]) << "level: " << static_cast<int>(level)
+                                                   << ", numBits: " << static_cast<int>(numBits)
+                                                   << ", numLeadingBits: " << static_cast<int>(numLeadingBits)
+                                                   << ", index: " << i;
+                }
+
+                // the reader continues right behind the run
+                ASSERT_EQ(numLeadingBits + numValues * numBits, reader.getBitPosition());
+                const auto markerResult = reader.readBits(8);
+                ASSERT_TRUE(markerResult.isSuccess());
+                ASSERT_EQ(MARKER, markerResult.getValue());
+            }
+        }
+    }
+}
+
+// values of all lengths, the run is long enough to go through both the fast path and the checked tail
+template <typename T>
+std::vector<T> createVarNumValues(const std::vector<T>& specialValues)
+{
+    std::vector<T> values;
+    for (size_t i = 0; i < 40; ++i)
+    {
+        values.push_back(specialValues[i % specialValues.size()]);
+    }
+    return values;
+}
+
+template <typename T, typename WRITE_FUNC, typename READ_FUNC>
+void checkReadVarNumArray(const std::vector<T>& values, WRITE_FUNC writeFunc, READ_FUNC readFunc)
+{
+    for (uint8_t numLeadingBits = 0; numLeadingBits < 8; ++numLeadingBits)
+    {
+        std::vector<uint8_t> buffer(numLeadingBits / 8 + values.size() * 9 + 1);
+        BitStreamWriter writer(buffer.data(), buffer.size());
+        if (numLeadingBits > 0)
+        {
+            ASSERT_TRUE(writer.writeBits(0, numLeadingBits).isSuccess());
+        }
+        for (T value : values)
+        {
+            ASSERT_TRUE(writeFunc(writer, value).isSuccess());
+        }
+        writer.flush();
+
+        // the stream ends right behind the last value, thus the last values are read by the checked tail
+        const size_t bitSize = writer.getBitPosition();
+        BitStreamReader reader(buffer.data(), bitSize, BitsTag());
+        ASSERT_TRUE(reader.skipBits(numLeadingBits).isSuccess());
+        std::vector<T> readValues(values.size());
+        ASSERT_TRUE(readFunc(reader, Span<T>(readValues)).isSuccess());
+        ASSERT_EQ(values, readValues) << "numLeadingBits: " << static_cast<int>(numLeadingBits);
+        ASSERT_EQ(bitSize, reader.getBitPosition());
+
+        // one bit less than needed
+        BitStreamReader shortReader(buffer.data(), bitSize - 1, BitsTag());
+        ASSERT_TRUE(shortReader.skipBits(numLeadingBits).isSuccess());
+        std::vector<T> shortValues(values.size());
+        ASSERT_EQ(ErrorCode::EndOfStream, readFunc(shortReader, Span<T>(shortValues)).getError());
+        // values read before the error are kept
+        ASSERT_TRUE(std::equal(values.begin(), values.end() - 1, shortValues.begin()));
+    }
+}
+
+// allocator which records the largest allocation
+template <typename T>
+class MaxSizeAllocator
+{
+public:
+    using value_type = T;
+
+    explicit MaxSizeAllocator(size_t& maxByteSize) noexcept :
+            m_maxByteSize(&maxByteSize)
+    {}
+
+    template <typename U>
+    MaxSizeAllocator(const MaxSizeAllocator<U>& other) noexcept :
+            m_maxByteSize(other.getMaxByteSize())
+    {}
+
+    T* allocate(size_t numElements)
+    {
+        *m_maxByteSize = std::max(*m_maxByteSize, numElements * sizeof(T));
+        return std::allocator<T>().allocate(numElements);
+    }
+
+    void deallocate(T* pointer, size_t numElements) noexcept
+    {
+        std::allocator<T>().deallocate(pointer, numElements);
+    }
+
+    size_t* getMaxByteSize() const noexcept
+    {
+        return m_maxByteSize;
+    }
+
+private:
+    size_t* m_maxByteSize;
+};
+
+template <typename T, typename U>
+bool operator==(const MaxSizeAllocator<T>& lhs, const MaxSizeAllocator<U>& rhs)
+{
+    return lhs.getMaxByteSize() == rhs.getMaxByteSize();
+}
+
+template <typename T, typename U>
+bool operator!=(const MaxSizeAllocator<T>& lhs, const MaxSizeAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace
+
 class BitStreamReaderTest : public ::testing::Test
 {
 public:
@@ -161,6 +368,325 @@ TEST_F(BitStreamReaderTest, readVarSize)
     }
 }
 
+TEST_F(BitStreamReaderTest, readBitsArray)
+{
+    for (uint8_t numBits = 1; numBits <= 8; ++numBits)
+    {
+        checkReadBitsArray<uint8_t>(numBits, [](BitStreamReader& reader, Span<uint8_t> values, uint8_t bits) {
+            return reader.readBitsArray(values, bits);
+        });
+    }
+    for (uint8_t numBits = 1; numBits <= 16; ++numBits)
+    {
+        checkReadBitsArray<uint16_t>(numBits, [](BitStreamReader& reader, Span<uint16_t> values, uint8_t bits) {
+            return reader.readBitsArray(values, bits);
+        });
+    }
+    for (uint8_t numBits = 1; numBits <= 32; ++numBits)
+    {
+        checkReadBitsArray<uint32_t>(numBits, [](BitStreamReader& reader, Span<uint32_t> values, uint8_t bits) {
+            return reader.readBitsArray(values, bits);
+        });
+    }
+}
+
+TEST_F(BitStreamReaderTest, readBits64Array)
+{
+    for (uint8_t numBits = 1; numBits <= 64; ++numBits)
+    {
+        checkReadBitsArray<uint64_t>(numBits, [](BitStreamReader& reader, Span<uint64_t> values, uint8_t bits) {
+            return reader.readBits64Array(values, bits);
+        });
+    }
+}
+
+TEST_F(BitStreamReaderTest, readSignedBitsArray)
+{
+    for (uint8_t numBits = 1; numBits <= 8; ++numBits)
+    {
+        checkReadBitsArray<int8_t>(numBits, [](BitStreamReader& reader, Span<int8_t> values, uint8_t bits) {
+            return reader.readSignedBitsArray(values, bits);
+        });
+    }
+    for (uint8_t numBits = 1; numBits <= 16; ++numBits)
+    {
+        checkReadBitsArray<int16_t>(numBits, [](BitStreamReader& reader, Span<int16_t> values, uint8_t bits) {
+            return reader.readSignedBitsArray(values, bits);
+        });
+    }
+    for (uint8_t numBits = 1; numBits <= 32; ++numBits)
+    {
+        checkReadBitsArray<int32_t>(numBits, [](BitStreamReader& reader, Span<int32_t> values, uint8_t bits) {
+            return reader.readSignedBitsArray(values, bits);
+        });
+    }
+}
+
+TEST_F(BitStreamReaderTest, readSignedBits64Array)
+{
+    for (uint8_t numBits = 1; numBits <= 64; ++numBits)
+    {
+        checkReadBitsArray<int64_t>(numBits, [](BitStreamReader& reader, Span<int64_t> values, uint8_t bits) {
+            return reader.readSignedBits64Array(values, bits);
+        });
+    }
+}
+
+TEST_F(BitStreamReaderTest, readBitsArrayErrors)
+{
+    for (detail::SimdLevel level : SIMD_LEVELS)
+    {
+        const SimdLevelGuard guard(level);
+        for (size_t numValues : ARRAY_SIZES)
+        {
+            // the run needs one bit more than the stream holds
+            const size_t bitSize = numValues * 7 + 2;
+            std::vector<uint8_t> buffer((bitSize + 7) / 8, 0xFF);
+            BitStreamReader reader(buffer.data(), bitSize, BitsTag());
+            ASSERT_TRUE(reader.readBits(3).isSuccess());
+
+            std::vector<uint8_t> values(numValues, 0);
+            ASSERT_EQ(ErrorCode::EndOfStream, reader.readBitsArray(Span<uint8_t>(values), 7).getError());
+            std::vector<int64_t> signedValues(numValues, 0);
+            ASSERT_EQ(ErrorCode::EndOfStream,
+                    reader.readSignedBits64Array(Span<int64_t>(signedValues), 7).getError());
+
+            // nothing is read on error
+            ASSERT_EQ(3, reader.getBitPosition());
+            ASSERT_EQ(std::vector<uint8_t>(numValues, 0), values);
+            ASSERT_EQ(std::vector<int64_t>(numValues, 0), signedValues);
+
+            ASSERT_EQ(ErrorCode::InvalidNumBits, reader.readBitsArray(Span<uint8_t>(values), 9).getError());
+            std::vector<int16_t> shortValues(numValues);
+            ASSERT_EQ(ErrorCode::InvalidNumBits,
+                    reader.readSignedBitsArray(Span<int16_t>(shortValues), 17).getError());
+            std::vector<uint64_t> longValues(numValues);
+            ASSERT_EQ(ErrorCode::InvalidNumBits, reader.readBits64Array(Span<uint64_t>(longValues), 65).getError());
+            ASSERT_EQ(3, reader.getBitPosition());
+
+            // the rest of the stream is still readable
+            ASSERT_TRUE(reader.readBitsArray(Span<uint8_t>(values.data(), numValues - 1), 7).isSuccess());
+            ASSERT_EQ(std::vector<uint8_t>(numValues - 1, 0x7F),
+                    std::vector<uint8_t>(values.begin(), values.end() - 1));
+        }
+    }
+}
+
+TEST_F(BitStreamReaderTest, readVarIntArrays)
+{
+    checkReadVarNumArray(createVarNumValues<int16_t>({0, -1, 63, -64, 64, 300, -16383, 16383}),
+            [](BitStreamWriter& writer, int16_t value) { return writer.writeVarInt16(value); },
+            [](BitStreamReader& reader, Span<int16_t> values) { return reader.readVarInt16Array(values); });
+    checkReadVarNumArray(createVarNumValues<int32_t>({0, -1, 63, -64, 8191, -1048575, 268435455, -268435455}),
+            [](BitStreamWriter& writer, int32_t value) { return writer.writeVarInt32(value); },
+            [](BitStreamReader& reader, Span<int32_t> values) { return reader.readVarInt32Array(values); });
+    checkReadVarNumArray(
+            createVarNumValues<int64_t>({0, -1, 63, -8191, INT64_C(36028797018963967), -INT64_C(36028797018963967),
+                    INT64_C(1) << 40, -(INT64_C(1) << 20)}),
+            [](BitStreamWriter& writer, int64_t value) { return writer.writeVarInt64(value); },
+            [](BitStreamReader& reader, Span<int64_t> values) { return reader.readVarInt64Array(values); });
+    checkReadVarNumArray(
+            createVarNumValues<int64_t>({0, -1, std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max(), 63, -8191, INT64_C(1) << 56, -(INT64_C(1) << 62)}),
+            [](BitStreamWriter& writer, int64_t value) { return writer.writeVarInt(value); },
+            [](BitStreamReader& reader, Span<int64_t> values) { return reader.readVarIntArray(values); });
+}
+
+TEST_F(BitStreamReaderTest, readVarUIntArrays)
+{
+    checkReadVarNumArray(createVarNumValues<uint16_t>({0, 1, 127, 128, 32767, 1000}),
+            [](BitStreamWriter& writer, uint16_t value) { return writer.writeVarUInt16(value); },
+            [](BitStreamReader& reader, Span<uint16_t> values) { return reader.readVarUInt16Array(values); });
+    checkReadVarNumArray(createVarNumValues<uint32_t>({0, 127, 16383, 2097151, 536870911, 300}),
+            [](BitStreamWriter& writer, uint32_t value) { return writer.writeVarUInt32(value); },
+            [](BitStreamReader& reader, Span<uint32_t> values) { return reader.readVarUInt32Array(values); });
+    checkReadVarNumArray(createVarNumValues<uint64_t>({0, 127, UINT64_C(72057594037927935), UINT64_C(1) << 35}),
+            [](BitStreamWriter& writer, uint64_t value) { return writer.writeVarUInt64(value); },
+            [](BitStreamReader& reader, Span<uint64_t> values) { return reader.readVarUInt64Array(values); });
+    checkReadVarNumArray(
+            createVarNumValues<uint64_t>({0, 127, std::numeric_limits<uint64_t>::max(), UINT64_C(1) << 57}),
+            [](BitStreamWriter& writer, uint64_t value) { return writer.writeVarUInt(value); },
+            [](BitStreamReader& reader, Span<uint64_t> values) { return reader.readVarUIntArray(values); });
+    checkReadVarNumArray(createVarNumValues<uint32_t>({0, 127, 2147483647, 16384, 1}),
+            [](BitStreamWriter& writer, uint32_t value) { return writer.writeVarSize(value); },
+            [](BitStreamReader& reader, Span<uint32_t> values) { return reader.readVarSizeArray(values); });
+}
+
+TEST_F(BitStreamReaderTest, readVarSizeArrayOutOfRange)
+{
+    // 2^32 - 1 is too much ({ 0x83, 0xFF, 0xFF, 0xFF, 0xFF } is the maximum)
+    const std::array<uint8_t, 5> invalidVarSize = {0x87, 0xFF, 0xFF, 0xFF, 0xFF};
+    for (uint8_t numLeadingBits : {0, 1})
+    {
+        // the invalid value is decoded by the fast path when more bytes follow, an unaligned value at the end
+        // of the stream is decoded by the checked tail
+        for (size_t numTrailingBytes : {size_t(0), size_t(16)})
+        {
+            const size_t numValid = 3;
+            std::array<uint8_t, 32> buffer = {};
+            BitStreamWriter writer(buffer.data(), buffer.size());
+            if (numLeadingBits > 0)
+            {
+                ASSERT_TRUE(writer.writeBits(0, numLeadingBits).isSuccess());
+            }
+            for (size_t i = 0; i < numValid; ++i)
+            {
+                ASSERT_TRUE(writer.writeVarSize(1).isSuccess());
+            }
+            for (uint8_t byte : invalidVarSize)
+            {
+                ASSERT_TRUE(writer.writeBits(byte, 8).isSuccess());
+            }
+            for (size_t i = 0; i < numTrailingBytes; ++i)
+            {
+                ASSERT_TRUE(writer.writeBits(0, 8).isSuccess());
+            }
+            writer.flush();
+
+            BitStreamReader reader(buffer.data(), writer.getBitPosition(), BitsTag());
+            ASSERT_TRUE(reader.skipBits(numLeadingBits).isSuccess());
+            std::vector<uint32_t> values(numValid + 1 + numTrailingBytes);
+            ASSERT_EQ(ErrorCode::OutOfRange, reader.readVarSizeArray(Span<uint32_t>(values)).getError());
+            ASSERT_EQ(std::vector<uint32_t>(numValid, 1),
+                    std::vector<uint32_t>(values.begin(), values.begin() + static_cast<ptrdiff_t>(numValid)));
+        }
+    }
+}
+
+TEST_F(BitStreamReaderTest, readHugeLength)
+{
+    // lengths which cannot be read are rejected before the payload is allocated
+    for (size_t numLeadingBits : {size_t(0), size_t(3)})
+    {
+        std::array<uint8_t, 32> data = {};
+        BitStreamWriter writer(data.data(), data.size());
+        if (numLeadingBits > 0)
+        {
+            ASSERT_TRUE(writer.writeBits(0, static_cast<uint8_t>(numLeadingBits)).isSuccess());
+        }
+        ASSERT_TRUE(writer.writeVarSize(1U << 30U).isSuccess());
+        writer.flush();
+
+        size_t maxByteSize = 0;
+        BitStreamReader bytesReader(data.data(), data.size());
+        ASSERT_TRUE(bytesReader.skipBits(numLeadingBits).isSuccess());
+        ASSERT_EQ(ErrorCode::EndOfStream,
+                bytesReader.readBytes(MaxSizeAllocator<uint8_t>(maxByteSize)).getError());
+
+        BitStreamReader stringReader(data.data(), data.size());
+        ASSERT_TRUE(stringReader.skipBits(numLeadingBits).isSuccess());
+        ASSERT_EQ(ErrorCode::EndOfStream,
+                stringReader.readString(MaxSizeAllocator<char>(maxByteSize)).getError());
+
+        BitStreamReader bitBufferReader(data.data(), data.size());
+        ASSERT_TRUE(bitBufferReader.skipBits(numLeadingBits).isSuccess());
+        ASSERT_EQ(ErrorCode::EndOfStream,
+                bitBufferReader.readBitBuffer(MaxSizeAllocator<uint8_t>(maxByteSize)).getError());
+
+        ASSERT_EQ(0U, maxByteSize) << numLeadingBits;
+    }
+}
+
+TEST_F(BitStreamReaderTest, createErrors)
+{
+    const std::array<const uint8_t, 3> data = {0xAE, 0xEA, 0x80};
+    const Span<const uint8_t> span(data);
+
+    auto readerResult = BitStreamReader::create(span, 24);
+    ASSERT_TRUE(readerResult.isSuccess());
+    ASSERT_EQ(24, readerResult.getValue().getBufferBitSize());
+    ASSERT_EQ(0xAEE, readerResult.getValue().readBits(12).getValue());
+
+    ASSERT_EQ(ErrorCode::WrongBufferBitSize, BitStreamReader::create(span, 25).getError());
+    ASSERT_EQ(ErrorCode::WrongBufferBitSize,
+            BitStreamReader::create(Span<const uint8_t>(), 1).getError());
+
+    // the buffer is never accessed, only its size is validated
+    const Span<const uint8_t> hugeSpan(data.data(), std::numeric_limits<size_t>::max() / 8);
+    ASSERT_EQ(ErrorCode::BufferSizeExceeded, BitStreamReader::create(hugeSpan).getError());
+    ASSERT_EQ(ErrorCode::BufferSizeExceeded, BitStreamReader::create(hugeSpan, 8).getError());
+}
+
+TEST_F(BitStreamReaderTest, readInvalidBuffer)
+{
+    // reader constructed directly from an invalid buffer reports the validation error on the first read
+    const std::array<const uint8_t, 3> data = {0xAE, 0xEA, 0x80};
+    const Span<const uint8_t> span(data);
+
+    BitStreamReader wrongBitSizeReader(span, 25);
+    ASSERT_EQ(0, wrongBitSizeReader.getBufferBitSize());
+    ASSERT_EQ(ErrorCode::WrongBufferBitSize, wrongBitSizeReader.readBits(1).getError());
+    ASSERT_EQ(ErrorCode::WrongBufferBitSize, wrongBitSizeReader.readBits64(64).getError());
+    ASSERT_EQ(ErrorCode::WrongBufferBitSize, wrongBitSizeReader.readVarSize().getError());
+    ASSERT_EQ(ErrorCode::WrongBufferBitSize, wrongBitSizeReader.readBytes().getError());
+    ASSERT_EQ(0, wrongBitSizeReader.getBitPosition());
+
+    BitStreamReader hugeReader(data.data(), std::numeric_limits<size_t>::max() / 8);
+    ASSERT_EQ(0, hugeReader.getBufferBitSize());
+    ASSERT_EQ(ErrorCode::BufferSizeExceeded, hugeReader.readBits(8).getError());
+    ASSERT_EQ(ErrorCode::BufferSizeExceeded, hugeReader.readString().getError());
+    std::array<uint32_t, 4> values = {};
+    ASSERT_EQ(ErrorCode::BufferSizeExceeded,
+            hugeReader.readBitsArray(Span<uint32_t>(values), 7).getError());
+    ASSERT_EQ(0, hugeReader.getBitPosition());
+}
+
+TEST_F(BitStreamReaderTest, readBytesView)
+{
+    const std::array<uint8_t, 3> bytes = {0x01, 0x02, 0x03};
+    std::array<uint8_t, 16> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(bytes)).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x5, 3).isSuccess());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(bytes)).isSuccess());
+    writer.flush();
+
+    // the view points into the buffer of the reader
+    BitStreamReader reader(data.data(), data.size());
+    const auto viewResult = reader.readBytesView();
+    ASSERT_TRUE(viewResult.isSuccess());
+    ASSERT_EQ(data.data() + 1, viewResult.getValue().data());
+    ASSERT_EQ(bytes.size(), viewResult.getValue().size());
+    ASSERT_TRUE(std::equal(bytes.begin(), bytes.end(), viewResult.getValue().begin()));
+    ASSERT_EQ(32, reader.getBitPosition());
+
+    // the reader stays at the unaligned value
+    ASSERT_EQ(0x5, reader.readBits(3).getValue());
+    ASSERT_EQ(ErrorCode::InvalidAlignment, reader.readBytesView().getError());
+    ASSERT_EQ(35, reader.getBitPosition());
+    const auto bytesResult = reader.readBytes();
+    ASSERT_TRUE(bytesResult.isSuccess());
+    ASSERT_TRUE(std::equal(bytes.begin(), bytes.end(), bytesResult.getValue().begin()));
+
+    // bytes behind the end of the buffer
+    BitStreamReader shortReader(data.data(), 3);
+    ASSERT_EQ(ErrorCode::EndOfStream, shortReader.readBytesView().getError());
+}
+
+TEST_F(BitStreamReaderTest, readStringView)
+{
+    std::array<uint8_t, 16> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    ASSERT_TRUE(writer.writeString(StringView("text")).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x1, 1).isSuccess());
+    ASSERT_TRUE(writer.writeString(StringView("text")).isSuccess());
+    writer.flush();
+
+    BitStreamReader reader(data.data(), data.size());
+    const auto viewResult = reader.readStringView();
+    ASSERT_TRUE(viewResult.isSuccess());
+    ASSERT_EQ(reinterpret_cast<const char*>(data.data() + 1), viewResult.getValue().data());
+    ASSERT_EQ(StringView("text"), viewResult.getValue());
+
+    ASSERT_EQ(0x1, reader.readBits(1).getValue());
+    ASSERT_EQ(ErrorCode::InvalidAlignment, reader.readStringView().getError());
+    ASSERT_EQ(41, reader.getBitPosition());
+    ASSERT_EQ("text", reader.readString().getValue());
+
+    BitStreamReader shortReader(data.data(), 4);
+    ASSERT_EQ(ErrorCode::EndOfStream, shortReader.readStringView().getError());
+}
+
 TEST_F(BitStreamReaderTest, getBitPosition)
 {
     ASSERT_EQ(0, m_reader.getBitPosition());
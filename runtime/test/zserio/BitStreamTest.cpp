@@ -697,6 +697,143 @@ TEST_F(BitStreamTest, readBytes)
     testImpl(values, writerFunc, readerFunc, 7);
 }
 
+TEST_F(BitStreamTest, unalignedPayloads)
+{
+    // lengths around the eight byte blocks of the bulk copy
+    for (size_t length : {size_t(0), size_t(1), size_t(7), size_t(8), size_t(9), size_t(15), size_t(17), size_t(1000)})
+    {
+        vector<uint8_t> bytes(length);
+        string<> text(length, ' ');
+        for (size_t i = 0; i < length; ++i)
+        {
+            bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+            text[i] = static_cast<char>('a' + i % 26);
+        }
+        const size_t bitBufferBitSize = length * 8 + length % 8;
+        vector<uint8_t> bitBufferData((bitBufferBitSize + 7) / 8);
+        for (size_t i = 0; i < bitBufferData.size(); ++i)
+        {
+            bitBufferData[i] = static_cast<uint8_t>(0xFF - i);
+        }
+        // unused bits of the last byte are not written
+        if (bitBufferBitSize % 8 != 0)
+        {
+            bitBufferData.back() = static_cast<uint8_t>(bitBufferData.back() & (0xFF << (8 - length % 8)));
+        }
+        auto bitBufferResult = BitBuffer::fromVector(std::move(bitBufferData), bitBufferBitSize);
+        ASSERT_TRUE(bitBufferResult.isSuccess());
+        const BitBuffer& bitBuffer = bitBufferResult.getValue();
+
+        for (uint8_t bitPos = 0; bitPos < 8; ++bitPos)
+        {
+            vector<uint8_t> data(3 * length + 32);
+            BitStreamWriter writer(data.data(), data.size());
+            ASSERT_TRUE(writer.writeBool(true).isSuccess());
+            if (bitPos > 0)
+            {
+                ASSERT_TRUE(writer.writeBits(0, bitPos).isSuccess());
+            }
+            ASSERT_TRUE(writer.writeBytes(bytes).isSuccess());
+            ASSERT_TRUE(writer.writeString(text).isSuccess());
+            ASSERT_TRUE(writer.writeBitBuffer(bitBuffer).isSuccess());
+            ASSERT_TRUE(writer.writeBits(0x5A, 8).isSuccess());
+            writer.flush();
+
+            // bytes written one by one give the same stream
+            vector<uint8_t> expectedData(data.size());
+            BitStreamWriter expectedWriter(expectedData.data(), expectedData.size());
+            ASSERT_TRUE(expectedWriter.writeBool(true).isSuccess());
+            if (bitPos > 0)
+            {
+                ASSERT_TRUE(expectedWriter.writeBits(0, bitPos).isSuccess());
+            }
+            ASSERT_TRUE(expectedWriter.writeVarSize(static_cast<uint32_t>(length)).isSuccess());
+            for (uint8_t byte : bytes)
+            {
+                ASSERT_TRUE(expectedWriter.writeBits(byte, 8).isSuccess());
+            }
+            ASSERT_TRUE(expectedWriter.writeVarSize(static_cast<uint32_t>(length)).isSuccess());
+            for (char character : text)
+            {
+                ASSERT_TRUE(expectedWriter.writeBits(static_cast<uint8_t>(character), 8).isSuccess());
+            }
+            ASSERT_TRUE(expectedWriter.writeVarSize(static_cast<uint32_t>(bitBufferBitSize)).isSuccess());
+            for (size_t i = 0; i < bitBufferBitSize / 8; ++i)
+            {
+                ASSERT_TRUE(expectedWriter.writeBits(bitBuffer.getBuffer()[i], 8).isSuccess());
+            }
+            if (bitBufferBitSize % 8 != 0)
+            {
+                const uint8_t numRestBits = static_cast<uint8_t>(bitBufferBitSize % 8);
+                const uint8_t lastByte = bitBuffer.getBuffer()[bitBufferBitSize / 8];
+                ASSERT_TRUE(expectedWriter.writeBits(lastByte >> (8 - numRestBits), numRestBits).isSuccess());
+            }
+            ASSERT_TRUE(expectedWriter.writeBits(0x5A, 8).isSuccess());
+            expectedWriter.flush();
+            ASSERT_EQ(expectedWriter.getBitPosition(), writer.getBitPosition());
+            ASSERT_EQ(expectedData, data) << "length: " << length << ", bitPos: " << static_cast<int>(bitPos);
+
+            BitStreamReader reader(data.data(), writer.getBitPosition(), BitsTag());
+            ASSERT_TRUE(reader.skipBits(1 + bitPos).isSuccess());
+            const auto readBytes = reader.readBytes();
+            ASSERT_TRUE(readBytes.isSuccess());
+            ASSERT_EQ(bytes, readBytes.getValue());
+            const auto readText = reader.readString();
+            ASSERT_TRUE(readText.isSuccess());
+            ASSERT_EQ(text, readText.getValue());
+            const auto readBitBuffer = reader.readBitBuffer();
+            ASSERT_TRUE(readBitBuffer.isSuccess());
+            ASSERT_EQ(bitBuffer, readBitBuffer.getValue());
+            const auto marker = reader.readBits(8);
+            ASSERT_TRUE(marker.isSuccess());
+            ASSERT_EQ(0x5A, marker.getValue());
+        }
+    }
+}
+
+TEST_F(BitStreamTest, unalignedPayloadsEndOfStream)
+{
+    const vector<uint8_t> bytes(100, 0xAB);
+    const StringView text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    auto bitBufferResult = BitBuffer::fromVector(vector<uint8_t>(100, 0xCD));
+    ASSERT_TRUE(bitBufferResult.isSuccess());
+    const BitBuffer& bitBuffer = bitBufferResult.getValue();
+
+    for (uint8_t bitPos = 1; bitPos < 8; ++bitPos)
+    {
+        vector<uint8_t> data(128);
+        BitStreamWriter writer(data.data(), data.size());
+        ASSERT_TRUE(writer.writeBits(0, bitPos).isSuccess());
+        ASSERT_TRUE(writer.writeBytes(bytes).isSuccess());
+        const size_t bitSize = writer.getBitPosition();
+        vector<uint8_t> bitBufferData(128);
+        BitStreamWriter bitBufferWriter(bitBufferData.data(), bitBufferData.size());
+        ASSERT_TRUE(bitBufferWriter.writeBits(0, bitPos).isSuccess());
+        ASSERT_TRUE(bitBufferWriter.writeBitBuffer(bitBuffer).isSuccess());
+        const size_t bitBufferBitSize = bitBufferWriter.getBitPosition();
+        writer.flush();
+        bitBufferWriter.flush();
+
+        // one bit is missing, bytes and string have the same encoding
+        BitStreamReader reader(data.data(), bitSize - 1, BitsTag());
+        ASSERT_TRUE(reader.setBitPosition(bitPos).isSuccess());
+        ASSERT_EQ(ErrorCode::EndOfStream, reader.readBytes().getError());
+        ASSERT_TRUE(reader.setBitPosition(bitPos).isSuccess());
+        ASSERT_EQ(ErrorCode::EndOfStream, reader.readString().getError());
+        BitStreamReader bitBufferReader(bitBufferData.data(), bitBufferBitSize - 1, BitsTag());
+        ASSERT_TRUE(bitBufferReader.setBitPosition(bitPos).isSuccess());
+        ASSERT_EQ(ErrorCode::EndOfStream, bitBufferReader.readBitBuffer().getError());
+
+        // the payloads do not fit into the writer
+        vector<uint8_t> smallData(100);
+        BitStreamWriter smallWriter(smallData.data(), smallData.size());
+        ASSERT_TRUE(smallWriter.writeBits(0, bitPos).isSuccess());
+        ASSERT_TRUE(smallWriter.writeBytes(bytes).isError());
+        ASSERT_TRUE(smallWriter.writeString(text).isError());
+        ASSERT_TRUE(smallWriter.writeBitBuffer(bitBuffer).isError());
+    }
+}
+
 TEST_F(BitStreamTest, setBitPosition)
 {
     testSetBitPosition(m_externalWriter);
@@ -1,13 +1,207 @@
 #include <array>
 #include <cstring>
+#include <type_traits>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "zserio/BitPackingUtil.h"
+#include "zserio/BitStreamReader.h"
 #include "zserio/BitStreamWriter.h"
 #include "zserio/CppRuntimeException.h"
 
 namespace zserio
 {
 
+namespace
+{
+
+const std::array<detail::SimdLevel, 3> SIMD_LEVELS = {
+        detail::SimdLevel::SCALAR, detail::SimdLevel::SSE41, detail::SimdLevel::AVX2};
+
+// lengths which leave a tail behind the last full vector
+const std::array<size_t, 5> ARRAY_SIZES = {1, 5, 17, 37, 101};
+
+const uint8_t MARKER = 0x5A;
+
+// restores the instruction set of the bit packing kernels
+class SimdLevelGuard
+{
+public:
+    explicit SimdLevelGuard(detail::SimdLevel level) :
+            m_previousLevel(detail::setSimdLevel(level))
+    {}
+
+    ~SimdLevelGuard()
+    {
+        detail::setSimdLevel(m_previousLevel);
+    }
+
+    SimdLevelGuard(const SimdLevelGuard&) = delete;
+    SimdLevelGuard& operator=(const SimdLevelGuard&) = delete;
+
+private:
+    detail::SimdLevel m_previousLevel;
+};
+
+uint64_t createValue(size_t index, uint8_t numBits)
+{
+    const uint64_t value = UINT64_C(0x9E3779B97F4A7C15) * (index + 1);
+    return (numBits == 64) ? value : value & ((UINT64_C(1) << numBits) - 1);
+}
+
+int64_t createSignedValue(size_t index, uint8_t numBits)
+{
+    const uint64_t value = createValue(index, numBits);
+    if (numBits == 64 || value < (UINT64_C(1) << (numBits - 1)))
+    {
+        return static_cast<int64_t>(value);
+    }
+    return static_cast<int64_t>(value - (UINT64_C(1) << (numBits - 1))) - (INT64_C(1) << (numBits - 1));
+}
+
+template <typename T>
+typename std::enable_if<std::is_unsigned<T>::value, std::vector<T>>::type createValues(
+        size_t numValues, uint8_t numBits)
+{
+    std::vector<T> values(numValues);
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        values[i] = static_cast<T>(createValue(i, numBits));
+    }
+    return values;
+}
+
+template <typename T>
+typename std::enable_if<std::is_signed<T>::value, std::vector<T>>::type createValues(
+        size_t numValues, uint8_t numBits)
+{
+    std::vector<T> values(numValues);
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        values[i] = static_cast<T>(createSignedValue(i, numBits));
+    }
+    return values;
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<uint8_t>& values, uint8_t numBits)
+{
+    return writer.writeBitsArray(Span<const uint8_t>(values), numBits);
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<uint16_t>& values, uint8_t numBits)
+{
+    return writer.writeBitsArray(Span<const uint16_t>(values), numBits);
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<uint32_t>& values, uint8_t numBits)
+{
+    return writer.writeBitsArray(Span<const uint32_t>(values), numBits);
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<uint64_t>& values, uint8_t numBits)
+{
+    return writer.writeBits64Array(Span<const uint64_t>(values), numBits);
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<int8_t>& values, uint8_t numBits)
+{
+    return writer.writeSignedBitsArray(Span<const int8_t>(values), numBits);
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<int16_t>& values, uint8_t numBits)
+{
+    return writer.writeSignedBitsArray(Span<const int16_t>(values), numBits);
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<int32_t>& values, uint8_t numBits)
+{
+    return writer.writeSignedBitsArray(Span<const int32_t>(values), numBits);
+}
+
+Result<void> writeArray(BitStreamWriter& writer, const std::vector<int64_t>& values, uint8_t numBits)
+{
+    return writer.writeSignedBits64Array(Span<const int64_t>(values), numBits);
+}
+
+Result<void> writeValue(BitStreamWriter& writer, uint64_t value, uint8_t numBits)
+{
+    return writer.writeBits64(value, numBits);
+}
+
+Result<void> writeValue(BitStreamWriter& writer, int64_t value, uint8_t numBits)
+{
+    return writer.writeSignedBits64(value, numBits);
+}
+
+Result<uint64_t> readValue(BitStreamReader& reader, uint8_t numBits, std::false_type)
+{
+    return reader.readBits64(numBits);
+}
+
+Result<int64_t> readValue(BitStreamReader& reader, uint8_t numBits, std::true_type)
+{
+    return reader.readSignedBits64(numBits);
+}
+
+// writes the array behind ones in the leading bits followed by a marker, using every instruction set
+template <typename T>
+void checkWriteArray(uint8_t numBits)
+{
+    using WideType = typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type;
+    for (detail::SimdLevel level : SIMD_LEVELS)
+    {
+        SimdLevelGuard guard(level);
+        for (uint8_t numLeadingBits : {uint8_t(0), uint8_t(3), uint8_t(7)})
+        {
+            for (size_t numValues : ARRAY_SIZES)
+            {
+                const std::vector<T> values = createValues<T>(numValues, numBits);
+                const size_t byteSize = (numLeadingBits + numValues * numBits + 8 + 7) / 8;
+
+                // reference stream written value by value
+                std::vector<uint8_t> expected(byteSize);
+                BitStreamWriter expectedWriter(expected.data(), expected.size());
+                if (numLeadingBits > 0)
+                {
+                    ASSERT_TRUE(expectedWriter.writeBits((1U << numLeadingBits) - 1, numLeadingBits).isSuccess());
+                }
+                for (T value : values)
+                {
+                    ASSERT_TRUE(writeValue(expectedWriter, static_cast<WideType>(value), numBits).isSuccess());
+                }
+                ASSERT_TRUE(expectedWriter.writeBits(MARKER, 8).isSuccess());
+
+                // pending bits of the write cache are stored around the array
+                std::vector<uint8_t> data(byteSize);
+                BitStreamWriter writer(data.data(), data.size());
+                writer.enableWriteCache();
+                if (numLeadingBits > 0)
+                {
+                    ASSERT_TRUE(writer.writeBits((1U << numLeadingBits) - 1, numLeadingBits).isSuccess());
+                }
+                ASSERT_TRUE(writeArray(writer, values, numBits).isSuccess());
+                ASSERT_EQ(numLeadingBits + numValues * numBits, writer.getBitPosition());
+                ASSERT_TRUE(writer.writeBits(MARKER, 8).isSuccess());
+                writer.flush();
+                ASSERT_EQ(expected, data) << static_cast<int>(level) << ":" << static_cast<int>(numLeadingBits)
+                                          << ":" << numValues;
+
+                BitStreamReader reader(data.data(), data.size());
+                ASSERT_TRUE(reader.skipBits(numLeadingBits).isSuccess());
+                for (size_t i = 0; i < numValues; ++i)
+                {
+                    const auto readResult = readValue(reader, numBits, std::is_signed<T>());
+                    ASSERT_TRUE(readResult.isSuccess());
+                    ASSERT_EQ(static_cast<WideType>(values[i]), readResult.getValue()) << i;
+                }
+                ASSERT_EQ(MARKER, reader.readBits(8).getValue());
+            }
+        }
+    }
+}
+
+} // namespace
+
 class BitStreamWriterTest : public ::testing::Test
 {
 public:
@@ -354,4 +548,194 @@ TEST_F(BitStreamWriterTest, dummyBufferTest)
     ASSERT_EQ(25, m_dummyBufferWriter.getBitPosition());
 }
 
+TEST_F(BitStreamWriterTest, writeCacheEmptyArray)
+{
+    std::array<uint8_t, 16> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    writer.enableWriteCache();
+
+    ASSERT_TRUE(writer.writeBits(0x05, 3).isSuccess());
+    // empty arrays must keep the bits pending in the write cache
+    ASSERT_TRUE(writer.writeBitsArray(Span<const uint32_t>(), 7).isSuccess());
+    ASSERT_TRUE(writer.writeSignedBitsArray(Span<const int16_t>(), 5).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x1F, 5).isSuccess());
+    ASSERT_EQ(8, writer.getBitPosition());
+
+    const std::array<uint32_t, 2> values = {0x7F, 0x01};
+    ASSERT_TRUE(writer.writeBits(0x03, 2).isSuccess());
+    ASSERT_TRUE(writer.writeBitsArray(Span<const uint32_t>(values), 7).isSuccess());
+    ASSERT_TRUE(writer.writeSignedBitsArray(Span<const int16_t>(), 5).isSuccess());
+    ASSERT_EQ(24, writer.getBitPosition());
+
+    writer.flush();
+    ASSERT_EQ(0xBF, data[0]);
+    ASSERT_EQ(0xFF, data[1]);
+    ASSERT_EQ(0x81, data[2]);
+}
+
+TEST_F(BitStreamWriterTest, writeCacheSetBitPosition)
+{
+    std::array<uint8_t, 16> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    writer.enableWriteCache();
+
+    ASSERT_TRUE(writer.writeBits(0xFFFFFFFF, 32).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x0F, 4).isSuccess());
+
+    // pending bits are flushed and the bits behind the new position are kept
+    ASSERT_TRUE(writer.setBitPosition(4).isSuccess());
+    ASSERT_TRUE(writer.writeBitsArray(Span<const uint32_t>(), 3).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x00, 4).isSuccess());
+    ASSERT_EQ(8, writer.getBitPosition());
+
+    ASSERT_TRUE(writer.setBitPosition(64).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0xAB, 8).isSuccess());
+    ASSERT_TRUE(writer.setBitPosition(36).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x0A, 4).isSuccess());
+    ASSERT_EQ(ErrorCode::BufferOverflow, writer.setBitPosition(16 * 8 + 1).getError());
+
+    writer.flush();
+    const std::array<uint8_t, 16> expected = {
+            0xF0, 0xFF, 0xFF, 0xFF, 0xFA, 0x00, 0x00, 0x00, 0xAB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    ASSERT_EQ(expected, data);
+}
+
+TEST_F(BitStreamWriterTest, writeBitsArraySimd)
+{
+    for (uint8_t numBits : {uint8_t(1), uint8_t(3), uint8_t(7)})
+    {
+        checkWriteArray<uint8_t>(numBits);
+    }
+    for (uint8_t numBits : {uint8_t(5), uint8_t(11), uint8_t(15)})
+    {
+        checkWriteArray<uint16_t>(numBits);
+    }
+    for (uint8_t numBits : {uint8_t(1), uint8_t(13), uint8_t(17), uint8_t(31)})
+    {
+        checkWriteArray<uint32_t>(numBits);
+    }
+    for (uint8_t numBits : {uint8_t(7), uint8_t(33), uint8_t(63)})
+    {
+        checkWriteArray<uint64_t>(numBits);
+    }
+}
+
+TEST_F(BitStreamWriterTest, writeSignedBitsArraySimd)
+{
+    for (uint8_t numBits : {uint8_t(1), uint8_t(3), uint8_t(7)})
+    {
+        checkWriteArray<int8_t>(numBits);
+    }
+    for (uint8_t numBits : {uint8_t(5), uint8_t(11), uint8_t(15)})
+    {
+        checkWriteArray<int16_t>(numBits);
+    }
+    for (uint8_t numBits : {uint8_t(1), uint8_t(13), uint8_t(17), uint8_t(31)})
+    {
+        checkWriteArray<int32_t>(numBits);
+    }
+    for (uint8_t numBits : {uint8_t(7), uint8_t(33), uint8_t(63)})
+    {
+        checkWriteArray<int64_t>(numBits);
+    }
+}
+
+TEST_F(BitStreamWriterTest, writeByteSwappedArraySimd)
+{
+    // full width values are byte swapped at aligned positions and packed at unaligned ones
+    checkWriteArray<uint8_t>(8);
+    checkWriteArray<uint16_t>(16);
+    checkWriteArray<uint32_t>(32);
+    checkWriteArray<uint64_t>(64);
+    checkWriteArray<int8_t>(8);
+    checkWriteArray<int16_t>(16);
+    checkWriteArray<int32_t>(32);
+    checkWriteArray<int64_t>(64);
+}
+
+TEST_F(BitStreamWriterTest, writeBitsFrom)
+{
+    std::array<uint8_t, 64> source = {};
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<uint8_t>(i * 37 + 1);
+    }
+
+    // same and different offsets within a byte
+    for (size_t readOffset : {size_t(0), size_t(3)})
+    {
+        for (uint8_t writeOffset : {uint8_t(0), uint8_t(3), uint8_t(5)})
+        {
+            for (size_t numBits : {size_t(0), size_t(7), size_t(64), size_t(301)})
+            {
+                BitStreamReader in(source.data(), source.size());
+                ASSERT_TRUE(in.setBitPosition(readOffset).isSuccess());
+                std::array<uint8_t, 64> data = {};
+                BitStreamWriter writer(data.data(), data.size());
+                if (writeOffset > 0)
+                {
+                    ASSERT_TRUE(writer.writeBits(0, writeOffset).isSuccess());
+                }
+                ASSERT_TRUE(writer.writeBitsFrom(in, numBits).isSuccess());
+                ASSERT_EQ(readOffset + numBits, in.getBitPosition());
+                ASSERT_EQ(writeOffset + numBits, writer.getBitPosition());
+                writer.flush();
+
+                BitStreamReader expectedReader(source.data(), source.size());
+                ASSERT_TRUE(expectedReader.setBitPosition(readOffset).isSuccess());
+                BitStreamReader reader(data.data(), data.size());
+                ASSERT_TRUE(reader.setBitPosition(writeOffset).isSuccess());
+                for (size_t i = 0; i < numBits; ++i)
+                {
+                    ASSERT_EQ(expectedReader.readBits(1).getValue(), reader.readBits(1).getValue()) << i;
+                }
+            }
+        }
+    }
+
+    // writer without a buffer only counts the bits
+    BitStreamReader in(source.data(), source.size());
+    ASSERT_TRUE(m_dummyBufferWriter.writeBitsFrom(in, 100).isSuccess());
+    ASSERT_EQ(100, m_dummyBufferWriter.getBitPosition());
+}
+
+TEST_F(BitStreamWriterTest, writeBitsFromEndOfStream)
+{
+    const std::array<uint8_t, 4> source = {0x01, 0x02, 0x03, 0x04};
+    BitStreamReader in(source.data(), source.size());
+    ASSERT_TRUE(in.setBitPosition(5).isSuccess());
+
+    // the reader stays at its original position
+    ASSERT_EQ(ErrorCode::EndOfStream, m_externalBufferWriter.writeBitsFrom(in, 28).getError());
+    ASSERT_EQ(5, in.getBitPosition());
+    ASSERT_EQ(0, m_externalBufferWriter.getBitPosition());
+
+    ASSERT_TRUE(m_externalBufferWriter.writeBitsFrom(in, 27).isSuccess());
+    ASSERT_EQ(32, in.getBitPosition());
+}
+
+TEST_F(BitStreamWriterTest, writeBitsFromBufferOverflow)
+{
+    const std::array<uint8_t, 8> source = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    for (uint8_t writeOffset : {uint8_t(0), uint8_t(3)})
+    {
+        BitStreamReader in(source.data(), source.size());
+        ASSERT_TRUE(in.setBitPosition(2).isSuccess());
+        std::array<uint8_t, 4> data = {};
+        BitStreamWriter writer(data.data(), data.size());
+        if (writeOffset > 0)
+        {
+            ASSERT_TRUE(writer.writeBits(0, writeOffset).isSuccess());
+        }
+
+        // destination is smaller than the copied bits, the reader stays at its original position
+        ASSERT_EQ(ErrorCode::BufferOverflow, writer.writeBitsFrom(in, 40).getError());
+        ASSERT_EQ(2, in.getBitPosition());
+        ASSERT_EQ(writeOffset, writer.getBitPosition());
+
+        ASSERT_TRUE(writer.writeBitsFrom(in, 32 - writeOffset).isSuccess());
+        ASSERT_EQ(34 - writeOffset, in.getBitPosition());
+    }
+}
+
 } // namespace zserio
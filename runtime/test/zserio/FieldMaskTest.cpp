@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "zserio/FieldMask.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+// masks are usable in constant expressions like FIELD_name constants of generated structures
+constexpr FieldMask FIELD_FIRST = FieldMask::field(0);
+constexpr FieldMask FIELD_SECOND = FieldMask::field(1);
+constexpr FieldMask FIELD_LAST = FieldMask::field(FieldMask::MAX_NUM_FIELDS - 1);
+
+static_assert((FIELD_FIRST | FIELD_SECOND).contains(FIELD_SECOND), "constexpr contains");
+static_assert(!FieldMask().contains(FIELD_FIRST), "constexpr empty");
+
+} // namespace
+
+TEST(FieldMaskTest, emptyConstructor)
+{
+    const FieldMask mask;
+    ASSERT_TRUE(mask.isEmpty());
+    ASSERT_EQ(0, mask.getBits());
+    ASSERT_TRUE(mask.contains(FieldMask()));
+    ASSERT_FALSE(mask.contains(FIELD_FIRST));
+}
+
+TEST(FieldMaskTest, field)
+{
+    ASSERT_EQ(UINT64_C(1), FIELD_FIRST.getBits());
+    ASSERT_EQ(UINT64_C(2), FIELD_SECOND.getBits());
+    ASSERT_EQ(UINT64_C(1) << 63, FIELD_LAST.getBits());
+    ASSERT_FALSE(FIELD_LAST.isEmpty());
+    ASSERT_TRUE(FIELD_FIRST.contains(FIELD_FIRST));
+    ASSERT_FALSE(FIELD_FIRST.contains(FIELD_SECOND));
+}
+
+TEST(FieldMaskTest, all)
+{
+    const FieldMask mask = FieldMask::all();
+    ASSERT_EQ(~UINT64_C(0), mask.getBits());
+    ASSERT_TRUE(mask.contains(FIELD_FIRST | FIELD_SECOND | FIELD_LAST));
+    ASSERT_TRUE(mask.contains(FieldMask()));
+}
+
+TEST(FieldMaskTest, contains)
+{
+    const FieldMask mask = FIELD_FIRST | FIELD_LAST;
+
+    // all given fields must be contained
+    ASSERT_TRUE(mask.contains(FIELD_FIRST));
+    ASSERT_TRUE(mask.contains(FIELD_LAST));
+    ASSERT_TRUE(mask.contains(FIELD_FIRST | FIELD_LAST));
+    ASSERT_FALSE(mask.contains(FIELD_SECOND));
+    ASSERT_FALSE(mask.contains(FIELD_FIRST | FIELD_SECOND));
+}
+
+TEST(FieldMaskTest, operators)
+{
+    const FieldMask mask = FIELD_FIRST | FIELD_SECOND;
+    ASSERT_EQ(UINT64_C(3), mask.getBits());
+    ASSERT_EQ(FIELD_SECOND, mask & (FIELD_SECOND | FIELD_LAST));
+    ASSERT_TRUE((mask & FIELD_LAST).isEmpty());
+
+    FieldMask unitedMask;
+    unitedMask |= FIELD_LAST;
+    unitedMask |= FIELD_FIRST;
+    unitedMask |= FIELD_FIRST;
+    ASSERT_EQ(FIELD_FIRST | FIELD_LAST, unitedMask);
+    ASSERT_NE(mask, unitedMask);
+    ASSERT_TRUE(FIELD_FIRST == FieldMask::field(0));
+    ASSERT_FALSE(FIELD_FIRST != FieldMask::field(0));
+}
+
+} // namespace zserio
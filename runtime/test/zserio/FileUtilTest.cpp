@@ -1,3 +1,6 @@
+#include <array>
+#include <cstdio>
+#include <fstream>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -74,4 +77,43 @@ TEST(FileUtilTest, writeReadBitStreamWriter)
     }
 }
 
+TEST(FileUtilTest, getTemporaryFileName)
+{
+    const std::string fileName = "dir/FileUtilTest.bin";
+    const std::string tempFileName = getTemporaryFileName(fileName);
+    const std::string otherTempFileName = getTemporaryFileName(fileName);
+
+    // temporary files lie in the same directory and never share the name
+    ASSERT_EQ(0, tempFileName.compare(0, fileName.size() + 1, fileName + "."));
+    ASSERT_EQ(".tmp", tempFileName.substr(tempFileName.size() - 4));
+    ASSERT_EQ(0, otherTempFileName.compare(0, fileName.size() + 1, fileName + "."));
+    ASSERT_NE(tempFileName, otherTempFileName);
+}
+
+TEST(FileUtilTest, fileByteSourceLargeFile)
+{
+    // size which is -1 when narrowed to 32 bits, the file is sparse and thus it does not occupy the disk
+    const std::string fileName = "FileUtilTest_largeFile.bin";
+    const uint64_t byteSize = UINT64_C(0xFFFFFFFF);
+    {
+        std::ofstream stream(fileName.c_str(), std::ofstream::binary | std::ofstream::trunc);
+        ASSERT_TRUE(static_cast<bool>(stream.seekp(static_cast<std::streamoff>(byteSize - 1))));
+        ASSERT_TRUE(static_cast<bool>(stream.put(0x01)));
+    }
+
+    auto sourceResult = FileByteSource::open(fileName);
+    ASSERT_TRUE(sourceResult.isSuccess());
+    if (byteSize < IByteSource::UNKNOWN_BYTE_SIZE)
+    {
+        ASSERT_EQ(byteSize, sourceResult.getValue().getByteSize());
+    }
+    std::array<uint8_t, 4> data = {0xFF, 0xFF, 0xFF, 0xFF};
+    const auto readResult = sourceResult.getValue().read(Span<uint8_t>(data));
+    ASSERT_TRUE(readResult.isSuccess());
+    ASSERT_EQ(data.size(), readResult.getValue());
+    ASSERT_EQ(0, data[0]);
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
 } // namespace zserio
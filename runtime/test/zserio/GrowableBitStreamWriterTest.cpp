@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/BitSizeOfCalculator.h"
+#include "zserio/GrowableBitStreamWriter.h"
+#include "zserio/SerializeUtil.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+struct Allocations
+{
+    size_t numAllocations = 0;
+    size_t maxByteSize = 0;
+};
+
+// allocator which counts the allocations and records the largest one
+template <typename T>
+class CountingAllocator
+{
+public:
+    using value_type = T;
+
+    explicit CountingAllocator(Allocations& allocations) noexcept :
+            m_allocations(&allocations)
+    {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept :
+            m_allocations(other.getAllocations())
+    {}
+
+    T* allocate(size_t numElements)
+    {
+        ++m_allocations->numAllocations;
+        m_allocations->maxByteSize = std::max(m_allocations->maxByteSize, numElements * sizeof(T));
+        return std::allocator<T>().allocate(numElements);
+    }
+
+    void deallocate(T* pointer, size_t numElements) noexcept
+    {
+        std::allocator<T>().deallocate(pointer, numElements);
+    }
+
+    Allocations* getAllocations() const noexcept
+    {
+        return m_allocations;
+    }
+
+private:
+    Allocations* m_allocations;
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs)
+{
+    return lhs.getAllocations() == rhs.getAllocations();
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>& lhs, const CountingAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// object holding a bit field and a payload of bytes
+class GrowableObject
+{
+public:
+    Result<size_t> initializeOffsets(size_t bitPosition = 0) const noexcept
+    {
+        auto bytesBitSizeResult = bitSizeOfBytes(Span<const uint8_t>(payload));
+        if (bytesBitSizeResult.isError())
+        {
+            return bytesBitSizeResult;
+        }
+        return Result<size_t>::success(bitPosition + 5 + bytesBitSizeResult.getValue());
+    }
+
+    Result<void> write(BitStreamWriter& writer) const noexcept
+    {
+        auto result = writer.writeBits(value, 5);
+        if (result.isError())
+        {
+            return result;
+        }
+        return writer.writeBytes(Span<const uint8_t>(payload));
+    }
+
+    uint8_t value = 0;
+    std::vector<uint8_t> payload;
+};
+
+} // namespace
+
+TEST(GrowableBitStreamWriterTest, emptyWriter)
+{
+    Allocations allocations;
+    BasicGrowableBitStreamWriter<CountingAllocator<uint8_t>> writer{CountingAllocator<uint8_t>(allocations)};
+    ASSERT_EQ(0, writer.getBitPosition());
+    ASSERT_EQ(0, allocations.numAllocations);
+
+    const auto releaseResult = writer.release();
+    ASSERT_TRUE(releaseResult.isSuccess());
+    ASSERT_EQ(0, releaseResult.getValue().getBitSize());
+}
+
+TEST(GrowableBitStreamWriterTest, maxByteSize)
+{
+    GrowableBitStreamWriter writer(100);
+    ASSERT_TRUE(writer.reserve(800).isSuccess());
+    ASSERT_LE(800, writer.getBufferBitSize());
+    ASSERT_EQ(ErrorCode::AllocationFailed, writer.reserve(801).getError());
+
+    const std::vector<uint8_t> data(98, 0xAB);
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(data)).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x55, 8).isSuccess());
+    ASSERT_EQ(800, writer.getBitPosition());
+    ASSERT_EQ(ErrorCode::AllocationFailed, writer.writeBits(1, 1).getError());
+    ASSERT_EQ(ErrorCode::AllocationFailed, writer.writeBytes(Span<const uint8_t>(data)).getError());
+
+    const auto releaseResult = writer.release();
+    ASSERT_TRUE(releaseResult.isSuccess());
+    ASSERT_EQ(800, releaseResult.getValue().getBitSize());
+    ASSERT_EQ(0x55, releaseResult.getValue().getBuffer()[99]);
+}
+
+TEST(GrowableBitStreamWriterTest, growGeometrically)
+{
+    // many small writes need a logarithmic number of allocations
+    const size_t numBytes = 100000;
+    Allocations allocations;
+    BasicGrowableBitStreamWriter<CountingAllocator<uint8_t>> writer{CountingAllocator<uint8_t>(allocations)};
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        ASSERT_TRUE(writer.writeBits(static_cast<uint32_t>(i & 0xFFU), 8).isSuccess());
+    }
+    ASSERT_LE(allocations.numAllocations, 12U);
+    ASSERT_LE(allocations.maxByteSize, 2 * numBytes);
+
+    const auto releaseResult = writer.release();
+    ASSERT_TRUE(releaseResult.isSuccess());
+    const auto& bitBuffer = releaseResult.getValue();
+    ASSERT_EQ(numBytes * 8, bitBuffer.getBitSize());
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        ASSERT_EQ(static_cast<uint8_t>(i & 0xFFU), bitBuffer.getBuffer()[i]) << i;
+    }
+}
+
+TEST(GrowableBitStreamWriterTest, growByLargeWrite)
+{
+    // a large write grows the buffer geometrically as well
+    std::vector<uint8_t> data(1000000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    Allocations allocations;
+    BasicGrowableBitStreamWriter<CountingAllocator<uint8_t>> writer{CountingAllocator<uint8_t>(allocations)};
+    ASSERT_TRUE(writer.writeBits(0x1, 8).isSuccess());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(data)).isSuccess());
+    ASSERT_LE(allocations.numAllocations, 16U);
+    ASSERT_LE(allocations.maxByteSize, 2 * data.size());
+
+    const auto releaseResult = writer.release();
+    ASSERT_TRUE(releaseResult.isSuccess());
+    const auto& bitBuffer = releaseResult.getValue();
+    ASSERT_EQ((data.size() + 4) * 8, bitBuffer.getBitSize());
+    ASSERT_EQ(0x1, bitBuffer.getBuffer()[0]);
+    ASSERT_TRUE(std::equal(data.begin(), data.end(), bitBuffer.getBuffer() + 4));
+}
+
+TEST(GrowableBitStreamWriterTest, release)
+{
+    GrowableBitStreamWriter writer;
+    ASSERT_TRUE(writer.writeBits(0xFFFF, 16).isSuccess());
+
+    // bits behind the position are masked
+    ASSERT_TRUE(writer.setBitPosition(11).isSuccess());
+    const auto releaseResult = writer.release();
+    ASSERT_TRUE(releaseResult.isSuccess());
+    const BitBuffer& bitBuffer = releaseResult.getValue();
+    ASSERT_EQ(11, bitBuffer.getBitSize());
+    ASSERT_EQ(2, bitBuffer.getByteSize());
+    ASSERT_EQ(0xFF, bitBuffer.getBuffer()[0]);
+    ASSERT_EQ(0xE0, bitBuffer.getBuffer()[1]);
+
+    // the writer starts again with an empty buffer
+    ASSERT_EQ(0, writer.getBitPosition());
+    ASSERT_TRUE(writer.writeBits(0x5, 3).isSuccess());
+    const auto secondReleaseResult = writer.release();
+    ASSERT_TRUE(secondReleaseResult.isSuccess());
+    ASSERT_EQ(3, secondReleaseResult.getValue().getBitSize());
+    ASSERT_EQ(0xA0, secondReleaseResult.getValue().getBuffer()[0]);
+    ASSERT_EQ(0xFF, bitBuffer.getBuffer()[0]);
+}
+
+TEST(GrowableBitStreamWriterTest, moveConstructor)
+{
+    GrowableBitStreamWriter writer;
+    ASSERT_TRUE(writer.writeBits(0xAB, 8).isSuccess());
+
+    GrowableBitStreamWriter movedWriter(std::move(writer));
+    ASSERT_TRUE(movedWriter.writeBits(0xCD, 8).isSuccess());
+    const auto releaseResult = movedWriter.release();
+    ASSERT_TRUE(releaseResult.isSuccess());
+    ASSERT_EQ(16, releaseResult.getValue().getBitSize());
+    ASSERT_EQ(0xAB, releaseResult.getValue().getBuffer()[0]);
+    ASSERT_EQ(0xCD, releaseResult.getValue().getBuffer()[1]);
+}
+
+TEST(GrowableBitStreamWriterTest, serializeSinglePass)
+{
+    GrowableObject object;
+    object.value = 0x13;
+    object.payload.resize(1000);
+    for (size_t i = 0; i < object.payload.size(); ++i)
+    {
+        object.payload[i] = static_cast<uint8_t>(i * 3);
+    }
+
+    const auto expectedResult = serialize(object);
+    ASSERT_TRUE(expectedResult.isSuccess());
+    const auto singlePassResult = serializeSinglePass(object);
+    ASSERT_TRUE(singlePassResult.isSuccess());
+    ASSERT_EQ(expectedResult.getValue(), singlePassResult.getValue());
+}
+
+} // namespace zserio
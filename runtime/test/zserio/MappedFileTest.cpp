@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/FileUtil.h"
+#include "zserio/MappedFile.h"
+#include "zserio/SerializeUtil.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+// object holding a bit field and a view of a string
+class MappedObject
+{
+public:
+    static Result<MappedObject> deserialize(BitStreamReader& reader) noexcept
+    {
+        auto valueResult = reader.readBits(16);
+        if (valueResult.isError())
+        {
+            return Result<MappedObject>::error(valueResult.getError());
+        }
+        auto textResult = reader.readStringView();
+        if (textResult.isError())
+        {
+            return Result<MappedObject>::error(textResult.getError());
+        }
+
+        MappedObject object;
+        object.value = static_cast<uint16_t>(valueResult.getValue());
+        object.text = textResult.getValue();
+        return Result<MappedObject>::success(object);
+    }
+
+    uint16_t value = 0;
+    StringView text;
+};
+
+std::vector<uint8_t> createMappedObjectData(const std::string& text)
+{
+    std::vector<uint8_t> data(text.size() + 16);
+    BitStreamWriter writer(data.data(), data.size());
+    EXPECT_TRUE(writer.writeBits(0xCAFE, 16).isSuccess());
+    EXPECT_TRUE(writer.writeString(StringView(text)).isSuccess());
+    data.resize(writer.getBitPosition() / 8);
+    return data;
+}
+
+void writeFile(const std::string& fileName, const std::vector<uint8_t>& data)
+{
+    ASSERT_TRUE(writeBufferToFile(data.data(), data.size(), fileName).isSuccess());
+}
+
+} // namespace
+
+TEST(MappedFileTest, emptyConstructor)
+{
+    const MappedFile mappedFile;
+    ASSERT_TRUE(mappedFile.getData().empty());
+    ASSERT_FALSE(mappedFile.isMapped());
+}
+
+TEST(MappedFileTest, open)
+{
+    const std::string fileName = "MappedFileTest_open.bin";
+    std::vector<uint8_t> data(10000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 3);
+    }
+    writeFile(fileName, data);
+
+    auto mappedFileResult = MappedFile::open(fileName);
+    ASSERT_TRUE(mappedFileResult.isSuccess());
+    const MappedFile& mappedFile = mappedFileResult.getValue();
+#if defined(__unix__) || defined(__APPLE__)
+    ASSERT_TRUE(mappedFile.isMapped());
+#endif
+    ASSERT_EQ(data.size(), mappedFile.getData().size());
+    ASSERT_TRUE(std::equal(data.begin(), data.end(), mappedFile.getData().begin()));
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(MappedFileTest, openEmptyFile)
+{
+    const std::string fileName = "MappedFileTest_empty.bin";
+    writeFile(fileName, std::vector<uint8_t>());
+
+    // empty files cannot be mapped
+    auto mappedFileResult = MappedFile::open(fileName);
+    ASSERT_TRUE(mappedFileResult.isSuccess());
+    ASSERT_TRUE(mappedFileResult.getValue().getData().empty());
+    ASSERT_FALSE(mappedFileResult.getValue().isMapped());
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(MappedFileTest, openMissingFile)
+{
+    ASSERT_EQ(ErrorCode::FileOpenFailed, MappedFile::open("MappedFileTest_missing.bin").getError());
+    ASSERT_EQ(ErrorCode::FileOpenFailed, MappedFile::open("").getError());
+}
+
+TEST(MappedFileTest, move)
+{
+    const std::string fileName = "MappedFileTest_move.bin";
+    const std::vector<uint8_t> data = {0x01, 0x02, 0x03};
+    writeFile(fileName, data);
+
+    auto mappedFileResult = MappedFile::open(fileName);
+    ASSERT_TRUE(mappedFileResult.isSuccess());
+    const uint8_t* mappedData = mappedFileResult.getValue().getData().data();
+
+    MappedFile movedFile(std::move(mappedFileResult.getValue()));
+    ASSERT_EQ(mappedData, movedFile.getData().data());
+    ASSERT_EQ(data.size(), movedFile.getData().size());
+
+    MappedFile assignedFile;
+    assignedFile = std::move(movedFile);
+    ASSERT_EQ(mappedData, assignedFile.getData().data());
+    ASSERT_TRUE(std::equal(data.begin(), data.end(), assignedFile.getData().begin()));
+    ASSERT_TRUE(movedFile.getData().empty());
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(MappedFileTest, deserializeFromMappedFile)
+{
+    const std::string fileName = "MappedFileTest_deserialize.bin";
+    const std::string text = "text which is read without any copy";
+    writeFile(fileName, createMappedObjectData(text));
+
+    auto mappedFileResult = MappedFile::open(fileName);
+    ASSERT_TRUE(mappedFileResult.isSuccess());
+    const MappedFile& mappedFile = mappedFileResult.getValue();
+    const auto objectResult = deserializeFromMappedFile<MappedObject>(mappedFile);
+    ASSERT_TRUE(objectResult.isSuccess());
+    ASSERT_EQ(0xCAFE, objectResult.getValue().value);
+    ASSERT_EQ(StringView(text), objectResult.getValue().text);
+
+    // the view points into the file contents
+    const uint8_t* textData = reinterpret_cast<const uint8_t*>(objectResult.getValue().text.data());
+    ASSERT_GE(textData, mappedFile.getData().data());
+    ASSERT_LE(textData + text.size(), mappedFile.getData().data() + mappedFile.getData().size());
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(MappedFileTest, deserializeFromTruncatedMappedFile)
+{
+    const std::string fileName = "MappedFileTest_truncated.bin";
+    std::vector<uint8_t> data = createMappedObjectData("truncated text");
+    data.pop_back();
+    writeFile(fileName, data);
+
+    auto mappedFileResult = MappedFile::open(fileName);
+    ASSERT_TRUE(mappedFileResult.isSuccess());
+    ASSERT_EQ(ErrorCode::EndOfStream,
+            deserializeFromMappedFile<MappedObject>(mappedFileResult.getValue()).getError());
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(MappedFileTest, deserializeFromEmptyMappedFile)
+{
+    const std::string fileName = "MappedFileTest_emptyDeserialize.bin";
+    writeFile(fileName, std::vector<uint8_t>());
+
+    auto mappedFileResult = MappedFile::open(fileName);
+    ASSERT_TRUE(mappedFileResult.isSuccess());
+    ASSERT_EQ(ErrorCode::EndOfStream,
+            deserializeFromMappedFile<MappedObject>(mappedFileResult.getValue()).getError());
+
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+} // namespace zserio
@@ -1,5 +1,8 @@
+#include <cstdint>
+
 #include "gtest/gtest.h"
 #include "zserio/pmr/MemoryResource.h"
+#include "zserio/pmr/MonotonicBufferResource.h"
 
 namespace zserio
 {
@@ -47,6 +50,23 @@ private:
     size_t m_instanceId;
 };
 
+class NullResource : public zserio::pmr::MemoryResource
+{
+private:
+    void* doAllocate(size_t, size_t) override
+    {
+        return nullptr;
+    }
+
+    void doDeallocate(void*, size_t, size_t) override
+    {}
+
+    bool doIsEqual(const MemoryResource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
 TEST(MemoryResourceTest, allocateDeallocate)
 {
     TestResource res(1);
@@ -96,4 +116,71 @@ TEST(MemoryResourceTest, setGetDefaultResource)
     ASSERT_EQ(origRes, zserio::pmr::getDefaultResource());
 }
 
+TEST(MemoryResourceTest, monotonicBufferResource)
+{
+    alignas(8) unsigned char buffer[64];
+    TestResource upstream(1);
+    {
+        zserio::pmr::MonotonicBufferResource res(buffer, sizeof(buffer), &upstream);
+        void* memory1 = res.allocate(1, 1);
+        void* memory2 = res.allocate(8, 8);
+        ASSERT_EQ(buffer, memory1);
+        ASSERT_EQ(buffer + 8, memory2);
+        res.deallocate(memory2, 8, 8);
+        ASSERT_EQ(buffer + 16, res.allocate(8, 8));
+        ASSERT_EQ(0, upstream.numAllocs());
+
+        // the buffer is exhausted, blocks come from the upstream resource
+        void* memory3 = res.allocate(64, 8);
+        ASSERT_NE(nullptr, memory3);
+        ASSERT_EQ(0, reinterpret_cast<uintptr_t>(memory3) % 8);
+        ASSERT_EQ(1, upstream.numAllocs());
+        ASSERT_FALSE(res.isExhausted());
+
+        res.release();
+        ASSERT_EQ(1, upstream.numDeallocs());
+        ASSERT_EQ(buffer, res.allocate(1, 1));
+        ASSERT_NE(nullptr, res.allocate(100, 8));
+        ASSERT_EQ(2, upstream.numAllocs());
+    }
+    // the destructor releases the blocks
+    ASSERT_EQ(2, upstream.numDeallocs());
+}
+
+TEST(MemoryResourceTest, monotonicBufferResourceExhausted)
+{
+    alignas(8) unsigned char buffer[16];
+    TestResource defaultResource(1);
+    auto origRes = zserio::pmr::setDefaultResource(&defaultResource);
+
+    // without the upstream resource, the default resource is used when the buffer is exhausted
+    zserio::pmr::MonotonicBufferResource bufferOnlyRes(buffer, sizeof(buffer), nullptr);
+    ASSERT_EQ(nullptr, bufferOnlyRes.getUpstreamResource());
+    ASSERT_EQ(buffer, bufferOnlyRes.allocate(16, 8));
+    ASSERT_FALSE(bufferOnlyRes.isExhausted());
+    ASSERT_NE(nullptr, bufferOnlyRes.allocate(16, 8));
+    ASSERT_TRUE(bufferOnlyRes.isExhausted());
+    ASSERT_EQ(1, defaultResource.numAllocs());
+    bufferOnlyRes.release();
+    ASSERT_FALSE(bufferOnlyRes.isExhausted());
+    ASSERT_EQ(1, defaultResource.numDeallocs());
+
+    // the default resource is used when the upstream resource fails
+    NullResource nullUpstream;
+    zserio::pmr::MonotonicBufferResource failingUpstreamRes(&nullUpstream);
+    ASSERT_NE(nullptr, failingUpstreamRes.allocate(32, 8));
+    ASSERT_TRUE(failingUpstreamRes.isExhausted());
+    ASSERT_EQ(2, defaultResource.numAllocs());
+    failingUpstreamRes.release();
+    ASSERT_EQ(2, defaultResource.numDeallocs());
+
+    // null pointer is returned only when the default resource fails as well
+    zserio::pmr::setDefaultResource(&nullUpstream);
+    zserio::pmr::MonotonicBufferResource exhaustedRes(&nullUpstream);
+    ASSERT_EQ(nullptr, exhaustedRes.allocate(32, 8));
+    ASSERT_TRUE(exhaustedRes.isExhausted());
+
+    zserio::pmr::setDefaultResource(origRes);
+}
+
 } // namespace zserio
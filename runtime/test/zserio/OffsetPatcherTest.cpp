@@ -0,0 +1,123 @@
+#include <array>
+
+#include "gtest/gtest.h"
+#include "zserio/BitStreamReader.h"
+#include "zserio/OffsetPatcher.h"
+
+namespace zserio
+{
+
+TEST(OffsetPatcherTest, resolve)
+{
+    std::array<uint8_t, 8> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    OffsetPatcher patcher;
+    const int owner = 0;
+    const int otherOwner = 0;
+
+    // offset fields are identified by both the owner and the name
+    ASSERT_TRUE(writer.writeBits(0, 8).isSuccess());
+    ASSERT_TRUE(patcher.addSlot(&owner, "offset", 0, 8).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0, 8).isSuccess());
+    ASSERT_TRUE(patcher.addSlot(&otherOwner, "offset", 8, 8).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0xFF, 8).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&otherOwner, "offset", 0, 2).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&owner, "offset", 0, 3).isSuccess());
+
+    ASSERT_TRUE(patcher.apply(writer).isSuccess());
+    writer.flush();
+    ASSERT_EQ(3, data[0]);
+    ASSERT_EQ(2, data[1]);
+    ASSERT_EQ(0xFF, data[2]);
+}
+
+TEST(OffsetPatcherTest, resolveWithoutSlot)
+{
+    std::array<uint8_t, 8> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    OffsetPatcher patcher;
+    const int owner = 0;
+
+    ASSERT_EQ(ErrorCode::InvalidOffset, patcher.resolve(&owner, "offset", 0, 1).getError());
+
+    // the first error is kept even if the following offsets are resolved
+    ASSERT_TRUE(writer.writeBits(0, 8).isSuccess());
+    ASSERT_TRUE(patcher.addSlot(&owner, "offset", 0, 8).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&owner, "offset", 0, 1).isSuccess());
+    ASSERT_EQ(ErrorCode::InvalidOffset, patcher.resolve(&owner, "other", 0, 1).getError());
+    ASSERT_EQ(ErrorCode::InvalidOffset, patcher.apply(writer).getError());
+    writer.flush();
+    ASSERT_EQ(0, data[0]);
+
+    patcher.clear();
+    ASSERT_TRUE(patcher.apply(writer).isSuccess());
+    ASSERT_EQ(ErrorCode::InvalidOffset, patcher.resolve(&owner, "offset", 0, 1).getError());
+}
+
+TEST(OffsetPatcherTest, applyOutOfRange)
+{
+    std::array<uint8_t, 8> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    OffsetPatcher patcher;
+    const int owner = 0;
+
+    ASSERT_TRUE(writer.writeBits(0, 4).isSuccess());
+    ASSERT_TRUE(patcher.addSlot(&owner, "offset", 0, 4).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&owner, "offset", 0, 15).isSuccess());
+    ASSERT_TRUE(patcher.apply(writer).isSuccess());
+
+    ASSERT_TRUE(patcher.resolve(&owner, "offset", 0, 16).isSuccess());
+    ASSERT_EQ(ErrorCode::OutOfRange, patcher.apply(writer).getError());
+}
+
+TEST(OffsetPatcherTest, applyArray)
+{
+    std::array<uint8_t, 8> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    OffsetPatcher patcher;
+    const int owner = 0;
+
+    // elements of an array of offsets follow each other
+    ASSERT_TRUE(writer.writeBits(0x5, 3).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0, 12).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0, 12).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0, 12).isSuccess());
+    ASSERT_TRUE(patcher.addSlot(&owner, "offsets", 3, 12).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x3, 2).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&owner, "offsets", 2, 0xCCC).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&owner, "offsets", 0, 0xAAA).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&owner, "offsets", 1, 0xBBB).isSuccess());
+    ASSERT_TRUE(patcher.apply(writer).isSuccess());
+    writer.flush();
+
+    BitStreamReader reader(data.data(), data.size());
+    ASSERT_EQ(0x5, reader.readBits(3).getValue());
+    ASSERT_EQ(0xAAA, reader.readBits(12).getValue());
+    ASSERT_EQ(0xBBB, reader.readBits(12).getValue());
+    ASSERT_EQ(0xCCC, reader.readBits(12).getValue());
+    ASSERT_EQ(0x3, reader.readBits(2).getValue());
+}
+
+TEST(OffsetPatcherTest, applyKeepsBitPosition)
+{
+    std::array<uint8_t, 8> data = {};
+    BitStreamWriter writer(data.data(), data.size());
+    OffsetPatcher patcher;
+    const int owner = 0;
+
+    ASSERT_TRUE(writer.writeBits(0, 16).isSuccess());
+    ASSERT_TRUE(patcher.addSlot(&owner, "offset", 0, 16).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x1, 5).isSuccess());
+    ASSERT_TRUE(patcher.resolve(&owner, "offset", 0, 0x1234).isSuccess());
+    ASSERT_TRUE(patcher.apply(writer).isSuccess());
+
+    // writing continues behind the last written bits
+    ASSERT_EQ(21, writer.getBitPosition());
+    ASSERT_TRUE(writer.writeBits(0x7, 3).isSuccess());
+    writer.flush();
+    ASSERT_EQ(0x12, data[0]);
+    ASSERT_EQ(0x34, data[1]);
+    ASSERT_EQ(0x0F, data[2]);
+}
+
+} // namespace zserio
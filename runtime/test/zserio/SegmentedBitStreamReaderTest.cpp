@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/BitStreamWriter.h"
+#include "zserio/SegmentedBitStreamReader.h"
+#include "zserio/SerializeUtil.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+const std::vector<uint8_t> BYTES_VALUE = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A};
+const std::string STRING_VALUE = "string which spans more segments";
+const size_t ARRAY_SIZE = 40;
+
+std::vector<uint32_t> createBitsArray()
+{
+    std::vector<uint32_t> values;
+    for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    {
+        values.push_back(static_cast<uint32_t>((i * 37) & 0x7FF));
+    }
+    return values;
+}
+
+std::vector<uint32_t> createVarUInt32Array()
+{
+    std::vector<uint32_t> values;
+    for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    {
+        values.push_back(static_cast<uint32_t>(i * i * i * 101));
+    }
+    return values;
+}
+
+// writes all kinds of values, unaligned values are mixed with aligned ones
+std::vector<uint8_t> writeValues(size_t& bitSize)
+{
+    std::vector<uint8_t> data(1024);
+    BitStreamWriter writer(data.data(), data.size());
+    EXPECT_TRUE(writer.writeBits(0x15, 5).isSuccess());
+    EXPECT_TRUE(writer.writeBits64(0x123456789ABCDEF0ULL, 64).isSuccess());
+    EXPECT_TRUE(writer.writeVarUInt64(0xFEDCBA9876ULL).isSuccess());
+    EXPECT_TRUE(writer.writeVarInt32(-1000000).isSuccess());
+    EXPECT_TRUE(writer.writeBytes(Span<const uint8_t>(BYTES_VALUE)).isSuccess());
+    EXPECT_TRUE(writer.writeString(StringView(STRING_VALUE)).isSuccess());
+    const std::vector<uint32_t> bitsArray = createBitsArray();
+    EXPECT_TRUE(writer.writeBitsArray(Span<const uint32_t>(bitsArray), 11).isSuccess());
+    const std::vector<uint32_t> varUInt32Array = createVarUInt32Array();
+    for (uint32_t value : varUInt32Array)
+    {
+        EXPECT_TRUE(writer.writeVarUInt32(value).isSuccess());
+    }
+    EXPECT_TRUE(writer.alignTo(8).isSuccess());
+    EXPECT_TRUE(writer.writeBytes(Span<const uint8_t>(BYTES_VALUE)).isSuccess());
+    EXPECT_TRUE(writer.writeString(StringView(STRING_VALUE)).isSuccess());
+    EXPECT_TRUE(writer.writeBits(0x3, 2).isSuccess());
+    bitSize = writer.getBitPosition();
+    writer.flush();
+    data.resize((bitSize + 7) / 8);
+    return data;
+}
+
+void readValues(BitStreamReader& reader, size_t bitSize)
+{
+    ASSERT_EQ(0x15, reader.readBits(5).getValue());
+    ASSERT_EQ(0x123456789ABCDEF0ULL, reader.readBits64(64).getValue());
+    ASSERT_EQ(0xFEDCBA9876ULL, reader.readVarUInt64().getValue());
+    ASSERT_EQ(-1000000, reader.readVarInt32().getValue());
+    ASSERT_EQ(BYTES_VALUE, reader.readBytes().getValue());
+    ASSERT_EQ(STRING_VALUE, reader.readString().getValue());
+    std::vector<uint32_t> bitsArray(ARRAY_SIZE);
+    ASSERT_TRUE(reader.readBitsArray(Span<uint32_t>(bitsArray), 11).isSuccess());
+    ASSERT_EQ(createBitsArray(), bitsArray);
+    std::vector<uint32_t> varUInt32Array(ARRAY_SIZE);
+    ASSERT_TRUE(reader.readVarUInt32Array(Span<uint32_t>(varUInt32Array)).isSuccess());
+    ASSERT_EQ(createVarUInt32Array(), varUInt32Array);
+    ASSERT_TRUE(reader.alignTo(8).isSuccess());
+    ASSERT_EQ(BYTES_VALUE, reader.readBytes().getValue());
+    ASSERT_EQ(STRING_VALUE, reader.readString().getValue());
+    ASSERT_EQ(0x3, reader.readBits(2).getValue());
+    ASSERT_EQ(bitSize, reader.getBitPosition());
+    ASSERT_EQ(ErrorCode::EndOfStream, reader.readBits(8).getError());
+}
+
+// splits the data to segments of the given sizes repeatedly, zero sizes give empty segments
+std::vector<Span<const uint8_t>> splitToSegments(
+        const std::vector<uint8_t>& data, const std::vector<size_t>& segmentSizes)
+{
+    std::vector<Span<const uint8_t>> segments;
+    size_t offset = 0;
+    for (size_t i = 0; offset < data.size(); ++i)
+    {
+        const size_t segmentSize = std::min(segmentSizes[i % segmentSizes.size()], data.size() - offset);
+        segments.emplace_back(data.data() + offset, segmentSize);
+        offset += segmentSize;
+    }
+    return segments;
+}
+
+// object holding a bit field, a variable integer and a string
+class SegmentedObject
+{
+public:
+    static Result<SegmentedObject> deserialize(BitStreamReader& reader) noexcept
+    {
+        SegmentedObject object;
+        auto valueResult = reader.readBits(12);
+        if (valueResult.isError())
+        {
+            return Result<SegmentedObject>::error(valueResult.getError());
+        }
+        object.value = static_cast<uint16_t>(valueResult.getValue());
+        auto countResult = reader.readVarUInt64();
+        if (countResult.isError())
+        {
+            return Result<SegmentedObject>::error(countResult.getError());
+        }
+        object.count = countResult.getValue();
+        auto textResult = reader.readString();
+        if (textResult.isError())
+        {
+            return Result<SegmentedObject>::error(textResult.getError());
+        }
+        object.text = textResult.moveValue();
+        return Result<SegmentedObject>::success(std::move(object));
+    }
+
+    Result<void> write(BitStreamWriter& writer) const noexcept
+    {
+        auto result = writer.writeBits(value, 12);
+        if (result.isSuccess())
+        {
+            result = writer.writeVarUInt64(count);
+        }
+        if (result.isSuccess())
+        {
+            result = writer.writeString(StringView(text));
+        }
+        return result;
+    }
+
+    uint16_t value = 0;
+    uint64_t count = 0;
+    std::string text;
+};
+
+} // namespace
+
+TEST(SegmentedBitStreamReaderTest, readSegments)
+{
+    size_t bitSize = 0;
+    const std::vector<uint8_t> data = writeValues(bitSize);
+
+    // segments smaller than the seam are joined with more following segments
+    const std::vector<std::vector<size_t>> segmentSizes = {
+            {data.size()}, {1}, {3}, {7, 0, 2}, {16}, {17, 1}, {64, 5, 0, 0, 9}};
+    for (const std::vector<size_t>& sizes : segmentSizes)
+    {
+        const std::vector<Span<const uint8_t>> segments = splitToSegments(data, sizes);
+        SegmentedBitStreamReader reader{Span<const Span<const uint8_t>>(segments)};
+        ASSERT_EQ(data.size() * 8, reader.getBufferBitSize());
+        readValues(reader, bitSize);
+    }
+}
+
+TEST(SegmentedBitStreamReaderTest, emptySegments)
+{
+    SegmentedBitStreamReader emptyReader{Span<const Span<const uint8_t>>()};
+    ASSERT_EQ(0, emptyReader.getBufferBitSize());
+    ASSERT_EQ(ErrorCode::EndOfStream, emptyReader.readBits(1).getError());
+
+    const std::vector<uint8_t> empty;
+    const std::vector<Span<const uint8_t>> segments(3, Span<const uint8_t>(empty));
+    SegmentedBitStreamReader reader{Span<const Span<const uint8_t>>(segments)};
+    ASSERT_EQ(0, reader.getBufferBitSize());
+    ASSERT_EQ(ErrorCode::EndOfStream, reader.readBits(1).getError());
+}
+
+TEST(SegmentedBitStreamReaderTest, setBitPosition)
+{
+    size_t bitSize = 0;
+    const std::vector<uint8_t> data = writeValues(bitSize);
+    const std::vector<Span<const uint8_t>> segments = splitToSegments(data, {5, 3});
+    SegmentedBitStreamReader reader{Span<const Span<const uint8_t>>(segments)};
+
+    readValues(reader, bitSize);
+
+    // back to the beginning over all segments
+    ASSERT_TRUE(reader.setBitPosition(0).isSuccess());
+    readValues(reader, bitSize);
+
+    // back into the middle of a value which crosses a segment boundary
+    ASSERT_TRUE(reader.setBitPosition(5).isSuccess());
+    ASSERT_EQ(0x123456789ABCDEF0ULL, reader.readBits64(64).getValue());
+    ASSERT_TRUE(reader.setBitPosition(37).isSuccess());
+    ASSERT_EQ(0x9ABCDEF0U, reader.readBits(32).getValue());
+    ASSERT_TRUE(reader.setBitPosition(5 + 4).isSuccess());
+    ASSERT_EQ(0x23456789U, reader.readBits(32).getValue());
+
+    ASSERT_TRUE(reader.setBitPosition(data.size() * 8).isSuccess());
+    ASSERT_EQ(ErrorCode::InvalidBitPosition, reader.setBitPosition(data.size() * 8 + 1).getError());
+}
+
+TEST(SegmentedBitStreamReaderTest, readViews)
+{
+    std::vector<uint8_t> data(64);
+    BitStreamWriter writer(data.data(), data.size());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(BYTES_VALUE)).isSuccess());
+    ASSERT_TRUE(writer.writeString(StringView("text")).isSuccess());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(BYTES_VALUE)).isSuccess());
+    ASSERT_TRUE(writer.writeString(StringView("text")).isSuccess());
+    writer.flush();
+    data.resize(writer.getBitPosition() / 8);
+
+    // first bytes and the first string lie in the first segment, the others cross the segment boundary
+    const std::vector<Span<const uint8_t>> segments = {
+            Span<const uint8_t>(data.data(), 20), Span<const uint8_t>(data.data() + 20, data.size() - 20)};
+    SegmentedBitStreamReader reader{Span<const Span<const uint8_t>>(segments)};
+
+    const auto bytesResult = reader.readBytesView();
+    ASSERT_TRUE(bytesResult.isSuccess());
+    ASSERT_EQ(data.data() + 1, bytesResult.getValue().data());
+    ASSERT_EQ(BYTES_VALUE.size(), bytesResult.getValue().size());
+    const auto stringResult = reader.readStringView();
+    ASSERT_TRUE(stringResult.isSuccess());
+    ASSERT_EQ(StringView("text"), stringResult.getValue());
+
+    // the reader stays at the value which cannot be viewed
+    const size_t bitPosition = reader.getBitPosition();
+    ASSERT_EQ(ErrorCode::InvalidPointer, reader.readBytesView().getError());
+    ASSERT_EQ(bitPosition, reader.getBitPosition());
+    ASSERT_EQ(BYTES_VALUE, reader.readBytes().getValue());
+
+    // the string is within the second segment
+    const auto secondStringResult = reader.readStringView();
+    ASSERT_TRUE(secondStringResult.isSuccess());
+    ASSERT_EQ(StringView("text"), secondStringResult.getValue());
+
+    // a string crossing the boundary cannot be viewed
+    const std::vector<Span<const uint8_t>> stringSegments = {
+            Span<const uint8_t>(data.data(), 14), Span<const uint8_t>(data.data() + 14, data.size() - 14)};
+    SegmentedBitStreamReader stringReader{Span<const Span<const uint8_t>>(stringSegments)};
+    ASSERT_TRUE(stringReader.readBytesView().isSuccess());
+    ASSERT_EQ(ErrorCode::InvalidPointer, stringReader.readStringView().getError());
+    ASSERT_EQ("text", stringReader.readString().getValue());
+}
+
+TEST(SegmentedBitStreamReaderTest, fork)
+{
+    const std::vector<uint8_t> data = {0x01, 0x02, 0x03};
+    const std::vector<Span<const uint8_t>> segments = {Span<const uint8_t>(data)};
+    SegmentedBitStreamReader reader{Span<const Span<const uint8_t>>(segments)};
+    ASSERT_EQ(ErrorCode::InvalidOperation, reader.fork(0).getError());
+}
+
+TEST(SegmentedBitStreamReaderTest, moveBase)
+{
+    const std::vector<uint8_t> data = {0x01, 0x02, 0x03};
+    const std::vector<Span<const uint8_t>> segments = {Span<const uint8_t>(data)};
+    SegmentedBitStreamReader reader{Span<const Span<const uint8_t>>(segments)};
+    ASSERT_EQ(0x01, reader.readBits(8).getValue());
+
+    // window state stays with the segmented reader, the moved base cannot read
+    BitStreamReader movedReader(std::move(static_cast<BitStreamReader&>(reader)));
+    ASSERT_EQ(0, movedReader.getBufferBitSize());
+    ASSERT_EQ(0, movedReader.getBitPosition());
+    ASSERT_EQ(ErrorCode::InvalidOperation, movedReader.readBits(1).getError());
+    ASSERT_EQ(ErrorCode::InvalidOperation, movedReader.readBytes().getError());
+}
+
+TEST(SegmentedBitStreamReaderTest, deserializeFromSegments)
+{
+    SegmentedObject object;
+    object.value = 0xABC;
+    object.count = 0x123456789ULL;
+    object.text = "text of the segmented object";
+
+    std::vector<uint8_t> data(64);
+    BitStreamWriter writer(data.data(), data.size());
+    ASSERT_TRUE(object.write(writer).isSuccess());
+    writer.flush();
+    data.resize((writer.getBitPosition() + 7) / 8);
+
+    const std::vector<Span<const uint8_t>> segments = splitToSegments(data, {2, 0, 5});
+    const auto readResult = deserializeFromSegments<SegmentedObject>(Span<const Span<const uint8_t>>(segments));
+    ASSERT_TRUE(readResult.isSuccess());
+    const SegmentedObject& readObject = readResult.getValue();
+    ASSERT_EQ(object.value, readObject.value);
+    ASSERT_EQ(object.count, readObject.count);
+    ASSERT_EQ(object.text, readObject.text);
+
+    // truncated segments
+    const std::vector<Span<const uint8_t>> truncatedSegments = {
+            Span<const uint8_t>(data.data(), 2), Span<const uint8_t>(data.data() + 2, data.size() - 3)};
+    ASSERT_EQ(ErrorCode::EndOfStream,
+            deserializeFromSegments<SegmentedObject>(Span<const Span<const uint8_t>>(truncatedSegments))
+                    .getError());
+}
+
+} // namespace zserio
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/BitStreamReader.h"
+#include "zserio/IPubsub.h"
+#include "zserio/SegmentedBitStreamWriter.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+std::vector<uint8_t> joinSegments(Span<const Span<const uint8_t>> segments)
+{
+    std::vector<uint8_t> data;
+    for (const Span<const uint8_t>& segment : segments)
+    {
+        data.insert(data.end(), segment.begin(), segment.end());
+    }
+    return data;
+}
+
+// writes a bit field, an aligned payload, a string and an unaligned payload
+template <typename WRITER>
+void writeMessage(WRITER& writer, const std::vector<uint8_t>& payload, const std::string& text)
+{
+    ASSERT_TRUE(writer.writeBits(0x15, 5).isSuccess());
+    ASSERT_TRUE(writer.alignTo(8).isSuccess());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(payload)).isSuccess());
+    ASSERT_TRUE(writer.writeString(StringView(text)).isSuccess());
+    ASSERT_TRUE(writer.writeBits(1, 3).isSuccess());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(payload)).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0x7, 3).isSuccess());
+}
+
+std::vector<uint8_t> writeExpectedMessage(const std::vector<uint8_t>& payload, const std::string& text)
+{
+    std::vector<uint8_t> data(2 * payload.size() + text.size() + 32);
+    BitStreamWriter writer(data.data(), data.size());
+    writeMessage(writer, payload, text);
+    writer.flush();
+    data.resize((writer.getBitPosition() + 7) / 8);
+    return data;
+}
+
+class TestPubsub : public IPubsub
+{
+public:
+    Result<void> publish(StringView topic, Span<const uint8_t> data, void*) noexcept override
+    {
+        m_topic = std::string(topic.data(), topic.size());
+        m_data.assign(data.begin(), data.end());
+        return Result<void>::success();
+    }
+
+    Result<SubscriptionId> subscribe(StringView, const std::shared_ptr<OnTopicCallback>&, void*) noexcept override
+    {
+        return Result<SubscriptionId>::error(ErrorCode::InvalidOperation);
+    }
+
+    Result<void> unsubscribe(SubscriptionId) noexcept override
+    {
+        return Result<void>::error(ErrorCode::InvalidOperation);
+    }
+
+    const std::string& getTopic() const
+    {
+        return m_topic;
+    }
+
+    const std::vector<uint8_t>& getData() const
+    {
+        return m_data;
+    }
+
+private:
+    std::string m_topic;
+    std::vector<uint8_t> m_data;
+};
+
+} // namespace
+
+TEST(SegmentedBitStreamWriterTest, emptyWriter)
+{
+    SegmentedBitStreamWriter writer;
+    ASSERT_EQ(0, writer.getBitPosition());
+    ASSERT_TRUE(writer.getSegments().empty());
+}
+
+TEST(SegmentedBitStreamWriterTest, copySmallPayloads)
+{
+    const std::vector<uint8_t> payload(100, 0xAB);
+    const std::string text = "small text";
+    SegmentedBitStreamWriter writer;
+    writeMessage(writer, payload, text);
+
+    const Span<const Span<const uint8_t>> segments = writer.getSegments();
+    ASSERT_EQ(1, segments.size());
+    ASSERT_EQ(writeExpectedMessage(payload, text), joinSegments(segments));
+}
+
+TEST(SegmentedBitStreamWriterTest, referenceLargePayloads)
+{
+    std::vector<uint8_t> payload(10000);
+    for (size_t i = 0; i < payload.size(); ++i)
+    {
+        payload[i] = static_cast<uint8_t>(i * 7);
+    }
+    const std::string text(5000, 'x');
+    SegmentedBitStreamWriter writer;
+    writeMessage(writer, payload, text);
+    const size_t bitPosition = writer.getBitPosition();
+
+    // the unaligned payload is copied into the last owned segment
+    const Span<const Span<const uint8_t>> segments = writer.getSegments();
+    ASSERT_EQ(5, segments.size());
+    ASSERT_EQ(payload.data(), segments[1].data());
+    ASSERT_EQ(payload.size(), segments[1].size());
+    ASSERT_EQ(reinterpret_cast<const uint8_t*>(text.data()), segments[3].data());
+    ASSERT_EQ(text.size(), segments[3].size());
+
+    const std::vector<uint8_t> data = joinSegments(segments);
+    ASSERT_EQ(writeExpectedMessage(payload, text), data);
+    ASSERT_EQ((bitPosition + 7) / 8, data.size());
+
+    BitStreamReader reader(data.data(), bitPosition, BitsTag());
+    ASSERT_EQ(0x15, reader.readBits(5).getValue());
+    ASSERT_TRUE(reader.alignTo(8).isSuccess());
+    const auto readPayload = reader.readBytes();
+    ASSERT_TRUE(readPayload.isSuccess());
+    ASSERT_EQ(payload.size(), readPayload.getValue().size());
+    ASSERT_TRUE(std::equal(payload.begin(), payload.end(), readPayload.getValue().begin()));
+}
+
+TEST(SegmentedBitStreamWriterTest, minReferenceByteSize)
+{
+    const std::vector<uint8_t> payload(64, 0xCD);
+    const std::string text = "text";
+    SegmentedBitStreamWriter writer(64);
+    writeMessage(writer, payload, text);
+
+    // the text is below the threshold
+    const Span<const Span<const uint8_t>> segments = writer.getSegments();
+    ASSERT_EQ(3, segments.size());
+    ASSERT_EQ(payload.data(), segments[1].data());
+    ASSERT_EQ(writeExpectedMessage(payload, text), joinSegments(segments));
+}
+
+TEST(SegmentedBitStreamWriterTest, setBitPosition)
+{
+    const std::vector<uint8_t> payload(16, 0xEF);
+    SegmentedBitStreamWriter writer(16);
+    ASSERT_TRUE(writer.writeBits(0xFF, 8).isSuccess());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(payload)).isSuccess());
+    const size_t payloadEnd = writer.getBitPosition();
+    ASSERT_TRUE(writer.writeBits(0, 16).isSuccess());
+
+    // bits of the referenced payload and before it cannot be rewritten
+    ASSERT_EQ(ErrorCode::InvalidParameter, writer.setBitPosition(payloadEnd - 1).getError());
+    ASSERT_EQ(ErrorCode::InvalidParameter, writer.setBitPosition(0).getError());
+    ASSERT_TRUE(writer.setBitPosition(payloadEnd + 4).isSuccess());
+    ASSERT_TRUE(writer.writeBits(0xA, 4).isSuccess());
+    ASSERT_TRUE(writer.setBitPosition(payloadEnd + 16).isSuccess());
+
+    const Span<const Span<const uint8_t>> segments = writer.getSegments();
+    ASSERT_EQ(3, segments.size());
+    ASSERT_EQ(2, segments[2].size());
+    ASSERT_EQ(0x0A, segments[2][0]);
+    ASSERT_EQ(0x00, segments[2][1]);
+}
+
+TEST(SegmentedBitStreamWriterTest, clear)
+{
+    const std::vector<uint8_t> payload(10000, 0x11);
+    const std::string text(5000, 'y');
+    SegmentedBitStreamWriter writer;
+    writeMessage(writer, payload, text);
+    ASSERT_FALSE(writer.getSegments().empty());
+
+    writer.clear();
+    ASSERT_EQ(0, writer.getBitPosition());
+    ASSERT_TRUE(writer.getSegments().empty());
+
+    writeMessage(writer, payload, text);
+    ASSERT_EQ(writeExpectedMessage(payload, text), joinSegments(writer.getSegments()));
+}
+
+TEST(SegmentedBitStreamWriterTest, publishSegments)
+{
+    const std::vector<uint8_t> payload(10000, 0x22);
+    const std::string text(5000, 'z');
+    SegmentedBitStreamWriter writer;
+    writeMessage(writer, payload, text);
+
+    // the default implementation publishes the coalesced segments
+    TestPubsub pubsub;
+    ASSERT_TRUE(pubsub.publishSegments(StringView("topic"), writer.getSegments(), nullptr).isSuccess());
+    ASSERT_EQ("topic", pubsub.getTopic());
+    ASSERT_EQ(writeExpectedMessage(payload, text), pubsub.getData());
+}
+
+} // namespace zserio
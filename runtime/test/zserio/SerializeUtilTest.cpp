@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <array>
+#include <cstdio>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "test_object/polymorphic_allocator/SerializeEnum.h"
@@ -9,11 +12,168 @@
 #include "test_object/std_allocator/SerializeObject.h"
 #include "zserio/Enums.h"
 #include "zserio/SerializeUtil.h"
+#include "zserio/ThreadPoolExecutor.h"
 #include "zserio/pmr/PolymorphicAllocator.h"
 
 namespace zserio
 {
 
+namespace
+{
+
+// object whose write fails after the given number of bytes
+class FailingWriteObject
+{
+public:
+    explicit FailingWriteObject(size_t numBytes) noexcept :
+            m_numBytes(numBytes)
+    {}
+
+    Result<size_t> initializeOffsets() const noexcept
+    {
+        return Result<size_t>::success(m_numBytes * 8);
+    }
+
+    Result<void> write(BitStreamWriter& writer) const noexcept
+    {
+        for (size_t i = 0; i < m_numBytes; ++i)
+        {
+            auto result = writer.writeBits(0xAB, 8);
+            if (result.isError())
+            {
+                return result;
+            }
+        }
+
+        return Result<void>::error(ErrorCode::OutOfRange);
+    }
+
+private:
+    size_t m_numBytes;
+};
+
+// allocator which knows the worker it has been created for
+template <typename T>
+class WorkerAllocator
+{
+public:
+    using value_type = T;
+
+    explicit WorkerAllocator(size_t workerIndex) noexcept :
+            m_workerIndex(workerIndex)
+    {}
+
+    template <typename U>
+    WorkerAllocator(const WorkerAllocator<U>& other) noexcept :
+            m_workerIndex(other.getWorkerIndex())
+    {}
+
+    T* allocate(size_t numElements)
+    {
+        return std::allocator<T>().allocate(numElements);
+    }
+
+    void deallocate(T* pointer, size_t numElements) noexcept
+    {
+        std::allocator<T>().deallocate(pointer, numElements);
+    }
+
+    size_t getWorkerIndex() const noexcept
+    {
+        return m_workerIndex;
+    }
+
+private:
+    size_t m_workerIndex;
+};
+
+template <typename T, typename U>
+bool operator==(const WorkerAllocator<T>& lhs, const WorkerAllocator<U>& rhs)
+{
+    return lhs.getWorkerIndex() == rhs.getWorkerIndex();
+}
+
+template <typename T, typename U>
+bool operator!=(const WorkerAllocator<T>& lhs, const WorkerAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// object holding a 16-bit value increased by the parameter and the worker which has read it
+class BatchObject
+{
+public:
+    using allocator_type = WorkerAllocator<uint8_t>;
+
+    static Result<BatchObject> deserialize(
+            BitStreamReader& reader, uint32_t param, const allocator_type& allocator) noexcept
+    {
+        auto valueResult = reader.readBits(16);
+        if (valueResult.isError())
+        {
+            return Result<BatchObject>::error(valueResult.getError());
+        }
+
+        BatchObject object;
+        object.value = valueResult.getValue() + param;
+        object.workerIndex = allocator.getWorkerIndex();
+        return Result<BatchObject>::success(object);
+    }
+
+    uint32_t value = 0;
+    size_t workerIndex = 0;
+};
+
+const size_t BATCH_NUM_BUFFERS = 100;
+
+// every tenth buffer is too short
+std::vector<std::vector<uint8_t>> createBatchBuffers()
+{
+    std::vector<std::vector<uint8_t>> buffers;
+    for (size_t index = 0; index < BATCH_NUM_BUFFERS; ++index)
+    {
+        std::vector<uint8_t> buffer = {static_cast<uint8_t>(index >> 8U), static_cast<uint8_t>(index)};
+        if (index % 10 == 9)
+        {
+            buffer.pop_back();
+        }
+        buffers.push_back(buffer);
+    }
+    return buffers;
+}
+
+// checks the results and returns the number of the workers which have read the objects
+template <typename RESULTS>
+size_t checkBatchResults(const RESULTS& results, uint32_t param, size_t concurrency)
+{
+    EXPECT_EQ(BATCH_NUM_BUFFERS, results.size());
+    EXPECT_EQ(0U, results.get_allocator().getWorkerIndex());
+    std::vector<bool> workers(concurrency);
+    for (size_t index = 0; index < results.size(); ++index)
+    {
+        if (index % 10 == 9)
+        {
+            EXPECT_EQ(ErrorCode::EndOfStream, results[index].getError()) << index;
+            continue;
+        }
+
+        EXPECT_TRUE(results[index].isSuccess()) << index;
+        if (results[index].isSuccess())
+        {
+            const BatchObject& object = results[index].getValue();
+            EXPECT_EQ(index + param, object.value) << index;
+            EXPECT_GT(concurrency, object.workerIndex) << index;
+            if (object.workerIndex < concurrency)
+            {
+                workers[object.workerIndex] = true;
+            }
+        }
+    }
+    return static_cast<size_t>(std::count(workers.begin(), workers.end(), true));
+}
+
+} // namespace
+
 TEST(SerializeUtilTest, serializeEnum)
 {
     // without allocator
@@ -561,4 +721,91 @@ TEST(SerializeUtilTest, serializeToFileFromFile)
     }
 }
 
+TEST(SerializeUtilTest, serializeToFileError)
+{
+    const std::string fileName = "SerializationErrorTest.bin";
+    const std::array<uint8_t, 3> oldData = {0x01, 0x02, 0x03};
+    ASSERT_TRUE(writeBufferToFile(oldData.data(), oldData.size(), fileName).isSuccess());
+
+    // file of another writer with a fixed temporary name is not touched
+    const std::string otherTempFileName = fileName + ".tmp";
+    const std::array<uint8_t, 1> otherData = {0xAB};
+    ASSERT_TRUE(writeBufferToFile(otherData.data(), otherData.size(), otherTempFileName).isSuccess());
+
+    // more bytes than the streaming buffer holds, thus some of them have already been flushed
+    FailingWriteObject failingObject(100000);
+    ASSERT_EQ(ErrorCode::OutOfRange, serializeToFile(failingObject, fileName).getError());
+
+    const auto readResult = readBufferFromFile(fileName);
+    ASSERT_TRUE(readResult.isSuccess());
+    ASSERT_EQ(oldData.size(), readResult.getValue().getByteSize());
+    ASSERT_TRUE(std::equal(oldData.begin(), oldData.end(), readResult.getValue().getBuffer()));
+
+    const auto otherReadResult = readBufferFromFile(otherTempFileName);
+    ASSERT_TRUE(otherReadResult.isSuccess());
+    ASSERT_EQ(otherData.size(), otherReadResult.getValue().getByteSize());
+    ASSERT_EQ(0xAB, otherReadResult.getValue().getBuffer()[0]);
+
+    // the file cannot be opened in a missing directory
+    ASSERT_EQ(ErrorCode::FileOpenFailed, serializeToFile(failingObject, "missing/" + fileName).getError());
+
+    ASSERT_EQ(0, std::remove(otherTempFileName.c_str()));
+    ASSERT_EQ(0, std::remove(fileName.c_str()));
+}
+
+TEST(SerializeUtilTest, deserializeBatch)
+{
+    const std::vector<std::vector<uint8_t>> buffers = createBatchBuffers();
+    std::vector<Span<const uint8_t>> bufferSpans(buffers.begin(), buffers.end());
+    auto allocatorFactory = [](size_t workerIndex) {
+        return WorkerAllocator<uint8_t>(workerIndex);
+    };
+    const uint32_t param = 1000;
+
+    ThreadPoolExecutor executor(3);
+    const auto results = deserializeBatch<BatchObject>(
+            Span<const Span<const uint8_t>>(bufferSpans), executor, allocatorFactory, param);
+    ASSERT_LE(1U, checkBatchResults(results, param, executor.getConcurrency()));
+
+    const auto emptyResults =
+            deserializeBatch<BatchObject>(Span<const Span<const uint8_t>>(), executor, allocatorFactory, param);
+    ASSERT_TRUE(emptyResults.empty());
+}
+
+TEST(SerializeUtilTest, deserializeBatchNested)
+{
+    const std::vector<std::vector<uint8_t>> buffers = createBatchBuffers();
+    std::vector<Span<const uint8_t>> bufferSpans(buffers.begin(), buffers.end());
+    auto allocatorFactory = [](size_t workerIndex) {
+        return WorkerAllocator<uint8_t>(workerIndex);
+    };
+
+    // batches deserialized by tasks of the same executor are read by the worker of the task
+    ThreadPoolExecutor executor(3);
+    const size_t numBatches = 8;
+    std::vector<size_t> numBatchWorkers(numBatches);
+    std::vector<size_t> taskWorkerIndices(numBatches);
+    auto deserializeBatchTask = [&](size_t batchIndex, size_t workerIndex) {
+        const auto results = deserializeBatch<BatchObject>(Span<const Span<const uint8_t>>(bufferSpans),
+                executor, allocatorFactory, static_cast<uint32_t>(batchIndex));
+        numBatchWorkers[batchIndex] =
+                checkBatchResults(results, static_cast<uint32_t>(batchIndex), executor.getConcurrency());
+        taskWorkerIndices[batchIndex] = workerIndex;
+        for (const auto& result : results)
+        {
+            if (result.isSuccess() && result.getValue().workerIndex != workerIndex)
+            {
+                taskWorkerIndices[batchIndex] = executor.getConcurrency();
+            }
+        }
+    };
+    runWorkerTasks(executor, numBatches, deserializeBatchTask);
+
+    for (size_t batchIndex = 0; batchIndex < numBatches; ++batchIndex)
+    {
+        ASSERT_EQ(1U, numBatchWorkers[batchIndex]) << batchIndex;
+        ASSERT_GT(executor.getConcurrency(), taskWorkerIndices[batchIndex]) << batchIndex;
+    }
+}
+
 } // namespace zserio
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/StreamingBitStreamReader.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+class TestByteSource : public IByteSource
+{
+public:
+    TestByteSource(size_t byteSize, size_t maxReadByteSize, bool isSizeKnown) :
+            m_data(byteSize),
+            m_position(0),
+            m_maxReadByteSize(maxReadByteSize),
+            m_isSizeKnown(isSizeKnown)
+    {
+        for (size_t i = 0; i < byteSize; ++i)
+        {
+            m_data[i] = getByte(i);
+        }
+    }
+
+    Result<size_t> read(Span<uint8_t> buffer) noexcept override
+    {
+        const size_t numBytes = std::min({buffer.size(), m_maxReadByteSize, m_data.size() - m_position});
+        std::memcpy(buffer.data(), m_data.data() + m_position, numBytes);
+        m_position += numBytes;
+        return Result<size_t>::success(numBytes);
+    }
+
+    size_t getByteSize() const noexcept override
+    {
+        return m_isSizeKnown ? m_data.size() : UNKNOWN_BYTE_SIZE;
+    }
+
+    static uint8_t getByte(size_t byteIndex)
+    {
+        return static_cast<uint8_t>(byteIndex * 37 + 1);
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+    size_t m_position;
+    size_t m_maxReadByteSize;
+    bool m_isSizeKnown;
+};
+
+} // namespace
+
+TEST(StreamingBitStreamReaderTest, readBits)
+{
+    TestByteSource source(64, 5, true);
+    StreamingBitStreamReader reader(source, 16, 4);
+    ASSERT_EQ(64 * 8, reader.getBufferBitSize());
+
+    for (size_t i = 0; i < 64; ++i)
+    {
+        auto result = reader.readBits(8);
+        ASSERT_TRUE(result.isSuccess()) << i;
+        ASSERT_EQ(TestByteSource::getByte(i), result.getValue()) << i;
+    }
+    ASSERT_EQ(ErrorCode::EndOfStream, reader.readBits(1).getError());
+}
+
+TEST(StreamingBitStreamReaderTest, unknownByteSize)
+{
+    TestByteSource source(10, 3, false);
+    StreamingBitStreamReader reader(source, 4, 2);
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto result = reader.readBits(8);
+        ASSERT_TRUE(result.isSuccess()) << i;
+        ASSERT_EQ(TestByteSource::getByte(i), result.getValue()) << i;
+    }
+    ASSERT_EQ(ErrorCode::EndOfStream, reader.readBits(1).getError());
+}
+
+TEST(StreamingBitStreamReaderTest, setBitPositionBackward)
+{
+    const size_t backwardByteSize = 26;
+    for (size_t readByteSize : {1, 4, 8, 26, 64})
+    {
+        for (size_t endBitPosition = 64; endBitPosition < 2000; endBitPosition += 37)
+        {
+            TestByteSource source(300, 5, true);
+            StreamingBitStreamReader reader(source, backwardByteSize, readByteSize);
+
+            // go back after the first reads, the retained bytes must follow the position afterwards
+            ASSERT_TRUE(reader.setBitPosition(56).isSuccess());
+            ASSERT_TRUE(reader.setBitPosition(2).isSuccess());
+            while (reader.getBitPosition() < endBitPosition)
+            {
+                ASSERT_TRUE(reader.readBits(5).isSuccess());
+            }
+
+            const size_t bitPosition = reader.getBitPosition();
+            const size_t byteIndex = bitPosition / 8 - std::min(bitPosition / 8, backwardByteSize);
+            ASSERT_TRUE(reader.setBitPosition(byteIndex * 8).isSuccess()) << readByteSize << " " << bitPosition;
+            auto result = reader.readBits(8);
+            ASSERT_TRUE(result.isSuccess());
+            ASSERT_EQ(TestByteSource::getByte(byteIndex), result.getValue());
+        }
+    }
+}
+
+TEST(StreamingBitStreamReaderTest, setBitPositionForward)
+{
+    TestByteSource source(1000, 7, true);
+    StreamingBitStreamReader reader(source, 8, 16);
+
+    ASSERT_TRUE(reader.setBitPosition(900 * 8 + 3).isSuccess());
+    auto result = reader.readBits(5);
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_EQ(TestByteSource::getByte(900) & 0x1F, result.getValue());
+
+    ASSERT_EQ(ErrorCode::SeekError, reader.setBitPosition(800 * 8).getError());
+    ASSERT_EQ(ErrorCode::InvalidBitPosition, reader.setBitPosition(1000 * 8 + 1).getError());
+}
+
+TEST(StreamingBitStreamReaderTest, readViews)
+{
+    // the first byte is the length of the following single byte
+    TestByteSource source(64, 5, true);
+    StreamingBitStreamReader reader(source, 16, 4);
+
+    // bytes of the streaming reader are not stable, the reader stays at the value
+    ASSERT_EQ(ErrorCode::InvalidPointer, reader.readBytesView().getError());
+    ASSERT_EQ(0, reader.getBitPosition());
+    ASSERT_EQ(ErrorCode::InvalidPointer, reader.readStringView().getError());
+    ASSERT_EQ(0, reader.getBitPosition());
+
+    const auto bytesResult = reader.readBytes();
+    ASSERT_TRUE(bytesResult.isSuccess());
+    ASSERT_EQ(std::vector<uint8_t>{TestByteSource::getByte(1)}, bytesResult.getValue());
+
+    ASSERT_TRUE(reader.readBits(3).isSuccess());
+    ASSERT_EQ(ErrorCode::InvalidAlignment, reader.readBytesView().getError());
+}
+
+} // namespace zserio
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/StreamingBitStreamWriter.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+class TestByteSink : public IByteSink
+{
+public:
+    Result<void> write(Span<const uint8_t> data) noexcept override
+    {
+        m_data.insert(m_data.end(), data.begin(), data.end());
+        return Result<void>::success();
+    }
+
+    const std::vector<uint8_t>& getData() const
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+// allocator which records the largest allocation
+template <typename T>
+class MaxSizeAllocator
+{
+public:
+    using value_type = T;
+
+    explicit MaxSizeAllocator(size_t& maxByteSize) noexcept :
+            m_maxByteSize(&maxByteSize)
+    {}
+
+    template <typename U>
+    MaxSizeAllocator(const MaxSizeAllocator<U>& other) noexcept :
+            m_maxByteSize(other.getMaxByteSize())
+    {}
+
+    T* allocate(size_t numElements)
+    {
+        *m_maxByteSize = std::max(*m_maxByteSize, numElements * sizeof(T));
+        return std::allocator<T>().allocate(numElements);
+    }
+
+    void deallocate(T* pointer, size_t numElements) noexcept
+    {
+        std::allocator<T>().deallocate(pointer, numElements);
+    }
+
+    size_t* getMaxByteSize() const noexcept
+    {
+        return m_maxByteSize;
+    }
+
+private:
+    size_t* m_maxByteSize;
+};
+
+template <typename T, typename U>
+bool operator==(const MaxSizeAllocator<T>& lhs, const MaxSizeAllocator<U>& rhs)
+{
+    return lhs.getMaxByteSize() == rhs.getMaxByteSize();
+}
+
+template <typename T, typename U>
+bool operator!=(const MaxSizeAllocator<T>& lhs, const MaxSizeAllocator<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace
+
+TEST(StreamingBitStreamWriterTest, writeBits)
+{
+    TestByteSink sink;
+    StreamingBitStreamWriter writer(sink, 8);
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(writer.writeBits(i, 8).isSuccess());
+    }
+    ASSERT_TRUE(writer.writeBits(1, 1).isSuccess());
+    ASSERT_TRUE(writer.finish().isSuccess());
+    ASSERT_EQ(ErrorCode::StreamClosed, writer.writeBits(1, 8).getError());
+    ASSERT_EQ(ErrorCode::StreamClosed, writer.finish().getError());
+
+    ASSERT_EQ(101, sink.getData().size());
+    for (size_t i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(i, sink.getData()[i]) << i;
+    }
+    ASSERT_EQ(0x80, sink.getData()[100]);
+}
+
+TEST(StreamingBitStreamWriterTest, writeLargeArraysInChunks)
+{
+    std::vector<uint8_t> bitsArray(300 * 1024);
+    std::vector<uint8_t> bytes(200 * 1024);
+    for (size_t i = 0; i < bitsArray.size(); ++i)
+    {
+        bitsArray[i] = static_cast<uint8_t>((i * 13) & 0x7F);
+    }
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        bytes[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    // unaligned payloads are written by the writer itself, thus they must not grow the buffer at once
+    size_t maxByteSize = 0;
+    TestByteSink sink;
+    BasicStreamingBitStreamWriter<MaxSizeAllocator<uint8_t>> writer(
+            sink, 64, MaxSizeAllocator<uint8_t>(maxByteSize));
+    ASSERT_TRUE(writer.writeBits(1, 3).isSuccess());
+    ASSERT_TRUE(writer.writeBitsArray(Span<const uint8_t>(bitsArray), 7).isSuccess());
+    ASSERT_TRUE(writer.writeBytes(Span<const uint8_t>(bytes)).isSuccess());
+    ASSERT_TRUE(writer.finish().isSuccess());
+    ASSERT_LE(maxByteSize, 33 * 1024U);
+
+    std::vector<uint8_t> expectedData(bitsArray.size() + bytes.size() + 8);
+    BitStreamWriter expectedWriter(expectedData.data(), expectedData.size());
+    ASSERT_TRUE(expectedWriter.writeBits(1, 3).isSuccess());
+    ASSERT_TRUE(expectedWriter.writeBitsArray(Span<const uint8_t>(bitsArray), 7).isSuccess());
+    ASSERT_TRUE(expectedWriter.writeBytes(Span<const uint8_t>(bytes)).isSuccess());
+    expectedWriter.flush();
+    expectedData.resize((expectedWriter.getBitPosition() + 7) / 8);
+    ASSERT_EQ(expectedData, sink.getData());
+}
+
+} // namespace zserio
@@ -0,0 +1,159 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "zserio/ThreadPoolExecutor.h"
+
+namespace zserio
+{
+
+namespace
+{
+
+// counts runs of each task and detects tasks of the same worker which overlap
+class TaskRecorder
+{
+public:
+    TaskRecorder(size_t numTasks, size_t numWorkers) :
+            m_taskRuns(numTasks),
+            m_busyWorkers(numWorkers)
+    {}
+
+    void runTask(size_t taskIndex, size_t workerIndex)
+    {
+        if (workerIndex >= m_busyWorkers.size())
+        {
+            ++m_numInvalidWorkers;
+            return;
+        }
+
+        if (m_busyWorkers[workerIndex].exchange(true))
+        {
+            ++m_numOverlaps;
+        }
+        ++m_taskRuns[taskIndex];
+        std::this_thread::yield();
+        m_busyWorkers[workerIndex] = false;
+    }
+
+    void check() const
+    {
+        for (size_t taskIndex = 0; taskIndex < m_taskRuns.size(); ++taskIndex)
+        {
+            ASSERT_EQ(1U, m_taskRuns[taskIndex].load()) << taskIndex;
+        }
+        ASSERT_EQ(0U, m_numInvalidWorkers.load());
+        ASSERT_EQ(0U, m_numOverlaps.load());
+    }
+
+private:
+    std::vector<std::atomic<size_t>> m_taskRuns;
+    std::vector<std::atomic<bool>> m_busyWorkers;
+    std::atomic<size_t> m_numInvalidWorkers{0};
+    std::atomic<size_t> m_numOverlaps{0};
+};
+
+} // namespace
+
+TEST(ThreadPoolExecutorTest, getConcurrency)
+{
+    ThreadPoolExecutor executor(3);
+    ASSERT_EQ(4U, executor.getConcurrency());
+
+    ThreadPoolExecutor defaultExecutor;
+    ASSERT_LE(1U, defaultExecutor.getConcurrency());
+}
+
+TEST(ThreadPoolExecutorTest, run)
+{
+    ThreadPoolExecutor executor(3);
+    for (size_t numTasks : {size_t(0), size_t(1), size_t(3), size_t(4), size_t(1000)})
+    {
+        TaskRecorder recorder(numTasks, executor.getConcurrency());
+        auto task = [&recorder](size_t taskIndex, size_t workerIndex) {
+            recorder.runTask(taskIndex, workerIndex);
+        };
+        runWorkerTasks(executor, numTasks, task);
+        recorder.check();
+    }
+}
+
+TEST(ThreadPoolExecutorTest, runInCallingThread)
+{
+    // the calling thread is the worker zero
+    ThreadPoolExecutor executor(3);
+    const std::thread::id callingThreadId = std::this_thread::get_id();
+    std::atomic<size_t> numMismatches{0};
+    auto task = [&](size_t, size_t workerIndex) {
+        if ((workerIndex == 0) != (std::this_thread::get_id() == callingThreadId))
+        {
+            ++numMismatches;
+        }
+    };
+    runWorkerTasks(executor, 1000, task);
+    ASSERT_EQ(0U, numMismatches.load());
+}
+
+TEST(ThreadPoolExecutorTest, nestedRun)
+{
+    ThreadPoolExecutor executor(3);
+    const size_t numTasks = 20;
+    const size_t numNestedTasks = 50;
+    TaskRecorder recorder(numTasks * numNestedTasks, executor.getConcurrency());
+    std::atomic<size_t> numForeignNestedTasks{0};
+
+    // nested tasks run in the thread of the outer task with its worker index
+    auto task = [&](size_t taskIndex, size_t workerIndex) {
+        const std::thread::id threadId = std::this_thread::get_id();
+        auto nestedTask = [&](size_t nestedTaskIndex, size_t nestedWorkerIndex) {
+            if (std::this_thread::get_id() != threadId || nestedWorkerIndex != workerIndex)
+            {
+                ++numForeignNestedTasks;
+            }
+            recorder.runTask(taskIndex * numNestedTasks + nestedTaskIndex, nestedWorkerIndex);
+        };
+        runWorkerTasks(executor, numNestedTasks, nestedTask);
+    };
+    runWorkerTasks(executor, numTasks, task);
+
+    recorder.check();
+    ASSERT_EQ(0U, numForeignNestedTasks.load());
+}
+
+TEST(ThreadPoolExecutorTest, concurrentRuns)
+{
+    // runs from several threads are served one after another
+    ThreadPoolExecutor executor(2);
+    const size_t numThreads = 4;
+    const size_t numTasks = 500;
+    std::vector<std::unique_ptr<TaskRecorder>> recorders;
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        recorders.emplace_back(new TaskRecorder(numTasks, executor.getConcurrency()));
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([&executor, &recorders, i] {
+            TaskRecorder& recorder = *recorders[i];
+            auto task = [&recorder](size_t taskIndex, size_t workerIndex) {
+                recorder.runTask(taskIndex, workerIndex);
+            };
+            runWorkerTasks(executor, numTasks, task);
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& recorder : recorders)
+    {
+        recorder->check();
+    }
+}
+
+} // namespace zserio
@@ -34,6 +34,16 @@ public final class AccessorNameFormatter
         return getAccessorName(READER_NAME_PREFIX, field.getName());
     }
 
+    public static String getCopyRawName(Field field)
+    {
+        return getAccessorName(COPY_RAW_NAME_PREFIX, field.getName());
+    }
+
+    public static String getSkipperName(Field field)
+    {
+        return getAccessorName(SKIPPER_NAME_PREFIX, field.getName());
+    }
+
     public static String getSetterName(Parameter param)
     {
         return getAccessorName(SETTER_NAME_PREFIX, param.getName());
@@ -54,6 +64,11 @@ public final class AccessorNameFormatter
         return getAccessorName(INDICATOR_NAME_PREFIX, field.getName(), IS_PRESENT_INDICATOR_NAME_SUFFIX);
     }
 
+    public static String getIsLoadedIndicatorName(Field field)
+    {
+        return getAccessorName(INDICATOR_NAME_PREFIX, field.getName(), IS_LOADED_INDICATOR_NAME_SUFFIX);
+    }
+
     public static String getResetterName(Field field)
     {
         return getAccessorName(RESETTER_NAME_PREFIX, field.getName());
@@ -94,10 +109,13 @@ public final class AccessorNameFormatter
     private final static String GETTER_NAME_PREFIX = "get";
     private final static String SETTER_NAME_PREFIX = "set";
     private final static String READER_NAME_PREFIX = "read";
+    private final static String COPY_RAW_NAME_PREFIX = "copyRaw";
+    private final static String SKIPPER_NAME_PREFIX = "skip";
     private final static String INDICATOR_NAME_PREFIX = "is";
     private final static String IS_PRESENT_INDICATOR_NAME_SUFFIX = "Present";
     private final static String IS_USED_INDICATOR_NAME_SUFFIX = "Used";
     private final static String IS_SET_INDICATOR_NAME_SUFFIX = "Set";
+    private final static String IS_LOADED_INDICATOR_NAME_SUFFIX = "Loaded";
     private final static String RESETTER_NAME_PREFIX = "reset";
     private final static String FUNCTION_NAME_PREFIX = "func";
     private final static String REMOVED_ENUMERATOR_PREFIX = "ZSERIO_REMOVED_";
@@ -11,9 +11,9 @@ import zserio.extension.common.ZserioExtensionException;
 public final class BitmaskEmitter extends CppDefaultEmitter
 {
     public BitmaskEmitter(OutputFileManager outputFileManager, CppExtensionParameters cppParameters,
-            PackedTypesCollector packedTypesCollector)
+            PackedTypesCollector packedTypesCollector, OffsetFieldsCollector offsetFieldsCollector)
     {
-        super(outputFileManager, cppParameters, packedTypesCollector);
+        super(outputFileManager, cppParameters, packedTypesCollector, offsetFieldsCollector);
     }
 
     @Override
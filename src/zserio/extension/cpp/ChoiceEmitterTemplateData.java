@@ -25,11 +25,14 @@ public final class ChoiceEmitterTemplateData extends CompoundTypeTemplateData
         final ExpressionFormatter cppExpressionFormatter = context.getExpressionFormatter(this);
         final ExpressionFormatter cppObjectIndirectExpressionFormatter =
                 context.getIndirectExpressionFormatter(this, "m_object");
+        final ExpressionFormatter cppOwnerIndirectExpressionFormatter =
+                context.getIndirectExpressionFormatter(this, "owner");
 
         final Expression expression = choiceType.getSelectorExpression();
         selectorExpression = cppExpressionFormatter.formatGetter(expression);
 
         objectIndirectSelectorExpression = cppObjectIndirectExpressionFormatter.formatGetter(expression);
+        ownerIndirectSelectorExpression = cppOwnerIndirectExpressionFormatter.formatGetter(expression);
 
         // TODO[Mi-L@]: Consider using switch also on bitmask (using valueof).
         canUseNativeSwitch = expression.getExprType() != Expression.ExpressionType.BOOLEAN &&
@@ -66,6 +69,11 @@ public final class ChoiceEmitterTemplateData extends CompoundTypeTemplateData
         return objectIndirectSelectorExpression;
     }
 
+    public String getOwnerIndirectSelectorExpression()
+    {
+        return ownerIndirectSelectorExpression;
+    }
+
     public boolean getCanUseNativeSwitch()
     {
         return canUseNativeSwitch;
@@ -140,6 +148,7 @@ public final class ChoiceEmitterTemplateData extends CompoundTypeTemplateData
 
     private final String selectorExpression;
     private final String objectIndirectSelectorExpression;
+    private final String ownerIndirectSelectorExpression;
     private final boolean canUseNativeSwitch;
     private final List<CaseMember> caseMemberList;
     private final DefaultMember defaultMember;
@@ -4,6 +4,7 @@ import java.math.BigInteger;
 import java.util.ArrayList;
 
 import zserio.ast.ArrayInstantiation;
+import zserio.ast.BytesType;
 import zserio.ast.ChoiceType;
 import zserio.ast.CompoundType;
 import zserio.ast.DynamicBitFieldInstantiation;
@@ -12,6 +13,7 @@ import zserio.ast.Field;
 import zserio.ast.IntegerType;
 import zserio.ast.ParameterizedTypeInstantiation;
 import zserio.ast.ParameterizedTypeInstantiation.InstantiatedParameter;
+import zserio.ast.StringType;
 import zserio.ast.TypeInstantiation;
 import zserio.ast.TypeReference;
 import zserio.ast.UnionType;
@@ -34,7 +36,9 @@ public final class CompoundFieldTemplateData
         final ZserioType fieldBaseType = fieldTypeInstantiation.getBaseType();
 
         final CppNativeMapper cppNativeMapper = context.getCppNativeMapper();
-        final CppNativeType fieldNativeType = cppNativeMapper.getCppType(fieldTypeInstantiation);
+        isBufferView = context.getWithBufferViewsCode() &&
+                (fieldBaseType instanceof StringType || fieldBaseType instanceof BytesType);
+        final CppNativeType fieldNativeType = getFieldNativeType(cppNativeMapper, fieldTypeInstantiation);
         includeCollector.addHeaderIncludesForType(fieldNativeType);
 
         optional = (field.isOptional())
@@ -49,6 +53,9 @@ public final class CompoundFieldTemplateData
         getterName = AccessorNameFormatter.getGetterName(field);
         setterName = AccessorNameFormatter.getSetterName(field);
         readerName = AccessorNameFormatter.getReaderName(field);
+        copyRawName = AccessorNameFormatter.getCopyRawName(field);
+        skipperName = AccessorNameFormatter.getSkipperName(field);
+        isLoadedIndicatorName = AccessorNameFormatter.getIsLoadedIndicatorName(field);
 
         isExtended = field.isExtended();
         isPresentIndicatorName = AccessorNameFormatter.getIsPresentIndicatorName(field);
@@ -66,10 +73,12 @@ public final class CompoundFieldTemplateData
 
         constraint = createConstraint(context, field, includeCollector);
         offset = createOffset(context, field, includeCollector);
+        isUsedAsOffset = context.getOffsetFieldsCollector().isUsedAsOffset(field);
         array = createArray(context, fieldNativeType, fieldTypeInstantiation, parentType, includeCollector);
         runtimeFunction =
                 RuntimeFunctionDataCreator.createData(context, fieldTypeInstantiation, includeCollector);
         bitSize = BitSizeTemplateData.create(context, fieldTypeInstantiation, includeCollector);
+        skip = createSkip(context, parentType, field, includeCollector);
         docComments = DocCommentsDataCreator.createData(context, field);
     }
 
@@ -108,6 +117,21 @@ public final class CompoundFieldTemplateData
         return readerName;
     }
 
+    public String getCopyRawName()
+    {
+        return copyRawName;
+    }
+
+    public String getSkipperName()
+    {
+        return skipperName;
+    }
+
+    public String getIsLoadedIndicatorName()
+    {
+        return isLoadedIndicatorName;
+    }
+
     public boolean getIsExtended()
     {
         return isExtended;
@@ -163,11 +187,21 @@ public final class CompoundFieldTemplateData
         return offset;
     }
 
+    public boolean getIsUsedAsOffset()
+    {
+        return isUsedAsOffset;
+    }
+
     public Array getArray()
     {
         return array;
     }
 
+    public boolean getIsBufferView()
+    {
+        return isBufferView;
+    }
+
     public RuntimeFunctionTemplateData getRuntimeFunction()
     {
         return runtimeFunction;
@@ -178,6 +212,11 @@ public final class CompoundFieldTemplateData
         return bitSize;
     }
 
+    public Skip getSkip()
+    {
+        return skip;
+    }
+
     public DocCommentsTemplateData getDocComments()
     {
         return docComments;
@@ -231,6 +270,45 @@ public final class CompoundFieldTemplateData
         private final boolean isRecursive;
     }
 
+    public static final class Skip
+    {
+        public Skip(TemplateDataContext context, CompoundType parentType, Field field,
+                IncludeCollector includeCollector) throws ZserioExtensionException
+        {
+            isOwnerField = context.getSkippableTypesChecker().isSkipOwnerField(parentType, field);
+            final ExpressionFormatter cppOwnerIndirectExpressionFormatter =
+                    context.getIndirectExpressionFormatter(includeCollector, "owner");
+            final Expression optionalClauseExpression = field.getOptionalClauseExpr();
+            optionalClause = (optionalClauseExpression == null)
+                    ? null
+                    : cppOwnerIndirectExpressionFormatter.formatGetter(optionalClauseExpression);
+            final TypeInstantiation fieldTypeInstantiation = field.getTypeInstantiation();
+            arrayLength = (fieldTypeInstantiation instanceof ArrayInstantiation)
+                    ? Array.createLength((ArrayInstantiation)fieldTypeInstantiation,
+                              cppOwnerIndirectExpressionFormatter)
+                    : null;
+        }
+
+        public boolean getIsOwnerField()
+        {
+            return isOwnerField;
+        }
+
+        public String getOptionalClause()
+        {
+            return optionalClause;
+        }
+
+        public String getArrayLength()
+        {
+            return arrayLength;
+        }
+
+        private final boolean isOwnerField;
+        private final String optionalClause;
+        private final String arrayLength;
+    }
+
     public static final class Compound
     {
         public Compound(TemplateDataContext context,
@@ -367,6 +445,36 @@ public final class CompoundFieldTemplateData
             final CppNativeType nativeType = cppNativeMapper.getCppType(offsetExprZserioType);
             typeInfo = new NativeTypeInfoTemplateData(nativeType, offsetExprZserioType);
             containsIndex = offsetExpression.containsIndex();
+
+            // offset field is identified by its owner object and its name during single pass serialization
+            final Expression fieldExpression = OffsetFieldsCollector.getOffsetFieldExpression(offsetExpression);
+            if (fieldExpression == null)
+            {
+                fieldName = null;
+                ownerGetter = null;
+                ownerIndirectGetter = null;
+                indexedFieldGetterName = null;
+            }
+            else
+            {
+                fieldName = OffsetFieldsCollector.getReferencedField(fieldExpression).getName();
+                if (OffsetFieldsCollector.isDot(fieldExpression))
+                {
+                    ownerGetter = cppExpressionFormatter.formatGetter(fieldExpression.op1());
+                    ownerIndirectGetter =
+                            cppOwnerIndirectExpressionFormatter.formatGetter(fieldExpression.op1());
+                }
+                else
+                {
+                    ownerGetter = "*this";
+                    ownerIndirectGetter = "owner";
+                }
+
+                // views access elements of aligned arrays directly when offsets are held in the same compound
+                indexedFieldGetterName = (containsIndex && !OffsetFieldsCollector.isDot(fieldExpression))
+                        ? AccessorNameFormatter.getGetterName(OffsetFieldsCollector.getReferencedField(fieldExpression))
+                        : null;
+            }
         }
 
         public String getGetter()
@@ -399,12 +507,36 @@ public final class CompoundFieldTemplateData
             return containsIndex;
         }
 
+        public String getFieldName()
+        {
+            return fieldName;
+        }
+
+        public String getOwnerGetter()
+        {
+            return ownerGetter;
+        }
+
+        public String getOwnerIndirectGetter()
+        {
+            return ownerIndirectGetter;
+        }
+
+        public String getIndexedFieldGetterName()
+        {
+            return indexedFieldGetterName;
+        }
+
         private final String getter;
         private final String indirectGetter;
         private final String setter;
         private final String indirectSetter;
         private final NativeTypeInfoTemplateData typeInfo;
         private final boolean containsIndex;
+        private final String fieldName;
+        private final String ownerGetter;
+        private final String ownerIndirectGetter;
+        private final String indexedFieldGetterName;
     }
 
     public static final class IntegerRange
@@ -549,6 +681,19 @@ public final class CompoundFieldTemplateData
         private final boolean elementUsedInPackedArray;
     }
 
+    private CppNativeType getFieldNativeType(CppNativeMapper cppNativeMapper,
+            TypeInstantiation fieldTypeInstantiation) throws ZserioExtensionException
+    {
+        if (!isBufferView)
+            return cppNativeMapper.getCppType(fieldTypeInstantiation);
+
+        // views point into the buffer the compound was read from
+        if (fieldTypeInstantiation.getBaseType() instanceof StringType)
+            return cppNativeMapper.getStringViewType();
+        else
+            return cppNativeMapper.getBytesViewType();
+    }
+
     private static Optional createOptional(TemplateDataContext context, Field field, ZserioType baseFieldType,
             CompoundType parentType, IncludeCollector includeCollector) throws ZserioExtensionException
     {
@@ -655,6 +800,15 @@ public final class CompoundFieldTemplateData
         return new Offset(context, offsetExpression, includeCollector);
     }
 
+    private static Skip createSkip(TemplateDataContext context, CompoundType parentType, Field field,
+            IncludeCollector includeCollector) throws ZserioExtensionException
+    {
+        if (!context.getSkippableTypesChecker().isSkippable(parentType))
+            return null;
+
+        return new Skip(context, parentType, field, includeCollector);
+    }
+
     private static Array createArray(TemplateDataContext context, CppNativeType cppNativeType,
             TypeInstantiation typeInstantiation, CompoundType parentType, IncludeCollector includeCollector)
             throws ZserioExtensionException
@@ -697,6 +851,9 @@ public final class CompoundFieldTemplateData
     private final String getterName;
     private final String setterName;
     private final String readerName;
+    private final String copyRawName;
+    private final String skipperName;
+    private final String isLoadedIndicatorName;
     private final boolean isExtended;
     private final String isPresentIndicatorName;
     private final boolean isPackable;
@@ -705,11 +862,14 @@ public final class CompoundFieldTemplateData
     private final String initializer;
     private final boolean usesAnyHolder;
     private final boolean needsAllocator;
+    private final boolean isBufferView;
     private final boolean holderNeedsAllocator;
     private final Constraint constraint;
     private final Offset offset;
+    private final boolean isUsedAsOffset;
     private final Array array;
     private final RuntimeFunctionTemplateData runtimeFunction;
     private final BitSizeTemplateData bitSize;
+    private final Skip skip;
     private final DocCommentsTemplateData docComments;
 }
@@ -5,6 +5,7 @@ import java.util.List;
 
 import zserio.ast.CompoundType;
 import zserio.ast.Field;
+import zserio.ast.StructureType;
 import zserio.extension.common.ZserioExtensionException;
 
 /**
@@ -35,6 +36,11 @@ public class CompoundTypeTemplateData extends UserTypeTemplateData
                 new CompoundConstructorTemplateData(compoundType, compoundParametersData, fieldList);
 
         isPackable = compoundType.isPackable();
+        isSkippable = context.getSkippableTypesChecker().isSkippable(compoundType);
+        // projection read skips the fields which are not selected, the field mask holds up to 64 fields
+        isProjectable = context.getWithProjectionCode() && compoundType instanceof StructureType && isSkippable &&
+                fieldTypeList.size() <= MAX_NUM_PROJECTABLE_FIELDS;
+        isViewable = context.getWithViewCode() && context.getViewableTypesChecker().isViewable(compoundType);
 
         // TODO[Mi-L@] Similar logic is done in freemarker template function (has_field_with_initialization).
         //             Try to unify the logic!
@@ -73,6 +79,21 @@ public class CompoundTypeTemplateData extends UserTypeTemplateData
         return isPackable;
     }
 
+    public boolean getIsSkippable()
+    {
+        return isSkippable;
+    }
+
+    public boolean getIsProjectable()
+    {
+        return isProjectable;
+    }
+
+    public boolean getIsViewable()
+    {
+        return isViewable;
+    }
+
     public boolean getNeedsChildrenInitialization()
     {
         return needsChildrenInitialization;
@@ -83,6 +104,8 @@ public class CompoundTypeTemplateData extends UserTypeTemplateData
         return templateInstantiation;
     }
 
+    private static final int MAX_NUM_PROJECTABLE_FIELDS = 64;
+
     private final boolean usedInPackedArray;
 
     private final List<CompoundFieldTemplateData> fieldList;
@@ -91,6 +114,9 @@ public class CompoundTypeTemplateData extends UserTypeTemplateData
     private final CompoundConstructorTemplateData compoundConstructorsData;
 
     private final boolean isPackable;
+    private final boolean isSkippable;
+    private final boolean isProjectable;
+    private final boolean isViewable;
     private final boolean needsChildrenInitialization;
 
     private final TemplateInstantiationTemplateData templateInstantiation;
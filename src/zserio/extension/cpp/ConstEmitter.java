@@ -11,9 +11,9 @@ import zserio.extension.common.ZserioExtensionException;
 public final class ConstEmitter extends CppDefaultEmitter
 {
     public ConstEmitter(OutputFileManager outputFileManager, CppExtensionParameters cppParameters,
-            PackedTypesCollector packedTypesCollector)
+            PackedTypesCollector packedTypesCollector, OffsetFieldsCollector offsetFieldsCollector)
     {
-        super(outputFileManager, cppParameters, packedTypesCollector);
+        super(outputFileManager, cppParameters, packedTypesCollector, offsetFieldsCollector);
     }
 
     @Override
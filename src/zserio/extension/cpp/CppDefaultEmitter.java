@@ -22,11 +22,11 @@ import zserio.extension.common.ZserioExtensionException;
 abstract class CppDefaultEmitter extends DefaultTreeWalker
 {
     public CppDefaultEmitter(OutputFileManager outputFileManager, CppExtensionParameters cppParameters,
-            PackedTypesCollector packedTypesCollector)
+            PackedTypesCollector packedTypesCollector, OffsetFieldsCollector offsetFieldsCollector)
     {
         this.outputFileManager = outputFileManager;
         this.cppParameters = cppParameters;
-        this.context = new TemplateDataContext(cppParameters, packedTypesCollector);
+        this.context = new TemplateDataContext(cppParameters, packedTypesCollector, offsetFieldsCollector);
         this.generatorDescription = context.getGeneratorDescription().split("\\n");
     }
 
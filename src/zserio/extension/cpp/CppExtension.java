@@ -75,18 +75,33 @@ public final class CppExtension implements Extension
         final PackedTypesCollector packedTypesCollector = new PackedTypesCollector();
         rootNode.accept(packedTypesCollector);
 
+        // collect which fields are used as offsets
+        final OffsetFieldsCollector offsetFieldsCollector = new OffsetFieldsCollector();
+        rootNode.walk(offsetFieldsCollector);
+
         final List<CppDefaultEmitter> emitters = new ArrayList<CppDefaultEmitter>();
-        emitters.add(new ConstEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new SubtypeEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new EnumerationEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new BitmaskEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new StructureEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new ChoiceEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new UnionEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new SqlDatabaseEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new SqlTableEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new ServiceEmitter(outputFileManager, cppParameters, packedTypesCollector));
-        emitters.add(new PubsubEmitter(outputFileManager, cppParameters, packedTypesCollector));
+        emitters.add(new ConstEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new SubtypeEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new EnumerationEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new BitmaskEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new StructureEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new ChoiceEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new UnionEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new SqlDatabaseEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new SqlTableEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new ServiceEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
+        emitters.add(new PubsubEmitter(outputFileManager, cppParameters, packedTypesCollector,
+                offsetFieldsCollector));
 
         // emit C++ code
         for (CppDefaultEmitter emitter : emitters)
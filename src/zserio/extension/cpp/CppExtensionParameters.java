@@ -33,6 +33,9 @@ public final class CppExtensionParameters
         withSourcesAmalgamation = !parameters.argumentExists(OptionWithoutSourcesAmalgamation);
         withCodeComments = parameters.getWithCodeComments();
         withParsingInfoCode = parameters.argumentExists(OptionWithParsingInfoCode);
+        withBufferViewsCode = parameters.argumentExists(OptionWithBufferViewsCode);
+        withProjectionCode = parameters.argumentExists(OptionWithProjectionCode);
+        withViewCode = parameters.argumentExists(OptionWithViewCode);
 
         final String cppAllocator = parameters.getCommandLineArg(OptionSetCppAllocator);
         if (cppAllocator == null || cppAllocator.equals(StdAllocator))
@@ -70,6 +73,12 @@ public final class CppExtensionParameters
             description.add("codeComments");
         if (withParsingInfoCode)
             description.add("parsingInfoCode");
+        if (withBufferViewsCode)
+            description.add("bufferViewsCode");
+        if (withProjectionCode)
+            description.add("projectionCode");
+        if (withViewCode)
+            description.add("viewCode");
         addAllocatorDescription(description);
         parametersDescription = description.toString();
 
@@ -141,6 +150,21 @@ public final class CppExtensionParameters
         return withParsingInfoCode;
     }
 
+    public boolean getWithBufferViewsCode()
+    {
+        return withBufferViewsCode;
+    }
+
+    public boolean getWithProjectionCode()
+    {
+        return withProjectionCode;
+    }
+
+    public boolean getWithViewCode()
+    {
+        return withViewCode;
+    }
+
     public TypesContext.AllocatorDefinition getAllocatorDefinition()
     {
         return allocatorDefinition;
@@ -201,6 +225,29 @@ public final class CppExtensionParameters
         settersGroup.addOption(new Option(OptionWithoutSettersCode, false, "disable writing setters code"));
         settersGroup.setRequired(false);
         options.addOptionGroup(settersGroup);
+
+        final OptionGroup bufferViewsGroup = new OptionGroup();
+        bufferViewsGroup.addOption(new Option(OptionWithBufferViewsCode, false,
+                "map string and bytes fields to views into the read buffer (fields must be byte aligned)"));
+        bufferViewsGroup.addOption(
+                new Option(OptionWithoutBufferViewsCode, false, "disable buffer views code (default)"));
+        bufferViewsGroup.setRequired(false);
+        options.addOptionGroup(bufferViewsGroup);
+
+        final OptionGroup projectionGroup = new OptionGroup();
+        projectionGroup.addOption(new Option(OptionWithProjectionCode, false,
+                "enable read constructors of structures which read only fields selected by a field mask"));
+        projectionGroup.addOption(
+                new Option(OptionWithoutProjectionCode, false, "disable projection code (default)"));
+        projectionGroup.setRequired(false);
+        options.addOptionGroup(projectionGroup);
+
+        final OptionGroup viewGroup = new OptionGroup();
+        viewGroup.addOption(new Option(OptionWithViewCode, false,
+                "enable zero-copy views of structures which decode fields lazily from the serialized buffer"));
+        viewGroup.addOption(new Option(OptionWithoutViewCode, false, "disable view code (default)"));
+        viewGroup.setRequired(false);
+        options.addOptionGroup(viewGroup);
     }
 
     static boolean hasOptionCpp(ExtensionParameters parameters)
@@ -226,6 +273,20 @@ public final class CppExtensionParameters
                 throw new ZserioExtensionException("The specified option '" + OptionWithReflectionCode +
                         "' needs enabled type info code ('withTypeInfoCode')!");
             }
+
+            if (parameters.argumentExists(OptionWithBufferViewsCode))
+            {
+                throw new ZserioExtensionException("The specified option '" + OptionWithReflectionCode +
+                        "' cannot be used together with option '" + OptionWithBufferViewsCode + "'!");
+            }
+        }
+
+        // fields which are not loaded are default constructed
+        if (parameters.argumentExists(OptionWithProjectionCode) && !parameters.getWithWriterCode() &&
+                !parameters.argumentExists(OptionWithSettersCode))
+        {
+            throw new ZserioExtensionException("The specified option '" + OptionWithProjectionCode +
+                    "' needs enabled setters code ('" + OptionWithSettersCode + "')!");
         }
     }
 
@@ -256,6 +317,12 @@ public final class CppExtensionParameters
     private static final String OptionWithoutParsingInfoCode = "withoutParsingInfoCode";
     private static final String OptionWithSettersCode = "withSettersCode";
     private static final String OptionWithoutSettersCode = "withoutSettersCode";
+    private static final String OptionWithBufferViewsCode = "withBufferViewsCode";
+    private static final String OptionWithoutBufferViewsCode = "withoutBufferViewsCode";
+    private static final String OptionWithProjectionCode = "withProjectionCode";
+    private static final String OptionWithoutProjectionCode = "withoutProjectionCode";
+    private static final String OptionWithViewCode = "withViewCode";
+    private static final String OptionWithoutViewCode = "withoutViewCode";
 
     private final static String StdAllocator = "std";
     private final static String PolymorphicAllocator = "polymorphic";
@@ -273,6 +340,9 @@ public final class CppExtensionParameters
     private final boolean withSourcesAmalgamation;
     private final boolean withCodeComments;
     private final boolean withParsingInfoCode;
+    private final boolean withBufferViewsCode;
+    private final boolean withProjectionCode;
+    private final boolean withViewCode;
     private final TypesContext.AllocatorDefinition allocatorDefinition;
     private final String parametersDescription;
     private final String zserioVersion;
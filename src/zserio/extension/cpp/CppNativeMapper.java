@@ -70,6 +70,7 @@ public final class CppNativeMapper
         stringType = new NativeRuntimeAllocArrayableType(
                 typesContext.getString(), allocatorDefinition, "char", typesContext.getStringArrayTraits());
         stringViewType = new NativeStringViewType();
+        bytesViewType = new NativeRuntimeType("BytesView", "zserio/Span.h", true);
         vectorType = new NativeRuntimeAllocType(typesContext.getVector(), allocatorDefinition);
         mapType = new NativeRuntimeAllocType(typesContext.getMap(), allocatorDefinition);
         setType = new NativeRuntimeAllocType(typesContext.getSet(), allocatorDefinition);
@@ -201,6 +202,11 @@ public final class CppNativeMapper
         return stringViewType;
     }
 
+    public NativeRuntimeType getBytesViewType()
+    {
+        return bytesViewType;
+    }
+
     public NativeRuntimeAllocType getVectorType()
     {
         return vectorType;
@@ -597,6 +603,7 @@ public final class CppNativeMapper
 
     private final NativeRuntimeAllocArrayableType stringType;
     private final NativeStringViewType stringViewType;
+    private final NativeRuntimeType bytesViewType;
     private final NativeRuntimeAllocType vectorType;
     private final NativeRuntimeAllocType mapType;
     private final NativeRuntimeAllocType setType;
@@ -0,0 +1,107 @@
+package zserio.extension.cpp;
+
+import java.util.HashSet;
+import java.util.Set;
+
+import zserio.ast.ChoiceType;
+import zserio.ast.CompoundType;
+import zserio.ast.Expression;
+import zserio.ast.Field;
+import zserio.ast.StructureType;
+import zserio.ast.UnionType;
+import zserio.extension.common.DefaultTreeWalker;
+import zserio.extension.common.ZserioExtensionException;
+
+/**
+ * Collector of fields which are used as offsets.
+ *
+ * Single pass serialization registers such fields as patch slots when they are written.
+ */
+final class OffsetFieldsCollector extends DefaultTreeWalker
+{
+    @Override
+    public boolean traverseTemplateInstantiations()
+    {
+        return true;
+    }
+
+    @Override
+    public void beginStructure(StructureType structureType) throws ZserioExtensionException
+    {
+        collectOffsetFields(structureType);
+    }
+
+    @Override
+    public void beginChoice(ChoiceType choiceType) throws ZserioExtensionException
+    {
+        collectOffsetFields(choiceType);
+    }
+
+    @Override
+    public void beginUnion(UnionType unionType) throws ZserioExtensionException
+    {
+        collectOffsetFields(unionType);
+    }
+
+    /**
+     * Checks whether the given field is used as an offset.
+     */
+    public boolean isUsedAsOffset(Field field)
+    {
+        return offsetFields.contains(field);
+    }
+
+    /**
+     * Gets the expression which references the offset field, i.e. the offset expression without index.
+     */
+    public static Expression getOffsetFieldExpression(Expression offsetExpression)
+    {
+        Expression fieldExpression = offsetExpression;
+        if (fieldExpression.containsIndex() && isArrayElement(fieldExpression))
+            fieldExpression = fieldExpression.op1();
+
+        return (getReferencedField(fieldExpression) != null) ? fieldExpression : null;
+    }
+
+    /**
+     * Gets the field referenced by the expression returned from getOffsetFieldExpression().
+     */
+    public static Field getReferencedField(Expression fieldExpression)
+    {
+        final Expression symbolExpression = isDot(fieldExpression) ? fieldExpression.op2() : fieldExpression;
+        final Object symbolObject = symbolExpression.getExprSymbolObject();
+
+        return (symbolObject instanceof Field) ? (Field)symbolObject : null;
+    }
+
+    /**
+     * Checks whether the expression accesses a member of a compound, e.g. 'header.offset'.
+     */
+    public static boolean isDot(Expression expression)
+    {
+        return expression.op1() != null && expression.op2() != null &&
+                expression.op2().getExprSymbolObject() instanceof Field;
+    }
+
+    private static boolean isArrayElement(Expression expression)
+    {
+        return expression.op1() != null && expression.op2() != null &&
+                !(expression.op2().getExprSymbolObject() instanceof Field);
+    }
+
+    private void collectOffsetFields(CompoundType compoundType)
+    {
+        for (Field field : compoundType.getFields())
+        {
+            final Expression offsetExpression = field.getOffsetExpr();
+            if (offsetExpression == null)
+                continue;
+
+            final Expression fieldExpression = getOffsetFieldExpression(offsetExpression);
+            if (fieldExpression != null)
+                offsetFields.add(getReferencedField(fieldExpression));
+        }
+    }
+
+    private final Set<Field> offsetFields = new HashSet<Field>();
+}
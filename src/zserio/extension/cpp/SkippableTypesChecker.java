@@ -0,0 +1,201 @@
+package zserio.extension.cpp;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+import zserio.ast.ArrayInstantiation;
+import zserio.ast.BytesType;
+import zserio.ast.ChoiceType;
+import zserio.ast.CompoundType;
+import zserio.ast.DynamicBitFieldInstantiation;
+import zserio.ast.Expression;
+import zserio.ast.ExternType;
+import zserio.ast.Field;
+import zserio.ast.Function;
+import zserio.ast.ParameterizedTypeInstantiation;
+import zserio.ast.ParameterizedTypeInstantiation.InstantiatedParameter;
+import zserio.ast.StringType;
+import zserio.ast.StructureType;
+import zserio.ast.TypeInstantiation;
+import zserio.ast.ZserioType;
+
+/**
+ * Checker of compound types which can be skipped in the bit stream without reading them.
+ *
+ * Generated skip() knows only the parameters of the compound and the fields it reads on the way. Thus all
+ * expressions needed to skip the compound can reference only parameters and simple fields of the compound.
+ * Functions, indices, extended fields and packed arrays are not supported.
+ */
+final class SkippableTypesChecker
+{
+    /**
+     * Checks whether the given compound type can be skipped.
+     */
+    public boolean isSkippable(CompoundType compoundType)
+    {
+        final Boolean isSkippable = skippableTypes.get(compoundType);
+        if (isSkippable != null)
+            return isSkippable;
+
+        // recursive types are skippable unless anything else prevents it
+        skippableTypes.put(compoundType, true);
+        final int numCheckedTypes = checkedTypes.size();
+        checkedTypes.add(compoundType);
+        final Set<Field> ownerFields = new HashSet<Field>();
+        final boolean result = checkCompoundType(compoundType, ownerFields);
+        skippableTypes.put(compoundType, result);
+        if (result)
+        {
+            skipOwnerFields.put(compoundType, ownerFields);
+        }
+        else
+        {
+            // types checked meanwhile could rely on this type and must be checked again
+            for (CompoundType checkedType : checkedTypes.subList(numCheckedTypes + 1, checkedTypes.size()))
+            {
+                skippableTypes.remove(checkedType);
+                skipOwnerFields.remove(checkedType);
+            }
+            checkedTypes.subList(numCheckedTypes + 1, checkedTypes.size()).clear();
+        }
+
+        return result;
+    }
+
+    /**
+     * Checks whether the given field must be read by skip() because expressions of the compound use it.
+     */
+    public boolean isSkipOwnerField(CompoundType compoundType, Field field)
+    {
+        if (!isSkippable(compoundType))
+            return false;
+
+        final Set<Field> ownerFields = skipOwnerFields.get(compoundType);
+        return ownerFields != null && ownerFields.contains(field);
+    }
+
+    private boolean checkCompoundType(CompoundType compoundType, Set<Field> ownerFields)
+    {
+        if (compoundType instanceof ChoiceType &&
+                !collectOwnerFields(compoundType, ((ChoiceType)compoundType).getSelectorExpression(),
+                        ownerFields))
+        {
+            return false;
+        }
+
+        for (Field field : compoundType.getFields())
+        {
+            if (field.isExtended())
+                return false;
+
+            if (!collectOwnerFields(compoundType, field.getOptionalClauseExpr(), ownerFields))
+                return false;
+
+            if (!checkTypeInstantiation(compoundType, field.getTypeInstantiation(), ownerFields))
+                return false;
+        }
+
+        return true;
+    }
+
+    private boolean checkTypeInstantiation(
+            CompoundType compoundType, TypeInstantiation typeInstantiation, Set<Field> ownerFields)
+    {
+        if (typeInstantiation instanceof ArrayInstantiation)
+        {
+            final ArrayInstantiation arrayInstantiation = (ArrayInstantiation)typeInstantiation;
+            if (arrayInstantiation.isPacked())
+                return false;
+
+            if (!collectOwnerFields(compoundType, arrayInstantiation.getLengthExpression(), ownerFields))
+                return false;
+
+            // elements are skipped by array traits which do not know the owner
+            final TypeInstantiation elementTypeInstantiation =
+                    arrayInstantiation.getElementTypeInstantiation();
+            if (elementTypeInstantiation instanceof ParameterizedTypeInstantiation ||
+                    elementTypeInstantiation instanceof DynamicBitFieldInstantiation)
+            {
+                return false;
+            }
+
+            return checkBaseType(elementTypeInstantiation.getBaseType());
+        }
+
+        if (typeInstantiation instanceof ParameterizedTypeInstantiation)
+        {
+            for (InstantiatedParameter instantiatedParameter :
+                    ((ParameterizedTypeInstantiation)typeInstantiation).getInstantiatedParameters())
+            {
+                if (!collectOwnerFields(compoundType, instantiatedParameter.getArgumentExpression(), ownerFields))
+                    return false;
+            }
+        }
+        else if (typeInstantiation instanceof DynamicBitFieldInstantiation)
+        {
+            if (!collectOwnerFields(compoundType,
+                        ((DynamicBitFieldInstantiation)typeInstantiation).getLengthExpression(), ownerFields))
+            {
+                return false;
+            }
+        }
+
+        return checkBaseType(typeInstantiation.getBaseType());
+    }
+
+    private boolean checkBaseType(ZserioType baseType)
+    {
+        return !(baseType instanceof CompoundType) || isSkippable((CompoundType)baseType);
+    }
+
+    private static boolean collectOwnerFields(
+            CompoundType compoundType, Expression expression, Set<Field> ownerFields)
+    {
+        if (expression == null)
+            return true;
+
+        if (expression.containsIndex() || expression.getExprSymbolObject() instanceof Function)
+            return false;
+
+        // members of parameters are accessed through the parameter, thus only the left operand matters
+        if (OffsetFieldsCollector.isDot(expression))
+            return collectOwnerFields(compoundType, expression.op1(), ownerFields);
+
+        final Object symbolObject = expression.getExprSymbolObject();
+        if (symbolObject instanceof Field)
+        {
+            final Field field = (Field)symbolObject;
+            // only fields of structures are read before they are used
+            if (!(compoundType instanceof StructureType) || !compoundType.getFields().contains(field) ||
+                    !isSimpleField(field))
+            {
+                return false;
+            }
+
+            ownerFields.add(field);
+        }
+
+        return collectOwnerFields(compoundType, expression.op1(), ownerFields) &&
+                collectOwnerFields(compoundType, expression.op2(), ownerFields) &&
+                collectOwnerFields(compoundType, expression.op3(), ownerFields);
+    }
+
+    private static boolean isSimpleField(Field field)
+    {
+        final TypeInstantiation typeInstantiation = field.getTypeInstantiation();
+        final ZserioType baseType = typeInstantiation.getBaseType();
+
+        return !field.isOptional() && !(typeInstantiation instanceof ArrayInstantiation) &&
+                !(typeInstantiation instanceof DynamicBitFieldInstantiation) &&
+                !(baseType instanceof CompoundType) && !(baseType instanceof StringType) &&
+                !(baseType instanceof BytesType) && !(baseType instanceof ExternType);
+    }
+
+    private final List<CompoundType> checkedTypes = new ArrayList<CompoundType>();
+    private final Map<CompoundType, Boolean> skippableTypes = new HashMap<CompoundType, Boolean>();
+    private final Map<CompoundType, Set<Field>> skipOwnerFields = new HashMap<CompoundType, Set<Field>>();
+}
@@ -11,9 +11,13 @@ import zserio.extension.common.PackedTypesCollector;
  */
 final class TemplateDataContext
 {
-    public TemplateDataContext(CppExtensionParameters cppParameters, PackedTypesCollector packedTypesCollector)
+    public TemplateDataContext(CppExtensionParameters cppParameters, PackedTypesCollector packedTypesCollector,
+            OffsetFieldsCollector offsetFieldsCollector)
     {
         this.packedTypesCollector = packedTypesCollector;
+        this.offsetFieldsCollector = offsetFieldsCollector;
+        skippableTypesChecker = new SkippableTypesChecker();
+        viewableTypesChecker = new ViewableTypesChecker(skippableTypesChecker);
 
         typesContext = new TypesContext(cppParameters.getAllocatorDefinition());
         cppNativeMapper = new CppNativeMapper(typesContext);
@@ -26,6 +30,9 @@ final class TemplateDataContext
         withReflectionCode = cppParameters.getWithReflectionCode();
         withCodeComments = cppParameters.getWithCodeComments();
         withParsingInfoCode = cppParameters.getWithParsingInfoCode();
+        withBufferViewsCode = cppParameters.getWithBufferViewsCode();
+        withProjectionCode = cppParameters.getWithProjectionCode();
+        withViewCode = cppParameters.getWithViewCode();
 
         generatorDescription = "/**\n"
                 + " * Automatically generated by Zserio C++11 Safe generator version " +
@@ -42,6 +49,21 @@ final class TemplateDataContext
         return packedTypesCollector;
     }
 
+    public OffsetFieldsCollector getOffsetFieldsCollector()
+    {
+        return offsetFieldsCollector;
+    }
+
+    public SkippableTypesChecker getSkippableTypesChecker()
+    {
+        return skippableTypesChecker;
+    }
+
+    public ViewableTypesChecker getViewableTypesChecker()
+    {
+        return viewableTypesChecker;
+    }
+
     public CppNativeMapper getCppNativeMapper()
     {
         return cppNativeMapper;
@@ -104,6 +126,21 @@ final class TemplateDataContext
         return withParsingInfoCode;
     }
 
+    public boolean getWithBufferViewsCode()
+    {
+        return withBufferViewsCode;
+    }
+
+    public boolean getWithProjectionCode()
+    {
+        return withProjectionCode;
+    }
+
+    public boolean getWithViewCode()
+    {
+        return withViewCode;
+    }
+
     public TypesContext getTypesContext()
     {
         return typesContext;
@@ -125,6 +162,9 @@ final class TemplateDataContext
     }
 
     private final PackedTypesCollector packedTypesCollector;
+    private final OffsetFieldsCollector offsetFieldsCollector;
+    private final SkippableTypesChecker skippableTypesChecker;
+    private final ViewableTypesChecker viewableTypesChecker;
 
     private final TypesContext typesContext;
 
@@ -138,6 +178,9 @@ final class TemplateDataContext
     private final boolean withReflectionCode;
     private final boolean withCodeComments;
     private final boolean withParsingInfoCode;
+    private final boolean withBufferViewsCode;
+    private final boolean withProjectionCode;
+    private final boolean withViewCode;
     private final String generatorDescription;
     private final String generatorVersionString;
     private final long generatorVersionNumber;
@@ -0,0 +1,94 @@
+package zserio.extension.cpp;
+
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+import zserio.ast.ArrayInstantiation;
+import zserio.ast.BytesType;
+import zserio.ast.CompoundType;
+import zserio.ast.ExternType;
+import zserio.ast.Field;
+import zserio.ast.Parameter;
+import zserio.ast.StringType;
+import zserio.ast.StructureType;
+import zserio.ast.TypeInstantiation;
+import zserio.ast.ZserioType;
+
+/**
+ * Checker of compound types for which the zero-copy views can be generated.
+ *
+ * Views decode fields lazily by skipping the preceding fields, thus only skippable structures are supported.
+ * Parameters of the views are held by value, thus only simple parameters are supported. Compound fields and
+ * elements of compound arrays are returned as views, thus their types must be viewable as well. Extern fields
+ * cannot be viewed without allocation.
+ */
+final class ViewableTypesChecker
+{
+    public ViewableTypesChecker(SkippableTypesChecker skippableTypesChecker)
+    {
+        this.skippableTypesChecker = skippableTypesChecker;
+    }
+
+    /**
+     * Checks whether the view can be generated for the given compound type.
+     */
+    public boolean isViewable(CompoundType compoundType)
+    {
+        final Boolean isViewable = viewableTypes.get(compoundType);
+        if (isViewable != null)
+            return isViewable;
+
+        // recursive types are viewable unless anything else prevents it
+        viewableTypes.put(compoundType, true);
+        final int numCheckedTypes = checkedTypes.size();
+        checkedTypes.add(compoundType);
+        final boolean result = checkCompoundType(compoundType);
+        viewableTypes.put(compoundType, result);
+        if (!result)
+        {
+            // types checked meanwhile could rely on this type and must be checked again
+            for (CompoundType checkedType : checkedTypes.subList(numCheckedTypes + 1, checkedTypes.size()))
+                viewableTypes.remove(checkedType);
+            checkedTypes.subList(numCheckedTypes + 1, checkedTypes.size()).clear();
+        }
+
+        return result;
+    }
+
+    private boolean checkCompoundType(CompoundType compoundType)
+    {
+        if (!(compoundType instanceof StructureType) || !skippableTypesChecker.isSkippable(compoundType))
+            return false;
+
+        for (Parameter parameter : compoundType.getTypeParameters())
+        {
+            final ZserioType baseType = parameter.getTypeReference().getBaseTypeReference().getType();
+            if (baseType instanceof CompoundType || baseType instanceof StringType ||
+                    baseType instanceof BytesType || baseType instanceof ExternType)
+            {
+                return false;
+            }
+        }
+
+        for (Field field : compoundType.getFields())
+        {
+            TypeInstantiation typeInstantiation = field.getTypeInstantiation();
+            if (typeInstantiation instanceof ArrayInstantiation)
+                typeInstantiation = ((ArrayInstantiation)typeInstantiation).getElementTypeInstantiation();
+
+            final ZserioType baseType = typeInstantiation.getBaseType();
+            if (baseType instanceof ExternType)
+                return false;
+            if (baseType instanceof CompoundType && !isViewable((CompoundType)baseType))
+                return false;
+        }
+
+        return true;
+    }
+
+    private final SkippableTypesChecker skippableTypesChecker;
+    private final List<CompoundType> checkedTypes = new ArrayList<CompoundType>();
+    private final Map<CompoundType, Boolean> viewableTypes = new HashMap<CompoundType, Boolean>();
+}
@@ -0,0 +1,127 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "buffer_views/Dictionary.h"
+#include "buffer_views/Unaligned.h"
+#include "zserio/SerializeUtil.h"
+#include "zserio/String.h"
+#include "zserio/Vector.h"
+
+namespace
+{
+
+// fields of the objects are views, the owning storage must outlive them
+struct Storage
+{
+    zserio::vector<zserio::string<>> keys;
+    zserio::vector<zserio::vector<uint8_t>> values;
+    zserio::string<> name;
+    zserio::string<> comment;
+    zserio::vector<uint8_t> blob;
+};
+
+buffer_views::Dictionary createDictionary(const Storage& storage)
+{
+    zserio::vector<buffer_views::Entry> entries;
+    for (size_t i = 0; i < storage.keys.size(); ++i)
+    {
+        buffer_views::Entry entry;
+        entry.setKey(zserio::StringView(storage.keys[i]));
+        entry.setValue(zserio::BytesView(storage.values[i]));
+        entry.setId(static_cast<uint32_t>(i + 1));
+        entries.push_back(entry);
+    }
+
+    buffer_views::Dictionary dictionary;
+    dictionary.setNumEntries(static_cast<uint16_t>(entries.size()));
+    dictionary.setEntries(entries);
+    dictionary.setName(zserio::StringView(storage.name));
+    dictionary.setComment(zserio::StringView(storage.comment));
+    dictionary.setBlob(zserio::BytesView(storage.blob));
+    return dictionary;
+}
+
+bool check(bool condition, const char* message)
+{
+    std::cout << (condition ? "   - OK: " : "   - FAILED: ") << message << std::endl;
+    return condition;
+}
+
+bool isInBuffer(const void* data, size_t size, const zserio::BitBuffer& buffer)
+{
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    return begin >= buffer.getBuffer() && begin + size <= buffer.getBuffer() + buffer.getByteSize();
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "Zserio C++11-Safe Buffer Views Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    Storage storage;
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        storage.keys.push_back(zserio::string<>(i + 1U, static_cast<char>('k' + i)));
+        storage.values.push_back(zserio::vector<uint8_t>(i * 3U, static_cast<uint8_t>(0xA0 + i)));
+    }
+    storage.name = "dictionary";
+    storage.comment = "a comment which is longer than the small string buffer";
+    storage.blob = zserio::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF};
+
+    buffer_views::Dictionary dictionary = createDictionary(storage);
+    const auto bufferResult = zserio::serialize(dictionary);
+    if (bufferResult.isError())
+    {
+        std::cerr << "ERROR: serialize() failed with error code: " << static_cast<int>(bufferResult.getError())
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    const zserio::BitBuffer& buffer = bufferResult.getValue();
+
+    bool success = true;
+
+    std::cout << "\nByte aligned string and bytes fields..." << std::endl;
+    const auto readResult = zserio::deserialize<buffer_views::Dictionary>(buffer);
+    success &= check(readResult.isSuccess(), "deserialize");
+    if (readResult.isSuccess())
+    {
+        const buffer_views::Dictionary& readDictionary = readResult.getValue();
+        success &= check(readDictionary == dictionary, "read object equals the written object");
+        success &= check(readDictionary.hashCode() == dictionary.hashCode(), "hash codes of views match");
+
+        bool isZeroCopy = isInBuffer(readDictionary.getName().data(), readDictionary.getName().size(), buffer) &&
+                isInBuffer(readDictionary.getComment().data(), readDictionary.getComment().size(), buffer) &&
+                isInBuffer(readDictionary.getBlob().data(), readDictionary.getBlob().size(), buffer);
+        for (const buffer_views::Entry& entry : readDictionary.getEntries())
+        {
+            isZeroCopy &= isInBuffer(entry.getKey().data(), entry.getKey().size(), buffer);
+            // empty views do not need to point anywhere
+            isZeroCopy &= entry.getValue().empty() ||
+                    isInBuffer(entry.getValue().data(), entry.getValue().size(), buffer);
+        }
+        success &= check(isZeroCopy, "string and bytes fields point into the read buffer");
+    }
+
+    std::cout << "\nUnaligned string field..." << std::endl;
+    const zserio::string<> text("unaligned");
+    buffer_views::Unaligned unaligned;
+    unaligned.setFlags(5);
+    unaligned.setText(zserio::StringView(text));
+    const auto unalignedBufferResult = zserio::serialize(unaligned);
+    success &= check(unalignedBufferResult.isSuccess(), "views are written at any position");
+    if (unalignedBufferResult.isSuccess())
+    {
+        const auto unalignedReadResult = zserio::deserialize<buffer_views::Unaligned>(unalignedBufferResult.getValue());
+        success &= check(unalignedReadResult.isError() &&
+                        unalignedReadResult.getError() == zserio::ErrorCode::InvalidAlignment,
+                "reading fails with InvalidAlignment");
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << (success ? "SUCCESS: Buffer views verified!" : "FAILED: Buffer views differ!") << std::endl;
+    std::cout << "========================================" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
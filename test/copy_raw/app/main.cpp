@@ -0,0 +1,139 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "copy_raw/Message.h"
+#include "zserio/SerializeUtil.h"
+#include "zserio/String.h"
+#include "zserio/Vector.h"
+
+namespace
+{
+
+copy_raw::Inner createInner(uint8_t tag, const char* name, size_t numValues)
+{
+    copy_raw::Inner inner;
+    inner.setTag(tag);
+    inner.setName(zserio::string<>(name));
+    zserio::vector<uint16_t> values;
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        values.push_back(static_cast<uint16_t>(i * 1111));
+    }
+    inner.setValues(values);
+    return inner;
+}
+
+copy_raw::Message createMessage(uint8_t type)
+{
+    copy_raw::Payload payload;
+    if (type == 0)
+    {
+        payload.setInner(createInner(5, "payload", 9));
+    }
+    else
+    {
+        payload.setNumber(-123456);
+    }
+
+    copy_raw::Message message;
+    message.setId(0x1234);
+    message.setFlags(0x15);
+    message.setFirst(createInner(3, "first", 4));
+    message.setType(type);
+    message.setPayload(payload);
+    message.setAligned(createInner(7, "aligned", 17));
+    message.setNote(zserio::string<>("note"));
+    return message;
+}
+
+bool check(bool condition, const char* message)
+{
+    std::cout << (condition ? "   - OK: " : "   - FAILED: ") << message << std::endl;
+    return condition;
+}
+
+// writes the changed message field by field after the given number of leading bits, compounds are copied raw
+bool checkCopyRaw(const zserio::BitBuffer& buffer, uint8_t numLeadingBits)
+{
+    using copy_raw::Message;
+
+    zserio::BitStreamReader reader(buffer);
+    const Message original(reader);
+
+    Message expected = original;
+    expected.setId(static_cast<uint16_t>(original.getId() + 1));
+    expected.setNote(zserio::string<>("changed note"));
+    const auto endBitPositionResult = expected.initializeOffsets(numLeadingBits);
+    if (endBitPositionResult.isError())
+    {
+        return check(false, "initializeOffsets");
+    }
+    const size_t bitSize = endBitPositionResult.getValue();
+
+    zserio::vector<uint8_t> data((bitSize + 7) / 8);
+    zserio::BitStreamWriter writer(data.data(), data.size());
+    const bool isWritten = (numLeadingBits == 0 || writer.writeBits(0, numLeadingBits).isSuccess()) &&
+            writer.writeBits(expected.getId(), 16).isSuccess() &&
+            writer.writeBits(expected.getFlags(), 5).isSuccess();
+    original.copyRawFirst(reader, writer);
+    const bool isTypeWritten = writer.writeBits(expected.getType(), 8).isSuccess();
+    original.copyRawPayload(reader, writer);
+    const bool isAligned = writer.alignTo(8).isSuccess();
+    original.copyRawAligned(reader, writer);
+    const bool isNoteWritten = writer.writeString(zserio::StringView(expected.getNote())).isSuccess();
+    writer.flush();
+    if (!isWritten || !isTypeWritten || !isAligned || !isNoteWritten)
+    {
+        return check(false, "write");
+    }
+
+    zserio::vector<uint8_t> expectedData((bitSize + 7) / 8);
+    zserio::BitStreamWriter expectedWriter(expectedData.data(), expectedData.size());
+    const bool isExpectedWritten = (numLeadingBits == 0 || expectedWriter.writeBits(0, numLeadingBits).isSuccess()) &&
+            expected.write(expectedWriter).isSuccess();
+    expectedWriter.flush();
+
+    zserio::BitStreamReader readBackReader(data.data(), bitSize, zserio::BitsTag());
+    const bool isPrepared = readBackReader.skipBits(numLeadingBits).isSuccess();
+    const auto readBack = Message::deserialize(readBackReader);
+
+    return writer.getBitPosition() == bitSize && isExpectedWritten && data == expectedData && isPrepared &&
+            readBack.isSuccess() && readBack.getValue() == expected;
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "Zserio C++11-Safe Copy Raw Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    bool success = true;
+
+    for (uint8_t type : {0, 1})
+    {
+        std::cout << "\nMessage with payload type " << static_cast<int>(type) << "..." << std::endl;
+        copy_raw::Message message = createMessage(type);
+        const auto bufferResult = zserio::serialize(message);
+        if (bufferResult.isError())
+        {
+            std::cerr << "ERROR: serialize() failed with error code: " << static_cast<int>(bufferResult.getError())
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        // the destination is shifted against the source to cover both aligned and unaligned copies
+        bool isCopied = true;
+        for (uint8_t numLeadingBits = 0; numLeadingBits < 8; ++numLeadingBits)
+        {
+            isCopied &= checkCopyRaw(bufferResult.getValue(), numLeadingBits);
+        }
+        success &= check(isCopied, "copied fields give the same bytes as write()");
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << (success ? "SUCCESS: Raw copies verified!" : "FAILED: Raw copies differ!") << std::endl;
+    std::cout << "========================================" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "lazy_arrays/Table.h"
+#include "zserio/SerializeUtil.h"
+#include "zserio/String.h"
+#include "zserio/Vector.h"
+
+namespace
+{
+
+const uint32_t NUM_VALUES = 100000;
+const uint16_t NUM_NAMES = 1000;
+
+zserio::string<> createName(size_t index)
+{
+    // names of different lengths give the elements irregular offsets
+    return zserio::string<>(index % 13 + 1, static_cast<char>('a' + index % 26));
+}
+
+lazy_arrays::Table createTable()
+{
+    zserio::vector<uint32_t> values;
+    zserio::vector<uint8_t> flags;
+    for (uint32_t i = 0; i < NUM_VALUES; ++i)
+    {
+        values.push_back(i * 7919U);
+        flags.push_back(static_cast<uint8_t>(i % 8));
+    }
+
+    zserio::vector<zserio::string<>> names;
+    zserio::vector<uint8_t> codes;
+    for (uint16_t i = 0; i < NUM_NAMES; ++i)
+    {
+        names.push_back(createName(i));
+        codes.push_back(static_cast<uint8_t>(i % 32));
+    }
+
+    lazy_arrays::Table table;
+    table.setNumValues(NUM_VALUES);
+    table.setValues(values);
+    table.setFlags(flags);
+    table.setNumNames(NUM_NAMES);
+    table.setNameOffsets(zserio::vector<uint32_t>(NUM_NAMES));
+    table.setNames(names);
+    table.setCodeOffsets(zserio::vector<uint32_t>(NUM_NAMES));
+    table.setCodes(codes);
+    return table;
+}
+
+template <typename T>
+bool isEqual(const T& value, const T& expected)
+{
+    return value == expected;
+}
+
+bool isEqual(zserio::StringView value, const zserio::string<>& expected)
+{
+    return value == zserio::StringView(expected);
+}
+
+bool check(bool condition, const char* message)
+{
+    std::cout << (condition ? "   - OK: " : "   - FAILED: ") << message << std::endl;
+    return condition;
+}
+
+// decodes a handful of elements on demand, both by at() and by operator[]
+template <typename ARRAY_VIEW, typename EXPECTED>
+bool checkElements(const zserio::Result<ARRAY_VIEW>& result, size_t length, EXPECTED expected)
+{
+    if (result.isError() || result.getValue().size() != length)
+    {
+        return false;
+    }
+
+    const ARRAY_VIEW& arrayView = result.getValue();
+    for (size_t index : {length - 1, length / 2, size_t(1), size_t(0), length - 2})
+    {
+        const auto element = arrayView.at(index);
+        const auto indexedElement = arrayView[index];
+        if (element.isError() || indexedElement.isError() || !isEqual(element.getValue(), expected(index)) ||
+                !isEqual(indexedElement.getValue(), expected(index)))
+        {
+            return false;
+        }
+    }
+
+    return arrayView.at(length).getError() == zserio::ErrorCode::InvalidIndex;
+}
+
+} // namespace
+
+int main()
+{
+    using lazy_arrays::TableView;
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Zserio C++11-Safe Lazy Arrays Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    lazy_arrays::Table table = createTable();
+    const auto bufferResult = zserio::serialize(table);
+    if (bufferResult.isError())
+    {
+        std::cerr << "ERROR: serialize() failed with error code: " << static_cast<int>(bufferResult.getError())
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    const zserio::BitBuffer& buffer = bufferResult.getValue();
+    const TableView view(zserio::Span<const uint8_t>(buffer.getBuffer(), buffer.getByteSize()), 0);
+
+    bool success = true;
+
+    std::cout << "\nArrays of constant bit size elements..." << std::endl;
+    success &= check(checkElements(view.getValues(), NUM_VALUES,
+                             [](size_t index) { return static_cast<uint32_t>(index * 7919U); }),
+            "byte aligned elements");
+    success &= check(checkElements(view.getFlags(), NUM_VALUES,
+                             [](size_t index) { return static_cast<uint8_t>(index % 8); }),
+            "unaligned bit field elements");
+
+    std::cout << "\nAligned arrays with indexed offsets..." << std::endl;
+    success &= check(checkElements(view.getNames(), NUM_NAMES,
+                             [](size_t index) { return createName(index); }),
+            "strings of different lengths");
+    success &= check(checkElements(view.getCodes(), NUM_NAMES,
+                             [](size_t index) { return static_cast<uint8_t>(index % 32); }),
+            "bit field elements at byte offsets");
+
+    std::cout << "\nIteration..." << std::endl;
+    const auto names = view.getNames();
+    size_t index = 0;
+    bool isIterationMatched = names.isSuccess();
+    if (isIterationMatched)
+    {
+        for (auto it = names.getValue().begin(); it != names.getValue().end(); ++it, ++index)
+        {
+            const auto name = *it;
+            isIterationMatched &= name.isSuccess() && name.getValue() == zserio::StringView(createName(index));
+        }
+    }
+    success &= check(isIterationMatched && index == NUM_NAMES, "iteration reads all elements in order");
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << (success ? "SUCCESS: Lazy array elements verified!" : "FAILED: Lazy array elements differ!")
+              << std::endl;
+    std::cout << "========================================" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,118 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "projection/Record.h"
+#include "zserio/FieldMask.h"
+#include "zserio/SerializeUtil.h"
+#include "zserio/String.h"
+#include "zserio/Vector.h"
+
+namespace
+{
+
+projection::Record createRecord()
+{
+    zserio::vector<projection::Point> points;
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        projection::Point point;
+        point.setX(i * 10);
+        point.setY(-i);
+        points.push_back(point);
+    }
+
+    projection::Record record;
+    record.setId(0x12345678);
+    record.setName(zserio::string<>("record"));
+    record.setNumPoints(static_cast<uint16_t>(points.size()));
+    record.setPoints(points);
+    record.setComment(zserio::string<>("comment"));
+    record.setHasExtra(true);
+    record.setExtra(UINT64_C(0xFEDCBA9876543210));
+    record.setScore(1.5F);
+    return record;
+}
+
+bool check(bool condition, const char* message)
+{
+    std::cout << (condition ? "   - OK: " : "   - FAILED: ") << message << std::endl;
+    return condition;
+}
+
+// checks the loaded fields against the fully read record and the unloaded fields against the mask
+bool checkProjection(const char* name, const zserio::BitBuffer& buffer, zserio::FieldMask fieldMask,
+        const projection::Record& expected)
+{
+    using projection::Record;
+
+    std::cout << "\n" << name << "..." << std::endl;
+    zserio::BitStreamReader reader(buffer);
+    const Record projected(reader, fieldMask);
+
+    bool success = check(reader.getBitPosition() == buffer.getBitSize(), "reads up to the end of the record");
+
+    // fields which determine the layout are always read
+    success &= check(projected.isNumPointsLoaded() && projected.getNumPoints() == expected.getNumPoints() &&
+                    projected.isHasExtraLoaded() && projected.getHasExtra() == expected.getHasExtra(),
+            "layout fields are loaded");
+
+    bool isMaskMatched = projected.isIdLoaded() == fieldMask.contains(Record::FIELD_id) &&
+            projected.isNameLoaded() == fieldMask.contains(Record::FIELD_name) &&
+            projected.isPointsLoaded() == fieldMask.contains(Record::FIELD_points) &&
+            projected.isCommentLoaded() == fieldMask.contains(Record::FIELD_comment) &&
+            projected.isExtraLoaded() == fieldMask.contains(Record::FIELD_extra) &&
+            projected.isScoreLoaded() == fieldMask.contains(Record::FIELD_score);
+    success &= check(isMaskMatched, "only the selected fields are loaded");
+
+    bool isValueMatched = (!projected.isIdLoaded() || projected.getId() == expected.getId()) &&
+            (!projected.isNameLoaded() || projected.getName() == expected.getName()) &&
+            (!projected.isPointsLoaded() || projected.getPoints() == expected.getPoints()) &&
+            (!projected.isCommentLoaded() || projected.getComment() == expected.getComment()) &&
+            (!projected.isExtraLoaded() || projected.getExtra() == expected.getExtra()) &&
+            (!projected.isScoreLoaded() || projected.getScore() == expected.getScore());
+    success &= check(isValueMatched, "loaded fields have the serialized values");
+
+    return success;
+}
+
+} // namespace
+
+int main()
+{
+    using projection::Record;
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "Zserio C++11-Safe Projection Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    Record record = createRecord();
+    const auto bufferResult = zserio::serialize(record);
+    if (bufferResult.isError())
+    {
+        std::cerr << "ERROR: serialize() failed with error code: " << static_cast<int>(bufferResult.getError())
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    const zserio::BitBuffer& buffer = bufferResult.getValue();
+
+    bool success = true;
+    success &= checkProjection("Empty mask", buffer, zserio::FieldMask(), record);
+    success &= checkProjection("Scalars only", buffer, Record::FIELD_id | Record::FIELD_score, record);
+    success &= checkProjection("String and optional", buffer, Record::FIELD_name | Record::FIELD_comment, record);
+    success &= checkProjection("Array and conditional field", buffer,
+            Record::FIELD_points | Record::FIELD_extra, record);
+    success &= checkProjection("All fields", buffer, zserio::FieldMask::all(), record);
+
+    // setters mark a field as loaded again
+    std::cout << "\nSetters..." << std::endl;
+    zserio::BitStreamReader reader(buffer);
+    Record projected(reader, Record::FIELD_id);
+    projected.setName(zserio::string<>("changed"));
+    success &= check(projected.isNameLoaded() && projected.getName() == "changed", "setter loads the field");
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << (success ? "SUCCESS: Projection read verified!" : "FAILED: Projection read differs!")
+              << std::endl;
+    std::cout << "========================================" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
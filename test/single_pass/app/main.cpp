@@ -0,0 +1,101 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "single_pass/Container.h"
+#include "zserio/SerializeUtil.h"
+#include "zserio/String.h"
+#include "zserio/Vector.h"
+
+namespace
+{
+
+single_pass::Container createContainer(uint32_t staleOffset)
+{
+    const uint16_t numItems = 5;
+
+    single_pass::Header header;
+    header.setDataOffset(staleOffset);
+    header.setNumItems(numItems);
+    header.setItemOffsets(zserio::vector<uint32_t>(numItems, staleOffset));
+
+    zserio::vector<uint8_t> data;
+    zserio::vector<single_pass::Item> items;
+    for (uint16_t i = 0; i < numItems; ++i)
+    {
+        data.push_back(static_cast<uint8_t>(0xA0 + i));
+
+        single_pass::Item item;
+        item.setId(static_cast<uint16_t>(1000 + i));
+        // names of different lengths give the items irregular offsets
+        item.setName(zserio::string<>(i + 1U, static_cast<char>('a' + i)));
+        items.push_back(item);
+    }
+
+    single_pass::Container container;
+    container.setHeader(header);
+    container.setTrailerOffset(staleOffset);
+    container.setFlags(5);
+    container.setTitle("single pass");
+    container.setData(data);
+    container.setItems(items);
+    container.setTrailer(-42);
+    return container;
+}
+
+bool check(bool condition, const char* message)
+{
+    std::cout << (condition ? "   - OK: " : "   - FAILED: ") << message << std::endl;
+    return condition;
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "Zserio C++11-Safe Single Pass Offsets Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    bool success = true;
+
+    // two pass serialization sets all offsets by initializeOffsets()
+    single_pass::Container twoPassContainer = createContainer(0);
+    const auto twoPassResult = zserio::serialize(twoPassContainer);
+    if (twoPassResult.isError())
+    {
+        std::cerr << "ERROR: serialize() failed with error code: " << static_cast<int>(twoPassResult.getError())
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    const zserio::BitBuffer& twoPassBuffer = twoPassResult.getValue();
+
+    // single pass serialization patches the offsets, whatever the object holds
+    for (uint32_t staleOffset : {0U, 0xFFFFU})
+    {
+        std::cout << "\nSingle pass with offsets " << staleOffset << " in the object..." << std::endl;
+        single_pass::Container singlePassContainer = createContainer(staleOffset);
+        const auto singlePassResult = zserio::serializeSinglePass(singlePassContainer);
+        if (singlePassResult.isError())
+        {
+            std::cerr << "ERROR: serializeSinglePass() failed with error code: "
+                      << static_cast<int>(singlePassResult.getError()) << std::endl;
+            return EXIT_FAILURE;
+        }
+        const zserio::BitBuffer& singlePassBuffer = singlePassResult.getValue();
+
+        success &= check(singlePassBuffer.getBitSize() == twoPassBuffer.getBitSize(), "same bit size");
+        success &= check(singlePassBuffer == twoPassBuffer, "byte identical to serialize()");
+        success &= check(singlePassContainer.getHeader().getDataOffset() == staleOffset,
+                "offset fields of the object are kept");
+
+        const auto readResult = zserio::deserialize<single_pass::Container>(singlePassBuffer);
+        success &= check(readResult.isSuccess() && readResult.getValue() == twoPassContainer,
+                "reads back as the two pass object");
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << (success ? "SUCCESS: Single pass output verified!" : "FAILED: Single pass output differs!")
+              << std::endl;
+    std::cout << "========================================" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,193 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "skip/Node.h"
+#include "skip/RecordList.h"
+#include "skip/Tree.h"
+#include "skip/WithExtended.h"
+#include "skip/WithPacked.h"
+#include "zserio/SerializeUtil.h"
+#include "zserio/String.h"
+#include "zserio/Traits.h"
+#include "zserio/Vector.h"
+
+static_assert(zserio::has_skip<skip::RecordList>::value, "RecordList must be skippable!");
+static_assert(!zserio::has_skip<skip::WithExtended>::value, "Extended fields are not skippable!");
+static_assert(!zserio::has_skip<skip::WithPacked>::value, "Packed arrays are not skippable!");
+
+namespace
+{
+
+skip::Node createNode(uint8_t depth)
+{
+    skip::Node node;
+    node.setValue(depth);
+    node.setLabel(zserio::string<>(depth, 'n'));
+    node.setHasNext(depth > 0);
+    if (depth > 0)
+    {
+        node.setNext(createNode(static_cast<uint8_t>(depth - 1)));
+    }
+    return node;
+}
+
+skip::Tree createTree(uint16_t depth)
+{
+    skip::Tree tree;
+    zserio::vector<skip::Tree> children;
+    for (uint16_t i = 0; i < depth; ++i)
+    {
+        children.push_back(createTree(static_cast<uint16_t>(depth - 1)));
+    }
+    tree.setNumChildren(static_cast<uint16_t>(children.size()));
+    tree.setChildren(children);
+    if (depth % 2 == 0)
+    {
+        tree.setName(zserio::string<>("tree"));
+    }
+    return tree;
+}
+
+skip::RecordList createRecordList()
+{
+    zserio::vector<skip::Record> records;
+    for (uint8_t tag = 0; tag < 3; ++tag)
+    {
+        skip::Record record;
+        record.setPrefix(static_cast<uint8_t>(tag + 1));
+        record.setTag(tag);
+
+        skip::Payload payload;
+        skip::Variant variant;
+        switch (tag)
+        {
+        case 0:
+            payload.setNumber(0xDEADBEEF);
+            variant.setSmall(-7);
+            break;
+        case 1:
+            payload.setText(zserio::string<>("text"));
+            variant.setTree(createTree(3));
+            record.setMaybe(42);
+            break;
+        default:
+            payload.setNode(createNode(4));
+            variant.setTree(createTree(1));
+            break;
+        }
+        record.setPayload(payload);
+        record.setVariant(variant);
+        record.setDynamic(tag);
+        record.setNumbers(zserio::vector<uint16_t>(tag * 3U, 0xABCD));
+        record.setBlob(zserio::vector<uint8_t>(tag, 0x5A));
+        records.push_back(record);
+    }
+
+    skip::RecordList recordList;
+    recordList.setRecords(records);
+    return recordList;
+}
+
+template <typename T>
+zserio::Result<T> roundTrip(T& object)
+{
+    const auto bufferResult = zserio::serialize(object);
+    if (bufferResult.isError())
+    {
+        return zserio::Result<T>::error(bufferResult.getError());
+    }
+
+    return zserio::deserialize<T>(bufferResult.getValue());
+}
+
+bool check(bool condition, const char* message)
+{
+    std::cout << (condition ? "   - OK: " : "   - FAILED: ") << message << std::endl;
+    return condition;
+}
+
+// compares the end position of skip() with the end position of read() for every start bit offset
+template <typename T>
+bool checkSkip(const char* name, T& object)
+{
+    std::cout << "\n" << name << "..." << std::endl;
+
+    // serialize() initializes the children of the object
+    if (zserio::serialize(object).isError())
+    {
+        return check(false, "serialize");
+    }
+
+    // the object is written after up to 7 leading bits to check unaligned starts and alignment as well
+    bool success = true;
+    for (uint8_t numLeadingBits = 0; numLeadingBits < 8; ++numLeadingBits)
+    {
+        const auto endBitPositionResult = object.initializeOffsets(numLeadingBits);
+        if (endBitPositionResult.isError())
+        {
+            return check(false, "initializeOffsets");
+        }
+        const size_t bitSize = endBitPositionResult.getValue();
+        zserio::vector<uint8_t> data((bitSize + 7) / 8);
+        zserio::BitStreamWriter writer(data.data(), data.size());
+        const bool isWritten = (numLeadingBits == 0 || writer.writeBits(0, numLeadingBits).isSuccess()) &&
+                object.write(writer).isSuccess();
+        writer.flush();
+        if (!isWritten)
+        {
+            return check(false, "write");
+        }
+
+        zserio::BitStreamReader readReader(data.data(), bitSize, zserio::BitsTag());
+        zserio::BitStreamReader skipReader(data.data(), bitSize, zserio::BitsTag());
+        const bool isPrepared = readReader.skipBits(numLeadingBits).isSuccess() &&
+                skipReader.skipBits(numLeadingBits).isSuccess();
+
+        const auto readResult = T::deserialize(readReader);
+        const auto skipResult = T::skip(skipReader);
+        success &= isPrepared && readResult.isSuccess() && skipResult.isSuccess() &&
+                readReader.getBitPosition() == bitSize && skipReader.getBitPosition() == bitSize;
+    }
+
+    return check(success, "skip() ends where read() ends");
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "Zserio C++11-Safe Skip Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    bool success = true;
+
+    skip::Node node = createNode(5);
+    success &= checkSkip("Recursive node with optional clause", node);
+
+    skip::Tree tree = createTree(4);
+    success &= checkSkip("Recursive tree with auto optional fields", tree);
+
+    skip::RecordList recordList = createRecordList();
+    success &= checkSkip("Records with choices, unions, optionals, dynamic bit fields and arrays", recordList);
+
+    // types without skip() are read and dropped by their containers, the read position is the reference
+    std::cout << "\nTypes without skip()..." << std::endl;
+    skip::WithExtended withExtended;
+    withExtended.setValue(7);
+    withExtended.setExtra(8);
+    const auto extendedRead = roundTrip(withExtended);
+    success &= check(extendedRead.isSuccess() && extendedRead.getValue().isExtraPresent(),
+            "extended field is read");
+
+    skip::WithPacked withPacked;
+    withPacked.setValues(zserio::vector<uint32_t>{100, 101, 103, 106});
+    const auto packedRead = roundTrip(withPacked);
+    success &= check(packedRead.isSuccess() && packedRead.getValue() == withPacked, "packed array is read");
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << (success ? "SUCCESS: skip() matches read()!" : "FAILED: skip() differs from read()!")
+              << std::endl;
+    std::cout << "========================================" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
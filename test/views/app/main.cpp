@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include "views/Document.h"
+#include "zserio/SerializeUtil.h"
+#include "zserio/String.h"
+#include "zserio/Vector.h"
+
+namespace
+{
+
+views::Point createPoint(int32_t x, int32_t y)
+{
+    views::Point point;
+    point.setX(x);
+    point.setY(y);
+    return point;
+}
+
+views::Document createDocument(bool hasRevision)
+{
+    const uint8_t numCorners = 3;
+    zserio::vector<views::Point> corners;
+    for (uint8_t i = 0; i < numCorners; ++i)
+    {
+        corners.push_back(createPoint(i, -i));
+    }
+    views::Shape shape;
+    shape.setName(zserio::string<>("triangle"));
+    shape.setCorners(corners);
+
+    zserio::vector<views::Point> points;
+    zserio::vector<zserio::string<>> tags;
+    zserio::vector<uint32_t> values;
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        points.push_back(createPoint(static_cast<int32_t>(i * 100), static_cast<int32_t>(i * 1000)));
+        // tags of different lengths give the array elements irregular bit positions
+        tags.push_back(zserio::string<>(i + 1U, static_cast<char>('a' + i)));
+        values.push_back(i * 12345U);
+    }
+
+    views::Document document;
+    document.setVersion(17);
+    document.setTitle(zserio::string<>("document"));
+    document.setPayload(zserio::vector<uint8_t>{0xDE, 0xAD, 0xBE, 0xEF});
+    if (hasRevision)
+    {
+        document.setRevision(0xCAFE);
+    }
+    document.setNumCorners(numCorners);
+    document.setShape(shape);
+    document.setPoints(points);
+    document.setTags(tags);
+    document.setValues(values);
+    document.setScale(0.25);
+    return document;
+}
+
+bool check(bool condition, const char* message)
+{
+    std::cout << (condition ? "   - OK: " : "   - FAILED: ") << message << std::endl;
+    return condition;
+}
+
+bool isStringEqual(const zserio::Result<zserio::StringView>& result, const zserio::string<>& expected)
+{
+    return result.isSuccess() && result.getValue() == zserio::StringView(expected);
+}
+
+bool isPointEqual(const zserio::Result<views::PointView>& result, const views::Point& expected)
+{
+    if (result.isError())
+    {
+        return false;
+    }
+
+    const auto x = result.getValue().getX();
+    const auto y = result.getValue().getY();
+    return x.isSuccess() && x.getValue() == expected.getX() && y.isSuccess() && y.getValue() == expected.getY();
+}
+
+template <typename ARRAY_VIEW, typename VECTOR, typename EQUAL>
+bool isArrayEqual(const zserio::Result<ARRAY_VIEW>& result, const VECTOR& expected, EQUAL isEqual)
+{
+    if (result.isError() || result.getValue().size() != expected.size())
+    {
+        return false;
+    }
+
+    // indexed access goes backward, iteration goes forward
+    const ARRAY_VIEW& arrayView = result.getValue();
+    for (size_t i = expected.size(); i > 0; --i)
+    {
+        if (!isEqual(arrayView.at(i - 1), expected[i - 1]))
+        {
+            return false;
+        }
+    }
+    size_t index = 0;
+    for (auto it = arrayView.begin(); it != arrayView.end(); ++it, ++index)
+    {
+        if (!isEqual(*it, expected[index]))
+        {
+            return false;
+        }
+    }
+
+    return index == expected.size();
+}
+
+// checks the view of the document written after the given number of leading bits
+bool checkView(const char* name, views::Document& document, uint8_t numLeadingBits)
+{
+    using views::DocumentView;
+
+    std::cout << "\n" << name << " after " << static_cast<int>(numLeadingBits) << " leading bits..." << std::endl;
+
+    const auto endBitPositionResult = document.initializeOffsets(numLeadingBits);
+    if (endBitPositionResult.isError())
+    {
+        return check(false, "initializeOffsets");
+    }
+    const size_t bitSize = endBitPositionResult.getValue();
+    zserio::vector<uint8_t> data((bitSize + 7) / 8);
+    zserio::BitStreamWriter writer(data.data(), data.size());
+    const bool isWritten = (numLeadingBits == 0 || writer.writeBits(0, numLeadingBits).isSuccess()) &&
+            document.write(writer).isSuccess();
+    writer.flush();
+    if (!isWritten)
+    {
+        return check(false, "write");
+    }
+
+    const zserio::Span<const uint8_t> buffer(data.data(), data.size());
+    const DocumentView view(buffer, numLeadingBits);
+    bool success = check(view.getBitPosition() == numLeadingBits, "view starts at the given bit position");
+
+    // the last field first, the getters seek over all preceding fields
+    const auto scale = view.getScale();
+    success &= check(scale.isSuccess() && scale.getValue() == document.getScale(), "aligned last field");
+
+    const auto values = view.getValues();
+    success &= check(isArrayEqual(values, document.getValues(),
+                             [](const zserio::Result<uint32_t>& result, uint32_t expected) {
+                                 return result.isSuccess() && result.getValue() == expected;
+                             }),
+            "array of varuint32");
+
+    const auto tags = view.getTags();
+    success &= check(isArrayEqual(tags, document.getTags(), isStringEqual), "array of strings");
+
+    const auto points = view.getPoints();
+    success &= check(isArrayEqual(points, document.getPoints(), isPointEqual), "array of compounds");
+
+    const auto shape = view.getShape();
+    const bool isShapeEqual = shape.isSuccess() &&
+            shape.getValue().getNumCorners() == document.getShape().getNumCorners() &&
+            isStringEqual(shape.getValue().getName(), document.getShape().getName()) &&
+            isArrayEqual(shape.getValue().getCorners(), document.getShape().getCorners(), isPointEqual);
+    success &= check(isShapeEqual, "parameterized compound field");
+
+    const auto numCorners = view.getNumCorners();
+    success &= check(numCorners.isSuccess() && numCorners.getValue() == document.getNumCorners(), "uint8 field");
+
+    const auto isRevisionUsed = view.isRevisionUsed();
+    const auto revision = view.getRevision();
+    const bool isRevisionEqual = isRevisionUsed.isSuccess() &&
+            isRevisionUsed.getValue() == document.isRevisionUsed() &&
+            (document.isRevisionUsed()
+                            ? revision.isSuccess() && revision.getValue() == document.getRevision()
+                            : revision.isError() && revision.getError() == zserio::ErrorCode::EmptyOptional);
+    success &= check(isRevisionEqual, "optional field");
+
+    const auto payload = view.getPayload();
+    const bool isPayloadEqual = payload.isSuccess() && payload.getValue().size() == document.getPayload().size() &&
+            std::equal(payload.getValue().begin(), payload.getValue().end(), document.getPayload().begin());
+    success &= check(isPayloadEqual, "bytes field");
+
+    success &= check(isStringEqual(view.getTitle(), document.getTitle()), "string field");
+
+    const auto version = view.getVersion();
+    success &= check(version.isSuccess() && version.getValue() == document.getVersion(), "first field");
+
+    const auto viewBitSize = view.bitSizeOf();
+    success &= check(viewBitSize.isSuccess() && viewBitSize.getValue() == bitSize - numLeadingBits,
+            "bitSizeOf() covers the whole document");
+
+    zserio::BitStreamReader readReader(data.data(), bitSize, zserio::BitsTag());
+    zserio::BitStreamReader skipReader(data.data(), bitSize, zserio::BitsTag());
+    const bool isPrepared = readReader.skipBits(numLeadingBits).isSuccess() &&
+            skipReader.skipBits(numLeadingBits).isSuccess();
+    const auto readView = DocumentView::read(buffer, readReader);
+    const auto skipResult = DocumentView::skip(skipReader);
+    success &= check(isPrepared && readView.isSuccess() && readView.getValue().getBitPosition() == numLeadingBits &&
+                    readReader.getBitPosition() == bitSize,
+            "read() creates the view and skips the document");
+    success &= check(skipResult.isSuccess() && skipReader.getBitPosition() == bitSize,
+            "skip() ends at the end of the document");
+
+    return success;
+}
+
+} // namespace
+
+int main()
+{
+    std::cout << "========================================" << std::endl;
+    std::cout << "Zserio C++11-Safe Views Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    bool success = true;
+
+    views::Document document = createDocument(true);
+    // serialize() initializes the children of the document
+    if (zserio::serialize(document).isError())
+    {
+        std::cerr << "ERROR: serialize() failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    success &= checkView("Document with revision", document, 0);
+    success &= checkView("Document with revision", document, 3);
+
+    views::Document documentWithoutRevision = createDocument(false);
+    if (zserio::serialize(documentWithoutRevision).isError())
+    {
+        std::cerr << "ERROR: serialize() failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    success &= checkView("Document without revision", documentWithoutRevision, 0);
+    success &= checkView("Document without revision", documentWithoutRevision, 7);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << (success ? "SUCCESS: Views match the read objects!" : "FAILED: Views differ from the read objects!")
+              << std::endl;
+    std::cout << "========================================" << std::endl;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}